@@ -39,11 +39,23 @@ from compiler.backend.analysis.root_slots import (
 	analyze_callable_root_slots,
 	build_root_slot_plan_from_live_reg_sets,
 )
+from compiler.backend.analysis.shrink_wrap import (
+	BackendCallableShrinkWrap,
+	analyze_callable_shrink_wrap,
+)
 from compiler.backend.analysis.stack_homes import (
 	BackendCallableStackHomes,
 	analyze_callable_stack_homes,
 	stack_home_name_for_register,
 )
+from compiler.backend.analysis.induction_variables import (
+	BackendCallableInductionFacts,
+	analyze_callable_induction_variables,
+)
+from compiler.backend.analysis.gc_effects import (
+	BackendProgramGcEffects,
+	analyze_program_gc_effects,
+)
 from compiler.backend.analysis.pipeline import (
 	BackendPipelineCallableAnalysis,
 	BackendPipelineResult,
@@ -68,14 +80,20 @@ __all__ = [
 	"ordered_block_ids_for_callable",
 	"reachable_block_ids",
 	"reverse_postorder_block_ids",
+	"BackendCallableInductionFacts",
 	"BackendCallableLiveness",
 	"BackendCallableRootSlots",
 	"BackendCallableStackHomes",
 	"BackendCallableSafepoints",
+	"BackendCallableShrinkWrap",
+	"BackendProgramGcEffects",
+	"analyze_callable_induction_variables",
 	"analyze_callable_liveness",
 	"analyze_callable_root_slots",
 	"analyze_callable_stack_homes",
 	"analyze_callable_safepoints",
+	"analyze_callable_shrink_wrap",
+	"analyze_program_gc_effects",
 	"build_root_slot_plan_from_live_reg_sets",
 	"run_backend_ir_pipeline",
 	"stack_home_name_for_register",
@@ -0,0 +1,122 @@
+from __future__ import annotations
+
+from collections.abc import Iterable
+from dataclasses import dataclass
+
+from compiler.backend.analysis.cfg import iter_callable_instructions
+from compiler.backend.analysis.safepoints import instruction_effects
+from compiler.backend.ir import (
+    BackendCallableDecl,
+    BackendCallableId,
+    BackendCallInst,
+    BackendDirectCallTarget,
+    BackendInstruction,
+    BackendInterfaceCallTarget,
+    BackendProgram,
+    BackendRuntimeCallTarget,
+    BackendVirtualCallTarget,
+)
+from compiler.backend.program.runtime import has_runtime_call_metadata, runtime_call_metadata
+from compiler.semantic.symbols import MethodId
+
+
+@dataclass(frozen=True)
+class BackendProgramGcEffects:
+    gc_callable_ids: frozenset[BackendCallableId]
+    callable_by_id: dict[BackendCallableId, BackendCallableDecl]
+    methods_by_name: dict[str, tuple[BackendCallableId, ...]]
+
+    def callable_may_gc(self, callable_id: BackendCallableId) -> bool:
+        return callable_id in self.gc_callable_ids
+
+    def call_may_gc(self, instruction: BackendCallInst) -> bool:
+        callees = _instruction_user_callees(instruction, self.callable_by_id, self.methods_by_name)
+        return callees is None or any(callee_id in self.gc_callable_ids for callee_id in callees)
+
+
+def analyze_program_gc_effects(program: BackendProgram) -> BackendProgramGcEffects:
+    """Find the callables whose execution may trigger a garbage collection.
+
+    A callable may collect when one of its instructions allocates or calls the runtime with
+    ``may_gc``, when it makes an indirect call, or when any callable it may reach through a
+    direct, virtual, or interface call may collect. Virtual and interface calls over-approximate
+    their targets as every method with the dispatched name. Externs may collect unless runtime
+    metadata says otherwise. Recursion alone never forces a collection: facts only flow from
+    callees that collect to their callers.
+    """
+
+    callable_by_id = {callable_decl.callable_id: callable_decl for callable_decl in program.callables}
+    methods_by_name = _methods_by_name(callable_by_id)
+
+    may_gc: set[BackendCallableId] = set()
+    callers_by_callee: dict[BackendCallableId, set[BackendCallableId]] = {}
+    for callable_decl in program.callables:
+        if callable_decl.is_extern:
+            if _extern_may_gc(callable_decl):
+                may_gc.add(callable_decl.callable_id)
+            continue
+        for instruction in iter_callable_instructions(callable_decl):
+            callees = _instruction_user_callees(instruction, callable_by_id, methods_by_name)
+            if callees is None:
+                may_gc.add(callable_decl.callable_id)
+                continue
+            for callee_id in callees:
+                callers_by_callee.setdefault(callee_id, set()).add(callable_decl.callable_id)
+
+    worklist = list(may_gc)
+    while worklist:
+        callee_id = worklist.pop()
+        for caller_id in callers_by_callee.get(callee_id, ()):
+            if caller_id not in may_gc:
+                may_gc.add(caller_id)
+                worklist.append(caller_id)
+    return BackendProgramGcEffects(
+        gc_callable_ids=frozenset(may_gc),
+        callable_by_id=callable_by_id,
+        methods_by_name=methods_by_name,
+    )
+
+
+def _methods_by_name(
+    callable_by_id: dict[BackendCallableId, BackendCallableDecl],
+) -> dict[str, tuple[BackendCallableId, ...]]:
+    methods_by_name: dict[str, list[BackendCallableId]] = {}
+    for callable_id in callable_by_id:
+        if isinstance(callable_id, MethodId):
+            methods_by_name.setdefault(callable_id.name, []).append(callable_id)
+    return {name: tuple(method_ids) for name, method_ids in methods_by_name.items()}
+
+
+def _instruction_user_callees(
+    instruction: BackendInstruction,
+    callable_by_id: dict[BackendCallableId, BackendCallableDecl],
+    methods_by_name: dict[str, tuple[BackendCallableId, ...]],
+) -> Iterable[BackendCallableId] | None:
+    """Return the user callables an instruction may enter, or ``None`` when it may collect itself."""
+
+    if not isinstance(instruction, BackendCallInst):
+        effects = instruction_effects(instruction)
+        return None if effects is not None and effects.may_gc else ()
+    target = instruction.target
+    if isinstance(target, BackendRuntimeCallTarget):
+        return None if instruction.effects.may_gc else ()
+    if not instruction.effects.may_gc:
+        return ()
+    if isinstance(target, BackendDirectCallTarget):
+        callee_decl = callable_by_id.get(target.callable_id)
+        if callee_decl is None:
+            return None
+        # Without the receiver argument the call enters the constructor wrapper, which allocates.
+        if callee_decl.kind == "constructor" and len(instruction.args) != len(instruction.signature.param_types) + 1:
+            return None
+        return (target.callable_id,)
+    if isinstance(target, BackendVirtualCallTarget):
+        return methods_by_name.get(target.method_name) or None
+    if isinstance(target, BackendInterfaceCallTarget):
+        return methods_by_name.get(target.method_id.name) or None
+    return None
+
+
+def _extern_may_gc(callable_decl: BackendCallableDecl) -> bool:
+    name = callable_decl.callable_id.name
+    return not has_runtime_call_metadata(name) or runtime_call_metadata(name).may_gc
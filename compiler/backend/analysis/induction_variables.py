@@ -0,0 +1,317 @@
+from __future__ import annotations
+
+from dataclasses import dataclass
+
+from compiler.backend.analysis.cfg import BackendCallableCfg, index_callable_cfg, iter_block_instructions
+from compiler.backend.analysis.liveness import instruction_def_reg
+from compiler.backend.ir import (
+    BackendArrayAllocInst,
+    BackendArrayLengthInst,
+    BackendArrayLoadInst,
+    BackendArrayStoreInst,
+    BackendBinaryInst,
+    BackendBlockId,
+    BackendBranchTerminator,
+    BackendCallableDecl,
+    BackendCastInst,
+    BackendConstInst,
+    BackendConstOperand,
+    BackendCopyInst,
+    BackendInstId,
+    BackendInstruction,
+    BackendIntConst,
+    BackendOperand,
+    BackendRegId,
+    BackendRegOperand,
+)
+from compiler.backend.ir._ordering import inst_id_sort_key
+from compiler.common.type_names import TYPE_NAME_I64, TYPE_NAME_U64
+from compiler.semantic.operations import BinaryOpFlavor, BinaryOpKind, CastSemanticsKind
+from compiler.semantic.types import semantic_type_canonical_name
+
+
+# Facts are small tuples whose register positions are BackendRegIds:
+#   ("nonneg", r)          0 <= r < 2**63 under either 64-bit interpretation
+#   ("lt", x, y)           x < y as signed integers
+#   ("ult", x, y)          x < y as unsigned integers
+#   ("len", n, a)          n equals the length of array a
+#   ("same", x, y)         x and y hold the same bit pattern (a copy or an i64 <-> u64 reinterpretation)
+#   ("cmp", c, x, y, s)    boolean c holds x < y, signed when s is True
+_Fact = tuple
+_FactSet = frozenset
+
+_WORD_INTEGER_TYPE_NAMES = frozenset({TYPE_NAME_I64, TYPE_NAME_U64})
+
+
+@dataclass(frozen=True)
+class BackendCallableInductionFacts:
+    callable_decl: BackendCallableDecl
+    in_bounds_accesses: frozenset[BackendInstId]
+
+    def access_is_in_bounds(self, inst_id: BackendInstId) -> bool:
+        return inst_id in self.in_bounds_accesses
+
+    def in_bounds_access_ids(self) -> tuple[BackendInstId, ...]:
+        return tuple(sorted(self.in_bounds_accesses, key=inst_id_sort_key))
+
+
+def analyze_callable_induction_variables(
+    callable_decl: BackendCallableDecl,
+    *,
+    cfg: BackendCallableCfg | None = None,
+) -> BackendCallableInductionFacts:
+    """Prove direct array accesses whose index is a loop counter kept inside the array bounds.
+
+    A forward must-analysis tracks non-negative counters (a non-negative start stepped by
+    one while below a bound), array lengths, and the `<` comparisons guarding loop bodies.
+    Array loads and stores whose index is non-negative and below the array's own length on
+    every incoming path are reported so targets can drop the inline bounds check.
+    """
+
+    if callable_decl.is_extern or not callable_decl.blocks:
+        return BackendCallableInductionFacts(callable_decl=callable_decl, in_bounds_accesses=frozenset())
+
+    resolved_cfg = index_callable_cfg(callable_decl) if cfg is None else cfg
+    type_name_by_reg_id = {
+        register.reg_id: semantic_type_canonical_name(register.type_ref) for register in callable_decl.registers
+    }
+
+    # None is the optimistic top element: an edge that has not been evaluated yet does not
+    # constrain its successor, which lets counter facts survive the first pass over a loop.
+    edge_facts: dict[tuple[BackendBlockId, BackendBlockId], _FactSet] = {}
+    block_in: dict[BackendBlockId, _FactSet | None] = {}
+    changed = True
+    while changed:
+        changed = False
+        for block_id in resolved_cfg.reverse_postorder_block_ids:
+            facts = _join_predecessor_facts(block_id, resolved_cfg, callable_decl, edge_facts)
+            if facts is None:
+                continue
+            block_in[block_id] = facts
+            block = resolved_cfg.block_by_id[block_id]
+            for instruction in iter_block_instructions(block):
+                facts = _transfer_instruction(facts, instruction, type_name_by_reg_id)
+            for successor_id, successor_facts in _transfer_terminator(facts, block.terminator):
+                edge_key = (block_id, successor_id)
+                if edge_facts.get(edge_key) != successor_facts:
+                    edge_facts[edge_key] = successor_facts
+                    changed = True
+
+    in_bounds_accesses: set[BackendInstId] = set()
+    for block_id, facts in block_in.items():
+        if facts is None:
+            continue
+        for instruction in iter_block_instructions(resolved_cfg.block_by_id[block_id]):
+            if isinstance(instruction, (BackendArrayLoadInst, BackendArrayStoreInst)) and _access_is_in_bounds(
+                facts, instruction.array_ref, instruction.index
+            ):
+                in_bounds_accesses.add(instruction.inst_id)
+            facts = _transfer_instruction(facts, instruction, type_name_by_reg_id)
+
+    return BackendCallableInductionFacts(callable_decl=callable_decl, in_bounds_accesses=frozenset(in_bounds_accesses))
+
+
+def _join_predecessor_facts(
+    block_id: BackendBlockId,
+    cfg: BackendCallableCfg,
+    callable_decl: BackendCallableDecl,
+    edge_facts: dict[tuple[BackendBlockId, BackendBlockId], _FactSet],
+) -> _FactSet | None:
+    if block_id == callable_decl.entry_block_id:
+        return frozenset()
+    joined: _FactSet | None = None
+    for predecessor_id in cfg.predecessor_by_block[block_id]:
+        incoming = edge_facts.get((predecessor_id, block_id))
+        if incoming is None:
+            continue
+        joined = incoming if joined is None else joined & incoming
+    return joined
+
+
+def _transfer_instruction(facts: _FactSet, instruction: BackendInstruction, type_name_by_reg_id: dict) -> _FactSet:
+    dest = instruction_def_reg(instruction)
+    if dest is None:
+        return facts
+    generated = _generated_facts(facts, instruction, dest, type_name_by_reg_id)
+    surviving = frozenset(fact for fact in facts if dest not in fact)
+    return surviving | generated
+
+
+def _generated_facts(
+    facts: _FactSet,
+    instruction: BackendInstruction,
+    dest: BackendRegId,
+    type_name_by_reg_id: dict,
+) -> _FactSet:
+    if isinstance(instruction, BackendConstInst):
+        return _constant_facts(dest, instruction.constant)
+    if isinstance(instruction, BackendCopyInst):
+        if isinstance(instruction.source, BackendConstOperand):
+            return _constant_facts(dest, instruction.source.constant)
+        if isinstance(instruction.source, BackendRegOperand):
+            if instruction.source.reg_id == dest:
+                return frozenset()
+            return _renamed_facts(facts, instruction.source.reg_id, dest) | {("same", dest, instruction.source.reg_id)}
+        return frozenset()
+    if isinstance(instruction, BackendArrayLengthInst):
+        if isinstance(instruction.array_ref, BackendRegOperand) and instruction.array_ref.reg_id != dest:
+            return frozenset({("len", dest, instruction.array_ref.reg_id), ("nonneg", dest)})
+        return frozenset()
+    if isinstance(instruction, BackendArrayAllocInst):
+        if isinstance(instruction.length, BackendRegOperand) and instruction.length.reg_id != dest:
+            return frozenset({("len", instruction.length.reg_id, dest)})
+        return frozenset()
+    if isinstance(instruction, BackendCastInst):
+        return _cast_facts(facts, instruction, dest, type_name_by_reg_id)
+    if isinstance(instruction, BackendBinaryInst):
+        return _binary_facts(facts, instruction, dest, type_name_by_reg_id)
+    return frozenset()
+
+
+def _constant_facts(dest: BackendRegId, constant) -> _FactSet:
+    if isinstance(constant, BackendIntConst) and 0 <= constant.value < (1 << 63):
+        return frozenset({("nonneg", dest)})
+    return frozenset()
+
+
+def _renamed_facts(facts: _FactSet, source: BackendRegId, dest: BackendRegId) -> _FactSet:
+    if source == dest:
+        return frozenset()
+    return frozenset(
+        tuple(dest if part == source else part for part in fact)
+        for fact in facts
+        if source in fact and dest not in fact
+    )
+
+
+def _cast_facts(
+    facts: _FactSet,
+    instruction: BackendCastInst,
+    dest: BackendRegId,
+    type_name_by_reg_id: dict,
+) -> _FactSet:
+    if instruction.cast_kind is not CastSemanticsKind.TO_INTEGER or not isinstance(instruction.operand, BackendRegOperand):
+        return frozenset()
+    source = instruction.operand.reg_id
+    if source == dest:
+        return frozenset()
+    if type_name_by_reg_id.get(source) not in _WORD_INTEGER_TYPE_NAMES:
+        return frozenset()
+    if semantic_type_canonical_name(instruction.target_type_ref) not in _WORD_INTEGER_TYPE_NAMES:
+        return frozenset()
+    generated = {("same", dest, source)}
+    # Lengths and other non-negative values read the same under both interpretations.
+    if ("nonneg", source) in facts:
+        generated.update(_renamed_facts(facts, source, dest))
+    return frozenset(generated)
+
+
+def _binary_facts(
+    facts: _FactSet,
+    instruction: BackendBinaryInst,
+    dest: BackendRegId,
+    type_name_by_reg_id: dict,
+) -> _FactSet:
+    left = _reg_or_none(instruction.left)
+    right = _reg_or_none(instruction.right)
+    op = instruction.op
+    if op.flavor is BinaryOpFlavor.INTEGER_COMPARISON and op.kind in {BinaryOpKind.LESS_THAN, BinaryOpKind.GREATER_THAN}:
+        if left is None or right is None or dest in (left, right):
+            return frozenset()
+        operand_type_name = type_name_by_reg_id.get(left)
+        if operand_type_name not in _WORD_INTEGER_TYPE_NAMES:
+            return frozenset()
+        lower, upper = (left, right) if op.kind is BinaryOpKind.LESS_THAN else (right, left)
+        return frozenset({("cmp", dest, lower, upper, operand_type_name == TYPE_NAME_I64)})
+    if op.flavor is BinaryOpFlavor.INTEGER and op.kind is BinaryOpKind.ADD:
+        if type_name_by_reg_id.get(dest) != TYPE_NAME_I64:
+            return frozenset()
+        counter, step = (left, _int_constant(instruction.right)) if left is not None else (right, _int_constant(instruction.left))
+        if counter is None or step is None or not _known_nonneg(facts, counter):
+            return frozenset()
+        # A counter strictly below some bound cannot overflow when stepped by one.
+        if step == 0 or (step == 1 and _known_bounded_above(facts, counter)):
+            return frozenset({("nonneg", dest)})
+    return frozenset()
+
+
+def _transfer_terminator(facts: _FactSet, terminator) -> tuple[tuple[BackendBlockId, _FactSet], ...]:
+    if isinstance(terminator, BackendBranchTerminator):
+        true_facts = facts
+        if isinstance(terminator.condition, BackendRegOperand):
+            true_facts = facts | _taken_comparison_facts(facts, terminator.condition.reg_id)
+        if terminator.true_block_id == terminator.false_block_id:
+            return ((terminator.true_block_id, facts),)
+        return ((terminator.true_block_id, true_facts), (terminator.false_block_id, facts))
+    target_block_id = getattr(terminator, "target_block_id", None)
+    if target_block_id is None:
+        return ()
+    return ((target_block_id, facts),)
+
+
+def _taken_comparison_facts(facts: _FactSet, condition: BackendRegId) -> _FactSet:
+    generated: set[_Fact] = set()
+    for fact in facts:
+        if fact[0] != "cmp" or fact[1] != condition:
+            continue
+        _, _, lower, upper, signed = fact
+        if signed:
+            generated.add(("lt", lower, upper))
+            continue
+        generated.add(("ult", lower, upper))
+        # `(u64)i < n` also bounds the signed counter `i`: negative values wrap above any length.
+        for other in facts:
+            if other[0] == "same" and other[1] == lower:
+                generated.add(("ult", other[2], upper))
+    return frozenset(generated)
+
+
+def _access_is_in_bounds(facts: _FactSet, array_ref: BackendOperand, index: BackendOperand) -> bool:
+    array_reg = _reg_or_none(array_ref)
+    index_reg = _reg_or_none(index)
+    if array_reg is None or index_reg is None:
+        return False
+    # Copy propagation may leave the length read through one name and the access through another.
+    array_regs = {array_reg}
+    array_regs.update(fact[2] for fact in facts if fact[0] == "same" and fact[1] == array_reg)
+    array_regs.update(fact[1] for fact in facts if fact[0] == "same" and fact[2] == array_reg)
+    for fact in facts:
+        if fact[0] != "len" or fact[2] not in array_regs:
+            continue
+        length_reg = fact[1]
+        if ("ult", index_reg, length_reg) in facts:
+            return True
+        if ("lt", index_reg, length_reg) in facts and ("nonneg", index_reg) in facts:
+            return True
+    return False
+
+
+def _known_nonneg(facts: _FactSet, reg_id: BackendRegId) -> bool:
+    if ("nonneg", reg_id) in facts:
+        return True
+    return any(fact[0] == "ult" and fact[1] == reg_id and _is_length(facts, fact[2]) for fact in facts)
+
+
+def _known_bounded_above(facts: _FactSet, reg_id: BackendRegId) -> bool:
+    for fact in facts:
+        if fact[1] != reg_id:
+            continue
+        if fact[0] == "lt":
+            return True
+        if fact[0] == "ult" and _is_length(facts, fact[2]):
+            return True
+    return False
+
+
+def _is_length(facts: _FactSet, reg_id: BackendRegId) -> bool:
+    return any(fact[0] == "len" and fact[1] == reg_id for fact in facts)
+
+
+def _reg_or_none(operand: BackendOperand) -> BackendRegId | None:
+    return operand.reg_id if isinstance(operand, BackendRegOperand) else None
+
+
+def _int_constant(operand: BackendOperand) -> int | None:
+    if isinstance(operand, BackendConstOperand) and isinstance(operand.constant, BackendIntConst):
+        return operand.constant.value
+    return None
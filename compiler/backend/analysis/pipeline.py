@@ -4,12 +4,25 @@ from dataclasses import dataclass, replace
 
 from compiler.backend.analysis.block_order import order_callable_blocks, ordered_block_ids_for_callable
 from compiler.backend.analysis.cfg import BackendCallableCfg, index_callable_cfg
+from compiler.backend.analysis.induction_variables import (
+    BackendCallableInductionFacts,
+    analyze_callable_induction_variables,
+)
 from compiler.backend.analysis.liveness import BackendCallableLiveness, analyze_callable_liveness
 from compiler.backend.analysis.root_slots import BackendCallableRootSlots, analyze_callable_root_slots
 from compiler.backend.analysis.safepoints import BackendCallableSafepoints, analyze_callable_safepoints
+from compiler.backend.analysis.shrink_wrap import BackendCallableShrinkWrap, analyze_callable_shrink_wrap
 from compiler.backend.analysis.stack_homes import BackendCallableStackHomes, analyze_callable_stack_homes
-from compiler.backend.ir import BackendCallableDecl, BackendCallableId, BackendFunctionAnalysisDump, BackendProgram
+from compiler.backend.ir import (
+    BackendArrayLoadInst,
+    BackendArrayStoreInst,
+    BackendCallableDecl,
+    BackendCallableId,
+    BackendFunctionAnalysisDump,
+    BackendProgram,
+)
 from compiler.backend.ir.verify import verify_backend_program
+from compiler.common.opt_remarks import PassRemarks
 
 
 @dataclass(frozen=True)
@@ -19,7 +32,9 @@ class BackendPipelineCallableAnalysis:
     liveness: BackendCallableLiveness
     safepoints: BackendCallableSafepoints
     root_slots: BackendCallableRootSlots
+    shrink_wrap: BackendCallableShrinkWrap
     stack_homes: BackendCallableStackHomes
+    induction_variables: BackendCallableInductionFacts
     ordered_block_ids: tuple
     analysis_dump: BackendFunctionAnalysisDump
 
@@ -42,13 +57,19 @@ def run_backend_ir_pipeline(program: BackendProgram) -> BackendPipelineResult:
 
     rewritten_callables: list[BackendCallableDecl] = []
     analysis_by_callable_id: dict[BackendCallableId, BackendPipelineCallableAnalysis] = {}
+    bounds_check_remarks = PassRemarks("bounds_check_elision")
+    shrink_wrap_remarks = PassRemarks("shrink_wrap")
 
     for callable_decl in program.callables:
         ordered_callable = order_callable_blocks(callable_decl)
         callable_analysis = _analyze_callable(ordered_callable)
         rewritten_callables.append(ordered_callable)
         analysis_by_callable_id[ordered_callable.callable_id] = callable_analysis
+        _remark_bounds_checks(ordered_callable, callable_analysis, bounds_check_remarks)
+        _remark_shrink_wrap(ordered_callable, callable_analysis, shrink_wrap_remarks)
 
+    bounds_check_remarks.publish()
+    shrink_wrap_remarks.publish()
     rewritten_program = replace(program, callables=tuple(rewritten_callables))
     verify_backend_program(rewritten_program)
     return BackendPipelineResult(
@@ -62,7 +83,9 @@ def _analyze_callable(callable_decl: BackendCallableDecl) -> BackendPipelineCall
     liveness = analyze_callable_liveness(callable_decl)
     safepoints = analyze_callable_safepoints(callable_decl, liveness=liveness)
     root_slots = analyze_callable_root_slots(callable_decl, safepoints=safepoints)
+    shrink_wrap = analyze_callable_shrink_wrap(callable_decl, cfg=cfg, safepoints=safepoints)
     stack_homes = analyze_callable_stack_homes(callable_decl)
+    induction_variables = analyze_callable_induction_variables(callable_decl, cfg=cfg)
     ordered_block_ids = ordered_block_ids_for_callable(callable_decl)
     analysis_dump = BackendFunctionAnalysisDump(
         predecessors={} if cfg is None else cfg.predecessor_by_block,
@@ -79,12 +102,71 @@ def _analyze_callable(callable_decl: BackendCallableDecl) -> BackendPipelineCall
         liveness=liveness,
         safepoints=safepoints,
         root_slots=root_slots,
+        shrink_wrap=shrink_wrap,
         stack_homes=stack_homes,
+        induction_variables=induction_variables,
         ordered_block_ids=ordered_block_ids,
         analysis_dump=analysis_dump,
     )
 
 
+def _remark_bounds_checks(
+    callable_decl: BackendCallableDecl,
+    analysis: BackendPipelineCallableAnalysis,
+    remarks: PassRemarks,
+) -> None:
+    if not remarks.enabled or callable_decl.is_extern:
+        return
+    remarks.enter_callable(callable_decl.callable_id)
+    for block in callable_decl.blocks:
+        for instruction in block.instructions:
+            if not isinstance(instruction, (BackendArrayLoadInst, BackendArrayStoreInst)):
+                continue
+            access = "load" if isinstance(instruction, BackendArrayLoadInst) else "store"
+            if analysis.induction_variables.access_is_in_bounds(instruction.inst_id):
+                remarks.applied(
+                    instruction.span,
+                    f"array {access} bounds check dropped: index is a loop counter kept below the array length",
+                )
+            else:
+                remarks.missed(
+                    instruction.span,
+                    f"array {access} bounds check kept: index is not proven non-negative and below the array length",
+                )
+    remarks.leave_callable()
+
+
+def _remark_shrink_wrap(
+    callable_decl: BackendCallableDecl,
+    analysis: BackendPipelineCallableAnalysis,
+    remarks: PassRemarks,
+) -> None:
+    if not remarks.enabled or callable_decl.is_extern:
+        return
+    rooted_inst_ids = {
+        inst_id for inst_id, live_reg_ids in analysis.safepoints.safepoint_live_regs.items() if live_reg_ids
+    }
+    if not rooted_inst_ids:
+        return
+    remarks.enter_callable(callable_decl.callable_id)
+    shrink_wrap = analysis.shrink_wrap
+    if not shrink_wrap.sets_up_root_frame_in_prologue():
+        frame_block = next(block for block in callable_decl.blocks if block.block_id == shrink_wrap.root_frame_block_id)
+        remarks.applied(
+            frame_block.span,
+            "root frame setup moved out of the prologue into the block that dominates every rooted safepoint; "
+            f"returns that skip it: {len(shrink_wrap.unframed_return_block_ids)}",
+        )
+    else:
+        entry_block = next(block for block in callable_decl.blocks if block.block_id == callable_decl.entry_block_id)
+        if any(instruction.inst_id in rooted_inst_ids for instruction in entry_block.instructions):
+            reason = "the entry block itself has a safepoint with live references"
+        else:
+            reason = "no block outside every loop dominates all safepoints with live references"
+        remarks.missed(callable_decl.span, f"root frame set up in the prologue: {reason}")
+    remarks.leave_callable()
+
+
 __all__ = [
     "BackendPipelineCallableAnalysis",
     "BackendPipelineResult",
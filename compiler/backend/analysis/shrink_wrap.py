@@ -0,0 +1,154 @@
+from __future__ import annotations
+
+from dataclasses import dataclass
+
+from compiler.backend.analysis.cfg import BackendCallableCfg, index_callable_cfg
+from compiler.backend.analysis.safepoints import BackendCallableSafepoints, analyze_callable_safepoints
+from compiler.backend.ir import BackendBlockId, BackendCallableDecl, BackendReturnTerminator
+
+
+@dataclass(frozen=True)
+class BackendCallableShrinkWrap:
+    callable_decl: BackendCallableDecl
+    root_frame_block_id: BackendBlockId | None
+    unframed_return_block_ids: frozenset[BackendBlockId]
+
+    def sets_up_root_frame_in_prologue(self) -> bool:
+        return self.root_frame_block_id is None
+
+    def block_sets_up_root_frame(self, block_id: BackendBlockId) -> bool:
+        return block_id == self.root_frame_block_id
+
+    def return_skips_root_frame(self, block_id: BackendBlockId) -> bool:
+        return block_id in self.unframed_return_block_ids
+
+
+def analyze_callable_shrink_wrap(
+    callable_decl: BackendCallableDecl,
+    *,
+    cfg: BackendCallableCfg | None = None,
+    safepoints: BackendCallableSafepoints | None = None,
+) -> BackendCallableShrinkWrap:
+    """Choose where a callable sets up its root frame.
+
+    Only safepoints with live references need the frame, so setup moves from the prologue to
+    the block that dominates all of them, provided that block is outside every loop and the
+    blocks reachable from it form a region it alone enters. Returns inside that region pop
+    the frame; returns outside it leave through an epilogue that never linked one, so early
+    exits such as cached-value fast paths skip root slot zeroing and the frame push entirely.
+    """
+
+    prologue = BackendCallableShrinkWrap(
+        callable_decl=callable_decl,
+        root_frame_block_id=None,
+        unframed_return_block_ids=frozenset(),
+    )
+    if callable_decl.is_extern or not callable_decl.blocks or callable_decl.entry_block_id is None:
+        return prologue
+
+    resolved_cfg = index_callable_cfg(callable_decl) if cfg is None else cfg
+    resolved_safepoints = analyze_callable_safepoints(callable_decl) if safepoints is None else safepoints
+    block_id_by_inst_id = {
+        instruction.inst_id: block.block_id for block in callable_decl.blocks for instruction in block.instructions
+    }
+    rooted_block_ids = {
+        block_id_by_inst_id[inst_id]
+        for inst_id, live_reg_ids in resolved_safepoints.safepoint_live_regs.items()
+        if live_reg_ids
+    }
+    rooted_block_ids &= resolved_cfg.reachable_block_ids
+    if not rooted_block_ids:
+        return prologue
+
+    entry_block_id = callable_decl.entry_block_id
+    idom = _immediate_dominators(resolved_cfg, entry_block_id)
+    candidate_id = _nearest_common_dominator(rooted_block_ids, idom)
+    while candidate_id != entry_block_id:
+        region = _region_from(candidate_id, resolved_cfg, idom)
+        if region is not None:
+            return BackendCallableShrinkWrap(
+                callable_decl=callable_decl,
+                root_frame_block_id=candidate_id,
+                unframed_return_block_ids=frozenset(
+                    block_id
+                    for block_id in resolved_cfg.reachable_block_ids
+                    if block_id not in region
+                    and isinstance(resolved_cfg.block_by_id[block_id].terminator, BackendReturnTerminator)
+                ),
+            )
+        candidate_id = idom[candidate_id]
+    return prologue
+
+
+def _region_from(
+    start_id: BackendBlockId,
+    cfg: BackendCallableCfg,
+    idom: dict[BackendBlockId, BackendBlockId],
+) -> frozenset[BackendBlockId] | None:
+    """Return the blocks reachable from ``start_id`` if it dominates them all and sits in no loop."""
+
+    region = {start_id}
+    worklist = [start_id]
+    while worklist:
+        block_id = worklist.pop()
+        for successor_id in cfg.successor_by_block[block_id]:
+            if successor_id == start_id or not _dominates(start_id, successor_id, idom):
+                return None
+            if successor_id not in region:
+                region.add(successor_id)
+                worklist.append(successor_id)
+    return frozenset(region)
+
+
+def _immediate_dominators(cfg: BackendCallableCfg, entry_block_id: BackendBlockId) -> dict[BackendBlockId, BackendBlockId]:
+    rpo_ids = cfg.reverse_postorder_block_ids
+    rpo_index = {block_id: index for index, block_id in enumerate(rpo_ids)}
+    idom: dict[BackendBlockId, BackendBlockId] = {entry_block_id: entry_block_id}
+
+    def intersect(left: BackendBlockId, right: BackendBlockId) -> BackendBlockId:
+        while left != right:
+            while rpo_index[left] > rpo_index[right]:
+                left = idom[left]
+            while rpo_index[right] > rpo_index[left]:
+                right = idom[right]
+        return left
+
+    changed = True
+    while changed:
+        changed = False
+        for block_id in rpo_ids:
+            if block_id == entry_block_id:
+                continue
+            processed_preds = [pred_id for pred_id in cfg.predecessor_by_block[block_id] if pred_id in idom]
+            if not processed_preds:
+                continue
+            new_idom = processed_preds[0]
+            for pred_id in processed_preds[1:]:
+                new_idom = intersect(pred_id, new_idom)
+            if idom.get(block_id) != new_idom:
+                idom[block_id] = new_idom
+                changed = True
+    return idom
+
+
+def _nearest_common_dominator(
+    block_ids: set[BackendBlockId],
+    idom: dict[BackendBlockId, BackendBlockId],
+) -> BackendBlockId:
+    ordered_ids = sorted(block_ids, key=lambda block_id: block_id.ordinal)
+    common_id = ordered_ids[0]
+    for block_id in ordered_ids[1:]:
+        while not _dominates(common_id, block_id, idom):
+            common_id = idom[common_id]
+    return common_id
+
+
+def _dominates(dominator_id: BackendBlockId, block_id: BackendBlockId, idom: dict[BackendBlockId, BackendBlockId]) -> bool:
+    current_id = block_id
+    while True:
+        if current_id == dominator_id:
+            return True
+        parent_id = idom.get(current_id)
+        if parent_id is None or parent_id == current_id:
+            return False
+        current_id = parent_id
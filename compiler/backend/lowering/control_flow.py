@@ -12,11 +12,18 @@ from compiler.backend.lowering.expressions import (
     lower_null_operand,
     lower_unit_operand,
 )
+from compiler.backend.program.intrinsics import is_intrinsic_callable_id
 from compiler.backend.program.runtime import ARRAY_FROM_BYTES_U8_RUNTIME_CALL, runtime_call_metadata
+from compiler.backend.program.runtime import (
+    STR_FORMAT_LEN_RUNTIME_CALLS,
+    STR_FORMAT_WRITE_RUNTIME_CALLS,
+    STR_WRITE_BYTES_RUNTIME_CALL,
+    STR_WRITE_LITERAL_RUNTIME_CALL,
+)
 from compiler.backend.program.runtime import runtime_dispatch_call_name
 from compiler.common.collection_protocols import ArrayRuntimeKind, CollectionOpKind, array_runtime_kind_for_element_type_name
 from compiler.common.span import SourceSpan
-from compiler.common.type_names import TYPE_NAME_BOOL, TYPE_NAME_I64, TYPE_NAME_OBJ, TYPE_NAME_U64
+from compiler.common.type_names import TYPE_NAME_BOOL, TYPE_NAME_I64, TYPE_NAME_OBJ, TYPE_NAME_U64, TYPE_NAME_U8
 from compiler.semantic.ir import (
     ArrayCtorExprS,
     ArrayLenExpr,
@@ -58,6 +65,7 @@ from compiler.semantic.ir import (
     SliceReadExpr,
     StaticMethodCallTarget,
     StringLiteralBytesExpr,
+    StrConcatExprS,
     TypeTestExprS,
     UnaryExprS,
     VirtualMethodDispatch,
@@ -67,6 +75,7 @@ from compiler.semantic.operations import BinaryOpFlavor, BinaryOpKind, CastSeman
 from compiler.semantic.symbols import ClassId, LocalId
 from compiler.semantic.types import (
     SemanticTypeRef,
+    semantic_array_type_ref,
     semantic_primitive_type_ref,
     semantic_type_callable_params,
     semantic_type_callable_return,
@@ -82,9 +91,11 @@ from compiler.semantic.types import (
 _BOOL_TYPE_REF = semantic_primitive_type_ref(TYPE_NAME_BOOL)
 _I64_TYPE_REF = semantic_primitive_type_ref(TYPE_NAME_I64)
 _U64_TYPE_REF = semantic_primitive_type_ref(TYPE_NAME_U64)
+_U8_ARRAY_TYPE_REF = semantic_array_type_ref(semantic_primitive_type_ref(TYPE_NAME_U8))
 _OPAQUE_DATA_TYPE_REF = SemanticTypeRef(kind="reference", canonical_name=TYPE_NAME_OBJ, display_name=TYPE_NAME_OBJ)
 _I64_LT_OP = SemanticBinaryOp(kind=BinaryOpKind.LESS_THAN, flavor=BinaryOpFlavor.INTEGER_COMPARISON)
 _I64_ADD_OP = SemanticBinaryOp(kind=BinaryOpKind.ADD, flavor=BinaryOpFlavor.INTEGER)
+_U64_ADD_OP = SemanticBinaryOp(kind=BinaryOpKind.ADD, flavor=BinaryOpFlavor.INTEGER)
 
 
 @dataclass(frozen=True)
@@ -1345,6 +1356,9 @@ def _materialize_expr_into(
     if isinstance(expr, StringLiteralBytesExpr):
         _emit_string_literal_bytes_expr(builder, state, expr=expr, dest_reg_id=dest_reg_id)
         return
+    if isinstance(expr, StrConcatExprS):
+        _emit_str_concat_expr(builder, state, expr=expr, dest_reg_id=dest_reg_id)
+        return
 
     operand = _lower_expression_to_operand(builder, state, expr)
     if isinstance(operand, ir_model.BackendRegOperand):
@@ -1507,6 +1521,7 @@ def _lower_expression_to_operand(
             IndexReadExpr,
             SliceReadExpr,
             StringLiteralBytesExpr,
+            StrConcatExprS,
         ),
     ):
         dest_reg_id = builder.allocate_temp(type_ref=expr.type_ref, span=expr.span, debug_hint="tmp")
@@ -1678,6 +1693,7 @@ def _emit_call_expression(
             target=ir_model.BackendDirectCallTarget(callable_id=target.function_id),
             args=args,
             signature=signature,
+            effects=_direct_function_call_effects(target.function_id, signature),
             span=call_span,
         )
         return
@@ -2017,6 +2033,173 @@ def _emit_string_literal_bytes_expr(
     )
 
 
+@dataclass(frozen=True)
+class _StrConcatPartValue:
+    write_call_name: str
+    value_args: tuple[ir_model.BackendOperand, ...]
+    value_types: tuple[SemanticTypeRef, ...]
+    length: ir_model.BackendOperand
+
+
+def _emit_str_concat_expr(
+    builder: _CallableCFGBuilder,
+    state: _ControlFlowState,
+    *,
+    expr: StrConcatExprS,
+    dest_reg_id: ir_model.BackendRegId,
+) -> None:
+    # Parts run strictly left to right, and each one is null-checked or formatted as soon as it is evaluated, so a
+    # null `Str` or an unformattable double panics before any later operand runs. Only then is one u8[] of the
+    # summed length allocated and filled in place.
+    str_class_id = ClassId(module_path=expr.constructor_id.module_path, name=expr.constructor_id.class_name)
+    part_values: list[_StrConcatPartValue] = []
+    for part in expr.parts:
+        if isinstance(part, StringLiteralBytesExpr):
+            data_operand, data_len = builder.string_data_operand_for_literal(part.literal_text)
+            length = ir_model.BackendConstOperand(constant=ir_model.BackendIntConst(type_name=TYPE_NAME_U64, value=data_len))
+            part_values.append(
+                _StrConcatPartValue(
+                    write_call_name=STR_WRITE_LITERAL_RUNTIME_CALL,
+                    value_args=(data_operand, length),
+                    value_types=(_OPAQUE_DATA_TYPE_REF, _U64_TYPE_REF),
+                    length=length,
+                )
+            )
+            continue
+
+        operand = _lower_receiver_operand(builder, state, part, span=part.span)
+        format_type_name = semantic_type_canonical_name(part.type_ref)
+        if format_type_name in STR_FORMAT_LEN_RUNTIME_CALLS:
+            length_reg_id = builder.allocate_temp(type_ref=_U64_TYPE_REF, span=part.span, debug_hint="strlen")
+            _emit_str_runtime_call(
+                builder,
+                state,
+                dest=length_reg_id,
+                call_name=STR_FORMAT_LEN_RUNTIME_CALLS[format_type_name],
+                args=(operand,),
+                param_types=(part.type_ref,),
+                span=part.span,
+            )
+            part_values.append(
+                _StrConcatPartValue(
+                    write_call_name=STR_FORMAT_WRITE_RUNTIME_CALLS[format_type_name],
+                    value_args=(operand,),
+                    value_types=(part.type_ref,),
+                    length=ir_model.BackendRegOperand(reg_id=length_reg_id),
+                )
+            )
+            continue
+
+        bytes_reg_id = builder.allocate_temp(type_ref=_U8_ARRAY_TYPE_REF, span=part.span, debug_hint="strbytes")
+        builder.emit_null_check(state, value=operand, span=part.span)
+        builder.emit_field_load(
+            state,
+            dest=bytes_reg_id,
+            object_ref=operand,
+            owner_class_id=str_class_id,
+            field_name=expr.bytes_field_name,
+            span=part.span,
+        )
+        length_reg_id = builder.allocate_temp(type_ref=_U64_TYPE_REF, span=part.span, debug_hint="strlen")
+        bytes_operand = ir_model.BackendRegOperand(reg_id=bytes_reg_id)
+        builder.emit_array_length(state, dest=length_reg_id, array_ref=bytes_operand, span=part.span)
+        part_values.append(
+            _StrConcatPartValue(
+                write_call_name=STR_WRITE_BYTES_RUNTIME_CALL,
+                value_args=(bytes_operand,),
+                value_types=(_U8_ARRAY_TYPE_REF,),
+                length=ir_model.BackendRegOperand(reg_id=length_reg_id),
+            )
+        )
+
+    literal_len = sum(
+        part_value.length.constant.value
+        for part_value in part_values
+        if isinstance(part_value.length, ir_model.BackendConstOperand)
+    )
+    total_len: ir_model.BackendOperand = ir_model.BackendConstOperand(
+        constant=ir_model.BackendIntConst(type_name=TYPE_NAME_U64, value=literal_len)
+    )
+    for part_value in part_values:
+        if isinstance(part_value.length, ir_model.BackendConstOperand):
+            continue
+        if literal_len == 0 and isinstance(total_len, ir_model.BackendConstOperand):
+            total_len = part_value.length
+            continue
+        sum_reg_id = builder.allocate_temp(type_ref=_U64_TYPE_REF, span=expr.span, debug_hint="strlen")
+        builder.emit_binary(state, dest=sum_reg_id, op=_U64_ADD_OP, left=total_len, right=part_value.length, span=expr.span)
+        total_len = ir_model.BackendRegOperand(reg_id=sum_reg_id)
+
+    buffer_reg_id = builder.allocate_temp(type_ref=_U8_ARRAY_TYPE_REF, span=expr.span, debug_hint="strbuf")
+    builder.emit_array_alloc(
+        state,
+        dest=buffer_reg_id,
+        array_runtime_kind=ArrayRuntimeKind.U8,
+        length=total_len,
+        effects=_conservative_alloc_effects(),
+        span=expr.span,
+    )
+    buffer_operand = ir_model.BackendRegOperand(reg_id=buffer_reg_id)
+    offset: ir_model.BackendOperand = ir_model.BackendConstOperand(
+        constant=ir_model.BackendIntConst(type_name=TYPE_NAME_U64, value=0)
+    )
+    for part_value in part_values:
+        next_offset_reg_id = builder.allocate_temp(type_ref=_U64_TYPE_REF, span=expr.span, debug_hint="stroff")
+        _emit_str_runtime_call(
+            builder,
+            state,
+            dest=next_offset_reg_id,
+            call_name=part_value.write_call_name,
+            args=(buffer_operand, offset, *part_value.value_args),
+            param_types=(_U8_ARRAY_TYPE_REF, _U64_TYPE_REF, *part_value.value_types),
+            span=expr.span,
+        )
+        offset = ir_model.BackendRegOperand(reg_id=next_offset_reg_id)
+
+    builder.emit_alloc_object(
+        state,
+        dest=dest_reg_id,
+        class_id=str_class_id,
+        effects=_conservative_alloc_effects(),
+        span=expr.span,
+    )
+    builder.emit_call(
+        state,
+        dest=dest_reg_id,
+        target=ir_model.BackendDirectCallTarget(callable_id=expr.constructor_id),
+        args=(ir_model.BackendRegOperand(reg_id=dest_reg_id), buffer_operand),
+        signature=builder.require_callable_surface(expr.constructor_id).signature,
+        span=expr.span,
+    )
+
+
+def _emit_str_runtime_call(
+    builder: _CallableCFGBuilder,
+    state: _ControlFlowState,
+    *,
+    dest: ir_model.BackendRegId,
+    call_name: str,
+    args: tuple[ir_model.BackendOperand, ...],
+    param_types: tuple[SemanticTypeRef, ...],
+    span: SourceSpan,
+) -> None:
+    builder.emit_call(
+        state,
+        dest=dest,
+        target=ir_model.BackendRuntimeCallTarget(
+            name=call_name,
+            ref_arg_indices=runtime_call_metadata(call_name).ref_arg_indices,
+        ),
+        args=args,
+        signature=ir_model.BackendSignature(
+            param_types=param_types,
+            return_type=_U64_TYPE_REF,
+        ),
+        effects=_runtime_call_effects(call_name),
+        span=span,
+    )
+
+
 def _reachable_block_ids(blocks: list[_MutableBlock]) -> set[ir_model.BackendBlockId]:
     if not blocks:
         return set()
@@ -2132,6 +2315,13 @@ def _conservative_user_call_effects() -> ir_model.BackendEffects:
     return ir_model.BackendEffects(reads_memory=True, writes_memory=True, may_gc=True, may_trap=True)
 
 
+def _direct_function_call_effects(function_id, signature: ir_model.BackendSignature) -> ir_model.BackendEffects | None:
+    # std.math and std.bits intrinsics are lowered inline by every checked target: no memory, no GC, no trap.
+    if is_intrinsic_callable_id(function_id, signature):
+        return ir_model.BackendEffects()
+    return None
+
+
 def _runtime_call_effects(call_name: str) -> ir_model.BackendEffects:
     metadata = runtime_call_metadata(call_name)
     return ir_model.BackendEffects(
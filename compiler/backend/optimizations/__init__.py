@@ -6,6 +6,9 @@ from compiler.backend.optimizations.dead_pure_definition_elimination import (
     dead_pure_definition_elimination,
     instruction_is_dead_eliminable,
 )
+from compiler.backend.optimizations.gc_effect_inference import gc_effect_inference, refine_callable_call_gc_effects
+from compiler.backend.optimizations.idiom_recognition import idiom_recognition, recognize_callable_loop_idioms
+from compiler.backend.optimizations.loop_rotation import loop_rotation, rotate_callable_loops
 from compiler.backend.optimizations.pipeline import (
     DEFAULT_BACKEND_OPTIMIZATION_PASSES,
     BackendOptimization,
@@ -32,8 +35,14 @@ __all__ = [
     "eliminate_unreachable_blocks",
     "fold_constant_branches",
     "fold_same_target_branches",
+    "gc_effect_inference",
+    "idiom_recognition",
     "instruction_is_dead_eliminable",
+    "loop_rotation",
     "optimize_backend_ir_program",
+    "recognize_callable_loop_idioms",
+    "refine_callable_call_gc_effects",
+    "rotate_callable_loops",
     "simplify_callable_cfg",
     "simplify_cfg",
     "simplify_trivial_jump_blocks",
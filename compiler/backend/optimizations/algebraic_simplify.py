@@ -1,6 +1,6 @@
 from __future__ import annotations
 
-from dataclasses import dataclass, replace
+from dataclasses import dataclass, field, replace
 
 from compiler.backend.analysis import instruction_def_reg
 from compiler.backend.ir import (
@@ -8,9 +8,11 @@ from compiler.backend.ir import (
     BackendBlock,
     BackendBoolConst,
     BackendCallableDecl,
+    BackendCallableId,
     BackendConstInst,
     BackendConstOperand,
     BackendCopyInst,
+    BackendInstId,
     BackendIntConst,
     BackendOperand,
     BackendProgram,
@@ -18,11 +20,22 @@ from compiler.backend.ir import (
     BackendRegOperand,
     BackendUnaryInst,
 )
+from compiler.backend.ir._ordering import block_sort_key
 from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
 from compiler.common.type_names import TYPE_NAME_I64, TYPE_NAME_U8, TYPE_NAME_U64
-from compiler.semantic.operations import BinaryOpFlavor, BinaryOpKind, SemanticUnaryOp, UnaryOpFlavor, UnaryOpKind
+from compiler.semantic.operations import (
+    BinaryOpFlavor,
+    BinaryOpKind,
+    SemanticBinaryOp,
+    SemanticUnaryOp,
+    UnaryOpFlavor,
+    UnaryOpKind,
+)
 from compiler.semantic.types import semantic_type_canonical_name
 
+from .fresh_definitions import FreshDefinitions
+
 
 _INTEGER_MASKS = {TYPE_NAME_I64: (1 << 64) - 1, TYPE_NAME_U64: (1 << 64) - 1, TYPE_NAME_U8: (1 << 8) - 1}
 _ALL_ONES_BY_TYPE = {
@@ -30,19 +43,23 @@ _ALL_ONES_BY_TYPE = {
     TYPE_NAME_U64: (1 << 64) - 1,
     TYPE_NAME_U8: (1 << 8) - 1,
 }
+_UINT64_BITS = 64
+_DIVISION_OPERATORS = {BinaryOpKind.DIVIDE: "/", BinaryOpKind.REMAINDER: "%"}
 
 
 @dataclass
 class _AlgebraicSimplifyStats:
     simplified_instructions: int = 0
     optimized_callables: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
 
 
 def algebraic_simplify(program: BackendProgram) -> BackendProgram:
     logger = get_logger(__name__)
-    stats = _AlgebraicSimplifyStats()
+    stats = _AlgebraicSimplifyStats(remarks=PassRemarks("algebraic_simplify"))
     optimized_callables = tuple(_simplify_callable(callable_decl, stats) for callable_decl in program.callables)
     optimized_program = replace(program, callables=optimized_callables)
+    stats.remarks.publish()
     logger.debugv(
         1,
         "Backend optimization pass algebraic_simplify simplified %d instructions across %d callables",
@@ -59,27 +76,52 @@ def _simplify_callable(callable_decl: BackendCallableDecl, stats: _AlgebraicSimp
     register_type_name_by_reg_id = {
         register.reg_id: semantic_type_canonical_name(register.type_ref) for register in callable_decl.registers
     }
+    fresh = FreshDefinitions.for_callable(callable_decl, debug_name_prefix="sr")
     rewritten_blocks: list[BackendBlock] = []
     changed = False
+    stats.remarks.enter_callable(callable_decl.callable_id)
     for block in callable_decl.blocks:
         rewritten_block, block_changed = _simplify_block(
             block,
             register_type_name_by_reg_id=register_type_name_by_reg_id,
+            fresh=fresh,
             stats=stats,
         )
         rewritten_blocks.append(rewritten_block)
         changed = changed or block_changed
+    stats.remarks.leave_callable()
 
     if not changed:
         return callable_decl
     stats.optimized_callables += 1
-    return replace(callable_decl, blocks=tuple(rewritten_blocks))
+    if fresh.issued_inst_ids:
+        rewritten_blocks = _renumber_instructions(rewritten_blocks, callable_id=callable_decl.callable_id)
+    return replace(
+        callable_decl,
+        registers=callable_decl.registers + tuple(fresh.registers),
+        blocks=tuple(rewritten_blocks),
+    )
+
+
+def _renumber_instructions(blocks: list[BackendBlock], *, callable_id: BackendCallableId) -> list[BackendBlock]:
+    # Instruction ordinals define program order within a block, so expanded sequences need fresh
+    # ordinals that sit between their neighbours.
+    next_ordinal = 0
+    renumbered_by_block_id = {}
+    for block in sorted(blocks, key=block_sort_key):
+        instructions = []
+        for instruction in block.instructions:
+            instructions.append(replace(instruction, inst_id=BackendInstId(owner_id=callable_id, ordinal=next_ordinal)))
+            next_ordinal += 1
+        renumbered_by_block_id[block.block_id] = replace(block, instructions=tuple(instructions))
+    return [renumbered_by_block_id[block.block_id] for block in blocks]
 
 
 def _simplify_block(
     block: BackendBlock,
     *,
     register_type_name_by_reg_id: dict[BackendRegId, str],
+    fresh: FreshDefinitions,
     stats: _AlgebraicSimplifyStats,
 ) -> tuple[BackendBlock, bool]:
     unary_by_reg: dict[BackendRegId, BackendUnaryInst] = {}
@@ -87,38 +129,108 @@ def _simplify_block(
     changed = False
 
     for instruction in block.instructions:
-        simplified_instruction = _simplify_instruction(
+        simplified = _simplify_instruction(
             instruction,
             unary_by_reg=unary_by_reg,
             register_type_name_by_reg_id=register_type_name_by_reg_id,
+            fresh=fresh,
         )
-        if simplified_instruction is not instruction:
+        if simplified is not instruction:
             stats.simplified_instructions += 1
             changed = True
+        _remark_simplification(instruction, simplified, register_type_name_by_reg_id, stats.remarks)
 
-        destination = instruction_def_reg(simplified_instruction)
-        if destination is not None:
-            _invalidate_unary_facts_for_definition(unary_by_reg, destination)
-        if isinstance(simplified_instruction, BackendUnaryInst):
-            unary_by_reg[simplified_instruction.dest] = simplified_instruction
+        for simplified_instruction in simplified if isinstance(simplified, tuple) else (simplified,):
+            destination = instruction_def_reg(simplified_instruction)
+            if destination is not None:
+                _invalidate_unary_facts_for_definition(unary_by_reg, destination)
+            if isinstance(simplified_instruction, BackendUnaryInst):
+                unary_by_reg[simplified_instruction.dest] = simplified_instruction
 
-        rewritten_instructions.append(simplified_instruction)
+            rewritten_instructions.append(simplified_instruction)
 
     if not changed:
         return block, False
     return replace(block, instructions=tuple(rewritten_instructions)), True
 
 
+def _remark_simplification(
+    instruction,
+    simplified,
+    register_type_name_by_reg_id: dict[BackendRegId, str],
+    remarks: PassRemarks,
+) -> None:
+    if not remarks.enabled:
+        return
+    if (
+        isinstance(instruction, BackendBinaryInst)
+        and instruction.op.flavor is BinaryOpFlavor.INTEGER
+        and instruction.op.kind in _DIVISION_OPERATORS
+        and _integer_operand_type_name(instruction, register_type_name_by_reg_id) is not None
+    ):
+        _remark_division(instruction, simplified, register_type_name_by_reg_id, remarks)
+        return
+    if simplified is not instruction:
+        remarks.applied(
+            instruction.span, f"{_instruction_label(instruction)} simplified to {_instruction_label(simplified)}"
+        )
+
+
+def _remark_division(
+    instruction: BackendBinaryInst,
+    simplified,
+    register_type_name_by_reg_id: dict[BackendRegId, str],
+    remarks: PassRemarks,
+) -> None:
+    operator = _DIVISION_OPERATORS[instruction.op.kind]
+    divisor = _integer_constant_value(instruction.right)
+    if isinstance(simplified, tuple):
+        remarks.applied(
+            instruction.span,
+            f"'{operator}' by constant {divisor} strength-reduced to a multiply-high sequence of "
+            f"{len(simplified)} instructions",
+        )
+    elif simplified is not instruction:
+        remarks.applied(
+            instruction.span, f"'{operator}' by constant {divisor} strength-reduced to {_instruction_label(simplified)}"
+        )
+    elif divisor is None:
+        remarks.missed(instruction.span, f"'{operator}' kept as a hardware divide: divisor is not a constant")
+    elif divisor <= 0:
+        remarks.missed(
+            instruction.span, f"'{operator}' by constant {divisor} kept as a hardware divide: divisor is not positive"
+        )
+    elif _integer_operand_type_name(instruction, register_type_name_by_reg_id) == TYPE_NAME_U8:
+        remarks.missed(
+            instruction.span,
+            f"'{operator}' by constant {divisor} kept as a hardware divide: u8 divisors are only reduced when they are "
+            "powers of two",
+        )
+
+
+def _instruction_label(instruction) -> str:
+    if isinstance(instruction, tuple):
+        return f"a sequence of {len(instruction)} instructions"
+    if isinstance(instruction, (BackendBinaryInst, BackendUnaryInst)):
+        return instruction.op.kind.value
+    if isinstance(instruction, BackendConstInst):
+        return "a constant"
+    if isinstance(instruction, BackendCopyInst):
+        return "a copy"
+    return type(instruction).__name__
+
+
 def _simplify_instruction(
     instruction,
     *,
     unary_by_reg: dict[BackendRegId, BackendUnaryInst],
     register_type_name_by_reg_id: dict[BackendRegId, str],
+    fresh: FreshDefinitions,
 ):
     if isinstance(instruction, BackendUnaryInst):
         return _simplify_unary(instruction, unary_by_reg)
     if isinstance(instruction, BackendBinaryInst):
-        return _simplify_binary(instruction, register_type_name_by_reg_id)
+        return _simplify_binary(instruction, register_type_name_by_reg_id, fresh)
     return instruction
 
 
@@ -137,13 +249,14 @@ def _simplify_unary(
 def _simplify_binary(
     instruction: BackendBinaryInst,
     register_type_name_by_reg_id: dict[BackendRegId, str],
+    fresh: FreshDefinitions,
 ):
     if instruction.op.flavor is BinaryOpFlavor.BOOL_LOGICAL:
         return _simplify_bool_logical(instruction)
     if instruction.op.flavor is BinaryOpFlavor.BOOL_COMPARISON:
         return _simplify_bool_comparison(instruction)
     if instruction.op.flavor is BinaryOpFlavor.INTEGER:
-        return _simplify_integer(instruction, register_type_name_by_reg_id)
+        return _simplify_integer(instruction, register_type_name_by_reg_id, fresh)
     return instruction
 
 
@@ -204,6 +317,7 @@ def _simplify_bool_comparison(instruction: BackendBinaryInst):
 def _simplify_integer(
     instruction: BackendBinaryInst,
     register_type_name_by_reg_id: dict[BackendRegId, str],
+    fresh: FreshDefinitions,
 ):
     left_value = _integer_constant_value(instruction.left)
     right_value = _integer_constant_value(instruction.right)
@@ -224,11 +338,11 @@ def _simplify_integer(
     if instruction.op.kind is BinaryOpKind.DIVIDE:
         if right_value == 1:
             return _copy_like(instruction, instruction.left)
-        return instruction
+        return _strength_reduce_division(instruction, operand_type_name, right_value, fresh)
     if instruction.op.kind is BinaryOpKind.REMAINDER:
         if right_value == 1:
             return _int_const_like(instruction, operand_type_name, 0)
-        return instruction
+        return _strength_reduce_division(instruction, operand_type_name, right_value, fresh)
     if instruction.op.kind is BinaryOpKind.POWER:
         if right_value == 0:
             return _int_const_like(instruction, operand_type_name, 1)
@@ -259,6 +373,112 @@ def _simplify_integer(
     return instruction
 
 
+def _strength_reduce_division(
+    instruction: BackendBinaryInst,
+    operand_type_name: str,
+    divisor: int | None,
+    fresh: FreshDefinitions,
+):
+    """Rewrite `/` and `%` by a positive constant into shifts, masks, or a multiply-high sequence.
+
+    Signed operands keep the language's floor semantics: the arithmetic shift and the mask already round
+    toward negative infinity, and the multiply-high path divides `n ^ (n >> 63)` (which is `n` or `-n - 1`,
+    never negative) and flips the quotient back with the same sign mask. Negative divisors and `u8`
+    divisors that are not powers of two keep the hardware divide.
+    """
+    if divisor is None or divisor <= 1:
+        return instruction
+    is_remainder = instruction.op.kind is BinaryOpKind.REMAINDER
+    if divisor & (divisor - 1) == 0:
+        if is_remainder:
+            return _binary_like(
+                instruction,
+                BinaryOpKind.BITWISE_AND,
+                instruction.left,
+                _int_operand(operand_type_name, divisor - 1),
+            )
+        return _binary_like(
+            instruction,
+            BinaryOpKind.SHIFT_RIGHT,
+            instruction.left,
+            _int_operand(TYPE_NAME_U64, divisor.bit_length() - 1),
+        )
+    if operand_type_name == TYPE_NAME_U8:
+        return instruction
+
+    emitted: list[BackendBinaryInst] = []
+
+    def emit(kind: BinaryOpKind, left: BackendOperand, right: BackendOperand) -> BackendRegOperand:
+        dest = fresh.temp(operand_type_name, instruction.span)
+        emitted.append(
+            BackendBinaryInst(
+                inst_id=fresh.inst_id(),
+                dest=dest,
+                op=SemanticBinaryOp(kind=kind, flavor=BinaryOpFlavor.INTEGER),
+                left=left,
+                right=right,
+                span=instruction.span,
+            )
+        )
+        return BackendRegOperand(reg_id=dest)
+
+    numerator = instruction.left
+    sign_mask: BackendRegOperand | None = None
+    numerator_bits = _UINT64_BITS
+    if operand_type_name == TYPE_NAME_I64:
+        sign_mask = emit(BinaryOpKind.SHIFT_RIGHT, numerator, _int_operand(TYPE_NAME_U64, 63))
+        numerator = emit(BinaryOpKind.BITWISE_XOR, numerator, sign_mask)
+        numerator_bits = _UINT64_BITS - 1
+
+    multiplier, post_shift, needs_add = _unsigned_division_magic(divisor, numerator_bits)
+    quotient = emit(BinaryOpKind.MULTIPLY_HIGH, numerator, _int_operand(operand_type_name, multiplier))
+    if needs_add:
+        # The multiplier needs 65 bits: add the numerator back in without overflowing, (n + t) / 2 = ((n - t) / 2) + t.
+        halved = emit(
+            BinaryOpKind.SHIFT_RIGHT,
+            emit(BinaryOpKind.SUBTRACT, numerator, quotient),
+            _int_operand(TYPE_NAME_U64, 1),
+        )
+        quotient = emit(BinaryOpKind.ADD, halved, quotient)
+    if post_shift > 0:
+        quotient = emit(BinaryOpKind.SHIFT_RIGHT, quotient, _int_operand(TYPE_NAME_U64, post_shift))
+
+    if is_remainder:
+        if sign_mask is not None:
+            quotient = emit(BinaryOpKind.BITWISE_XOR, quotient, sign_mask)
+        product = emit(BinaryOpKind.MULTIPLY, quotient, _int_operand(operand_type_name, divisor))
+        final_kind, final_left, final_right = BinaryOpKind.SUBTRACT, instruction.left, product
+    elif sign_mask is not None:
+        final_kind, final_left, final_right = BinaryOpKind.BITWISE_XOR, quotient, sign_mask
+    else:
+        # Retarget the last temporary at the original destination instead of copying it there.
+        last = emitted.pop()
+        fresh.registers.pop()
+        final_kind, final_left, final_right = last.op.kind, last.left, last.right
+    emitted.append(_binary_like(instruction, final_kind, final_left, final_right))
+    return tuple(emitted)
+
+
+def _unsigned_division_magic(divisor: int, numerator_bits: int) -> tuple[int, int, bool]:
+    """Return `(multiplier, post_shift, needs_add)` so that `n / divisor` is `mulhi(n, m) >> s` for `n < 2**bits`.
+
+    The smallest post-shift whose rounded-up reciprocal still fits in 64 bits and whose rounding error
+    stays below one unit over the whole numerator range wins (Granlund and Montgomery). When none fits,
+    the 65-bit multiplier for `ceil(log2(divisor))` is returned without its top bit and `needs_add` set.
+    """
+    numerator_max = (1 << numerator_bits) - 1
+    for post_shift in range(_UINT64_BITS):
+        precision = _UINT64_BITS + post_shift
+        multiplier = -(-(1 << precision) // divisor)
+        if multiplier >= 1 << _UINT64_BITS:
+            break
+        if numerator_max * (multiplier * divisor - (1 << precision)) < 1 << precision:
+            return multiplier, post_shift, False
+    log2_ceiling = divisor.bit_length()
+    multiplier = -(-(1 << (_UINT64_BITS + log2_ceiling)) // divisor)
+    return multiplier - (1 << _UINT64_BITS), log2_ceiling - 1, True
+
+
 def _simplify_identity(
     instruction: BackendBinaryInst,
     *,
@@ -307,6 +527,26 @@ def _copy_like(instruction, source: BackendOperand) -> BackendCopyInst:
     return BackendCopyInst(inst_id=instruction.inst_id, dest=instruction.dest, source=source, span=instruction.span)
 
 
+def _binary_like(
+    instruction: BackendBinaryInst,
+    kind: BinaryOpKind,
+    left: BackendOperand,
+    right: BackendOperand,
+) -> BackendBinaryInst:
+    return BackendBinaryInst(
+        inst_id=instruction.inst_id,
+        dest=instruction.dest,
+        op=SemanticBinaryOp(kind=kind, flavor=BinaryOpFlavor.INTEGER),
+        left=left,
+        right=right,
+        span=instruction.span,
+    )
+
+
+def _int_operand(type_name: str, value: int) -> BackendConstOperand:
+    return BackendConstOperand(constant=BackendIntConst(type_name=type_name, value=_wrap_integer(value, type_name)))
+
+
 def _logical_not_like(instruction, operand: BackendOperand) -> BackendUnaryInst:
     return BackendUnaryInst(
         inst_id=instruction.inst_id,
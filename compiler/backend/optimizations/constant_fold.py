@@ -332,6 +332,9 @@ def _fold_integer_binary(
         return BackendIntConst(type_name=operand_type_name, value=_wrap_integer(left_value - right_value, operand_type_name))
     if kind is BinaryOpKind.MULTIPLY:
         return BackendIntConst(type_name=operand_type_name, value=_wrap_integer(left_value * right_value, operand_type_name))
+    if kind is BinaryOpKind.MULTIPLY_HIGH:
+        product = (left_value & _INTEGER_MASKS[TYPE_NAME_U64]) * (right_value & _INTEGER_MASKS[TYPE_NAME_U64])
+        return BackendIntConst(type_name=operand_type_name, value=_wrap_integer(product >> 64, operand_type_name))
     if kind is BinaryOpKind.POWER:
         if right_value < 0:
             return None
@@ -0,0 +1,58 @@
+from __future__ import annotations
+
+from dataclasses import dataclass
+
+from compiler.backend.ir import BackendCallableDecl, BackendCallableId, BackendInstId, BackendRegId, BackendRegister
+from compiler.common.span import SourceSpan
+from compiler.semantic.types import semantic_primitive_type_ref
+
+
+@dataclass
+class FreshDefinitions:
+    """Registers and instruction ids a pass adds to one callable, numbered after everything it already has.
+
+    Fresh instruction ids sort after every existing instruction; a pass that splices them between
+    existing neighbours must renumber the block afterwards.
+    """
+
+    callable_id: BackendCallableId
+    debug_name_prefix: str
+    next_reg_ordinal: int
+    next_inst_ordinal: int
+    registers: list[BackendRegister]
+    issued_inst_ids: int = 0
+
+    @classmethod
+    def for_callable(cls, callable_decl: BackendCallableDecl, *, debug_name_prefix: str) -> FreshDefinitions:
+        return cls(
+            callable_id=callable_decl.callable_id,
+            debug_name_prefix=debug_name_prefix,
+            next_reg_ordinal=max((register.reg_id.ordinal for register in callable_decl.registers), default=-1) + 1,
+            next_inst_ordinal=max(
+                (instruction.inst_id.ordinal for block in callable_decl.blocks for instruction in block.instructions),
+                default=-1,
+            )
+            + 1,
+            registers=[],
+        )
+
+    def temp(self, type_name: str, span: SourceSpan) -> BackendRegId:
+        reg_id = BackendRegId(owner_id=self.callable_id, ordinal=self.next_reg_ordinal)
+        self.next_reg_ordinal += 1
+        self.registers.append(
+            BackendRegister(
+                reg_id=reg_id,
+                type_ref=semantic_primitive_type_ref(type_name),
+                debug_name=f"{self.debug_name_prefix}{len(self.registers)}",
+                origin_kind="temp",
+                semantic_local_id=None,
+                span=span,
+            )
+        )
+        return reg_id
+
+    def inst_id(self) -> BackendInstId:
+        inst_id = BackendInstId(owner_id=self.callable_id, ordinal=self.next_inst_ordinal)
+        self.next_inst_ordinal += 1
+        self.issued_inst_ids += 1
+        return inst_id
@@ -0,0 +1,116 @@
+from __future__ import annotations
+
+from dataclasses import dataclass, field, replace
+
+from compiler.backend.analysis import BackendProgramGcEffects, analyze_program_gc_effects
+from compiler.backend.ir import (
+    BackendCallableDecl,
+    BackendCallInst,
+    BackendCallTarget,
+    BackendDirectCallTarget,
+    BackendInterfaceCallTarget,
+    BackendProgram,
+    BackendRuntimeCallTarget,
+    BackendVirtualCallTarget,
+)
+from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks, format_remark_callable
+
+
+@dataclass
+class _GcEffectInferenceStats:
+    refined_calls: int = 0
+    optimized_callables: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
+
+
+def gc_effect_inference(program: BackendProgram) -> BackendProgram:
+    logger = get_logger(__name__)
+    stats = _GcEffectInferenceStats(remarks=PassRemarks("gc_effect_inference"))
+    gc_effects = analyze_program_gc_effects(program)
+    optimized_callables = tuple(
+        refine_callable_call_gc_effects(callable_decl, gc_effects, stats=stats) for callable_decl in program.callables
+    )
+    optimized_program = replace(program, callables=optimized_callables)
+    stats.remarks.publish()
+    logger.debugv(
+        1,
+        "Backend optimization pass gc_effect_inference cleared may_gc on %d calls across %d callables "
+        "(%d of %d callables may collect)",
+        stats.refined_calls,
+        stats.optimized_callables,
+        len(gc_effects.gc_callable_ids),
+        len(program.callables),
+    )
+    return optimized_program
+
+
+def refine_callable_call_gc_effects(
+    callable_decl: BackendCallableDecl,
+    gc_effects: BackendProgramGcEffects,
+    *,
+    stats: _GcEffectInferenceStats | None = None,
+) -> BackendCallableDecl:
+    """Clear ``may_gc`` on user calls that can never reach a collection.
+
+    Calls stop being safepoints once their callees are known not to collect, so a callable
+    whose calls all refine away keeps no reference registers in root slots and the targets
+    emit it without a root frame. Runtime calls keep the effects their metadata requires.
+    """
+
+    if callable_decl.is_extern or not callable_decl.blocks:
+        return callable_decl
+
+    remarks = PassRemarks.discarded() if stats is None else stats.remarks
+    remarks.enter_callable(callable_decl.callable_id)
+    refined_count = 0
+    rewritten_blocks = []
+    for block in callable_decl.blocks:
+        rewritten_instructions = []
+        for instruction in block.instructions:
+            if (
+                isinstance(instruction, BackendCallInst)
+                and not isinstance(instruction.target, BackendRuntimeCallTarget)
+                and instruction.effects.may_gc
+            ):
+                if gc_effects.call_may_gc(instruction):
+                    remarks.missed(
+                        instruction.span,
+                        f"{_call_label(instruction.target)} stays a safepoint: "
+                        f"{_may_gc_reason(instruction.target)}",
+                    )
+                else:
+                    instruction = replace(instruction, effects=replace(instruction.effects, may_gc=False))
+                    refined_count += 1
+                    remarks.applied(
+                        instruction.span,
+                        f"{_call_label(instruction.target)} is no longer a safepoint: no callee can collect",
+                    )
+            rewritten_instructions.append(instruction)
+        rewritten_blocks.append(replace(block, instructions=tuple(rewritten_instructions)))
+    remarks.leave_callable()
+
+    if refined_count == 0:
+        return callable_decl
+    if stats is not None:
+        stats.refined_calls += refined_count
+        stats.optimized_callables += 1
+    return replace(callable_decl, blocks=tuple(rewritten_blocks))
+
+
+def _call_label(target: BackendCallTarget) -> str:
+    if isinstance(target, BackendDirectCallTarget):
+        return f"call to {format_remark_callable(target.callable_id)}"
+    if isinstance(target, BackendVirtualCallTarget):
+        return f"virtual call to {target.method_name}"
+    if isinstance(target, BackendInterfaceCallTarget):
+        return f"interface call to {target.method_id.interface_name}.{target.method_id.name}"
+    return "indirect call"
+
+
+def _may_gc_reason(target: BackendCallTarget) -> str:
+    if isinstance(target, BackendDirectCallTarget):
+        return "the callee may collect"
+    if isinstance(target, (BackendVirtualCallTarget, BackendInterfaceCallTarget)):
+        return "a method it may dispatch to may collect"
+    return "the target is not known statically"
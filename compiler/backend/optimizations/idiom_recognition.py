@@ -0,0 +1,654 @@
+from __future__ import annotations
+
+from collections import Counter
+from dataclasses import dataclass, field, replace
+from enum import Enum
+
+from compiler.backend.analysis import (
+    analyze_callable_liveness,
+    build_block_index,
+    build_predecessor_map,
+    instruction_def_reg,
+    instruction_use_regs,
+    reverse_postorder_block_ids,
+)
+from compiler.backend.ir import (
+    BackendArrayLengthInst,
+    BackendArrayLoadInst,
+    BackendArrayStoreInst,
+    BackendBinaryInst,
+    BackendBlock,
+    BackendBlockId,
+    BackendBoolConst,
+    BackendBoundsCheckInst,
+    BackendBranchTerminator,
+    BackendCallableDecl,
+    BackendCallInst,
+    BackendCastInst,
+    BackendConstInst,
+    BackendConstOperand,
+    BackendCopyInst,
+    BackendDoubleConst,
+    BackendEffects,
+    BackendInstId,
+    BackendInstruction,
+    BackendIntConst,
+    BackendJumpTerminator,
+    BackendNullCheckInst,
+    BackendNullConst,
+    BackendOperand,
+    BackendProgram,
+    BackendRegId,
+    BackendRegister,
+    BackendRegOperand,
+    BackendRuntimeCallTarget,
+    BackendSignature,
+    BackendUnaryInst,
+)
+from compiler.backend.ir._ordering import instruction_sort_key
+from compiler.backend.program.runtime import (
+    ARRAY_COPY_RANGE_RUNTIME_CALL,
+    ARRAY_FILL_RUNTIME_CALLS,
+    ARRAY_MISMATCH_RANGE_RUNTIME_CALL,
+    runtime_call_metadata,
+)
+from compiler.common.collection_protocols import ArrayRuntimeKind
+from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
+from compiler.common.span import SourceSpan
+from compiler.common.type_names import TYPE_NAME_I64, TYPE_NAME_U64
+from compiler.semantic.operations import BinaryOpFlavor, BinaryOpKind, CastSemanticsKind
+from compiler.semantic.types import (
+    semantic_primitive_type_ref,
+    semantic_type_array_element,
+    semantic_type_canonical_name,
+)
+
+from .fresh_definitions import FreshDefinitions
+
+
+_WORD_INTEGER_TYPE_NAMES = frozenset({TYPE_NAME_I64, TYPE_NAME_U64})
+_INT64_MAX = (1 << 63) - 1
+# Idiom bodies are a handful of blocks: the element operation, an optional early exit, and the latch.
+_MAX_IDIOM_BODY_BLOCKS = 4
+# Doubles compare by value (NaN, signed zero), so only kinds with bitwise equality use memcmp.
+_MISMATCH_ARRAY_KINDS = frozenset({ArrayRuntimeKind.I64, ArrayRuntimeKind.U64, ArrayRuntimeKind.U8, ArrayRuntimeKind.BOOL})
+_REPLAYABLE_HEADER_INSTRUCTIONS = (
+    BackendArrayLengthInst,
+    BackendBinaryInst,
+    BackendCastInst,
+    BackendConstInst,
+    BackendCopyInst,
+    BackendUnaryInst,
+)
+
+
+class _LoopIdiomKind(Enum):
+    FILL = "fill"
+    COPY = "copy"
+    MISMATCH = "mismatch"
+
+
+@dataclass(frozen=True)
+class _LoopIdiom:
+    kind: _LoopIdiomKind
+    preheader_id: BackendBlockId
+    counter: BackendRegId
+    bound: BackendOperand
+    call_name: str
+    array_args: tuple[BackendRegId, ...]
+    value: BackendOperand | None
+    span: SourceSpan
+    bound_setup: tuple[BackendInstruction, ...] = ()
+
+
+@dataclass
+class _IdiomRecognitionStats:
+    fill_loops: int = 0
+    copy_loops: int = 0
+    mismatch_loops: int = 0
+    optimized_callables: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
+
+
+def idiom_recognition(program: BackendProgram) -> BackendProgram:
+    logger = get_logger(__name__)
+    stats = _IdiomRecognitionStats(remarks=PassRemarks("idiom_recognition"))
+    optimized_callables = tuple(
+        recognize_callable_loop_idioms(callable_decl, stats=stats) for callable_decl in program.callables
+    )
+    optimized_program = replace(program, callables=optimized_callables)
+    stats.remarks.publish()
+    logger.debugv(
+        1,
+        "Backend optimization pass idiom_recognition matched %d fill, %d copy and %d mismatch loops across %d callables",
+        stats.fill_loops,
+        stats.copy_loops,
+        stats.mismatch_loops,
+        stats.optimized_callables,
+    )
+    return optimized_program
+
+
+def recognize_callable_loop_idioms(
+    callable_decl: BackendCallableDecl,
+    *,
+    stats: _IdiomRecognitionStats | None = None,
+) -> BackendCallableDecl:
+    """Fast-forward counted array fill, copy and compare loops through bulk runtime kernels.
+
+    A matched loop keeps its body: the preheader gains a call that performs the in-bounds
+    prefix of the iteration space with memset/memmove/memcmp-style kernels and moves the
+    counter to the first index the kernel did not handle. The loop then runs from there, so
+    a null array, an out-of-bounds index or a mismatching element still executes the
+    original iteration with its usual panic or early exit.
+    """
+
+    if callable_decl.is_extern or not callable_decl.blocks:
+        return callable_decl
+
+    block_by_id = build_block_index(callable_decl)
+    predecessors = build_predecessor_map(callable_decl, block_by_id=block_by_id)
+    rpo_index = {block_id: index for index, block_id in enumerate(reverse_postorder_block_ids(callable_decl))}
+    register_by_id = {register.reg_id: register for register in callable_decl.registers}
+    type_name_by_reg_id = {
+        register.reg_id: semantic_type_canonical_name(register.type_ref) for register in callable_decl.registers
+    }
+    liveness = None
+    remarks = PassRemarks.discarded() if stats is None else stats.remarks
+    remarks.enter_callable(callable_decl.callable_id)
+
+    idioms_by_preheader: dict[BackendBlockId, _LoopIdiom] = {}
+    for latch in callable_decl.blocks:
+        shape = _counted_loop_shape(callable_decl, latch, block_by_id, predecessors, rpo_index)
+        if shape is None:
+            continue
+        if liveness is None:
+            liveness = analyze_callable_liveness(callable_decl)
+        idiom = _match_loop_idiom(shape, type_name_by_reg_id, liveness.live_in_by_block)
+        if isinstance(idiom, str):
+            remarks.missed(shape.header.terminator.span, f"counted loop kept: {idiom}")
+        elif idiom.preheader_id not in idioms_by_preheader:
+            idioms_by_preheader[idiom.preheader_id] = idiom
+            remarks.applied(
+                idiom.span, f"{idiom.kind.value} loop fast-forwarded through {idiom.call_name} in the preheader"
+            )
+    remarks.leave_callable()
+
+    if not idioms_by_preheader:
+        return callable_decl
+
+    fresh = FreshDefinitions.for_callable(callable_decl, debug_name_prefix="idiom")
+    rewritten_blocks: list[BackendBlock] = []
+    for block in callable_decl.blocks:
+        idiom = idioms_by_preheader.get(block.block_id)
+        if idiom is None:
+            rewritten_blocks.append(block)
+            continue
+        fast_forward = _fast_forward_instructions(idiom, register_by_id, type_name_by_reg_id, fresh)
+        rewritten_blocks.append(replace(block, instructions=block.instructions + fast_forward))
+        if stats is not None:
+            if idiom.kind is _LoopIdiomKind.FILL:
+                stats.fill_loops += 1
+            elif idiom.kind is _LoopIdiomKind.COPY:
+                stats.copy_loops += 1
+            else:
+                stats.mismatch_loops += 1
+
+    if stats is not None:
+        stats.optimized_callables += 1
+    return replace(
+        callable_decl,
+        registers=callable_decl.registers + tuple(fresh.registers),
+        blocks=tuple(rewritten_blocks),
+    )
+
+
+@dataclass(frozen=True)
+class _CountedLoopShape:
+    preheader_id: BackendBlockId
+    header: BackendBlock
+    body: tuple[BackendBlock, ...]
+    exit_id: BackendBlockId
+    early_exit_id: BackendBlockId | None
+    early_exit_condition: BackendRegId | None
+    counter_source: BackendRegId
+    compare: BackendBinaryInst
+
+
+def _counted_loop_shape(
+    callable_decl: BackendCallableDecl,
+    latch: BackendBlock,
+    block_by_id: dict[BackendBlockId, BackendBlock],
+    predecessors: dict[BackendBlockId, tuple[BackendBlockId, ...]],
+    rpo_index: dict[BackendBlockId, int],
+) -> _CountedLoopShape | None:
+    if not isinstance(latch.terminator, BackendJumpTerminator):
+        return None
+    header_id = latch.terminator.target_block_id
+    if header_id == callable_decl.entry_block_id or header_id == latch.block_id:
+        return None
+    if latch.block_id not in rpo_index or header_id not in rpo_index:
+        return None
+    if rpo_index[header_id] > rpo_index[latch.block_id]:
+        return None
+
+    header = block_by_id[header_id]
+    terminator = header.terminator
+    if not isinstance(terminator, BackendBranchTerminator) or not isinstance(terminator.condition, BackendRegOperand):
+        return None
+    outside_predecessors = [block_id for block_id in predecessors[header_id] if block_id != latch.block_id]
+    if len(outside_predecessors) != 1 or len(predecessors[header_id]) != 2:
+        return None
+    preheader = block_by_id[outside_predecessors[0]]
+    if not isinstance(preheader.terminator, BackendJumpTerminator):
+        return None
+
+    # Header instructions run again right after the preheader, so the ones without side effects
+    # can be replayed there to compute the bound before fast-forwarding.
+    cast_source_by_reg: dict[BackendRegId, BackendRegId] = {}
+    compare: BackendInstruction | None = None
+    for instruction in sorted(header.instructions, key=instruction_sort_key):
+        if not isinstance(instruction, _REPLAYABLE_HEADER_INSTRUCTIONS):
+            return None
+        if _is_word_reinterpret(instruction):
+            cast_source_by_reg[instruction.dest] = instruction.operand.reg_id
+        if instruction_def_reg(instruction) == terminator.condition.reg_id:
+            compare = instruction
+    if not (
+        isinstance(compare, BackendBinaryInst)
+        and compare.op.kind is BinaryOpKind.LESS_THAN
+        and compare.op.flavor is BinaryOpFlavor.INTEGER_COMPARISON
+        and isinstance(compare.left, BackendRegOperand)
+    ):
+        return None
+
+    body: list[BackendBlock] = []
+    early_exit_id = None
+    early_exit_condition = None
+    previous_id = header_id
+    current_id = terminator.true_block_id
+    while len(body) < _MAX_IDIOM_BODY_BLOCKS:
+        if current_id == header_id or predecessors[current_id] != (previous_id,):
+            return None
+        block = block_by_id[current_id]
+        body.append(block)
+        block_terminator = block.terminator
+        if isinstance(block_terminator, BackendJumpTerminator):
+            if block_terminator.target_block_id == header_id:
+                if block.block_id != latch.block_id:
+                    return None
+                return _CountedLoopShape(
+                    preheader_id=preheader.block_id,
+                    header=header,
+                    body=tuple(body),
+                    exit_id=terminator.false_block_id,
+                    early_exit_id=early_exit_id,
+                    early_exit_condition=early_exit_condition,
+                    counter_source=cast_source_by_reg.get(compare.left.reg_id, compare.left.reg_id),
+                    compare=compare,
+                )
+            previous_id, current_id = current_id, block_terminator.target_block_id
+            continue
+        if (
+            isinstance(block_terminator, BackendBranchTerminator)
+            and early_exit_id is None
+            and isinstance(block_terminator.condition, BackendRegOperand)
+        ):
+            early_exit_id = block_terminator.true_block_id
+            early_exit_condition = block_terminator.condition.reg_id
+            previous_id, current_id = current_id, block_terminator.false_block_id
+            continue
+        return None
+    return None
+
+
+def _match_loop_idiom(
+    shape: _CountedLoopShape,
+    type_name_by_reg_id: dict[BackendRegId, str],
+    live_in_by_block: dict[BackendBlockId, tuple[BackendRegId, ...]],
+) -> _LoopIdiom | str:
+    """Return the idiom the counted loop performs, or why it performs none."""
+
+    counter = shape.counter_source
+    if type_name_by_reg_id.get(counter) not in _WORD_INTEGER_TYPE_NAMES:
+        return "loop counter is not an i64 or u64"
+    bound = _bound_operand(shape.compare.right, type_name_by_reg_id)
+    if bound is None:
+        return "loop bound is not an i64 or u64"
+
+    loop_instructions = [
+        instruction
+        for block in (shape.header, *shape.body)
+        for instruction in sorted(block.instructions, key=instruction_sort_key)
+    ]
+    loop_defs = {def_reg for def_reg in map(instruction_def_reg, loop_instructions) if def_reg is not None}
+    bound_setup = _invariant_bound_setup(shape.header, bound, loop_instructions, loop_defs)
+    if bound_setup is None:
+        return "loop bound is computed inside the loop"
+
+    latch_instructions = sorted(shape.body[-1].instructions, key=instruction_sort_key)
+    if not latch_instructions:
+        return "loop counter is not stepped by the latch"
+    step = _counter_step(latch_instructions[-1], counter, loop_instructions)
+    if step is None:
+        return "loop counter is not advanced only by a final `+ 1` in the latch"
+    _step_temp, step_inst_ids = step
+
+    def invariant(operand: BackendOperand) -> bool:
+        return isinstance(operand, BackendConstOperand) or (
+            isinstance(operand, BackendRegOperand) and operand.reg_id not in loop_defs and operand.reg_id != counter
+        )
+
+    header_defs = {instruction_def_reg(instruction) for instruction in shape.header.instructions}
+    index_regs = {counter}
+    checked_arrays: set[BackendRegId] = set()
+    loads: list[BackendArrayLoadInst] = []
+    stores: list[BackendArrayStoreInst] = []
+    compares: list[BackendBinaryInst] = []
+    for block in shape.body:
+        for instruction in sorted(block.instructions, key=instruction_sort_key):
+            if instruction.inst_id in step_inst_ids:
+                continue
+            if _is_word_reinterpret(instruction) and instruction.operand.reg_id in index_regs:
+                index_regs.add(instruction.dest)
+                continue
+            if isinstance(instruction, BackendNullCheckInst) and isinstance(instruction.value, BackendRegOperand):
+                if not invariant(instruction.value):
+                    return "body null-checks a value computed inside the loop"
+                checked_arrays.add(instruction.value.reg_id)
+                continue
+            if isinstance(instruction, BackendBoundsCheckInst):
+                if not _indexed_access(instruction.array_ref, instruction.index, index_regs, invariant):
+                    return "body indexes an array by something other than the loop counter"
+                checked_arrays.add(instruction.array_ref.reg_id)
+                continue
+            if isinstance(instruction, BackendArrayLoadInst):
+                if not _indexed_access(instruction.array_ref, instruction.index, index_regs, invariant):
+                    return "body indexes an array by something other than the loop counter"
+                loads.append(instruction)
+                continue
+            if isinstance(instruction, BackendArrayStoreInst):
+                if not _indexed_access(instruction.array_ref, instruction.index, index_regs, invariant):
+                    return "body indexes an array by something other than the loop counter"
+                stores.append(instruction)
+                continue
+            if (
+                isinstance(instruction, BackendBinaryInst)
+                and instruction.op.kind is BinaryOpKind.NOT_EQUAL
+                and instruction.op.flavor in {BinaryOpFlavor.INTEGER_COMPARISON, BinaryOpFlavor.BOOL_COMPARISON}
+            ):
+                compares.append(instruction)
+                continue
+            return f"body has an instruction no bulk kernel performs: {_instruction_kind_label(instruction)}"
+
+    # Checks on arrays the kernel does not touch would be skipped for the fast-forwarded prefix.
+    accessed_arrays = {access.array_ref.reg_id for access in (*loads, *stores)}
+    if not checked_arrays <= accessed_arrays:
+        return "body checks an array the bulk kernel would not touch"
+
+    idiom = _classify_idiom(shape, counter, bound, loads, stores, compares, invariant)
+    if idiom is None:
+        return "body is not an element fill, copy or compare"
+    idiom = replace(idiom, bound_setup=bound_setup)
+
+    # Values computed by skipped iterations are stale, so none may be observed after the loop.
+    body_defs = loop_defs - header_defs - {counter}
+    exits = (shape.exit_id,) if shape.early_exit_id is None else (shape.exit_id, shape.early_exit_id)
+    if any(body_defs.intersection(live_in_by_block[exit_id]) for exit_id in exits):
+        return "a value computed in the body is used after the loop"
+    return idiom
+
+
+def _instruction_kind_label(instruction: BackendInstruction) -> str:
+    if isinstance(instruction, BackendBinaryInst):
+        return instruction.op.kind.value
+    return type(instruction).__name__.removeprefix("Backend").removesuffix("Inst")
+
+
+def _classify_idiom(
+    shape: _CountedLoopShape,
+    counter: BackendRegId,
+    bound: BackendOperand,
+    loads: list[BackendArrayLoadInst],
+    stores: list[BackendArrayStoreInst],
+    compares: list[BackendBinaryInst],
+    invariant,
+) -> _LoopIdiom | None:
+    span = shape.header.terminator.span
+    if shape.early_exit_id is None and not compares and len(stores) == 1:
+        store = stores[0]
+        if not loads and invariant(store.value) and _fill_value_supported(store.value):
+            return _LoopIdiom(
+                kind=_LoopIdiomKind.FILL,
+                preheader_id=shape.preheader_id,
+                counter=counter,
+                bound=bound,
+                call_name=ARRAY_FILL_RUNTIME_CALLS[store.array_runtime_kind],
+                array_args=(store.array_ref.reg_id,),
+                value=store.value,
+                span=span,
+            )
+        if (
+            len(loads) == 1
+            and loads[0].array_runtime_kind is store.array_runtime_kind
+            and store.value == BackendRegOperand(reg_id=loads[0].dest)
+        ):
+            return _LoopIdiom(
+                kind=_LoopIdiomKind.COPY,
+                preheader_id=shape.preheader_id,
+                counter=counter,
+                bound=bound,
+                call_name=ARRAY_COPY_RANGE_RUNTIME_CALL,
+                array_args=(store.array_ref.reg_id, loads[0].array_ref.reg_id),
+                value=None,
+                span=span,
+            )
+        return None
+
+    if shape.early_exit_id is None or stores or len(loads) != 2 or len(compares) != 1:
+        return None
+    left, right = loads
+    compare = compares[0]
+    if left.array_runtime_kind is not right.array_runtime_kind or left.array_runtime_kind not in _MISMATCH_ARRAY_KINDS:
+        return None
+    if compare.dest != shape.early_exit_condition:
+        return None
+    loaded = {BackendRegOperand(reg_id=left.dest), BackendRegOperand(reg_id=right.dest)}
+    if {compare.left, compare.right} != loaded or len(loaded) != 2:
+        return None
+    return _LoopIdiom(
+        kind=_LoopIdiomKind.MISMATCH,
+        preheader_id=shape.preheader_id,
+        counter=counter,
+        bound=bound,
+        call_name=ARRAY_MISMATCH_RANGE_RUNTIME_CALL,
+        array_args=(left.array_ref.reg_id, right.array_ref.reg_id),
+        value=None,
+        span=span,
+    )
+
+
+def _counter_step(
+    instruction: BackendInstruction,
+    counter: BackendRegId,
+    loop_instructions: list[BackendInstruction],
+) -> tuple[BackendRegId | None, frozenset[BackendInstId]] | None:
+    """Match the latch's final `i = i + 1` (directly or through a temporary) as the only counter update."""
+
+    if sum(1 for candidate in loop_instructions if instruction_def_reg(candidate) == counter) != 1:
+        return None
+    if _is_unit_increment(instruction, counter) and instruction.dest == counter:
+        return None, frozenset({instruction.inst_id})
+    if not (
+        isinstance(instruction, BackendCopyInst)
+        and instruction.dest == counter
+        and isinstance(instruction.source, BackendRegOperand)
+    ):
+        return None
+    step_temp = instruction.source.reg_id
+    increments = [
+        candidate
+        for candidate in loop_instructions
+        if instruction_def_reg(candidate) == step_temp
+    ]
+    if len(increments) != 1 or not _is_unit_increment(increments[0], counter):
+        return None
+    return step_temp, frozenset({instruction.inst_id, increments[0].inst_id})
+
+
+def _is_unit_increment(instruction: BackendInstruction, counter: BackendRegId) -> bool:
+    return (
+        isinstance(instruction, BackendBinaryInst)
+        and instruction.op.kind is BinaryOpKind.ADD
+        and instruction.op.flavor is BinaryOpFlavor.INTEGER
+        and instruction.left == BackendRegOperand(reg_id=counter)
+        and isinstance(instruction.right, BackendConstOperand)
+        and isinstance(instruction.right.constant, BackendIntConst)
+        and instruction.right.constant.value == 1
+    )
+
+
+def _is_word_reinterpret(instruction: BackendInstruction) -> bool:
+    return (
+        isinstance(instruction, BackendCastInst)
+        and instruction.cast_kind is CastSemanticsKind.TO_INTEGER
+        and not instruction.trap_on_failure
+        and isinstance(instruction.operand, BackendRegOperand)
+        and semantic_type_canonical_name(instruction.target_type_ref) in _WORD_INTEGER_TYPE_NAMES
+    )
+
+
+def _invariant_bound_setup(
+    header: BackendBlock,
+    bound: BackendOperand,
+    loop_instructions: list[BackendInstruction],
+    loop_defs: set[BackendRegId],
+) -> tuple[BackendInstruction, ...] | None:
+    """Return the header instructions that recompute a loop-invariant bound, or None if it varies."""
+
+    if not isinstance(bound, BackendRegOperand):
+        return ()
+    if bound.reg_id not in loop_defs:
+        return ()
+    def_counts = Counter(instruction_def_reg(instruction) for instruction in loop_instructions)
+    invariant_regs: set[BackendRegId] = set()
+    invariant_instructions: list[BackendInstruction] = []
+    for instruction in sorted(header.instructions, key=instruction_sort_key):
+        dest = instruction_def_reg(instruction)
+        if def_counts[dest] != 1:
+            continue
+        if all(reg not in loop_defs or reg in invariant_regs for reg in instruction_use_regs(instruction)):
+            invariant_regs.add(dest)
+            invariant_instructions.append(instruction)
+    if bound.reg_id not in invariant_regs:
+        return None
+
+    needed = {bound.reg_id}
+    setup: list[BackendInstruction] = []
+    for instruction in reversed(invariant_instructions):
+        if instruction_def_reg(instruction) in needed:
+            setup.append(instruction)
+            needed.update(instruction_use_regs(instruction))
+    return tuple(reversed(setup))
+
+
+def _bound_operand(operand: BackendOperand, type_name_by_reg_id: dict[BackendRegId, str]) -> BackendOperand | None:
+    if isinstance(operand, BackendRegOperand):
+        return operand if type_name_by_reg_id.get(operand.reg_id) in _WORD_INTEGER_TYPE_NAMES else None
+    if (
+        isinstance(operand, BackendConstOperand)
+        and isinstance(operand.constant, BackendIntConst)
+        and operand.constant.type_name in _WORD_INTEGER_TYPE_NAMES
+        and 0 <= operand.constant.value <= _INT64_MAX
+    ):
+        return BackendConstOperand(constant=BackendIntConst(type_name=TYPE_NAME_I64, value=operand.constant.value))
+    return None
+
+
+def _indexed_access(array_ref: BackendOperand, index: BackendOperand, index_regs: set[BackendRegId], invariant) -> bool:
+    return (
+        isinstance(array_ref, BackendRegOperand)
+        and invariant(array_ref)
+        and isinstance(index, BackendRegOperand)
+        and index.reg_id in index_regs
+    )
+
+
+def _fill_value_supported(value: BackendOperand) -> bool:
+    if isinstance(value, BackendRegOperand):
+        return True
+    return isinstance(value.constant, (BackendIntConst, BackendBoolConst, BackendDoubleConst, BackendNullConst))
+
+
+def _fast_forward_instructions(
+    idiom: _LoopIdiom,
+    register_by_id: dict[BackendRegId, BackendRegister],
+    type_name_by_reg_id: dict[BackendRegId, str],
+    fresh: FreshDefinitions,
+) -> tuple[BackendInstruction, ...]:
+    instructions: list[BackendInstruction] = [
+        replace(instruction, inst_id=fresh.inst_id()) for instruction in idiom.bound_setup
+    ]
+
+    def as_i64(operand: BackendOperand) -> BackendOperand:
+        if not isinstance(operand, BackendRegOperand) or type_name_by_reg_id[operand.reg_id] == TYPE_NAME_I64:
+            return operand
+        dest = fresh.temp(TYPE_NAME_I64, idiom.span)
+        instructions.append(_reinterpret(fresh.inst_id(), dest, operand, TYPE_NAME_I64, idiom.span))
+        return BackendRegOperand(reg_id=dest)
+
+    start = as_i64(BackendRegOperand(reg_id=idiom.counter))
+    end = as_i64(idiom.bound)
+    array_operands = tuple(BackendRegOperand(reg_id=array_reg) for array_reg in idiom.array_args)
+    array_types = tuple(register_by_id[array_reg].type_ref for array_reg in idiom.array_args)
+    i64_type = semantic_primitive_type_ref(TYPE_NAME_I64)
+    if idiom.kind is _LoopIdiomKind.FILL:
+        args = (*array_operands, start, end, idiom.value)
+        param_types = (*array_types, i64_type, i64_type, semantic_type_array_element(array_types[0]))
+    else:
+        args = (*array_operands, start, end)
+        param_types = (*array_types, i64_type, i64_type)
+
+    counter_is_i64 = type_name_by_reg_id[idiom.counter] == TYPE_NAME_I64
+    result = idiom.counter if counter_is_i64 else fresh.temp(TYPE_NAME_I64, idiom.span)
+    metadata = runtime_call_metadata(idiom.call_name)
+    instructions.append(
+        BackendCallInst(
+            inst_id=fresh.inst_id(),
+            span=idiom.span,
+            dest=result,
+            target=BackendRuntimeCallTarget(name=idiom.call_name, ref_arg_indices=metadata.ref_arg_indices),
+            args=args,
+            signature=BackendSignature(param_types=param_types, return_type=i64_type),
+            effects=BackendEffects(
+                reads_memory=True,
+                writes_memory=idiom.kind is not _LoopIdiomKind.MISMATCH,
+                may_gc=metadata.may_gc,
+                needs_safepoint_hooks=metadata.emits_safepoint_hooks,
+            ),
+        )
+    )
+    if not counter_is_i64:
+        instructions.append(
+            _reinterpret(fresh.inst_id(), idiom.counter, BackendRegOperand(reg_id=result), TYPE_NAME_U64, idiom.span)
+        )
+    return tuple(instructions)
+
+
+def _reinterpret(
+    inst_id: BackendInstId,
+    dest: BackendRegId,
+    operand: BackendOperand,
+    type_name: str,
+    span: SourceSpan,
+) -> BackendCastInst:
+    return BackendCastInst(
+        inst_id=inst_id,
+        span=span,
+        dest=dest,
+        cast_kind=CastSemanticsKind.TO_INTEGER,
+        operand=operand,
+        target_type_ref=semantic_primitive_type_ref(type_name),
+        trap_on_failure=False,
+    )
@@ -0,0 +1,143 @@
+from __future__ import annotations
+
+from dataclasses import dataclass, field, replace
+
+from compiler.backend.analysis import build_block_index, instruction_is_safepoint, reverse_postorder_block_ids
+from compiler.backend.ir import (
+    BackendBlock,
+    BackendBranchTerminator,
+    BackendCallableDecl,
+    BackendJumpTerminator,
+    BackendProgram,
+)
+from compiler.backend.ir._ordering import instruction_sort_key
+from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
+
+from .fresh_definitions import FreshDefinitions
+
+
+# Loop headers are duplicated into every latch, so only short condition blocks are worth rotating.
+_MAX_ROTATED_HEADER_INSTRUCTIONS = 8
+
+
+@dataclass
+class _LoopRotationStats:
+    rotated_latches: int = 0
+    duplicated_instructions: int = 0
+    optimized_callables: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
+
+
+def loop_rotation(program: BackendProgram) -> BackendProgram:
+    logger = get_logger(__name__)
+    stats = _LoopRotationStats(remarks=PassRemarks("loop_rotation"))
+    optimized_callables = tuple(rotate_callable_loops(callable_decl, stats=stats) for callable_decl in program.callables)
+    optimized_program = replace(program, callables=optimized_callables)
+    stats.remarks.publish()
+    logger.debugv(
+        1,
+        "Backend optimization pass loop_rotation rotated %d latches (%d duplicated instructions) across %d callables",
+        stats.rotated_latches,
+        stats.duplicated_instructions,
+        stats.optimized_callables,
+    )
+    return optimized_program
+
+
+def rotate_callable_loops(
+    callable_decl: BackendCallableDecl,
+    *,
+    stats: _LoopRotationStats | None = None,
+) -> BackendCallableDecl:
+    """Turn top-tested loops into guarded bottom-tested loops.
+
+    A latch that jumps back to a short branching header receives a copy of the header's
+    instructions and its branch, so each iteration runs one conditional branch at the bottom
+    of the loop instead of a jump back to the test. The original header stays in place as
+    the guard on loop entry.
+    """
+
+    if callable_decl.is_extern or not callable_decl.blocks:
+        return callable_decl
+
+    block_by_id = build_block_index(callable_decl)
+    rpo_index = {block_id: index for index, block_id in enumerate(reverse_postorder_block_ids(callable_decl))}
+    fresh = FreshDefinitions.for_callable(callable_decl, debug_name_prefix="rot")
+    remarks = PassRemarks.discarded() if stats is None else stats.remarks
+    remarks.enter_callable(callable_decl.callable_id)
+
+    rewritten_blocks: list[BackendBlock] = []
+    rotated_count = 0
+    for block in callable_decl.blocks:
+        header = _loop_header(callable_decl, block, block_by_id, rpo_index)
+        if header is None:
+            rewritten_blocks.append(block)
+            continue
+        blocker = _rotation_blocker(header)
+        if blocker is not None:
+            remarks.missed(header.terminator.span, f"loop not rotated: {blocker}")
+            rewritten_blocks.append(block)
+            continue
+        cloned_instructions = [
+            replace(instruction, inst_id=fresh.inst_id())
+            for instruction in sorted(header.instructions, key=instruction_sort_key)
+        ]
+        remarks.applied(
+            header.terminator.span,
+            f"loop rotated: the exit test and {len(cloned_instructions)} header instructions copied into the latch",
+        )
+        rewritten_blocks.append(
+            replace(
+                block,
+                instructions=block.instructions + tuple(cloned_instructions),
+                terminator=header.terminator,
+            )
+        )
+        rotated_count += 1
+        if stats is not None:
+            stats.duplicated_instructions += len(cloned_instructions)
+
+    remarks.leave_callable()
+    if rotated_count == 0:
+        return callable_decl
+    if stats is not None:
+        stats.rotated_latches += rotated_count
+        stats.optimized_callables += 1
+    return replace(callable_decl, blocks=tuple(rewritten_blocks))
+
+
+def _loop_header(
+    callable_decl: BackendCallableDecl,
+    latch: BackendBlock,
+    block_by_id: dict,
+    rpo_index: dict,
+) -> BackendBlock | None:
+    terminator = latch.terminator
+    if not isinstance(terminator, BackendJumpTerminator):
+        return None
+    header_id = terminator.target_block_id
+    if header_id == callable_decl.entry_block_id or header_id == latch.block_id:
+        return None
+    if latch.block_id not in rpo_index or header_id not in rpo_index:
+        return None
+    # Only retreating edges close a loop; forward jumps into a branching block are left alone.
+    if rpo_index[header_id] > rpo_index[latch.block_id]:
+        return None
+    header = block_by_id[header_id]
+    if not isinstance(header.terminator, BackendBranchTerminator):
+        return None
+    if header_id in (header.terminator.true_block_id, header.terminator.false_block_id):
+        return None
+    return header
+
+
+def _rotation_blocker(header: BackendBlock) -> str | None:
+    if len(header.instructions) > _MAX_ROTATED_HEADER_INSTRUCTIONS:
+        return (
+            f"header has {len(header.instructions)} instructions, more than the "
+            f"{_MAX_ROTATED_HEADER_INSTRUCTIONS} worth copying into the latch"
+        )
+    if any(instruction_is_safepoint(instruction) for instruction in header.instructions):
+        return "header contains a safepoint"
+    return None
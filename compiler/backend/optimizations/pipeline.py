@@ -4,13 +4,17 @@ from collections.abc import Callable, Sequence
 from dataclasses import dataclass
 from time import perf_counter
 
-from compiler.backend.ir import BackendProgram
+from compiler.backend.ir import BackendCallableDecl, BackendProgram
 from compiler.backend.ir.verify import verify_backend_program
 from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks, collected_opt_remarks, format_remark_callable
 
 from .algebraic_simplify import algebraic_simplify
 from .constant_fold import constant_fold
 from .dead_pure_definition_elimination import dead_pure_definition_elimination
+from .gc_effect_inference import gc_effect_inference
+from .idiom_recognition import idiom_recognition
+from .loop_rotation import loop_rotation
 from .simplify_cfg import simplify_cfg
 from .trivial_copy_elimination import trivial_copy_elimination
 
@@ -31,7 +35,10 @@ DEFAULT_BACKEND_OPTIMIZATION_PASSES: tuple[BackendOptimizationPass, ...] = (
     BackendOptimizationPass(name="algebraic_simplify", transform=algebraic_simplify),
     BackendOptimizationPass(name="trivial_copy_elimination", transform=trivial_copy_elimination),
     BackendOptimizationPass(name="simplify_cfg", transform=simplify_cfg),
+    BackendOptimizationPass(name="idiom_recognition", transform=idiom_recognition),
+    BackendOptimizationPass(name="loop_rotation", transform=loop_rotation),
     BackendOptimizationPass(name="dead_pure_definition_elimination", transform=dead_pure_definition_elimination),
+    BackendOptimizationPass(name="gc_effect_inference", transform=gc_effect_inference),
 )
 
 
@@ -45,13 +52,53 @@ def optimize_backend_ir_program(
     verify_backend_program(optimized_program)
     for optimization_pass in passes:
         start = perf_counter()
+        remarks = PassRemarks(optimization_pass.name)
+        published_before = len(collected_opt_remarks())
+        previous_program = optimized_program
         optimized_program = optimization_pass.transform(optimized_program)
         verify_backend_program(optimized_program)
+        if remarks.enabled:
+            site_remarked_callables = {
+                remark.callable_name
+                for remark in collected_opt_remarks()[published_before:]
+                if remark.pass_name == optimization_pass.name
+            }
+            _record_changed_callables(remarks, previous_program, optimized_program, site_remarked_callables)
+            remarks.publish()
         duration_ms = (perf_counter() - start) * 1000.0
         logger.debugv(1, "Backend optimization pass %s completed in %.2f ms", optimization_pass.name, duration_ms)
     return optimized_program
 
 
+def _record_changed_callables(
+    remarks: PassRemarks,
+    before: BackendProgram,
+    after: BackendProgram,
+    site_remarked_callables: set[str | None],
+) -> None:
+    # Fallback for rewrites the pass did not remark on itself: one summary per changed callable.
+    before_by_id = {callable_decl.callable_id: callable_decl for callable_decl in before.callables}
+    for callable_decl in after.callables:
+        previous_decl = before_by_id.get(callable_decl.callable_id)
+        if previous_decl is None or previous_decl is callable_decl or previous_decl == callable_decl:
+            continue
+        if format_remark_callable(callable_decl.callable_id) in site_remarked_callables:
+            continue
+        remarks.enter_callable(callable_decl.callable_id)
+        remarks.applied(callable_decl.span, _describe_callable_change(previous_decl, callable_decl))
+        remarks.leave_callable()
+
+
+def _describe_callable_change(before: BackendCallableDecl, after: BackendCallableDecl) -> str:
+    instructions_before = sum(len(block.instructions) for block in before.blocks)
+    instructions_after = sum(len(block.instructions) for block in after.blocks)
+    return (
+        f"rewrote callable: instructions {instructions_before} -> {instructions_after}, "
+        f"blocks {len(before.blocks)} -> {len(after.blocks)}, "
+        f"registers {len(before.registers)} -> {len(after.registers)}"
+    )
+
+
 __all__ = [
     "BackendOptimization",
     "BackendOptimizationPass",
@@ -9,6 +9,7 @@ from compiler.semantic.types import semantic_type_is_reference
 
 OBJECT_FIELD_BASE_OFFSET = 24
 OBJECT_FIELD_SIZE_BYTES = 8
+FIRST_CLASS_TYPE_ID = 1
 
 
 @dataclass(frozen=True, slots=True)
@@ -33,6 +34,7 @@ class BackendClassHierarchyIndex:
         self._callables_by_id = {callable_decl.callable_id: callable_decl for callable_decl in program.callables}
         self._effective_field_slots_by_class_id: dict[ClassId, tuple[EffectiveFieldSlot, ...]] = {}
         self._effective_virtual_slots_by_class_id: dict[ClassId, tuple[EffectiveVirtualMethodSlot, ...]] = {}
+        self._subtype_id_range_by_class_id = _number_classes_in_preorder(program)
 
     def class_by_id(self, class_id: ClassId):
         try:
@@ -120,6 +122,13 @@ class BackendClassHierarchyIndex:
         self._effective_virtual_slots_by_class_id[class_id] = result
         return result
 
+    def subtype_id_range(self, class_id: ClassId) -> tuple[int, int]:
+        """Return `(type_id, subtype_id_end)`: the class and all of its subclasses have ids in that range."""
+        try:
+            return self._subtype_id_range_by_class_id[class_id]
+        except KeyError as exc:
+            raise KeyError(f"Unknown backend class id '{class_id}'") from exc
+
     def resolve_virtual_slot_index(self, class_id: ClassId, slot_owner_class_id: ClassId, method_name: str) -> int:
         for slot in self.effective_virtual_slots(class_id):
             if slot.slot_owner_class_id == slot_owner_class_id and slot.method_name == method_name:
@@ -152,6 +161,27 @@ class BackendClassHierarchyIndex:
         raise KeyError(f"Class '{class_id.name}' does not declare or inherit method '{method_name}'")
 
 
+def _number_classes_in_preorder(program: BackendProgram) -> dict[ClassId, tuple[int, int]]:
+    children_by_class_id: dict[ClassId | None, list[ClassId]] = {}
+    for class_decl in program.classes:
+        children_by_class_id.setdefault(class_decl.superclass_id, []).append(class_decl.class_id)
+
+    ranges: dict[ClassId, tuple[int, int]] = {}
+    next_type_id = FIRST_CLASS_TYPE_ID
+    # Iterative preorder walk; each stack entry is (class_id, children_visited).
+    stack: list[tuple[ClassId, bool]] = [(class_id, False) for class_id in reversed(children_by_class_id.get(None, []))]
+    while stack:
+        class_id, children_visited = stack.pop()
+        if children_visited:
+            ranges[class_id] = (ranges[class_id][0], next_type_id)
+            continue
+        ranges[class_id] = (next_type_id, next_type_id)
+        next_type_id += 1
+        stack.append((class_id, True))
+        stack.extend((child_id, False) for child_id in reversed(children_by_class_id.get(class_id, [])))
+    return ranges
+
+
 def _is_virtual_method(callable_decl: BackendCallableDecl) -> bool:
     return callable_decl.kind == "method" and callable_decl.is_static is False and callable_decl.is_private is False
 
@@ -160,6 +190,7 @@ __all__ = [
     "BackendClassHierarchyIndex",
     "EffectiveFieldSlot",
     "EffectiveVirtualMethodSlot",
+    "FIRST_CLASS_TYPE_ID",
     "OBJECT_FIELD_BASE_OFFSET",
     "OBJECT_FIELD_SIZE_BYTES",
 ]
\ No newline at end of file
@@ -0,0 +1,127 @@
+"""Known std callables that checked targets lower inline instead of calling."""
+
+from __future__ import annotations
+
+from enum import Enum
+
+from compiler.backend.ir import BackendCallInst, BackendDirectCallTarget, BackendSignature
+from compiler.common.type_names import TYPE_NAME_DOUBLE, TYPE_NAME_U64
+from compiler.semantic.symbols import FunctionId
+from compiler.semantic.types import semantic_type_canonical_name
+
+
+STD_MATH_MODULE_PATH = ("std", "math")
+STD_BITS_MODULE_PATH = ("std", "bits")
+
+
+class MathIntrinsicKind(Enum):
+    SQRT = "sqrt"
+    FLOOR = "floor"
+    CEIL = "ceil"
+    TRUNC = "trunc"
+    ROUND = "round"
+    ABS = "abs"
+    MIN = "min"
+    MAX = "max"
+
+    @property
+    def arity(self) -> int:
+        return 2 if self in (MathIntrinsicKind.MIN, MathIntrinsicKind.MAX) else 1
+
+    @property
+    def runtime_fallback_call(self) -> str:
+        return f"rt_math_{self.value}"
+
+
+# Both the exported std.math wrappers and the rt_math_* externs they forward to are recognized, so
+# calls through either name (including the wrapper bodies themselves) lower to the same sequence.
+_MATH_INTRINSIC_BY_FUNCTION_NAME: dict[str, MathIntrinsicKind] = {
+    **{kind.value: kind for kind in MathIntrinsicKind},
+    **{kind.runtime_fallback_call: kind for kind in MathIntrinsicKind},
+}
+
+
+class BitsIntrinsicKind(Enum):
+    POPCOUNT = "popcount"
+    CLZ = "clz"
+    CTZ = "ctz"
+    ROTL = "rotl"
+    ROTR = "rotr"
+    BSWAP = "bswap"
+    MULHI = "mulhi"
+
+    @property
+    def arity(self) -> int:
+        return 2 if self in (BitsIntrinsicKind.ROTL, BitsIntrinsicKind.ROTR, BitsIntrinsicKind.MULHI) else 1
+
+    @property
+    def runtime_fallback_call(self) -> str:
+        return f"rt_bits_{self.value}"
+
+
+_BITS_INTRINSIC_BY_FUNCTION_NAME: dict[str, BitsIntrinsicKind] = {
+    **{kind.value: kind for kind in BitsIntrinsicKind},
+    **{kind.runtime_fallback_call: kind for kind in BitsIntrinsicKind},
+}
+
+
+def math_intrinsic_for_callable_id(callable_id: object, signature: BackendSignature) -> MathIntrinsicKind | None:
+    if not isinstance(callable_id, FunctionId) or callable_id.module_path != STD_MATH_MODULE_PATH:
+        return None
+    kind = _MATH_INTRINSIC_BY_FUNCTION_NAME.get(callable_id.name)
+    if kind is None or not _is_all_double_signature(signature, arity=kind.arity):
+        return None
+    return kind
+
+
+def math_intrinsic_for_call(instruction: BackendCallInst) -> MathIntrinsicKind | None:
+    if not isinstance(instruction.target, BackendDirectCallTarget):
+        return None
+    return math_intrinsic_for_callable_id(instruction.target.callable_id, instruction.signature)
+
+
+def bits_intrinsic_for_callable_id(callable_id: object, signature: BackendSignature) -> BitsIntrinsicKind | None:
+    if not isinstance(callable_id, FunctionId) or callable_id.module_path != STD_BITS_MODULE_PATH:
+        return None
+    kind = _BITS_INTRINSIC_BY_FUNCTION_NAME.get(callable_id.name)
+    if kind is None or not _is_uniform_signature(signature, TYPE_NAME_U64, arity=kind.arity):
+        return None
+    return kind
+
+
+def bits_intrinsic_for_call(instruction: BackendCallInst) -> BitsIntrinsicKind | None:
+    if not isinstance(instruction.target, BackendDirectCallTarget):
+        return None
+    return bits_intrinsic_for_callable_id(instruction.target.callable_id, instruction.signature)
+
+
+def is_intrinsic_callable_id(callable_id: object, signature: BackendSignature) -> bool:
+    return (
+        math_intrinsic_for_callable_id(callable_id, signature) is not None
+        or bits_intrinsic_for_callable_id(callable_id, signature) is not None
+    )
+
+
+def _is_all_double_signature(signature: BackendSignature, *, arity: int) -> bool:
+    return _is_uniform_signature(signature, TYPE_NAME_DOUBLE, arity=arity)
+
+
+def _is_uniform_signature(signature: BackendSignature, type_name: str, *, arity: int) -> bool:
+    if signature.return_type is None or semantic_type_canonical_name(signature.return_type) != type_name:
+        return False
+    return len(signature.param_types) == arity and all(
+        semantic_type_canonical_name(param_type) == type_name for param_type in signature.param_types
+    )
+
+
+__all__ = [
+    "BitsIntrinsicKind",
+    "MathIntrinsicKind",
+    "STD_BITS_MODULE_PATH",
+    "STD_MATH_MODULE_PATH",
+    "bits_intrinsic_for_call",
+    "bits_intrinsic_for_callable_id",
+    "is_intrinsic_callable_id",
+    "math_intrinsic_for_call",
+    "math_intrinsic_for_callable_id",
+]
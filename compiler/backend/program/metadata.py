@@ -49,6 +49,8 @@ class ClassMetadataRecord:
     aliases: tuple[str, ...]
     type_symbol: str
     type_name_symbol: str
+    type_id: int
+    subtype_id_end: int
     superclass_symbol: str | None
     pointer_offsets_symbol: str | None
     pointer_offsets: tuple[int, ...]
@@ -87,6 +89,10 @@ class BackendProgramMetadata:
     extra_runtime_types: tuple[ExtraRuntimeTypeRecord, ...]
     data_blobs: tuple[BackendDataBlobMetadataRecord, ...]
 
+    @property
+    def interface_slot_count(self) -> int:
+        return len(self.interfaces)
+
     @property
     def extra_runtime_type_names(self) -> tuple[str, ...]:
         return tuple(record.canonical_type_name for record in self.extra_runtime_types)
@@ -121,6 +127,7 @@ def build_backend_program_metadata(
         class_symbols = symbols.class_symbols(class_decl.class_id)
         qualified_type_name = class_symbols.qualified_type_name
         pointer_offsets = class_hierarchy.pointer_offsets(class_decl.class_id)
+        type_id, subtype_id_end = class_hierarchy.subtype_id_range(class_decl.class_id)
         superclass_symbol = None
         if class_decl.superclass_id is not None:
             superclass_symbol = symbols.class_symbols(class_decl.superclass_id).type_symbol
@@ -162,6 +169,8 @@ def build_backend_program_metadata(
                 aliases=_class_aliases(class_decl.class_id, short_type_alias_counts),
                 type_symbol=class_symbols.type_symbol,
                 type_name_symbol=class_symbols.type_name_symbol,
+                type_id=type_id,
+                subtype_id_end=subtype_id_end,
                 superclass_symbol=superclass_symbol,
                 pointer_offsets_symbol=class_symbols.pointer_offsets_symbol if pointer_offsets else None,
                 pointer_offsets=pointer_offsets,
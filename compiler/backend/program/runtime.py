@@ -89,6 +89,72 @@ ARRAY_SLICE_SET_RUNTIME_CALLS: dict[ArrayRuntimeKind, str] = {
     ArrayRuntimeKind.REF: "rt_array_set_slice_ref",
 }
 
+# Loop-idiom kernels return the first index they left for the compiled loop to finish.
+ARRAY_FILL_RUNTIME_CALLS: dict[ArrayRuntimeKind, str] = {
+    ArrayRuntimeKind.I64: "rt_array_fill_i64",
+    ArrayRuntimeKind.U64: "rt_array_fill_u64",
+    ArrayRuntimeKind.U8: "rt_array_fill_u8",
+    ArrayRuntimeKind.BOOL: "rt_array_fill_bool",
+    ArrayRuntimeKind.DOUBLE: "rt_array_fill_double",
+    ArrayRuntimeKind.REF: "rt_array_fill_ref",
+}
+ARRAY_COPY_RANGE_RUNTIME_CALL = "rt_array_copy_range"
+ARRAY_MISMATCH_RANGE_RUNTIME_CALL = "rt_array_mismatch_range"
+STR_FORMAT_LEN_RUNTIME_CALLS: dict[str, str] = {
+    TYPE_NAME_I64: "rt_str_len_i64",
+    TYPE_NAME_U64: "rt_str_len_u64",
+    TYPE_NAME_DOUBLE: "rt_str_len_double",
+}
+STR_FORMAT_WRITE_RUNTIME_CALLS: dict[str, str] = {
+    TYPE_NAME_I64: "rt_str_write_i64",
+    TYPE_NAME_U64: "rt_str_write_u64",
+    TYPE_NAME_DOUBLE: "rt_str_write_double",
+}
+STR_WRITE_BYTES_RUNTIME_CALL = "rt_str_write_bytes"
+STR_WRITE_LITERAL_RUNTIME_CALL = "rt_str_write_literal"
+
+# std declares these with `extern fn`; none of them allocates on the managed heap, which lets
+# interprocedural GC-effect inference treat their callers as non-collecting.
+NON_GC_EXTERN_RUNTIME_CALL_REF_ARG_INDICES: dict[str, tuple[int, ...]] = {
+    **{
+        f"rt_math_{name}": ()
+        for name in (
+            "abs", "acos", "asin", "atan", "atan2", "cbrt", "ceil", "cos", "exp", "floor", "hypot",
+            "is_infinite", "is_nan", "log", "log10", "max", "min", "pow", "round", "sin", "sqrt", "tan", "trunc",
+        )
+    },
+    **{
+        f"rt_bits_{name}": ()
+        for name in ("bswap", "clz", "ctz", "mulhi", "popcount", "rotl", "rotr")
+    },
+    "rt_bigint_compare": (0, 1),
+    "rt_bigint_add": (0, 1, 2),
+    "rt_bigint_sub": (0, 1, 2),
+    "rt_bigint_mul": (0, 1, 2),
+    "rt_bigint_mul_word_add": (0, 1),
+    "rt_bigint_divrem_word": (0, 1),
+    "rt_bigint_divrem": (0, 1, 2, 3),
+    "rt_bigint_to_decimal": (0, 1),
+    "rt_bigint_from_decimal": (0, 1),
+    "rt_bitset_and": (0, 1),
+    "rt_bitset_or": (0, 1),
+    "rt_bitset_xor": (0, 1),
+    "rt_bitset_and_not": (0, 1),
+    "rt_bitset_count": (0,),
+    "rt_bitset_next_set": (0,),
+    "rt_box_cache_get": (),
+    **{f"rt_sort_{kind}": (0,) for kind in ("i64", "u64", "u8", "double")},
+    **{f"rt_sort_search_{kind}": (0,) for kind in ("i64", "u64", "u8", "double")},
+    "rt_obj_same_type": (0, 1),
+    "rt_file_stdin_handle": (),
+    "rt_file_close": (),
+    "rt_file_open_for_read": (0,),
+    "rt_file_try_open_for_read": (0,),
+    "rt_file_read_u8_array": (1,),
+    "rt_file_write_all": (0, 1),
+    "rt_write_u8_array": (0,),
+}
+
 
 def _runtime_call_metadata(
     name: str,
@@ -146,6 +212,34 @@ _RUNTIME_CALL_METADATA_BY_NAME: dict[str, RuntimeCallMetadata] = {
         )
         for runtime_kind, call_name in ARRAY_SLICE_SET_RUNTIME_CALLS.items()
     },
+    **{
+        call_name: _runtime_call_metadata(
+            call_name,
+            ref_arg_indices=(0,) if runtime_kind is not ArrayRuntimeKind.REF else (0, 3),
+            may_gc=False,
+        )
+        for runtime_kind, call_name in ARRAY_FILL_RUNTIME_CALLS.items()
+    },
+    ARRAY_COPY_RANGE_RUNTIME_CALL: _runtime_call_metadata(ARRAY_COPY_RANGE_RUNTIME_CALL, ref_arg_indices=(0, 1), may_gc=False),
+    ARRAY_MISMATCH_RANGE_RUNTIME_CALL: _runtime_call_metadata(
+        ARRAY_MISMATCH_RANGE_RUNTIME_CALL, ref_arg_indices=(0, 1), may_gc=False
+    ),
+    **{
+        call_name: _runtime_call_metadata(call_name, may_gc=False)
+        for call_name in STR_FORMAT_LEN_RUNTIME_CALLS.values()
+    },
+    **{
+        call_name: _runtime_call_metadata(call_name, ref_arg_indices=(0,), may_gc=False)
+        for call_name in STR_FORMAT_WRITE_RUNTIME_CALLS.values()
+    },
+    STR_WRITE_BYTES_RUNTIME_CALL: _runtime_call_metadata(STR_WRITE_BYTES_RUNTIME_CALL, ref_arg_indices=(0, 2), may_gc=False),
+    STR_WRITE_LITERAL_RUNTIME_CALL: _runtime_call_metadata(
+        STR_WRITE_LITERAL_RUNTIME_CALL, ref_arg_indices=(0,), may_gc=False
+    ),
+    **{
+        call_name: _runtime_call_metadata(call_name, ref_arg_indices=ref_arg_indices, may_gc=False)
+        for call_name, ref_arg_indices in NON_GC_EXTERN_RUNTIME_CALL_REF_ARG_INDICES.items()
+    },
 }
 
 RUNTIME_REF_ARG_INDICES: dict[str, tuple[int, ...]] = {
@@ -16,8 +16,10 @@ RT_ROOT_FRAME_SIZE_BYTES = 24
 RT_OBJ_HEADER_TYPE_OFFSET = 0
 RT_OBJ_HEADER_SIZE_BYTES = 24
 
+RT_TYPE_TYPE_ID_OFFSET = 0
 RT_TYPE_DEBUG_NAME_OFFSET = 24
 RT_TYPE_POINTER_OFFSETS_OFFSET = 40
+RT_TYPE_SUBTYPE_ID_END_OFFSET = 52
 RT_TYPE_SUPER_TYPE_OFFSET = 56
 RT_TYPE_INTERFACE_TABLES_OFFSET = 64
 RT_INTERFACE_TABLE_ENTRY_SIZE_BYTES = 8
@@ -25,9 +27,20 @@ RT_INTERFACE_DEBUG_NAME_OFFSET = 0
 RT_INTERFACE_METHOD_ENTRY_SIZE_BYTES = 8
 RT_TYPE_CLASS_VTABLE_OFFSET = 80
 RT_VTABLE_ENTRY_SIZE_BYTES = 8
+# Compiled class records are laid out as [interface tables][RtType][vtable]; every class carries one
+# interface table entry per program interface, so both tables sit at fixed offsets from the type.
+RT_TYPE_SIZE_BYTES = 96
 
 RT_TYPE_FLAG_HAS_REFS = 1
 
+RT_FUNC_PROFILE_SITE_NAME_OFFSET = 0
+RT_FUNC_PROFILE_SITE_SIZE_BYTES = 48
+
+RT_LINE_TABLE_SECTION_NAME = "nif_line_tables"
+RT_LINE_TABLE_SIZE_BYTES = 40
+RT_LINE_TABLE_ENTRY_SIZE_BYTES = 12
+RT_LINE_TABLE_FLAG_FOLDS_CALLER = 1
+
 RT_ARRAY_LEN_OFFSET = RT_OBJ_HEADER_SIZE_BYTES
 RT_ARRAY_ELEMENT_KIND_OFFSET = RT_ARRAY_LEN_OFFSET + 8
 RT_ARRAY_ELEMENT_SIZE_OFFSET = RT_ARRAY_ELEMENT_KIND_OFFSET + 8
@@ -43,6 +56,10 @@ RT_ARRAY_KIND_REF = 6
 RT_ARRAY_PRIMITIVE_TYPE_SYMBOL = "rt_type_array_primitive_desc"
 RT_ARRAY_REFERENCE_TYPE_SYMBOL = "rt_type_array_reference_desc"
 
+# uint32_t flags from runtime/include/cpu_features.h, zero until the runtime has detected the extension.
+RT_CPU_HAS_SSE41_SYMBOL = "rt_cpu_has_sse41"
+RT_CPU_HAS_POPCNT_SYMBOL = "rt_cpu_has_popcnt"
+
 ARRAY_RUNTIME_KIND_TAGS: dict[ArrayRuntimeKind, int] = {
     ArrayRuntimeKind.I64: RT_ARRAY_KIND_I64,
     ArrayRuntimeKind.U64: RT_ARRAY_KIND_U64,
@@ -105,9 +122,17 @@ __all__ = [
     "RT_ARRAY_LEN_OFFSET",
     "RT_ARRAY_PRIMITIVE_TYPE_SYMBOL",
     "RT_ARRAY_REFERENCE_TYPE_SYMBOL",
+    "RT_CPU_HAS_POPCNT_SYMBOL",
+    "RT_CPU_HAS_SSE41_SYMBOL",
+    "RT_FUNC_PROFILE_SITE_NAME_OFFSET",
+    "RT_FUNC_PROFILE_SITE_SIZE_BYTES",
     "RT_INTERFACE_DEBUG_NAME_OFFSET",
     "RT_INTERFACE_METHOD_ENTRY_SIZE_BYTES",
     "RT_INTERFACE_TABLE_ENTRY_SIZE_BYTES",
+    "RT_LINE_TABLE_ENTRY_SIZE_BYTES",
+    "RT_LINE_TABLE_FLAG_FOLDS_CALLER",
+    "RT_LINE_TABLE_SECTION_NAME",
+    "RT_LINE_TABLE_SIZE_BYTES",
     "RT_OBJ_HEADER_SIZE_BYTES",
     "RT_OBJ_HEADER_TYPE_OFFSET",
     "RT_ROOT_FRAME_PREV_OFFSET",
@@ -121,7 +146,10 @@ __all__ = [
     "RT_TYPE_FLAG_HAS_REFS",
     "RT_TYPE_INTERFACE_TABLES_OFFSET",
     "RT_TYPE_POINTER_OFFSETS_OFFSET",
+    "RT_TYPE_SIZE_BYTES",
+    "RT_TYPE_SUBTYPE_ID_END_OFFSET",
     "RT_TYPE_SUPER_TYPE_OFFSET",
+    "RT_TYPE_TYPE_ID_OFFSET",
     "RT_VTABLE_ENTRY_SIZE_BYTES",
     "array_runtime_kind_display_name_for_tag",
     "array_runtime_kind_tag",
@@ -89,10 +89,34 @@ def mangle_debug_file_symbol(target_label: str) -> str:
     return f"__nif_debug_file_{_mangle_fragment(target_label)}"
 
 
+def mangle_profile_site_symbol(target_label: str) -> str:
+    return f"__nif_profile_site_{_mangle_fragment(target_label)}"
+
+
+def mangle_profile_name_symbol(target_label: str) -> str:
+    return f"__nif_profile_name_{_mangle_fragment(target_label)}"
+
+
+def mangle_line_table_entries_symbol(target_label: str) -> str:
+    return f"__nif_line_entries_{_mangle_fragment(target_label)}"
+
+
 def epilogue_label(fn_name: str) -> str:
     return f".L{fn_name}_epilogue"
 
 
+def unframed_epilogue_label(fn_name: str) -> str:
+    return f".L{fn_name}_epilogue_unframed"
+
+
+def code_end_label(fn_name: str) -> str:
+    return f".L{fn_name}_end"
+
+
+def line_location_label(fn_name: str, index: int) -> str:
+    return f".L{fn_name}_loc{index}"
+
+
 @dataclass(frozen=True, slots=True)
 class BackendCallableSymbol:
     callable_id: FunctionId | MethodId | ConstructorId
@@ -286,7 +310,9 @@ __all__ = [
     "BackendInterfaceSymbols",
     "BackendProgramSymbolTable",
     "build_backend_program_symbol_table",
+    "code_end_label",
     "epilogue_label",
+    "line_location_label",
     "mangle_class_interface_tables_symbol",
     "mangle_class_vtable_symbol",
     "mangle_constructor_init_symbol",
@@ -297,11 +323,15 @@ __all__ = [
     "mangle_interface_method_table_symbol",
     "mangle_interface_name_symbol",
     "mangle_interface_symbol",
+    "mangle_line_table_entries_symbol",
     "mangle_method_symbol",
+    "mangle_profile_name_symbol",
+    "mangle_profile_site_symbol",
     "mangle_type_name_symbol",
     "mangle_type_pointer_offsets_symbol",
     "mangle_type_symbol",
     "qualified_class_name",
     "qualified_interface_name",
     "string_literal_symbol",
+    "unframed_epilogue_label",
 ]
\ No newline at end of file
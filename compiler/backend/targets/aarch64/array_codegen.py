@@ -114,6 +114,7 @@ def emit_array_load_instruction(
     frame_layout: AArch64FrameLayout,
     register_type_name_by_reg_id: dict,
     options: BackendTargetOptions,
+    bounds_check_proven: bool = False,
 ) -> None:
     if options.collection_fast_paths_enabled:
         emit_load_operand(
@@ -130,12 +131,13 @@ def emit_array_load_instruction(
             frame_layout=frame_layout,
             register_type_name_by_reg_id=register_type_name_by_reg_id,
         )
-        _emit_direct_array_index_bounds_check(
-            builder,
-            callable_label=callable_label,
-            instruction=instruction,
-            panic_symbol=ARRAY_GET_OOB_PANIC_RUNTIME_CALL,
-        )
+        if not bounds_check_proven:
+            _emit_direct_array_index_bounds_check(
+                builder,
+                callable_label=callable_label,
+                instruction=instruction,
+                panic_symbol=ARRAY_GET_OOB_PANIC_RUNTIME_CALL,
+            )
         emit_array_data_address(builder, "x9", "x0")
         if instruction.array_runtime_kind is ArrayRuntimeKind.DOUBLE:
             builder.instruction("ldr", "d0", direct_primitive_array_load_operand("x9", "x1", runtime_kind=instruction.array_runtime_kind))
@@ -174,6 +176,7 @@ def emit_array_store_instruction(
     frame_layout: AArch64FrameLayout,
     register_type_name_by_reg_id: dict,
     options: BackendTargetOptions,
+    bounds_check_proven: bool = False,
 ) -> None:
     if options.collection_fast_paths_enabled:
         emit_load_operand(
@@ -190,12 +193,13 @@ def emit_array_store_instruction(
             frame_layout=frame_layout,
             register_type_name_by_reg_id=register_type_name_by_reg_id,
         )
-        _emit_direct_array_index_bounds_check(
-            builder,
-            callable_label=callable_label,
-            instruction=instruction,
-            panic_symbol=ARRAY_SET_OOB_PANIC_RUNTIME_CALL,
-        )
+        if not bounds_check_proven:
+            _emit_direct_array_index_bounds_check(
+                builder,
+                callable_label=callable_label,
+                instruction=instruction,
+                panic_symbol=ARRAY_SET_OOB_PANIC_RUNTIME_CALL,
+            )
         if instruction.array_runtime_kind is ArrayRuntimeKind.DOUBLE:
             emit_load_float_operand(
                 builder,
@@ -0,0 +1,69 @@
+"""Inline lowering of std.bits intrinsics for the AArch64 target.
+
+Every intrinsic maps onto base-ISA instructions: `popcount` goes through the AdvSIMD `cnt`/`addv`
+byte counts, `ctz` is `rbit` followed by `clz`, and `rotl` rotates right by the negated amount. `ror`
+already takes its register amount modulo 64, matching the runtime wrappers.
+"""
+
+from __future__ import annotations
+
+from compiler.backend.ir import BackendCallInst
+from compiler.backend.program.intrinsics import BitsIntrinsicKind
+from compiler.backend.targets.aarch64.asm import AArch64AsmBuilder
+from compiler.backend.targets.aarch64.frame import AArch64FrameLayout
+from compiler.backend.targets.aarch64.instruction_selection import emit_load_operand, emit_store_result
+
+
+_PRIMARY_REGISTER = "x0"
+_SECONDARY_REGISTER = "x1"
+_VECTOR_TEMP_SCALAR = "d16"
+_VECTOR_TEMP_BYTES = "v16.8b"
+_VECTOR_TEMP_BYTE_SCALAR = "b16"
+
+
+def emit_bits_intrinsic_instruction(
+    builder: AArch64AsmBuilder,
+    instruction: BackendCallInst,
+    kind: BitsIntrinsicKind,
+    *,
+    frame_layout: AArch64FrameLayout,
+    register_type_name_by_reg_id: dict,
+) -> None:
+    if instruction.dest is None:
+        return
+    registers = (_PRIMARY_REGISTER, _SECONDARY_REGISTER)
+    for operand, target_register in zip(instruction.args, registers[: kind.arity], strict=True):
+        emit_load_operand(
+            builder,
+            operand,
+            target_register=target_register,
+            frame_layout=frame_layout,
+            register_type_name_by_reg_id=register_type_name_by_reg_id,
+        )
+
+    if kind == BitsIntrinsicKind.POPCOUNT:
+        builder.instruction("fmov", _VECTOR_TEMP_SCALAR, _PRIMARY_REGISTER)
+        builder.instruction("cnt", _VECTOR_TEMP_BYTES, _VECTOR_TEMP_BYTES)
+        builder.instruction("addv", _VECTOR_TEMP_BYTE_SCALAR, _VECTOR_TEMP_BYTES)
+        builder.instruction("fmov", _PRIMARY_REGISTER, _VECTOR_TEMP_SCALAR)
+    elif kind == BitsIntrinsicKind.CLZ:
+        builder.instruction("clz", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+    elif kind == BitsIntrinsicKind.CTZ:
+        builder.instruction("rbit", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+        builder.instruction("clz", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+    elif kind == BitsIntrinsicKind.ROTL:
+        builder.instruction("neg", _SECONDARY_REGISTER, _SECONDARY_REGISTER)
+        builder.instruction("ror", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
+    elif kind == BitsIntrinsicKind.ROTR:
+        builder.instruction("ror", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
+    elif kind == BitsIntrinsicKind.BSWAP:
+        builder.instruction("rev", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+    else:
+        builder.instruction("umulh", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
+
+    emit_store_result(builder, instruction.dest, frame_layout=frame_layout)
+
+
+__all__ = [
+    "emit_bits_intrinsic_instruction",
+]
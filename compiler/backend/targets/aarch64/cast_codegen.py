@@ -21,7 +21,7 @@ from compiler.backend.program.runtime_layout import (
 from compiler.backend.program.symbols import mangle_type_name_symbol, mangle_type_symbol
 from compiler.backend.targets import BackendTargetLoweringError
 from compiler.backend.targets.aarch64.array_runtime import array_element_kind_operand
-from compiler.backend.targets.aarch64.asm import AArch64AsmBuilder, emit_materialize_symbol_address
+from compiler.backend.targets.aarch64.asm import AArch64AsmBuilder, emit_load_immediate, emit_materialize_symbol_address
 from compiler.backend.targets.aarch64.frame import AArch64FrameLayout
 from compiler.backend.targets.aarch64.instruction_selection import (
     emit_load_float_operand,
@@ -34,6 +34,7 @@ from compiler.backend.targets.aarch64.object_runtime import (
     interface_tables_operand,
     object_type_operand,
     type_debug_name_operand,
+    type_id_operand,
 )
 from compiler.common.collection_protocols import ArrayRuntimeKind
 from compiler.common.type_names import TYPE_NAME_BOOL, TYPE_NAME_DOUBLE, TYPE_NAME_NULL, TYPE_NAME_OBJ, TYPE_NAME_U64, TYPE_NAME_U8
@@ -197,7 +198,7 @@ def emit_type_test_instruction(
         _emit_interface_type_test(builder, instruction, callable_label=callable_label, program_context=program_context)
         emit_store_result(builder, instruction.dest, frame_layout=frame_layout)
         return
-    _emit_class_type_test(builder, instruction, program_context=program_context)
+    _emit_class_type_test(builder, instruction, callable_label=callable_label, program_context=program_context)
     emit_store_result(builder, instruction.dest, frame_layout=frame_layout)
 
 
@@ -324,6 +325,11 @@ def _emit_class_checked_cast(
 ) -> None:
     done_label = f".L{callable_label}_i{instruction.inst_id.ordinal}_class_cast_done"
     builder.instruction("cbz", _PRIMARY_REGISTER, done_label)
+    subtype_id_range = _subtype_id_range_for_target(instruction.target_type_ref, program_context=program_context)
+    if subtype_id_range is not None:
+        # A miss still calls the runtime, which reports the bad cast.
+        success_condition = _emit_subtype_id_range_compare(builder, subtype_id_range)
+        builder.instruction(f"b.{success_condition}", done_label)
     emit_materialize_symbol_address(
         builder,
         _SECONDARY_REGISTER,
@@ -337,14 +343,44 @@ def _emit_class_type_test(
     builder: AArch64AsmBuilder,
     instruction: BackendTypeTestInst,
     *,
+    callable_label: str,
     program_context: BackendProgramContext,
 ) -> None:
-    emit_materialize_symbol_address(
-        builder,
-        _SECONDARY_REGISTER,
-        _type_symbol_for_target(instruction.target_type_ref, program_context=program_context),
-    )
-    builder.instruction("bl", "rt_is_instance_of_type")
+    subtype_id_range = _subtype_id_range_for_target(instruction.target_type_ref, program_context=program_context)
+    if subtype_id_range is None:
+        emit_materialize_symbol_address(
+            builder,
+            _SECONDARY_REGISTER,
+            _type_symbol_for_target(instruction.target_type_ref, program_context=program_context),
+        )
+        builder.instruction("bl", "rt_is_instance_of_type")
+        return
+
+    done_label = f".L{callable_label}_i{instruction.inst_id.ordinal}_class_test_done"
+    builder.instruction("cbz", _PRIMARY_REGISTER, done_label)
+    success_condition = _emit_subtype_id_range_compare(builder, subtype_id_range)
+    builder.instruction("cset", _PRIMARY_WORD_REGISTER, success_condition)
+    builder.label(done_label)
+
+
+def _emit_subtype_id_range_compare(builder: AArch64AsmBuilder, subtype_id_range: tuple[int, int]) -> str:
+    """Compare the non-null object's type id against a class's preorder range; return the success condition."""
+    type_id, subtype_id_end = subtype_id_range
+    builder.instruction("ldr", _SECONDARY_REGISTER, object_type_operand(_PRIMARY_REGISTER))
+    builder.instruction("ldr", _SECONDARY_WORD_REGISTER, type_id_operand(_SECONDARY_REGISTER))
+    if subtype_id_end - type_id == 1:
+        builder.instruction("cmp", _SECONDARY_WORD_REGISTER, _word_immediate_operand(builder, type_id))
+        return "eq"
+    builder.instruction("sub", _SECONDARY_WORD_REGISTER, _SECONDARY_WORD_REGISTER, _word_immediate_operand(builder, type_id))
+    builder.instruction("cmp", _SECONDARY_WORD_REGISTER, _word_immediate_operand(builder, subtype_id_end - type_id))
+    return "lo"
+
+
+def _word_immediate_operand(builder: AArch64AsmBuilder, value: int) -> str:
+    if value < 4096:
+        return f"#{value}"
+    emit_load_immediate(builder, _TERTIARY_REGISTER, value)
+    return _TERTIARY_WORD_REGISTER
 
 
 def _emit_interface_checked_cast(
@@ -516,6 +552,14 @@ def _type_symbol_for_target(type_ref: SemanticTypeRef, *, program_context: Backe
     return mangle_type_symbol(semantic_type_canonical_name(type_ref))
 
 
+def _subtype_id_range_for_target(
+    type_ref: SemanticTypeRef, *, program_context: BackendProgramContext
+) -> tuple[int, int] | None:
+    if type_ref.class_id is None:
+        return None
+    return program_context.class_hierarchy.subtype_id_range(type_ref.class_id)
+
+
 def _type_name_symbol_for_target(type_ref: SemanticTypeRef, *, program_context: BackendProgramContext) -> str:
     if type_ref.interface_id is not None:
         return program_context.symbols.interface_symbols(type_ref.interface_id).name_symbol
@@ -231,6 +231,7 @@ def emit_branch_terminator(
     register_type_name_by_reg_id: dict,
     true_label: str,
     false_label: str,
+    fallthrough_label: str | None = None,
 ) -> None:
     emit_load_operand(
         builder,
@@ -240,12 +241,26 @@ def emit_branch_terminator(
         register_type_name_by_reg_id=register_type_name_by_reg_id,
     )
     builder.instruction("cmp", _PRIMARY_REGISTER, "#0")
+    if true_label == fallthrough_label:
+        builder.instruction("b.eq", false_label)
+        return
+    if false_label == fallthrough_label:
+        builder.instruction("b.ne", true_label)
+        return
     builder.instruction("b.eq", false_label)
     builder.instruction("b", true_label)
 
 
-def emit_jump_terminator(builder: AArch64AsmBuilder, terminator: BackendJumpTerminator, *, target_label: str) -> None:
+def emit_jump_terminator(
+    builder: AArch64AsmBuilder,
+    terminator: BackendJumpTerminator,
+    *,
+    target_label: str,
+    fallthrough_label: str | None = None,
+) -> None:
     del terminator
+    if target_label == fallthrough_label:
+        return
     builder.instruction("b", target_label)
 
 
@@ -389,7 +404,12 @@ def _emit_float_unary_operation(builder: AArch64AsmBuilder, instruction: Backend
 
 def _emit_binary_operation(builder: AArch64AsmBuilder, instruction: BackendBinaryInst, *, operand_type_name: str) -> None:
     if instruction.op.flavor == BinaryOpFlavor.INTEGER:
-        _emit_integer_binary_operation(builder, instruction.op.kind, operand_type_name=operand_type_name)
+        _emit_integer_binary_operation(
+            builder,
+            instruction.op.kind,
+            operand_type_name=operand_type_name,
+            shift_count_is_constant_in_range=_shift_count_is_constant_in_range(instruction, operand_type_name),
+        )
         return
     if instruction.op.flavor == BinaryOpFlavor.INTEGER_COMPARISON:
         _emit_integer_comparison(builder, instruction.op.kind, operand_type_name=operand_type_name)
@@ -483,7 +503,13 @@ def _emit_float_binary_operation(builder: AArch64AsmBuilder, instruction: Backen
     )
 
 
-def _emit_integer_binary_operation(builder: AArch64AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str) -> None:
+def _emit_integer_binary_operation(
+    builder: AArch64AsmBuilder,
+    kind: BinaryOpKind,
+    *,
+    operand_type_name: str,
+    shift_count_is_constant_in_range: bool = False,
+) -> None:
     if kind == BinaryOpKind.ADD:
         builder.instruction("add", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
         _mask_u8_result_if_needed(builder, operand_type_name)
@@ -496,6 +522,9 @@ def _emit_integer_binary_operation(builder: AArch64AsmBuilder, kind: BinaryOpKin
         builder.instruction("mul", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
         _mask_u8_result_if_needed(builder, operand_type_name)
         return
+    if kind == BinaryOpKind.MULTIPLY_HIGH:
+        builder.instruction("umulh", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
+        return
     if kind == BinaryOpKind.POWER:
         _emit_integer_power(builder, operand_type_name=operand_type_name)
         return
@@ -506,7 +535,12 @@ def _emit_integer_binary_operation(builder: AArch64AsmBuilder, kind: BinaryOpKin
         _emit_integer_divide_or_remainder(builder, operand_type_name=operand_type_name, emit_remainder=True)
         return
     if kind in {BinaryOpKind.SHIFT_LEFT, BinaryOpKind.SHIFT_RIGHT}:
-        _emit_integer_shift(builder, kind, operand_type_name=operand_type_name)
+        _emit_integer_shift(
+            builder,
+            kind,
+            operand_type_name=operand_type_name,
+            check_shift_count=not shift_count_is_constant_in_range,
+        )
         return
     if kind == BinaryOpKind.BITWISE_AND:
         builder.instruction("and", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
@@ -571,12 +605,14 @@ def _emit_integer_divide_or_remainder(
     builder.instruction("mov", _PRIMARY_REGISTER, _TERTIARY_REGISTER)
 
 
-def _emit_integer_shift(builder: AArch64AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str) -> None:
-    max_shift = 8 if operand_type_name == TYPE_NAME_U8 else 64
-    builder.instruction("cmp", _SECONDARY_REGISTER, f"#{max_shift}")
-    builder.instruction("b.lo", "1f")
-    builder.instruction("bl", "rt_panic_invalid_shift_count")
-    builder.label("1")
+def _emit_integer_shift(
+    builder: AArch64AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str, check_shift_count: bool
+) -> None:
+    if check_shift_count:
+        builder.instruction("cmp", _SECONDARY_REGISTER, f"#{_shift_width(operand_type_name)}")
+        builder.instruction("b.lo", "1f")
+        builder.instruction("bl", "rt_panic_invalid_shift_count")
+        builder.label("1")
     if kind == BinaryOpKind.SHIFT_LEFT:
         builder.instruction("lslv", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
         _mask_u8_result_if_needed(builder, operand_type_name)
@@ -587,6 +623,21 @@ def _emit_integer_shift(builder: AArch64AsmBuilder, kind: BinaryOpKind, *, opera
     builder.instruction("asrv", _PRIMARY_REGISTER, _PRIMARY_REGISTER, _SECONDARY_REGISTER)
 
 
+def _shift_width(operand_type_name: str) -> int:
+    return 8 if operand_type_name == TYPE_NAME_U8 else 64
+
+
+def _shift_count_is_constant_in_range(instruction: BackendBinaryInst, operand_type_name: str) -> bool:
+    if instruction.op.kind not in {BinaryOpKind.SHIFT_LEFT, BinaryOpKind.SHIFT_RIGHT}:
+        return False
+    right = instruction.right
+    return (
+        isinstance(right, BackendConstOperand)
+        and isinstance(right.constant, BackendIntConst)
+        and 0 <= right.constant.value < _shift_width(operand_type_name)
+    )
+
+
 def _emit_integer_comparison(builder: AArch64AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str) -> None:
     builder.instruction("cmp", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
     is_unsigned = operand_type_name in _UNSIGNED_TYPE_NAMES
@@ -14,7 +14,12 @@ from compiler.backend.program import BackendProgramContext
 from compiler.backend.program.symbols import BackendProgramSymbolTable
 from compiler.backend.targets import BackendTargetLoweringError
 from compiler.backend.targets.aarch64.abi import AARCH64_ABI, AArch64Abi
-from compiler.backend.targets.aarch64.asm import AArch64AsmBuilder, format_memory_operand
+from compiler.backend.targets.aarch64.asm import (
+    AArch64AsmBuilder,
+    emit_add_address,
+    emit_materialize_symbol_address,
+    format_memory_operand,
+)
 from compiler.backend.targets.aarch64.frame import AArch64FrameLayout
 from compiler.backend.targets.aarch64.instruction_selection import (
     emit_load_float_operand,
@@ -23,11 +28,9 @@ from compiler.backend.targets.aarch64.instruction_selection import (
     emit_store_result,
 )
 from compiler.backend.targets.aarch64.object_runtime import (
+    class_interface_table_entry_byte_offset,
     class_vtable_entry_operand,
-    class_vtable_operand,
     interface_method_entry_operand,
-    interface_table_entry_operand,
-    interface_tables_operand,
     object_type_operand,
 )
 from compiler.semantic.symbols import ClassId
@@ -37,6 +40,15 @@ _CALL_TEMP_REGISTER = "x9"
 _CALL_TEMP_FLOAT_REGISTER = "d16"
 _CALL_TARGET_REGISTER = "x16"
 _CALL_LOOKUP_SCRATCH_REGISTER = "x10"
+_INLINE_CACHE_ADDRESS_REGISTER = "x17"
+# Free once every argument is in place: stack arguments are staged through it before the lookup runs.
+_INLINE_CACHE_MISS_SCRATCH_REGISTER = "x9"
+INLINE_CACHE_ENTRY_COUNT = 4
+INLINE_CACHE_ENTRY_SIZE_BYTES = 16
+# Stored over the first entry's type once a site has missed with every entry taken; no RtType lives at 1.
+INLINE_CACHE_MEGAMORPHIC_MARKER = 1
+# Largest negative offset an unscaled load (ldur) can encode.
+_UNSCALED_LOAD_MIN_OFFSET = -256
 
 
 def emit_call_instruction(
@@ -52,6 +64,7 @@ def emit_call_instruction(
     callable_label: str,
     emit_safepoint_preamble=None,
     emit_safepoint_postamble=None,
+    inline_cache_labels: list[str] | None = None,
     abi: AArch64Abi = AARCH64_ABI,
 ) -> None:
     if not isinstance(
@@ -176,7 +189,9 @@ def emit_call_instruction(
         register_type_name_by_reg_id=register_type_name_by_reg_id,
         frame_layout=frame_layout,
         interface_method_slot_by_id=interface_method_slot_by_id,
+        callable_label=callable_label,
         includes_receiver=includes_receiver,
+        inline_cache_labels=inline_cache_labels,
     )
 
     if call_stack_reservation_bytes > 0:
@@ -240,7 +255,9 @@ def _emit_call_target_invocation(
     register_type_name_by_reg_id: dict,
     frame_layout: AArch64FrameLayout,
     interface_method_slot_by_id: dict,
+    callable_label: str,
     includes_receiver: bool,
+    inline_cache_labels: list[str] | None,
 ) -> None:
     if isinstance(instruction.target, (BackendDirectCallTarget, BackendRuntimeCallTarget)):
         builder.instruction("bl", _call_target_symbol(instruction, program_symbols, callee_decl, includes_receiver=includes_receiver))
@@ -259,81 +276,140 @@ def _emit_call_target_invocation(
         return
 
     if isinstance(instruction.target, BackendVirtualCallTarget):
-        _emit_virtual_call_target_lookup(builder, instruction=instruction, program_context=program_context)
-        builder.instruction("blr", _CALL_TARGET_REGISTER)
-        return
+        slot_index = _virtual_slot_index(program_context, instruction)
 
-    if isinstance(instruction.target, BackendInterfaceCallTarget):
-        _emit_interface_call_target_lookup(
-            builder,
-            instruction=instruction,
-            program_context=program_context,
-            interface_method_slot_by_id=interface_method_slot_by_id,
+        def emit_table_lookup(type_register: str, lookup_register: str) -> None:
+            _emit_virtual_call_target_lookup(builder, slot_index=slot_index, type_register=type_register)
+
+    elif isinstance(instruction.target, BackendInterfaceCallTarget):
+        table_byte_offset = class_interface_table_entry_byte_offset(
+            _interface_slot_index(program_context, instruction.target.interface_id),
+            interface_slot_count=program_context.metadata.interface_slot_count,
         )
-        builder.instruction("blr", _CALL_TARGET_REGISTER)
-        return
+        method_slot = _interface_method_slot(interface_method_slot_by_id, instruction)
 
-    raise BackendTargetLoweringError(
-        f"aarch64 call lowering does not support target '{type(instruction.target).__name__}'"
-    )
+        def emit_table_lookup(type_register: str, lookup_register: str) -> None:
+            _emit_interface_call_target_lookup(
+                builder,
+                table_byte_offset=table_byte_offset,
+                method_slot=method_slot,
+                type_register=type_register,
+                lookup_register=lookup_register,
+            )
 
+    else:
+        raise BackendTargetLoweringError(
+            f"aarch64 call lowering does not support target '{type(instruction.target).__name__}'"
+        )
 
-def _emit_virtual_call_target_lookup(
-    builder: AArch64AsmBuilder,
-    *,
-    instruction: BackendCallInst,
-    program_context: BackendProgramContext,
-) -> None:
+    builder.instruction("ldr", _CALL_LOOKUP_SCRATCH_REGISTER, object_type_operand("x0"))
+    if inline_cache_labels is None:
+        emit_table_lookup(_CALL_LOOKUP_SCRATCH_REGISTER, _CALL_LOOKUP_SCRATCH_REGISTER)
+    else:
+        cache_label = inline_cache_label(callable_label, instruction)
+        inline_cache_labels.append(cache_label)
+        _emit_inline_cache_lookup(builder, cache_label=cache_label, emit_table_lookup=emit_table_lookup)
+    builder.instruction("blr", _CALL_TARGET_REGISTER)
+
+
+def inline_cache_label(callable_label: str, instruction: BackendCallInst) -> str:
+    return f".L{callable_label}_i{instruction.inst_id.ordinal}_ic"
+
+
+def _emit_inline_cache_lookup(builder: AArch64AsmBuilder, *, cache_label: str, emit_table_lookup) -> None:
+    """Probe the site's (RtType*, target) entries, falling back to the tables and filling a free entry.
+
+    The receiver type is already in the lookup scratch register. Entries fill in
+    order and are never evicted; a miss with every entry taken marks the site
+    megamorphic, after which it skips the probes and goes straight to the tables.
+    """
+    hit_label = f"{cache_label}_hit"
+    miss_label = f"{cache_label}_miss"
+    full_label = f"{cache_label}_full"
+    megamorphic_label = f"{cache_label}_megamorphic"
+    entry_register = _INLINE_CACHE_MISS_SCRATCH_REGISTER
+    emit_materialize_symbol_address(builder, _INLINE_CACHE_ADDRESS_REGISTER, cache_label)
+    builder.instruction("ldp", entry_register, _CALL_TARGET_REGISTER, f"[{_INLINE_CACHE_ADDRESS_REGISTER}]")
+    builder.instruction("cmp", _CALL_LOOKUP_SCRATCH_REGISTER, entry_register)
+    builder.instruction("b.eq", hit_label)
+    builder.instruction("cmp", entry_register, f"#{INLINE_CACHE_MEGAMORPHIC_MARKER}")
+    builder.instruction("b.eq", megamorphic_label)
+    for entry_index in range(1, INLINE_CACHE_ENTRY_COUNT):
+        entry_operand = format_memory_operand(_INLINE_CACHE_ADDRESS_REGISTER, entry_index * INLINE_CACHE_ENTRY_SIZE_BYTES)
+        builder.instruction("ldp", entry_register, _CALL_TARGET_REGISTER, entry_operand)
+        builder.instruction("cmp", _CALL_LOOKUP_SCRATCH_REGISTER, entry_register)
+        builder.instruction("b.eq", hit_label)
+    builder.label(miss_label)
+    emit_table_lookup(_CALL_LOOKUP_SCRATCH_REGISTER, entry_register)
+    for entry_index in range(INLINE_CACHE_ENTRY_COUNT):
+        entry_operand = format_memory_operand(_INLINE_CACHE_ADDRESS_REGISTER, entry_index * INLINE_CACHE_ENTRY_SIZE_BYTES)
+        next_label = f"{cache_label}_fill{entry_index + 1}" if entry_index + 1 < INLINE_CACHE_ENTRY_COUNT else full_label
+        builder.instruction("ldr", entry_register, entry_operand)
+        builder.instruction("cbnz", entry_register, next_label)
+        builder.instruction("stp", _CALL_LOOKUP_SCRATCH_REGISTER, _CALL_TARGET_REGISTER, entry_operand)
+        builder.instruction("b", hit_label)
+        builder.label(next_label)
+    builder.instruction("mov", entry_register, f"#{INLINE_CACHE_MEGAMORPHIC_MARKER}")
+    builder.instruction("str", entry_register, f"[{_INLINE_CACHE_ADDRESS_REGISTER}]")
+    builder.instruction("b", hit_label)
+    builder.label(megamorphic_label)
+    emit_table_lookup(_CALL_LOOKUP_SCRATCH_REGISTER, _CALL_LOOKUP_SCRATCH_REGISTER)
+    builder.label(hit_label)
+
+
+def emit_inline_cache_sites(builder: AArch64AsmBuilder, *, labels: tuple[str, ...]) -> None:
+    """Emit one zeroed inline cache per dispatch site: (RtType*, target) pairs."""
+    if not labels:
+        return
+    builder.blank()
+    builder.directive(".bss")
+    for label in labels:
+        builder.directive(".p2align 4")
+        builder.label(label)
+        builder.directive(f".zero {INLINE_CACHE_ENTRY_COUNT * INLINE_CACHE_ENTRY_SIZE_BYTES}")
+
+
+def _virtual_slot_index(program_context: BackendProgramContext, instruction: BackendCallInst) -> int:
     assert isinstance(instruction.target, BackendVirtualCallTarget)
     selected_method_class_id = ClassId(
         module_path=instruction.target.selected_method_id.module_path,
         name=instruction.target.selected_method_id.class_name,
     )
-    slot_index = program_context.class_hierarchy.resolve_virtual_slot_index(
+    return program_context.class_hierarchy.resolve_virtual_slot_index(
         selected_method_class_id,
         instruction.target.slot_owner_class_id,
         instruction.target.method_name,
     )
-    builder.instruction("ldr", _CALL_LOOKUP_SCRATCH_REGISTER, object_type_operand("x0"))
-    builder.instruction("ldr", _CALL_LOOKUP_SCRATCH_REGISTER, class_vtable_operand(_CALL_LOOKUP_SCRATCH_REGISTER))
-    builder.instruction(
-        "ldr",
-        _CALL_TARGET_REGISTER,
-        class_vtable_entry_operand(_CALL_LOOKUP_SCRATCH_REGISTER, slot_index),
-    )
 
 
-def _emit_interface_call_target_lookup(
-    builder: AArch64AsmBuilder,
-    *,
-    instruction: BackendCallInst,
-    program_context: BackendProgramContext,
-    interface_method_slot_by_id: dict,
-) -> None:
+def _interface_method_slot(interface_method_slot_by_id: dict, instruction: BackendCallInst) -> int:
     assert isinstance(instruction.target, BackendInterfaceCallTarget)
-    slot_index = _interface_slot_index(program_context, instruction.target.interface_id)
     try:
-        method_slot = interface_method_slot_by_id[instruction.target.method_id]
+        return interface_method_slot_by_id[instruction.target.method_id]
     except KeyError as exc:
         raise BackendTargetLoweringError(
             f"aarch64 backend program context is missing interface method slot metadata for '{instruction.target.method_id}'"
         ) from exc
-    builder.instruction("ldr", _CALL_LOOKUP_SCRATCH_REGISTER, object_type_operand("x0"))
-    builder.instruction(
-        "ldr",
-        _CALL_LOOKUP_SCRATCH_REGISTER,
-        interface_tables_operand(_CALL_LOOKUP_SCRATCH_REGISTER),
-    )
-    builder.instruction(
-        "ldr",
-        _CALL_LOOKUP_SCRATCH_REGISTER,
-        interface_table_entry_operand(_CALL_LOOKUP_SCRATCH_REGISTER, slot_index),
-    )
-    builder.instruction(
-        "ldr",
-        _CALL_TARGET_REGISTER,
-        interface_method_entry_operand(_CALL_LOOKUP_SCRATCH_REGISTER, method_slot),
-    )
+
+
+def _emit_virtual_call_target_lookup(builder: AArch64AsmBuilder, *, slot_index: int, type_register: str) -> None:
+    builder.instruction("ldr", _CALL_TARGET_REGISTER, class_vtable_entry_operand(type_register, slot_index))
+
+
+def _emit_interface_call_target_lookup(
+    builder: AArch64AsmBuilder,
+    *,
+    table_byte_offset: int,
+    method_slot: int,
+    type_register: str,
+    lookup_register: str,
+) -> None:
+    if table_byte_offset >= _UNSCALED_LOAD_MIN_OFFSET:
+        builder.instruction("ldur", lookup_register, format_memory_operand(type_register, table_byte_offset))
+    else:
+        emit_add_address(builder, target_register=lookup_register, base_register=type_register, byte_offset=table_byte_offset)
+        builder.instruction("ldr", lookup_register, format_memory_operand(lookup_register))
+    builder.instruction("ldr", _CALL_TARGET_REGISTER, interface_method_entry_operand(lookup_register, method_slot))
 
 
 def _interface_slot_index(program_context: BackendProgramContext, interface_id) -> int:
@@ -0,0 +1,82 @@
+"""Inline lowering of std.math intrinsics for the AArch64 target.
+
+Every intrinsic maps onto a base-ISA scalar instruction. `round` uses `frinta` (ties away from zero),
+matching C `round`. `min`/`max` use `fmin`/`fmax`, which already order -0.0 below +0.0 and propagate
+NaN; `fminnm`/`fmaxnm` would instead drop a NaN operand. The unordered case is then replaced with the
+canonical quiet NaN the runtime returns.
+"""
+
+from __future__ import annotations
+
+from compiler.backend.ir import BackendCallInst
+from compiler.backend.program.intrinsics import MathIntrinsicKind
+from compiler.backend.targets.aarch64.asm import AArch64AsmBuilder, emit_load_immediate
+from compiler.backend.targets.aarch64.frame import AArch64FrameLayout
+from compiler.backend.targets.aarch64.instruction_selection import (
+    emit_load_float_operand,
+    emit_store_float_result,
+)
+
+
+_IMMEDIATE_TEMP_REGISTER = "x9"
+_PRIMARY_FLOAT_REGISTER = "d0"
+_SECONDARY_FLOAT_REGISTER = "d1"
+_FLOAT_TEMP_REGISTER = "d16"
+
+_DOUBLE_CANONICAL_NAN = 0x7FF8000000000000
+
+_UNARY_MNEMONIC_BY_KIND = {
+    MathIntrinsicKind.SQRT: "fsqrt",
+    MathIntrinsicKind.FLOOR: "frintm",
+    MathIntrinsicKind.CEIL: "frintp",
+    MathIntrinsicKind.TRUNC: "frintz",
+    MathIntrinsicKind.ROUND: "frinta",
+    MathIntrinsicKind.ABS: "fabs",
+}
+_BINARY_MNEMONIC_BY_KIND = {
+    MathIntrinsicKind.MIN: "fmin",
+    MathIntrinsicKind.MAX: "fmax",
+}
+
+
+def emit_math_intrinsic_instruction(
+    builder: AArch64AsmBuilder,
+    instruction: BackendCallInst,
+    kind: MathIntrinsicKind,
+    *,
+    frame_layout: AArch64FrameLayout,
+    register_type_name_by_reg_id: dict,
+) -> None:
+    if instruction.dest is None:
+        return
+    float_registers = (_PRIMARY_FLOAT_REGISTER, _SECONDARY_FLOAT_REGISTER)
+    for operand, target_float_register in zip(instruction.args, float_registers[: kind.arity], strict=True):
+        emit_load_float_operand(
+            builder,
+            operand,
+            target_float_register=target_float_register,
+            frame_layout=frame_layout,
+            register_type_name_by_reg_id=register_type_name_by_reg_id,
+        )
+
+    unary_mnemonic = _UNARY_MNEMONIC_BY_KIND.get(kind)
+    if unary_mnemonic is not None:
+        builder.instruction(unary_mnemonic, _PRIMARY_FLOAT_REGISTER, _PRIMARY_FLOAT_REGISTER)
+    else:
+        builder.instruction("fcmp", _PRIMARY_FLOAT_REGISTER, _SECONDARY_FLOAT_REGISTER)
+        builder.instruction(
+            _BINARY_MNEMONIC_BY_KIND[kind],
+            _PRIMARY_FLOAT_REGISTER,
+            _PRIMARY_FLOAT_REGISTER,
+            _SECONDARY_FLOAT_REGISTER,
+        )
+        emit_load_immediate(builder, _IMMEDIATE_TEMP_REGISTER, _DOUBLE_CANONICAL_NAN)
+        builder.instruction("fmov", _FLOAT_TEMP_REGISTER, _IMMEDIATE_TEMP_REGISTER)
+        builder.instruction("fcsel", _PRIMARY_FLOAT_REGISTER, _FLOAT_TEMP_REGISTER, _PRIMARY_FLOAT_REGISTER, "vs")
+
+    emit_store_float_result(builder, instruction.dest, frame_layout=frame_layout)
+
+
+__all__ = [
+    "emit_math_intrinsic_instruction",
+]
@@ -176,34 +176,34 @@ def emit_program_metadata_sections(builder: AArch64AsmBuilder, *, program_contex
             builder.label(interface_method_table.method_table_symbol)
             for method_label in interface_method_table.method_labels:
                 builder.directive(f".quad {method_label}")
+    for class_record in metadata.classes:
+        # Interface tables end where the RtType record starts and the vtable follows it, so dispatch
+        # indexes both at fixed offsets from the type pointer (see RT_TYPE_SIZE_BYTES).
+        _emit_alignment(builder, 8)
         if class_record.interface_tables_symbol is not None:
-            _emit_alignment(builder, 8)
             builder.label(class_record.interface_tables_symbol)
             for entry in class_record.interface_table_entries:
                 builder.directive(f".quad {entry or '0'}")
-    for class_record in metadata.classes:
-        if class_record.class_vtable_symbol is None:
-            continue
-        _emit_alignment(builder, 8)
-        builder.label(class_record.class_vtable_symbol)
-        for method_label in class_record.class_vtable_labels:
-            builder.directive(f".quad {method_label}")
-    for class_record in metadata.classes:
-        _emit_alignment(builder, 8)
         for alias in class_record.aliases:
             builder.label(mangle_type_symbol(alias))
         _emit_rt_type_record(
             builder,
             flags=RT_TYPE_FLAG_HAS_REFS if class_record.pointer_offsets else 0,
+            type_id=class_record.type_id,
             name_symbol=class_record.type_name_symbol,
             pointer_offsets_symbol=class_record.pointer_offsets_symbol,
             pointer_offsets_count=len(class_record.pointer_offsets),
+            subtype_id_end=class_record.subtype_id_end,
             super_type_symbol=class_record.superclass_symbol,
             interface_tables_symbol=class_record.interface_tables_symbol,
             interface_slot_count=class_record.interface_table_slot_count,
             class_vtable_symbol=class_record.class_vtable_symbol,
             class_vtable_count=len(class_record.class_vtable_labels),
         )
+        if class_record.class_vtable_symbol is not None:
+            builder.label(class_record.class_vtable_symbol)
+            for method_label in class_record.class_vtable_labels:
+                builder.directive(f".quad {method_label}")
     for runtime_type in metadata.extra_runtime_types:
         _emit_alignment(builder, 8)
         for alias in runtime_type.aliases:
@@ -211,9 +211,11 @@ def emit_program_metadata_sections(builder: AArch64AsmBuilder, *, program_contex
         _emit_rt_type_record(
             builder,
             flags=0,
+            type_id=0,
             name_symbol=runtime_type.type_name_symbol,
             pointer_offsets_symbol=None,
             pointer_offsets_count=0,
+            subtype_id_end=0,
             super_type_symbol=None,
             interface_tables_symbol=None,
             interface_slot_count=0,
@@ -253,17 +255,19 @@ def _emit_blob(builder: AArch64AsmBuilder, blob) -> None:
 def _emit_rt_type_record(
     builder: AArch64AsmBuilder,
     *,
+    type_id: int,
     flags: int,
     name_symbol: str,
     pointer_offsets_symbol: str | None,
     pointer_offsets_count: int,
+    subtype_id_end: int,
     super_type_symbol: str | None,
     interface_tables_symbol: str | None,
     interface_slot_count: int,
     class_vtable_symbol: str | None,
     class_vtable_count: int,
 ) -> None:
-    builder.directive(".long 0")
+    builder.directive(f".long {type_id}")
     builder.directive(f".long {flags}")
     builder.directive(".long 1")
     builder.directive(".long 8")
@@ -272,7 +276,7 @@ def _emit_rt_type_record(
     builder.directive(".quad 0")
     builder.directive(f".quad {pointer_offsets_symbol or '0'}")
     builder.directive(f".long {pointer_offsets_count}")
-    builder.directive(".long 0")
+    builder.directive(f".long {subtype_id_end}")
     builder.directive(f".quad {super_type_symbol or '0'}")
     builder.directive(f".quad {interface_tables_symbol or '0'}")
     builder.directive(f".long {interface_slot_count}")
@@ -5,10 +5,11 @@ from compiler.backend.program.runtime_layout import (
     RT_INTERFACE_METHOD_ENTRY_SIZE_BYTES,
     RT_INTERFACE_TABLE_ENTRY_SIZE_BYTES,
     RT_OBJ_HEADER_TYPE_OFFSET,
-    RT_TYPE_CLASS_VTABLE_OFFSET,
     RT_TYPE_DEBUG_NAME_OFFSET,
     RT_TYPE_INTERFACE_TABLES_OFFSET,
     RT_TYPE_POINTER_OFFSETS_OFFSET,
+    RT_TYPE_SIZE_BYTES,
+    RT_TYPE_TYPE_ID_OFFSET,
     RT_VTABLE_ENTRY_SIZE_BYTES,
 )
 from compiler.backend.targets.aarch64.asm import format_memory_operand
@@ -18,6 +19,10 @@ def object_type_operand(object_register: str) -> str:
     return format_memory_operand(object_register, RT_OBJ_HEADER_TYPE_OFFSET)
 
 
+def type_id_operand(type_register: str) -> str:
+    return format_memory_operand(type_register, RT_TYPE_TYPE_ID_OFFSET)
+
+
 def type_debug_name_operand(type_register: str) -> str:
     return format_memory_operand(type_register, RT_TYPE_DEBUG_NAME_OFFSET)
 
@@ -46,19 +51,21 @@ def interface_method_entry_operand(method_table_register: str, slot_index: int)
     return format_memory_operand(method_table_register, slot_index * RT_INTERFACE_METHOD_ENTRY_SIZE_BYTES)
 
 
-def class_vtable_operand(type_register: str) -> str:
-    return format_memory_operand(type_register, RT_TYPE_CLASS_VTABLE_OFFSET)
-
-
-def class_vtable_entry_operand(vtable_register: str, slot_index: int) -> str:
+def class_vtable_entry_operand(type_register: str, slot_index: int) -> str:
     if slot_index < 0:
         raise ValueError("virtual method slot index must be non-negative")
-    return format_memory_operand(vtable_register, slot_index * RT_VTABLE_ENTRY_SIZE_BYTES)
+    return format_memory_operand(type_register, RT_TYPE_SIZE_BYTES + slot_index * RT_VTABLE_ENTRY_SIZE_BYTES)
+
+
+def class_interface_table_entry_byte_offset(slot_index: int, *, interface_slot_count: int) -> int:
+    if slot_index < 0 or slot_index >= interface_slot_count:
+        raise ValueError("interface slot index must be within the program's interface slots")
+    return (slot_index - interface_slot_count) * RT_INTERFACE_TABLE_ENTRY_SIZE_BYTES
 
 
 __all__ = [
+    "class_interface_table_entry_byte_offset",
     "class_vtable_entry_operand",
-    "class_vtable_operand",
     "interface_debug_name_operand",
     "interface_method_entry_operand",
     "interface_table_entry_operand",
@@ -66,4 +73,5 @@ __all__ = [
     "object_type_operand",
     "pointer_offsets_operand",
     "type_debug_name_operand",
+    "type_id_operand",
 ]
\ No newline at end of file
@@ -1,8 +1,21 @@
 from __future__ import annotations
 
-from dataclasses import dataclass
-
-from compiler.backend.program.symbols import mangle_debug_file_symbol, mangle_debug_function_symbol
+from dataclasses import dataclass, field
+
+from compiler.backend.program.runtime_layout import (
+    RT_FUNC_PROFILE_SITE_NAME_OFFSET,
+    RT_FUNC_PROFILE_SITE_SIZE_BYTES,
+    RT_LINE_TABLE_SECTION_NAME,
+)
+from compiler.backend.program.symbols import (
+    code_end_label,
+    line_location_label,
+    mangle_debug_file_symbol,
+    mangle_debug_function_symbol,
+    mangle_line_table_entries_symbol,
+    mangle_profile_name_symbol,
+    mangle_profile_site_symbol,
+)
 from compiler.backend.targets.aarch64.asm import AArch64AsmBuilder, emit_materialize_symbol_address
 
 
@@ -13,6 +26,18 @@ class TraceDebugRecord:
     file_path: str
 
 
+@dataclass(slots=True)
+class LineTableRecord:
+    """PC-to-line table for one emitted code range; `locations` fill in as the body is emitted."""
+
+    trace_record: TraceDebugRecord
+    code_label: str
+    line: int
+    column: int
+    flags: int = 0
+    locations: list[tuple[str, int, int]] = field(default_factory=list)
+
+
 def emit_trace_push(builder: AArch64AsmBuilder, record: TraceDebugRecord, *, line: int, column: int) -> None:
     emit_materialize_symbol_address(builder, "x0", mangle_debug_function_symbol(record.target_label))
     emit_materialize_symbol_address(builder, "x1", mangle_debug_file_symbol(record.target_label))
@@ -31,6 +56,75 @@ def emit_trace_location(builder: AArch64AsmBuilder, *, line: int, column: int) -
     builder.instruction("bl", "rt_trace_set_location")
 
 
+def emit_line_table_mark(builder: AArch64AsmBuilder, record: LineTableRecord, *, line: int, column: int) -> None:
+    if record.locations and record.locations[-1][1:] == (line, column):
+        return
+    label = line_location_label(record.code_label, len(record.locations))
+    builder.label(label)
+    record.locations.append((label, line, column))
+
+
+def emit_line_table_end(builder: AArch64AsmBuilder, record: LineTableRecord) -> None:
+    builder.label(code_end_label(record.code_label))
+
+
+def emit_line_tables(builder: AArch64AsmBuilder, *, records: tuple[LineTableRecord, ...]) -> None:
+    """Emit RtLineTable headers into their own section plus per-callable location entries.
+
+    Offsets are self-relative so the tables need no dynamic relocations in PIE links.
+    """
+    if not records:
+        return
+    builder.blank()
+    builder.directive(".section .rodata")
+    builder.directive(".p2align 2")
+    for record in records:
+        if not record.locations:
+            continue
+        builder.label(mangle_line_table_entries_symbol(record.code_label))
+        for label, line, column in record.locations:
+            builder.directive(f".long {label} - {record.code_label}, {line}, {column}")
+    builder.blank()
+    builder.directive(f'.section {RT_LINE_TABLE_SECTION_NAME},"a",@progbits')
+    builder.directive(".p2align 2")
+    for record in records:
+        entries = f"{mangle_line_table_entries_symbol(record.code_label)} - ." if record.locations else "0"
+        builder.directive(f".long {record.code_label} - .")
+        builder.directive(f".long {code_end_label(record.code_label)} - {record.code_label}")
+        builder.directive(f".long {mangle_debug_function_symbol(record.trace_record.target_label)} - .")
+        builder.directive(f".long {mangle_debug_file_symbol(record.trace_record.target_label)} - .")
+        builder.directive(f".long {entries}")
+        builder.directive(f".long {len(record.locations)}, {record.line}, {record.column}, {record.flags}, 0")
+
+
+def emit_function_profile_enter(builder: AArch64AsmBuilder, record: TraceDebugRecord) -> None:
+    emit_materialize_symbol_address(builder, "x0", mangle_profile_site_symbol(record.target_label))
+    builder.instruction("bl", "rt_func_profile_enter")
+
+
+def emit_function_profile_exit(builder: AArch64AsmBuilder) -> None:
+    builder.instruction("bl", "rt_func_profile_exit")
+
+
+def emit_function_profile_sites(builder: AArch64AsmBuilder, *, records: tuple[TraceDebugRecord, ...]) -> None:
+    """Emit one zeroed RtFuncProfileSite per instrumented callable plus its display name."""
+    if not records:
+        return
+    builder.blank()
+    builder.directive(".section .rodata")
+    for record in records:
+        builder.label(mangle_profile_name_symbol(record.target_label))
+        builder.directive(f'.asciz "{_escape_c_string(record.function_name)}"')
+    builder.blank()
+    builder.directive(".data")
+    trailing_bytes = RT_FUNC_PROFILE_SITE_SIZE_BYTES - RT_FUNC_PROFILE_SITE_NAME_OFFSET - 8
+    for record in records:
+        builder.directive(".p2align 3")
+        builder.label(mangle_profile_site_symbol(record.target_label))
+        builder.directive(f".quad {mangle_profile_name_symbol(record.target_label)}")
+        builder.directive(f".zero {trailing_bytes}")
+
+
 def emit_trace_debug_literals(builder: AArch64AsmBuilder, *, records: tuple[TraceDebugRecord, ...]) -> None:
     if not records:
         return
@@ -54,7 +148,14 @@ def _escape_c_string(value: str) -> str:
 
 
 __all__ = [
+    "LineTableRecord",
     "TraceDebugRecord",
+    "emit_function_profile_enter",
+    "emit_function_profile_exit",
+    "emit_function_profile_sites",
+    "emit_line_table_end",
+    "emit_line_table_mark",
+    "emit_line_tables",
     "emit_trace_debug_literals",
     "emit_trace_location",
     "emit_trace_pop",
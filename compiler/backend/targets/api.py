@@ -29,7 +29,10 @@ class BackendTargetOptions:
     """Checked-path switches forwarded into a concrete backend target."""
 
     runtime_trace_enabled: bool = True
+    shadow_trace_enabled: bool = False
+    function_profile_enabled: bool = False
     collection_fast_paths_enabled: bool = True
+    inline_caches_enabled: bool = False
     emit_debug_comments: bool = False
     extra_flags: tuple[str, ...] = ()
 
@@ -115,6 +115,7 @@ def emit_array_load_instruction(
     frame_layout: X86_64SysVFrameLayout,
     register_type_name_by_reg_id: dict,
     options: BackendTargetOptions,
+    bounds_check_proven: bool = False,
 ) -> None:
     if options.collection_fast_paths_enabled:
         emit_load_operand(
@@ -133,12 +134,13 @@ def emit_array_load_instruction(
             frame_layout=frame_layout,
             register_type_name_by_reg_id=register_type_name_by_reg_id,
         )
-        _emit_direct_array_index_bounds_check(
-            builder,
-            callable_label=callable_label,
-            instruction=instruction,
-            panic_symbol=ARRAY_GET_OOB_PANIC_RUNTIME_CALL,
-        )
+        if not bounds_check_proven:
+            _emit_direct_array_index_bounds_check(
+                builder,
+                callable_label=callable_label,
+                instruction=instruction,
+                panic_symbol=ARRAY_GET_OOB_PANIC_RUNTIME_CALL,
+            )
         if instruction.array_runtime_kind is ArrayRuntimeKind.DOUBLE:
             builder.instruction("movq", "xmm0", _direct_array_load_operand(instruction.array_runtime_kind))
             emit_store_float_result(builder, instruction.dest, frame_layout=frame_layout)
@@ -171,6 +173,7 @@ def emit_array_store_instruction(
     frame_layout: X86_64SysVFrameLayout,
     register_type_name_by_reg_id: dict,
     options: BackendTargetOptions,
+    bounds_check_proven: bool = False,
 ) -> None:
     if options.collection_fast_paths_enabled:
         emit_load_operand(
@@ -189,12 +192,13 @@ def emit_array_store_instruction(
             frame_layout=frame_layout,
             register_type_name_by_reg_id=register_type_name_by_reg_id,
         )
-        _emit_direct_array_index_bounds_check(
-            builder,
-            callable_label=callable_label,
-            instruction=instruction,
-            panic_symbol=ARRAY_SET_OOB_PANIC_RUNTIME_CALL,
-        )
+        if not bounds_check_proven:
+            _emit_direct_array_index_bounds_check(
+                builder,
+                callable_label=callable_label,
+                instruction=instruction,
+                panic_symbol=ARRAY_SET_OOB_PANIC_RUNTIME_CALL,
+            )
         if instruction.array_runtime_kind is ArrayRuntimeKind.DOUBLE:
             emit_load_float_operand(
                 builder,
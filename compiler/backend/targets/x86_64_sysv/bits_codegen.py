@@ -0,0 +1,97 @@
+"""Inline lowering of std.bits intrinsics for the x86-64 SysV target.
+
+Only `popcount` needs an extension beyond the x86-64 baseline: it uses `popcnt` once the runtime has
+detected it and otherwise calls `rt_bits_popcount`, which runs that detection on first use. `clz` and
+`ctz` use baseline `bsr`/`bsf` with a `cmovz` fixup for a zero operand instead of LZCNT/TZCNT, whose
+encodings silently decode as `bsr`/`bsf` on CPUs without them. Rotates take the amount modulo 64,
+which is exactly what `rol`/`ror` with a count in `cl` do.
+"""
+
+from __future__ import annotations
+
+from compiler.backend.ir import BackendCallInst
+from compiler.backend.program.intrinsics import BitsIntrinsicKind
+from compiler.backend.program.runtime_layout import RT_CPU_HAS_POPCNT_SYMBOL
+from compiler.backend.targets.x86_64_sysv.asm import X86AsmBuilder
+from compiler.backend.targets.x86_64_sysv.frame import X86_64SysVFrameLayout
+from compiler.backend.targets.x86_64_sysv.instruction_selection import emit_load_operand, emit_store_result
+
+
+_PRIMARY_REGISTER = "rax"
+_PRIMARY_BYTE_REGISTER = "al"
+_SECONDARY_REGISTER = "rcx"
+_SECONDARY_BYTE_REGISTER = "cl"
+_FIRST_ARGUMENT_REGISTER = "rdi"
+
+_BIT_WIDTH = 64
+
+
+def emit_bits_intrinsic_instruction(
+    builder: X86AsmBuilder,
+    instruction: BackendCallInst,
+    kind: BitsIntrinsicKind,
+    *,
+    callable_label: str,
+    frame_layout: X86_64SysVFrameLayout,
+    register_type_name_by_reg_id: dict,
+) -> None:
+    if instruction.dest is None:
+        return
+    registers = (
+        (_PRIMARY_REGISTER, _PRIMARY_BYTE_REGISTER),
+        (_SECONDARY_REGISTER, _SECONDARY_BYTE_REGISTER),
+    )
+    for operand, (target_register, target_byte_register) in zip(
+        instruction.args, registers[: kind.arity], strict=True
+    ):
+        emit_load_operand(
+            builder,
+            operand,
+            target_register=target_register,
+            target_byte_register=target_byte_register,
+            frame_layout=frame_layout,
+            register_type_name_by_reg_id=register_type_name_by_reg_id,
+        )
+
+    if kind == BitsIntrinsicKind.POPCOUNT:
+        _emit_popcount(builder, label_prefix=f".L{callable_label}_i{instruction.inst_id.ordinal}_bits")
+    elif kind == BitsIntrinsicKind.CLZ:
+        # bsr yields the index of the highest set bit; 127 ^ 63 == 64 covers the zero operand.
+        builder.instruction("mov", _SECONDARY_REGISTER, str(2 * _BIT_WIDTH - 1))
+        builder.instruction("bsr", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+        builder.instruction("cmovz", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
+        builder.instruction("xor", _PRIMARY_REGISTER, str(_BIT_WIDTH - 1))
+    elif kind == BitsIntrinsicKind.CTZ:
+        builder.instruction("mov", _SECONDARY_REGISTER, str(_BIT_WIDTH))
+        builder.instruction("bsf", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+        builder.instruction("cmovz", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
+    elif kind == BitsIntrinsicKind.ROTL:
+        builder.instruction("rol", _PRIMARY_REGISTER, _SECONDARY_BYTE_REGISTER)
+    elif kind == BitsIntrinsicKind.ROTR:
+        builder.instruction("ror", _PRIMARY_REGISTER, _SECONDARY_BYTE_REGISTER)
+    elif kind == BitsIntrinsicKind.BSWAP:
+        builder.instruction("bswap", _PRIMARY_REGISTER)
+    else:
+        # One-operand mul leaves the 128-bit product in rdx:rax.
+        builder.instruction("mul", _SECONDARY_REGISTER)
+        builder.instruction("mov", _PRIMARY_REGISTER, "rdx")
+
+    emit_store_result(builder, instruction.dest, frame_layout=frame_layout)
+
+
+def _emit_popcount(builder: X86AsmBuilder, *, label_prefix: str) -> None:
+    fallback_label = f"{label_prefix}_fallback"
+    done_label = f"{label_prefix}_done"
+    builder.instruction("cmp", f"dword ptr [rip + {RT_CPU_HAS_POPCNT_SYMBOL}]", "0")
+    builder.instruction("je", fallback_label)
+    builder.instruction("popcnt", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+    builder.instruction("jmp", done_label)
+    builder.label(fallback_label)
+    builder.instruction("mov", _FIRST_ARGUMENT_REGISTER, _PRIMARY_REGISTER)
+    builder.instruction("call", BitsIntrinsicKind.POPCOUNT.runtime_fallback_call)
+    builder.label(done_label)
+
+
+__all__ = [
+    "emit_bits_intrinsic_instruction",
+]
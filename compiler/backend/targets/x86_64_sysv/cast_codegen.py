@@ -33,6 +33,7 @@ from compiler.backend.targets.x86_64_sysv.object_runtime import (
     interface_tables_operand,
     object_type_operand,
     type_debug_name_operand,
+    type_id_operand,
 )
 from compiler.common.collection_protocols import ArrayRuntimeKind
 from compiler.common.type_names import TYPE_NAME_BOOL, TYPE_NAME_DOUBLE, TYPE_NAME_NULL, TYPE_NAME_OBJ, TYPE_NAME_U64, TYPE_NAME_U8
@@ -50,6 +51,7 @@ _PRIMARY_REGISTER = "rax"
 _PRIMARY_BYTE_REGISTER = "al"
 _PRIMARY_FLOAT_REGISTER = "xmm0"
 _SECONDARY_REGISTER = "rcx"
+_SECONDARY_DWORD_REGISTER = "ecx"
 _SECONDARY_BYTE_REGISTER = "cl"
 _SECONDARY_FLOAT_REGISTER = "xmm1"
 _TERTIARY_REGISTER = "rdx"
@@ -199,7 +201,7 @@ def emit_type_test_instruction(
         _emit_interface_type_test(builder, instruction, callable_label=callable_label, program_context=program_context)
         emit_store_result(builder, instruction.dest, frame_layout=frame_layout)
         return
-    _emit_class_type_test(builder, instruction, program_context=program_context)
+    _emit_class_type_test(builder, instruction, callable_label=callable_label, program_context=program_context)
     emit_store_result(builder, instruction.dest, frame_layout=frame_layout)
 
 
@@ -334,6 +336,11 @@ def _emit_class_checked_cast(
     done_label = f".L{callable_label}_i{instruction.inst_id.ordinal}_class_cast_done"
     builder.instruction("test", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
     builder.instruction("je", done_label)
+    subtype_id_range = _subtype_id_range_for_target(instruction.target_type_ref, program_context=program_context)
+    if subtype_id_range is not None:
+        # A miss still calls the runtime, which reports the bad cast.
+        success_condition = _emit_subtype_id_range_compare(builder, subtype_id_range)
+        builder.instruction(f"j{success_condition}", done_label)
     builder.instruction("mov", "rdi", _PRIMARY_REGISTER)
     builder.instruction("lea", "rsi", f"[rip + {_type_symbol_for_target(instruction.target_type_ref, program_context=program_context)}]")
     builder.instruction("call", "rt_checked_cast")
@@ -344,11 +351,36 @@ def _emit_class_type_test(
     builder: X86AsmBuilder,
     instruction: BackendTypeTestInst,
     *,
+    callable_label: str,
     program_context: BackendProgramContext,
 ) -> None:
-    builder.instruction("mov", "rdi", _PRIMARY_REGISTER)
-    builder.instruction("lea", "rsi", f"[rip + {_type_symbol_for_target(instruction.target_type_ref, program_context=program_context)}]")
-    builder.instruction("call", "rt_is_instance_of_type")
+    subtype_id_range = _subtype_id_range_for_target(instruction.target_type_ref, program_context=program_context)
+    if subtype_id_range is None:
+        builder.instruction("mov", "rdi", _PRIMARY_REGISTER)
+        builder.instruction("lea", "rsi", f"[rip + {_type_symbol_for_target(instruction.target_type_ref, program_context=program_context)}]")
+        builder.instruction("call", "rt_is_instance_of_type")
+        return
+
+    done_label = f".L{callable_label}_i{instruction.inst_id.ordinal}_class_test_done"
+    builder.instruction("test", _PRIMARY_REGISTER, _PRIMARY_REGISTER)
+    builder.instruction("je", done_label)
+    success_condition = _emit_subtype_id_range_compare(builder, subtype_id_range)
+    builder.instruction(f"set{success_condition}", _PRIMARY_BYTE_REGISTER)
+    builder.instruction("movzx", _PRIMARY_REGISTER, _PRIMARY_BYTE_REGISTER)
+    builder.label(done_label)
+
+
+def _emit_subtype_id_range_compare(builder: X86AsmBuilder, subtype_id_range: tuple[int, int]) -> str:
+    """Compare the non-null object's type id against a class's preorder range; return the success condition."""
+    type_id, subtype_id_end = subtype_id_range
+    builder.instruction("mov", _SECONDARY_REGISTER, object_type_operand(_PRIMARY_REGISTER))
+    if subtype_id_end - type_id == 1:
+        builder.instruction("cmp", type_id_operand(_SECONDARY_REGISTER), str(type_id))
+        return "e"
+    builder.instruction("mov", _SECONDARY_DWORD_REGISTER, type_id_operand(_SECONDARY_REGISTER))
+    builder.instruction("sub", _SECONDARY_DWORD_REGISTER, str(type_id))
+    builder.instruction("cmp", _SECONDARY_DWORD_REGISTER, str(subtype_id_end - type_id))
+    return "b"
 
 
 def _emit_interface_checked_cast(
@@ -528,6 +560,14 @@ def _type_symbol_for_target(type_ref: SemanticTypeRef, *, program_context: Backe
     return mangle_type_symbol(semantic_type_canonical_name(type_ref))
 
 
+def _subtype_id_range_for_target(
+    type_ref: SemanticTypeRef, *, program_context: BackendProgramContext
+) -> tuple[int, int] | None:
+    if type_ref.class_id is None:
+        return None
+    return program_context.class_hierarchy.subtype_id_range(type_ref.class_id)
+
+
 def _type_name_symbol_for_target(type_ref: SemanticTypeRef, *, program_context: BackendProgramContext) -> str:
     if type_ref.interface_id is not None:
         return program_context.symbols.interface_symbols(type_ref.interface_id).name_symbol
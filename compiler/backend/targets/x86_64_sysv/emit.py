@@ -3,7 +3,9 @@ from __future__ import annotations
 import os
 from pathlib import Path
 
-from compiler.backend.program.symbols import epilogue_label
+from compiler.backend.program.runtime_layout import RT_LINE_TABLE_FLAG_FOLDS_CALLER
+from compiler.backend.program.intrinsics import bits_intrinsic_for_call, math_intrinsic_for_call
+from compiler.backend.program.symbols import epilogue_label, unframed_epilogue_label
 from compiler.backend.ir import (
     BackendAllocObjectInst,
     BackendArrayAllocInst,
@@ -70,6 +72,9 @@ from compiler.backend.targets.x86_64_sysv.array_codegen import (
     emit_bounds_check_instruction,
 )
 from compiler.backend.targets.x86_64_sysv.lower_calls import emit_call_instruction as emit_lowered_call_instruction
+from compiler.backend.targets.x86_64_sysv.lower_calls import emit_inline_cache_sites
+from compiler.backend.targets.x86_64_sysv.math_codegen import emit_math_intrinsic_instruction
+from compiler.backend.targets.x86_64_sysv.bits_codegen import emit_bits_intrinsic_instruction
 from compiler.backend.targets.x86_64_sysv.object_codegen import (
     emit_alloc_object_instruction,
     emit_field_load_instruction,
@@ -78,7 +83,14 @@ from compiler.backend.targets.x86_64_sysv.object_codegen import (
     emit_program_metadata_sections,
 )
 from compiler.backend.targets.x86_64_sysv.trace_codegen import (
+    LineTableRecord,
     TraceDebugRecord,
+    emit_function_profile_enter,
+    emit_function_profile_exit,
+    emit_function_profile_sites,
+    emit_line_table_end,
+    emit_line_table_mark,
+    emit_line_tables,
     emit_trace_debug_literals,
     emit_trace_location,
     emit_trace_pop,
@@ -110,6 +122,11 @@ def emit_x86_64_sysv_asm(target_input: BackendTargetInput, *, options: BackendTa
     builder = X86AsmBuilder(emit_debug_comments=options.emit_debug_comments)
     callable_by_id = {callable_decl.callable_id: callable_decl for callable_decl in target_input.program.callables}
     trace_records: list[TraceDebugRecord] = []
+    profile_records: list[TraceDebugRecord] = []
+    line_tables: list[LineTableRecord] | None = (
+        [] if options.runtime_trace_enabled and not options.shadow_trace_enabled else None
+    )
+    inline_cache_labels: list[str] | None = [] if options.inline_caches_enabled else None
     source_root = _common_source_root(target_input)
     builder.blank()
     builder.directive(".text")
@@ -126,6 +143,13 @@ def emit_x86_64_sysv_asm(target_input: BackendTargetInput, *, options: BackendTa
         )
         if trace_record is not None:
             trace_records.append(trace_record)
+        profile_record = (
+            _trace_record_for_callable(target_input, callable_decl, source_root=source_root)
+            if options.function_profile_enabled
+            else None
+        )
+        if profile_record is not None:
+            profile_records.append(profile_record)
         _emit_callable_body(
             builder,
             callable_decl,
@@ -136,12 +160,18 @@ def emit_x86_64_sysv_asm(target_input: BackendTargetInput, *, options: BackendTa
             callable_by_id=callable_by_id,
             emit_debug_comments=options.emit_debug_comments,
             trace_record=trace_record,
-            runtime_trace_enabled=options.runtime_trace_enabled,
+            shadow_trace_enabled=options.runtime_trace_enabled and options.shadow_trace_enabled,
+            line_tables=line_tables,
+            profile_record=profile_record,
+            inline_cache_labels=inline_cache_labels,
         )
 
     emit_program_metadata_sections(builder, program_context=target_input.program_context)
     emit_array_kind_name_literals(builder)
     emit_trace_debug_literals(builder, records=tuple(trace_records))
+    emit_function_profile_sites(builder, records=tuple(profile_records))
+    emit_line_tables(builder, records=() if line_tables is None else tuple(line_tables))
+    emit_inline_cache_sites(builder, labels=() if inline_cache_labels is None else tuple(inline_cache_labels))
 
     builder.blank()
     builder.directive('.section .note.GNU-stack,"",@progbits')
@@ -260,7 +290,10 @@ def _emit_callable_body(
     callable_by_id,
     emit_debug_comments: bool,
     trace_record,
-    runtime_trace_enabled: bool,
+    shadow_trace_enabled: bool,
+    line_tables: list[LineTableRecord] | None,
+    profile_record,
+    inline_cache_labels: list[str] | None,
 ) -> None:
     callable_analysis = target_input.analysis_for_callable(callable_decl.callable_id)
     callable_symbols = target_input.program_context.symbols.callable(callable_decl.callable_id)
@@ -277,15 +310,21 @@ def _emit_callable_body(
     }
     callable_label_for_calls = callable_symbols.emitted_label or callable_symbols.direct_call_symbol
 
+    active_line_table: LineTableRecord | None = None
+    location_hooks_enabled = shadow_trace_enabled or line_tables is not None
+
     def emit_location_hook(*, line: int, column: int) -> None:
-        emit_trace_location(builder, line=line, column=column)
+        if shadow_trace_enabled:
+            emit_trace_location(builder, line=line, column=column)
+        elif active_line_table is not None:
+            emit_line_table_mark(builder, active_line_table, line=line, column=column)
 
     def emit_safepoint_preamble(instruction) -> None:
         if frame_layout.has_root_frame:
             live_reg_ids = callable_analysis.safepoints.live_regs_for_instruction(instruction.inst_id)
             emit_root_slot_sync(builder, frame_layout=frame_layout, live_reg_ids=live_reg_ids)
         if (
-            runtime_trace_enabled
+            location_hooks_enabled
             and not isinstance(instruction, BackendCallInst)
             and instruction.effects.needs_safepoint_hooks
         ):
@@ -298,7 +337,29 @@ def _emit_callable_body(
         emit_root_slot_reload(builder, frame_layout=frame_layout, live_reg_ids=live_reg_ids)
 
     def emit_call_instruction(instruction: BackendCallInst) -> None:
-        if runtime_trace_enabled:
+        math_intrinsic = math_intrinsic_for_call(instruction)
+        if math_intrinsic is not None:
+            emit_math_intrinsic_instruction(
+                builder,
+                instruction,
+                math_intrinsic,
+                callable_label=callable_label_for_calls,
+                frame_layout=frame_layout,
+                register_type_name_by_reg_id=resolved_type_names,
+            )
+            return
+        bits_intrinsic = bits_intrinsic_for_call(instruction)
+        if bits_intrinsic is not None:
+            emit_bits_intrinsic_instruction(
+                builder,
+                instruction,
+                bits_intrinsic,
+                callable_label=callable_label_for_calls,
+                frame_layout=frame_layout,
+                register_type_name_by_reg_id=resolved_type_names,
+            )
+            return
+        if location_hooks_enabled:
             emit_location_hook(line=instruction.span.start.line, column=instruction.span.start.column)
         emit_lowered_call_instruction(
             builder,
@@ -312,9 +373,13 @@ def _emit_callable_body(
             callable_label=callable_label_for_calls,
             emit_safepoint_preamble=emit_safepoint_preamble,
             emit_safepoint_postamble=emit_safepoint_postamble,
+            inline_cache_labels=inline_cache_labels,
         )
 
     if callable_decl.kind == "constructor":
+        if line_tables is not None and trace_record is not None:
+            active_line_table = _line_table_for_code(callable_decl, trace_record, code_label=trace_record.target_label)
+            line_tables.append(active_line_table)
         _emit_constructor_entry_wrapper(
             builder,
             callable_decl,
@@ -322,22 +387,37 @@ def _emit_callable_body(
             frame_layout=frame_layout,
             register_type_name_by_reg_id=resolved_type_names,
             emit_call_instruction=emit_call_instruction,
-            emit_location_hook=emit_location_hook if runtime_trace_enabled else None,
+            emit_location_hook=emit_location_hook if location_hooks_enabled else None,
             trace_record=trace_record,
-            runtime_trace_enabled=runtime_trace_enabled,
+            shadow_trace_enabled=shadow_trace_enabled,
+            line_table=active_line_table,
+            profile_record=profile_record,
         )
         builder.blank()
         target_label = _constructor_init_label(target_input, callable_decl.callable_id)
         global_symbol = False
         alias_labels = ()
         body_trace_record = None
+        body_profile_record = None
     else:
         target_label = callable_symbols.emitted_label
         global_symbol = callable_symbols.global_label is not None
         alias_labels = callable_symbols.alias_labels
         body_trace_record = trace_record
+        body_profile_record = profile_record
+    if line_tables is not None and trace_record is not None:
+        # Constructor init bodies report under the wrapper's frame, as they do with the shadow trace.
+        active_line_table = _line_table_for_code(
+            callable_decl,
+            trace_record,
+            code_label=target_label,
+            flags=RT_LINE_TABLE_FLAG_FOLDS_CALLER if callable_decl.kind == "constructor" else 0,
+        )
+        line_tables.append(active_line_table)
 
     epilogue = epilogue_label(target_label)
+    unframed_epilogue = unframed_epilogue_label(target_label)
+    shrink_wrap = callable_analysis.shrink_wrap
     block_label_by_id = {
         block.block_id: _block_label(target_label, block.block_id.ordinal)
         for block in ordered_blocks
@@ -355,23 +435,37 @@ def _emit_callable_body(
         builder.instruction("sub", "rsp", str(frame_layout.stack_size))
 
     _emit_param_spills(builder, callable_decl, frame_layout=frame_layout)
-    if frame_layout.has_root_frame:
+    if frame_layout.has_root_frame and shrink_wrap.sets_up_root_frame_in_prologue():
         emit_zero_root_slots(builder, frame_layout=frame_layout)
         emit_root_frame_setup(builder, frame_layout=frame_layout)
-    if runtime_trace_enabled and body_trace_record is not None:
+    if shadow_trace_enabled and body_trace_record is not None:
         emit_trace_push(
             builder,
             body_trace_record,
             line=callable_decl.span.start.line,
             column=callable_decl.span.start.column,
         )
+    if body_profile_record is not None:
+        emit_function_profile_enter(builder, body_profile_record)
     if emit_debug_comments:
         for slot in frame_layout.slots:
             builder.comment(f"{slot.home_name} -> {format_stack_slot_operand('rbp', slot.byte_offset)}")
 
-    for block in ordered_blocks:
+    for block_index, block in enumerate(ordered_blocks):
         builder.label(block_label_by_id[block.block_id])
+        if frame_layout.has_root_frame and shrink_wrap.block_sets_up_root_frame(block.block_id):
+            emit_zero_root_slots(builder, frame_layout=frame_layout)
+            emit_root_frame_setup(builder, frame_layout=frame_layout)
         for instruction in block.instructions:
+            if active_line_table is not None:
+                # Marks cost nothing at run time, so every instruction gets one and inline panic
+                # checks report their own statement rather than the last call or safepoint.
+                emit_line_table_mark(
+                    builder,
+                    active_line_table,
+                    line=instruction.span.start.line,
+                    column=instruction.span.start.column,
+                )
             if isinstance(instruction, BackendAllocObjectInst):
                 emit_alloc_object_instruction(
                     builder,
@@ -432,6 +526,9 @@ def _emit_callable_body(
                     frame_layout=frame_layout,
                     register_type_name_by_reg_id=resolved_type_names,
                     options=options,
+                    bounds_check_proven=callable_analysis.induction_variables.access_is_in_bounds(
+                        instruction.inst_id
+                    ),
                 )
                 continue
             if isinstance(instruction, BackendArrayStoreInst):
@@ -443,6 +540,9 @@ def _emit_callable_body(
                     frame_layout=frame_layout,
                     register_type_name_by_reg_id=resolved_type_names,
                     options=options,
+                    bounds_check_proven=callable_analysis.induction_variables.access_is_in_bounds(
+                        instruction.inst_id
+                    ),
                 )
                 continue
             if isinstance(instruction, BackendArraySliceInst):
@@ -489,7 +589,16 @@ def _emit_callable_body(
             frame_layout=frame_layout,
             register_type_name_by_reg_id=resolved_type_names,
             block_label_by_id=block_label_by_id,
-            epilogue_label_text=epilogue,
+            fallthrough_label=(
+                block_label_by_id[ordered_blocks[block_index + 1].block_id]
+                if block_index + 1 < len(ordered_blocks)
+                else None
+            ),
+            epilogue_label_text=(
+                unframed_epilogue
+                if frame_layout.has_root_frame and shrink_wrap.return_skips_root_frame(block.block_id)
+                else epilogue
+            ),
             program_symbols=target_input.program_context.symbols,
         )
 
@@ -498,11 +607,28 @@ def _emit_callable_body(
         builder,
         callable_decl,
         frame_layout=frame_layout,
-        runtime_trace_enabled=runtime_trace_enabled and body_trace_record is not None,
+        root_frame_linked=frame_layout.has_root_frame,
+        shadow_trace_enabled=shadow_trace_enabled and body_trace_record is not None,
+        function_profile_enabled=body_profile_record is not None,
     )
     builder.instruction("mov", "rsp", "rbp")
     builder.instruction("pop", "rbp")
     builder.instruction("ret")
+    if frame_layout.has_root_frame and shrink_wrap.unframed_return_block_ids:
+        builder.label(unframed_epilogue)
+        _emit_runtime_epilogue_cleanup_preserving_return(
+            builder,
+            callable_decl,
+            frame_layout=frame_layout,
+            root_frame_linked=False,
+            shadow_trace_enabled=shadow_trace_enabled and body_trace_record is not None,
+            function_profile_enabled=body_profile_record is not None,
+        )
+        builder.instruction("mov", "rsp", "rbp")
+        builder.instruction("pop", "rbp")
+        builder.instruction("ret")
+    if active_line_table is not None:
+        emit_line_table_end(builder, active_line_table)
 
 
 def _emit_terminator(
@@ -512,6 +638,7 @@ def _emit_terminator(
     frame_layout,
     register_type_name_by_reg_id: dict,
     block_label_by_id: dict,
+    fallthrough_label: str | None,
     epilogue_label_text: str,
     program_symbols,
 ) -> None:
@@ -527,7 +654,12 @@ def _emit_terminator(
         )
         return
     if isinstance(terminator, BackendJumpTerminator):
-        emit_jump_terminator(builder, terminator, target_label=block_label_by_id[terminator.target_block_id])
+        emit_jump_terminator(
+            builder,
+            terminator,
+            target_label=block_label_by_id[terminator.target_block_id],
+            fallthrough_label=fallthrough_label,
+        )
         return
     if isinstance(terminator, BackendBranchTerminator):
         emit_branch_terminator(
@@ -537,6 +669,7 @@ def _emit_terminator(
             register_type_name_by_reg_id=register_type_name_by_reg_id,
             true_label=block_label_by_id[terminator.true_block_id],
             false_label=block_label_by_id[terminator.false_block_id],
+            fallthrough_label=fallthrough_label,
         )
         return
     raise BackendTargetLoweringError(
@@ -603,7 +736,9 @@ def _emit_constructor_entry_wrapper(
     emit_call_instruction,
     emit_location_hook,
     trace_record,
-    runtime_trace_enabled: bool,
+    shadow_trace_enabled: bool,
+    line_table: LineTableRecord | None,
+    profile_record,
 ) -> None:
     callable_symbols = target_input.program_context.symbols.callable(callable_decl.callable_id)
     target_label = callable_symbols.emitted_label
@@ -627,13 +762,15 @@ def _emit_constructor_entry_wrapper(
     if frame_layout.has_root_frame:
         emit_zero_root_slots(builder, frame_layout=frame_layout)
         emit_root_frame_setup(builder, frame_layout=frame_layout)
-    if runtime_trace_enabled and trace_record is not None:
+    if shadow_trace_enabled and trace_record is not None:
         emit_trace_push(
             builder,
             trace_record,
             line=callable_decl.span.start.line,
             column=callable_decl.span.start.column,
         )
+    if profile_record is not None:
+        emit_function_profile_enter(builder, profile_record)
     receiver_reg = callable_decl.receiver_reg
     if receiver_reg is None:
         raise BackendTargetLoweringError("constructor wrapper emission requires a receiver register")
@@ -679,11 +816,15 @@ def _emit_constructor_entry_wrapper(
         builder,
         callable_decl,
         frame_layout=frame_layout,
-        runtime_trace_enabled=runtime_trace_enabled and trace_record is not None,
+        root_frame_linked=frame_layout.has_root_frame,
+        shadow_trace_enabled=shadow_trace_enabled and trace_record is not None,
+        function_profile_enabled=profile_record is not None,
     )
     builder.instruction("mov", "rsp", "rbp")
     builder.instruction("pop", "rbp")
     builder.instruction("ret")
+    if line_table is not None:
+        emit_line_table_end(builder, line_table)
 
 
 def _trace_record_for_callable(target_input: BackendTargetInput, callable_decl, *, source_root: Path | None) -> TraceDebugRecord | None:
@@ -697,6 +838,16 @@ def _trace_record_for_callable(target_input: BackendTargetInput, callable_decl,
     )
 
 
+def _line_table_for_code(callable_decl, trace_record: TraceDebugRecord, *, code_label: str, flags: int = 0) -> LineTableRecord:
+    return LineTableRecord(
+        trace_record=trace_record,
+        code_label=code_label,
+        line=callable_decl.span.start.line,
+        column=callable_decl.span.start.column,
+        flags=flags,
+    )
+
+
 def _common_source_root(target_input: BackendTargetInput) -> Path | None:
     source_paths = [
         Path(callable_decl.span.start.path)
@@ -726,31 +877,41 @@ def _emit_runtime_epilogue_cleanup_preserving_return(
     callable_decl,
     *,
     frame_layout,
-    runtime_trace_enabled: bool,
+    root_frame_linked: bool,
+    shadow_trace_enabled: bool,
+    function_profile_enabled: bool,
 ) -> None:
+    if not (root_frame_linked or shadow_trace_enabled or function_profile_enabled):
+        return
     return_type = callable_decl.signature.return_type
     if return_type is None:
-        if frame_layout.has_root_frame:
+        if root_frame_linked:
             emit_root_frame_pop(builder, frame_layout=frame_layout)
-        if runtime_trace_enabled:
+        if function_profile_enabled:
+            emit_function_profile_exit(builder)
+        if shadow_trace_enabled:
             emit_trace_pop(builder)
         return
     return_type_name = semantic_type_canonical_name(return_type)
     if return_type_name == "double":
         builder.instruction("sub", "rsp", "16")
         builder.instruction("movq", "qword ptr [rsp]", "xmm0")
-        if frame_layout.has_root_frame:
+        if root_frame_linked:
             emit_root_frame_pop(builder, frame_layout=frame_layout)
-        if runtime_trace_enabled:
+        if function_profile_enabled:
+            emit_function_profile_exit(builder)
+        if shadow_trace_enabled:
             emit_trace_pop(builder)
         builder.instruction("movq", "xmm0", "qword ptr [rsp]")
         builder.instruction("add", "rsp", "16")
         return
     builder.instruction("sub", "rsp", "16")
     builder.instruction("mov", "qword ptr [rsp]", "rax")
-    if frame_layout.has_root_frame:
+    if root_frame_linked:
         emit_root_frame_pop(builder, frame_layout=frame_layout)
-    if runtime_trace_enabled:
+    if function_profile_enabled:
+        emit_function_profile_exit(builder)
+    if shadow_trace_enabled:
         emit_trace_pop(builder)
     builder.instruction("mov", "rax", "qword ptr [rsp]")
     builder.instruction("add", "rsp", "16")
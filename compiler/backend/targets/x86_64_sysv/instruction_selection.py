@@ -144,6 +144,7 @@ def emit_branch_terminator(
     register_type_name_by_reg_id: dict,
     true_label: str,
     false_label: str,
+    fallthrough_label: str | None = None,
 ) -> None:
     emit_load_operand(
         builder,
@@ -154,11 +155,27 @@ def emit_branch_terminator(
         register_type_name_by_reg_id=register_type_name_by_reg_id,
     )
     builder.instruction("cmp", _PRIMARY_REGISTER, "0")
+    # Block layout puts one successor right after the branch more often than not, so only the
+    # edge that leaves the layout order needs an explicit jump.
+    if true_label == fallthrough_label:
+        builder.instruction("je", false_label)
+        return
+    if false_label == fallthrough_label:
+        builder.instruction("jne", true_label)
+        return
     builder.instruction("je", false_label)
     builder.instruction("jmp", true_label)
 
 
-def emit_jump_terminator(builder: X86AsmBuilder, terminator: BackendJumpTerminator, *, target_label: str) -> None:
+def emit_jump_terminator(
+    builder: X86AsmBuilder,
+    terminator: BackendJumpTerminator,
+    *,
+    target_label: str,
+    fallthrough_label: str | None = None,
+) -> None:
+    if target_label == fallthrough_label:
+        return
     builder.instruction("jmp", target_label)
 
 
@@ -371,7 +388,12 @@ def _emit_float_unary_operation(builder: X86AsmBuilder, instruction: BackendUnar
 
 def _emit_binary_operation(builder: X86AsmBuilder, instruction: BackendBinaryInst, *, operand_type_name: str) -> None:
     if instruction.op.flavor == BinaryOpFlavor.INTEGER:
-        _emit_integer_binary_operation(builder, instruction.op.kind, operand_type_name=operand_type_name)
+        _emit_integer_binary_operation(
+            builder,
+            instruction.op.kind,
+            operand_type_name=operand_type_name,
+            shift_count_is_constant_in_range=_shift_count_is_constant_in_range(instruction, operand_type_name),
+        )
         return
 
     if instruction.op.flavor == BinaryOpFlavor.INTEGER_COMPARISON:
@@ -467,7 +489,13 @@ def _emit_float_binary_operation(builder: X86AsmBuilder, instruction: BackendBin
     builder.instruction("movzx", _PRIMARY_REGISTER, _PRIMARY_BYTE_REGISTER)
 
 
-def _emit_integer_binary_operation(builder: X86AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str) -> None:
+def _emit_integer_binary_operation(
+    builder: X86AsmBuilder,
+    kind: BinaryOpKind,
+    *,
+    operand_type_name: str,
+    shift_count_is_constant_in_range: bool = False,
+) -> None:
     if kind == BinaryOpKind.ADD:
         builder.instruction("add", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
         _mask_u8_result_if_needed(builder, operand_type_name)
@@ -480,6 +508,10 @@ def _emit_integer_binary_operation(builder: X86AsmBuilder, kind: BinaryOpKind, *
         builder.instruction("imul", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
         _mask_u8_result_if_needed(builder, operand_type_name)
         return
+    if kind == BinaryOpKind.MULTIPLY_HIGH:
+        builder.instruction("mul", _SECONDARY_REGISTER)
+        builder.instruction("mov", _PRIMARY_REGISTER, _TERTIARY_REGISTER)
+        return
     if kind == BinaryOpKind.POWER:
         _emit_integer_power(builder, operand_type_name=operand_type_name)
         return
@@ -490,7 +522,12 @@ def _emit_integer_binary_operation(builder: X86AsmBuilder, kind: BinaryOpKind, *
         _emit_integer_divide_or_remainder(builder, operand_type_name=operand_type_name, emit_remainder=True)
         return
     if kind in {BinaryOpKind.SHIFT_LEFT, BinaryOpKind.SHIFT_RIGHT}:
-        _emit_integer_shift(builder, kind, operand_type_name=operand_type_name)
+        _emit_integer_shift(
+            builder,
+            kind,
+            operand_type_name=operand_type_name,
+            check_shift_count=not shift_count_is_constant_in_range,
+        )
         return
     if kind == BinaryOpKind.BITWISE_AND:
         builder.instruction("and", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
@@ -551,12 +588,14 @@ def _emit_integer_divide_or_remainder(
     builder.instruction("sub", _PRIMARY_REGISTER, _QUATERNARY_REGISTER)
 
 
-def _emit_integer_shift(builder: X86AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str) -> None:
-    max_shift = "8" if operand_type_name == TYPE_NAME_U8 else "64"
-    builder.instruction("cmp", _SECONDARY_REGISTER, max_shift)
-    builder.instruction("jb", "1f")
-    builder.instruction("call", "rt_panic_invalid_shift_count")
-    builder.label("1")
+def _emit_integer_shift(
+    builder: X86AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str, check_shift_count: bool
+) -> None:
+    if check_shift_count:
+        builder.instruction("cmp", _SECONDARY_REGISTER, str(_shift_width(operand_type_name)))
+        builder.instruction("jb", "1f")
+        builder.instruction("call", "rt_panic_invalid_shift_count")
+        builder.label("1")
     if kind == BinaryOpKind.SHIFT_LEFT:
         builder.instruction("shl", _PRIMARY_REGISTER, _SECONDARY_BYTE_REGISTER)
         _mask_u8_result_if_needed(builder, operand_type_name)
@@ -567,6 +606,21 @@ def _emit_integer_shift(builder: X86AsmBuilder, kind: BinaryOpKind, *, operand_t
     builder.instruction("sar", _PRIMARY_REGISTER, _SECONDARY_BYTE_REGISTER)
 
 
+def _shift_width(operand_type_name: str) -> int:
+    return 8 if operand_type_name == TYPE_NAME_U8 else 64
+
+
+def _shift_count_is_constant_in_range(instruction: BackendBinaryInst, operand_type_name: str) -> bool:
+    if instruction.op.kind not in {BinaryOpKind.SHIFT_LEFT, BinaryOpKind.SHIFT_RIGHT}:
+        return False
+    right = instruction.right
+    return (
+        isinstance(right, BackendConstOperand)
+        and isinstance(right.constant, BackendIntConst)
+        and 0 <= right.constant.value < _shift_width(operand_type_name)
+    )
+
+
 def _emit_integer_comparison(builder: X86AsmBuilder, kind: BinaryOpKind, *, operand_type_name: str) -> None:
     builder.instruction("cmp", _PRIMARY_REGISTER, _SECONDARY_REGISTER)
     is_unsigned = operand_type_name in _UNSIGNED_TYPE_NAMES
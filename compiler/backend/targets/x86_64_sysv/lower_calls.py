@@ -24,11 +24,9 @@ from compiler.backend.targets.x86_64_sysv.instruction_selection import (
     emit_store_result,
 )
 from compiler.backend.targets.x86_64_sysv.object_runtime import (
+    class_interface_table_entry_byte_offset,
     class_vtable_entry_operand,
-    class_vtable_operand,
     interface_method_entry_operand,
-    interface_table_entry_operand,
-    interface_tables_operand,
     object_type_operand,
 )
 from compiler.semantic.symbols import ClassId
@@ -40,6 +38,12 @@ _CALL_TEMP_FLOAT_REGISTER = "xmm15"
 _CALL_TARGET_REGISTER = "r11"
 _CALL_TARGET_BYTE_REGISTER = "r11b"
 _CALL_LOOKUP_SCRATCH_REGISTER = "r10"
+# Free once every argument is in place: stack arguments are staged through it before the lookup runs.
+_INLINE_CACHE_MISS_SCRATCH_REGISTER = "rax"
+INLINE_CACHE_ENTRY_COUNT = 4
+INLINE_CACHE_ENTRY_SIZE_BYTES = 16
+# Stored over the first entry's type once a site has missed with every entry taken; no RtType lives at 1.
+INLINE_CACHE_MEGAMORPHIC_MARKER = 1
 _BYTE_REGISTER_BY_REGISTER = {
     "rax": "al",
     "rbx": "bl",
@@ -67,6 +71,7 @@ def emit_call_instruction(
     callable_label: str,
     emit_safepoint_preamble=None,
     emit_safepoint_postamble=None,
+    inline_cache_labels: list[str] | None = None,
     abi: X86_64SysVAbi = X86_64_SYSV_ABI,
 ) -> None:
     if not isinstance(
@@ -195,6 +200,7 @@ def emit_call_instruction(
         interface_method_slot_by_id=interface_method_slot_by_id,
         callable_label=callable_label,
         includes_receiver=includes_receiver,
+        inline_cache_labels=inline_cache_labels,
     )
 
     if call_stack_reservation_bytes > 0:
@@ -261,6 +267,7 @@ def _emit_call_target_invocation(
     interface_method_slot_by_id: dict,
     callable_label: str,
     includes_receiver: bool,
+    inline_cache_labels: list[str] | None,
 ) -> None:
     if isinstance(instruction.target, (BackendDirectCallTarget, BackendRuntimeCallTarget)):
         builder.instruction("call", _call_target_symbol(instruction, program_symbols, callee_decl, includes_receiver=includes_receiver))
@@ -280,81 +287,140 @@ def _emit_call_target_invocation(
         return
 
     if isinstance(instruction.target, BackendVirtualCallTarget):
-        _emit_virtual_call_target_lookup(builder, instruction=instruction, program_context=program_context)
-        builder.instruction("call", _CALL_TARGET_REGISTER)
-        return
+        slot_index = _virtual_slot_index(program_context, instruction)
 
-    if isinstance(instruction.target, BackendInterfaceCallTarget):
-        _emit_interface_call_target_lookup(
-            builder,
-            instruction=instruction,
-            program_context=program_context,
-            interface_method_slot_by_id=interface_method_slot_by_id,
+        def emit_table_lookup(type_register: str, lookup_register: str) -> None:
+            _emit_virtual_call_target_lookup(builder, slot_index=slot_index, type_register=type_register)
+
+    elif isinstance(instruction.target, BackendInterfaceCallTarget):
+        table_byte_offset = class_interface_table_entry_byte_offset(
+            _interface_slot_index(program_context, instruction.target.interface_id),
+            interface_slot_count=program_context.metadata.interface_slot_count,
         )
-        builder.instruction("call", _CALL_TARGET_REGISTER)
-        return
+        method_slot = _interface_method_slot(interface_method_slot_by_id, instruction)
 
-    raise BackendTargetLoweringError(
-        f"x86_64_sysv call lowering does not support target '{type(instruction.target).__name__}'"
-    )
+        def emit_table_lookup(type_register: str, lookup_register: str) -> None:
+            _emit_interface_call_target_lookup(
+                builder,
+                table_byte_offset=table_byte_offset,
+                method_slot=method_slot,
+                type_register=type_register,
+                lookup_register=lookup_register,
+            )
+
+    else:
+        raise BackendTargetLoweringError(
+            f"x86_64_sysv call lowering does not support target '{type(instruction.target).__name__}'"
+        )
 
+    builder.instruction("mov", _CALL_LOOKUP_SCRATCH_REGISTER, object_type_operand("rdi"))
+    if inline_cache_labels is None:
+        emit_table_lookup(_CALL_LOOKUP_SCRATCH_REGISTER, _CALL_LOOKUP_SCRATCH_REGISTER)
+    else:
+        cache_label = inline_cache_label(callable_label, instruction)
+        inline_cache_labels.append(cache_label)
+        _emit_inline_cache_lookup(builder, cache_label=cache_label, emit_table_lookup=emit_table_lookup)
+    builder.instruction("call", _CALL_TARGET_REGISTER)
+
+
+def inline_cache_label(callable_label: str, instruction: BackendCallInst) -> str:
+    return f".L{callable_label}_i{instruction.inst_id.ordinal}_ic"
+
+
+def _inline_cache_operand(cache_label: str, byte_offset: int) -> str:
+    if byte_offset == 0:
+        return f"qword ptr [rip + {cache_label}]"
+    return f"qword ptr [rip + {cache_label} + {byte_offset}]"
+
+
+def _emit_inline_cache_lookup(builder: X86AsmBuilder, *, cache_label: str, emit_table_lookup) -> None:
+    """Probe the site's (RtType*, target) entries, falling back to the tables and filling a free entry.
+
+    The receiver type is already in the lookup scratch register. Entries fill in
+    order and are never evicted; a miss with every entry taken marks the site
+    megamorphic, after which it skips the probes and goes straight to the tables.
+    """
+    hit_label = f"{cache_label}_hit"
+    miss_label = f"{cache_label}_miss"
+    full_label = f"{cache_label}_full"
+    megamorphic_label = f"{cache_label}_megamorphic"
+    builder.instruction("mov", _CALL_TARGET_REGISTER, _inline_cache_operand(cache_label, 8))
+    builder.instruction("cmp", _CALL_LOOKUP_SCRATCH_REGISTER, _inline_cache_operand(cache_label, 0))
+    builder.instruction("je", hit_label)
+    builder.instruction("cmp", _inline_cache_operand(cache_label, 0), str(INLINE_CACHE_MEGAMORPHIC_MARKER))
+    builder.instruction("je", megamorphic_label)
+    for entry_index in range(1, INLINE_CACHE_ENTRY_COUNT):
+        entry_offset = entry_index * INLINE_CACHE_ENTRY_SIZE_BYTES
+        builder.instruction("mov", _CALL_TARGET_REGISTER, _inline_cache_operand(cache_label, entry_offset + 8))
+        builder.instruction("cmp", _CALL_LOOKUP_SCRATCH_REGISTER, _inline_cache_operand(cache_label, entry_offset))
+        builder.instruction("je", hit_label)
+    builder.label(miss_label)
+    emit_table_lookup(_CALL_LOOKUP_SCRATCH_REGISTER, _INLINE_CACHE_MISS_SCRATCH_REGISTER)
+    for entry_index in range(INLINE_CACHE_ENTRY_COUNT):
+        entry_offset = entry_index * INLINE_CACHE_ENTRY_SIZE_BYTES
+        next_label = f"{cache_label}_fill{entry_index + 1}" if entry_index + 1 < INLINE_CACHE_ENTRY_COUNT else full_label
+        builder.instruction("cmp", _inline_cache_operand(cache_label, entry_offset), "0")
+        builder.instruction("jne", next_label)
+        builder.instruction("mov", _inline_cache_operand(cache_label, entry_offset + 8), _CALL_TARGET_REGISTER)
+        builder.instruction("mov", _inline_cache_operand(cache_label, entry_offset), _CALL_LOOKUP_SCRATCH_REGISTER)
+        builder.instruction("jmp", hit_label)
+        builder.label(next_label)
+    builder.instruction("mov", _inline_cache_operand(cache_label, 0), str(INLINE_CACHE_MEGAMORPHIC_MARKER))
+    builder.instruction("jmp", hit_label)
+    builder.label(megamorphic_label)
+    emit_table_lookup(_CALL_LOOKUP_SCRATCH_REGISTER, _CALL_LOOKUP_SCRATCH_REGISTER)
+    builder.label(hit_label)
+
+
+def emit_inline_cache_sites(builder: X86AsmBuilder, *, labels: tuple[str, ...]) -> None:
+    """Emit one zeroed inline cache per dispatch site: (RtType*, target) pairs."""
+    if not labels:
+        return
+    builder.blank()
+    builder.directive(".bss")
+    for label in labels:
+        builder.directive(".p2align 4")
+        builder.label(label)
+        builder.directive(f".zero {INLINE_CACHE_ENTRY_COUNT * INLINE_CACHE_ENTRY_SIZE_BYTES}")
 
-def _emit_virtual_call_target_lookup(
-    builder: X86AsmBuilder,
-    *,
-    instruction: BackendCallInst,
-    program_context: BackendProgramContext,
-) -> None:
+
+def _virtual_slot_index(program_context: BackendProgramContext, instruction: BackendCallInst) -> int:
     assert isinstance(instruction.target, BackendVirtualCallTarget)
     selected_method_class_id = ClassId(
         module_path=instruction.target.selected_method_id.module_path,
         name=instruction.target.selected_method_id.class_name,
     )
-    slot_index = program_context.class_hierarchy.resolve_virtual_slot_index(
+    return program_context.class_hierarchy.resolve_virtual_slot_index(
         selected_method_class_id,
         instruction.target.slot_owner_class_id,
         instruction.target.method_name,
     )
-    builder.instruction("mov", _CALL_LOOKUP_SCRATCH_REGISTER, object_type_operand("rdi"))
-    builder.instruction("mov", _CALL_LOOKUP_SCRATCH_REGISTER, class_vtable_operand(_CALL_LOOKUP_SCRATCH_REGISTER))
-    builder.instruction(
-        "mov",
-        _CALL_TARGET_REGISTER,
-        class_vtable_entry_operand(_CALL_LOOKUP_SCRATCH_REGISTER, slot_index),
-    )
 
 
-def _emit_interface_call_target_lookup(
-    builder: X86AsmBuilder,
-    *,
-    instruction: BackendCallInst,
-    program_context: BackendProgramContext,
-    interface_method_slot_by_id: dict,
-) -> None:
+def _interface_method_slot(interface_method_slot_by_id: dict, instruction: BackendCallInst) -> int:
     assert isinstance(instruction.target, BackendInterfaceCallTarget)
-    slot_index = _interface_slot_index(program_context, instruction.target.interface_id)
     try:
-        method_slot = interface_method_slot_by_id[instruction.target.method_id]
+        return interface_method_slot_by_id[instruction.target.method_id]
     except KeyError as exc:
         raise BackendTargetLoweringError(
             f"x86_64_sysv backend program context is missing interface method slot metadata for '{instruction.target.method_id}'"
         ) from exc
-    builder.instruction("mov", _CALL_LOOKUP_SCRATCH_REGISTER, object_type_operand("rdi"))
-    builder.instruction(
-        "mov",
-        _CALL_LOOKUP_SCRATCH_REGISTER,
-        interface_tables_operand(_CALL_LOOKUP_SCRATCH_REGISTER),
-    )
-    builder.instruction(
-        "mov",
-        _CALL_LOOKUP_SCRATCH_REGISTER,
-        interface_table_entry_operand(_CALL_LOOKUP_SCRATCH_REGISTER, slot_index),
-    )
-    builder.instruction(
-        "mov",
-        _CALL_TARGET_REGISTER,
-        interface_method_entry_operand(_CALL_LOOKUP_SCRATCH_REGISTER, method_slot),
-    )
+
+
+def _emit_virtual_call_target_lookup(builder: X86AsmBuilder, *, slot_index: int, type_register: str) -> None:
+    builder.instruction("mov", _CALL_TARGET_REGISTER, class_vtable_entry_operand(type_register, slot_index))
+
+
+def _emit_interface_call_target_lookup(
+    builder: X86AsmBuilder,
+    *,
+    table_byte_offset: int,
+    method_slot: int,
+    type_register: str,
+    lookup_register: str,
+) -> None:
+    builder.instruction("mov", lookup_register, format_stack_slot_operand(type_register, table_byte_offset))
+    builder.instruction("mov", _CALL_TARGET_REGISTER, interface_method_entry_operand(lookup_register, method_slot))
 
 
 def _interface_slot_index(program_context: BackendProgramContext, interface_id) -> int:
@@ -0,0 +1,129 @@
+"""Inline lowering of std.math intrinsics for the x86-64 SysV target.
+
+`sqrt`, `abs`, `min`, and `max` only need SSE2. `floor`, `ceil`, `trunc`, and `round` use SSE4.1
+`roundsd` once the runtime has detected it and otherwise call the matching `rt_math_*` wrapper, which
+runs that detection on first use. `min`/`max` keep the runtime's Java-like rules: any NaN
+operand yields the canonical quiet NaN and -0.0 orders below +0.0.
+"""
+
+from __future__ import annotations
+
+from compiler.backend.ir import BackendCallInst
+from compiler.backend.program.intrinsics import MathIntrinsicKind
+from compiler.backend.program.runtime_layout import RT_CPU_HAS_SSE41_SYMBOL
+from compiler.backend.targets.x86_64_sysv.asm import X86AsmBuilder
+from compiler.backend.targets.x86_64_sysv.frame import X86_64SysVFrameLayout
+from compiler.backend.targets.x86_64_sysv.instruction_selection import (
+    emit_load_float_operand,
+    emit_store_float_result,
+)
+
+
+_SCRATCH_REGISTER = "rax"
+_PRIMARY_FLOAT_REGISTER = "xmm0"
+_SECONDARY_FLOAT_REGISTER = "xmm1"
+_TERTIARY_FLOAT_REGISTER = "xmm2"
+
+_DOUBLE_SIGN_MASK = 0x8000000000000000
+_DOUBLE_ABS_MASK = 0x7FFFFFFFFFFFFFFF
+_DOUBLE_CANONICAL_NAN = 0x7FF8000000000000
+# The largest double below 0.5: adding it with the operand's sign and truncating rounds halfway cases
+# away from zero without the double rounding that adding exactly 0.5 causes just below a half.
+_DOUBLE_ROUND_BIAS = 0x3FDFFFFFFFFFFFFF
+
+# roundsd immediates: rounding mode in bits 0-1, bit 3 suppresses the inexact exception.
+_ROUNDSD_MODE_BY_KIND = {
+    MathIntrinsicKind.FLOOR: 9,
+    MathIntrinsicKind.CEIL: 10,
+    MathIntrinsicKind.TRUNC: 11,
+    MathIntrinsicKind.ROUND: 11,
+}
+
+
+def emit_math_intrinsic_instruction(
+    builder: X86AsmBuilder,
+    instruction: BackendCallInst,
+    kind: MathIntrinsicKind,
+    *,
+    callable_label: str,
+    frame_layout: X86_64SysVFrameLayout,
+    register_type_name_by_reg_id: dict,
+) -> None:
+    if instruction.dest is None:
+        return
+    float_registers = (_PRIMARY_FLOAT_REGISTER, _SECONDARY_FLOAT_REGISTER)
+    for operand, target_float_register in zip(instruction.args, float_registers[: kind.arity], strict=True):
+        emit_load_float_operand(
+            builder,
+            operand,
+            target_float_register=target_float_register,
+            frame_layout=frame_layout,
+            register_type_name_by_reg_id=register_type_name_by_reg_id,
+        )
+
+    label_prefix = f".L{callable_label}_i{instruction.inst_id.ordinal}_math"
+    if kind == MathIntrinsicKind.SQRT:
+        builder.instruction("sqrtsd", _PRIMARY_FLOAT_REGISTER, _PRIMARY_FLOAT_REGISTER)
+    elif kind == MathIntrinsicKind.ABS:
+        _emit_load_double_bits(builder, _SECONDARY_FLOAT_REGISTER, _DOUBLE_ABS_MASK)
+        builder.instruction("andpd", _PRIMARY_FLOAT_REGISTER, _SECONDARY_FLOAT_REGISTER)
+    elif kind in (MathIntrinsicKind.MIN, MathIntrinsicKind.MAX):
+        _emit_min_max(builder, kind, label_prefix=label_prefix)
+    else:
+        _emit_rounding(builder, kind, label_prefix=label_prefix)
+
+    emit_store_float_result(builder, instruction.dest, frame_layout=frame_layout)
+
+
+def _emit_rounding(builder: X86AsmBuilder, kind: MathIntrinsicKind, *, label_prefix: str) -> None:
+    fallback_label = f"{label_prefix}_fallback"
+    done_label = f"{label_prefix}_done"
+    builder.instruction("cmp", f"dword ptr [rip + {RT_CPU_HAS_SSE41_SYMBOL}]", "0")
+    builder.instruction("je", fallback_label)
+    if kind == MathIntrinsicKind.ROUND:
+        _emit_load_double_bits(builder, _SECONDARY_FLOAT_REGISTER, _DOUBLE_SIGN_MASK)
+        builder.instruction("andpd", _SECONDARY_FLOAT_REGISTER, _PRIMARY_FLOAT_REGISTER)
+        _emit_load_double_bits(builder, _TERTIARY_FLOAT_REGISTER, _DOUBLE_ROUND_BIAS)
+        builder.instruction("orpd", _SECONDARY_FLOAT_REGISTER, _TERTIARY_FLOAT_REGISTER)
+        builder.instruction("addsd", _PRIMARY_FLOAT_REGISTER, _SECONDARY_FLOAT_REGISTER)
+    builder.instruction("roundsd", _PRIMARY_FLOAT_REGISTER, _PRIMARY_FLOAT_REGISTER, str(_ROUNDSD_MODE_BY_KIND[kind]))
+    builder.instruction("jmp", done_label)
+    builder.label(fallback_label)
+    builder.instruction("call", kind.runtime_fallback_call)
+    builder.label(done_label)
+
+
+def _emit_min_max(builder: X86AsmBuilder, kind: MathIntrinsicKind, *, label_prefix: str) -> None:
+    ordered_label = f"{label_prefix}_ordered"
+    nan_label = f"{label_prefix}_nan"
+    done_label = f"{label_prefix}_done"
+    builder.instruction("ucomisd", _PRIMARY_FLOAT_REGISTER, _SECONDARY_FLOAT_REGISTER)
+    builder.instruction("jp", nan_label)
+    builder.instruction("jne", ordered_label)
+    # Equal operands differ at most in the sign of zero: OR keeps -0.0 for min, AND keeps +0.0 for max.
+    builder.instruction(
+        "orpd" if kind == MathIntrinsicKind.MIN else "andpd",
+        _PRIMARY_FLOAT_REGISTER,
+        _SECONDARY_FLOAT_REGISTER,
+    )
+    builder.instruction("jmp", done_label)
+    builder.label(nan_label)
+    _emit_load_double_bits(builder, _PRIMARY_FLOAT_REGISTER, _DOUBLE_CANONICAL_NAN)
+    builder.instruction("jmp", done_label)
+    builder.label(ordered_label)
+    builder.instruction(
+        "minsd" if kind == MathIntrinsicKind.MIN else "maxsd",
+        _PRIMARY_FLOAT_REGISTER,
+        _SECONDARY_FLOAT_REGISTER,
+    )
+    builder.label(done_label)
+
+
+def _emit_load_double_bits(builder: X86AsmBuilder, target_float_register: str, bits: int) -> None:
+    builder.instruction("movabs", _SCRATCH_REGISTER, f"0x{bits:016x}")
+    builder.instruction("movq", target_float_register, _SCRATCH_REGISTER)
+
+
+__all__ = [
+    "emit_math_intrinsic_instruction",
+]
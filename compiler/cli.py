@@ -1,6 +1,8 @@
 from __future__ import annotations
 
 import argparse
+import sys
+from contextlib import nullcontext
 from pathlib import Path
 from time import perf_counter
 
@@ -18,6 +20,12 @@ from compiler.backend.targets import (
     resolve_backend_target,
 )
 from compiler.common.logging import LOG_LEVEL_NAMES, configure_logging, get_logger, resolve_log_settings
+from compiler.common.opt_remarks import (
+    OptRemarkCollector,
+    collecting_opt_remarks,
+    render_opt_remarks_jsonl,
+    render_opt_remarks_summary,
+)
 from compiler.resolver import resolve_program
 from compiler.semantic.linker import link_semantic_program, require_main_function
 from compiler.semantic.lowering.orchestration import lower_program
@@ -110,7 +118,17 @@ def _flatten_disabled_optimization_names(disabled_pass_names: list[list[str]]) -
     return tuple(pass_name for pass_names in disabled_pass_names for pass_name in pass_names)
 
 
-def _optimize_program_phase(logger, lowered_program, *, disabled_pass_names: tuple[str, ...] = ()):
+def _opt_remark_scope(remark_collector: OptRemarkCollector | None):
+    return nullcontext() if remark_collector is None else collecting_opt_remarks(remark_collector)
+
+
+def _optimize_program_phase(
+    logger,
+    lowered_program,
+    *,
+    disabled_pass_names: tuple[str, ...] = (),
+    remark_collector: OptRemarkCollector | None = None,
+):
     logger.info("Optimizing semantic program")
     start = perf_counter()
     passes = _filter_optimization_passes(
@@ -118,7 +136,8 @@ def _optimize_program_phase(logger, lowered_program, *, disabled_pass_names: tup
         disabled_pass_names,
         label="semantic",
     )
-    optimized_program = optimize_semantic_program(lowered_program, passes=passes)
+    with _opt_remark_scope(remark_collector):
+        optimized_program = optimize_semantic_program(lowered_program, passes=passes)
     duration_ms = (perf_counter() - start) * 1000.0
     logger.debugv(1, "Optimized semantic program in %.2f ms", duration_ms)
     return optimized_program
@@ -139,13 +158,21 @@ def _emit_backend_target_assembly_phase(
     *,
     target_name: str | None,
     runtime_trace_enabled: bool,
+    shadow_trace_enabled: bool,
+    function_profile_enabled: bool,
+    inline_caches_enabled: bool,
 ) -> str:
     target = resolve_backend_target(target_name)
     logger.info("Emitting assembly via %s", target.name)
     start = perf_counter()
     emit_result = target.emit_assembly(
         BackendTargetInput.from_pipeline_result(pipeline_result),
-        options=BackendTargetOptions(runtime_trace_enabled=runtime_trace_enabled),
+        options=BackendTargetOptions(
+            runtime_trace_enabled=runtime_trace_enabled,
+            shadow_trace_enabled=shadow_trace_enabled,
+            function_profile_enabled=function_profile_enabled,
+            inline_caches_enabled=inline_caches_enabled,
+        ),
     )
     duration_ms = (perf_counter() - start) * 1000.0
     for diagnostic in emit_result.diagnostics:
@@ -163,7 +190,13 @@ def _lower_backend_ir_phase(logger, linked_program):
     return backend_program
 
 
-def _optimize_backend_ir_phase(logger, backend_program, *, disabled_pass_names: tuple[str, ...] = ()):
+def _optimize_backend_ir_phase(
+    logger,
+    backend_program,
+    *,
+    disabled_pass_names: tuple[str, ...] = (),
+    remark_collector: OptRemarkCollector | None = None,
+):
     logger.info("Optimizing backend IR")
     start = perf_counter()
     passes = _filter_optimization_passes(
@@ -171,16 +204,18 @@ def _optimize_backend_ir_phase(logger, backend_program, *, disabled_pass_names:
         disabled_pass_names,
         label="backend",
     )
-    optimized_program = optimize_backend_ir_program(backend_program, passes=passes)
+    with _opt_remark_scope(remark_collector):
+        optimized_program = optimize_backend_ir_program(backend_program, passes=passes)
     duration_ms = (perf_counter() - start) * 1000.0
     logger.debugv(1, "Optimized backend IR in %.2f ms", duration_ms)
     return optimized_program
 
 
-def _run_backend_ir_pipeline_phase(logger, backend_program):
+def _run_backend_ir_pipeline_phase(logger, backend_program, *, remark_collector: OptRemarkCollector | None = None):
     logger.info("Running backend IR passes")
     start = perf_counter()
-    pipeline_result = run_backend_ir_pipeline(backend_program)
+    with _opt_remark_scope(remark_collector):
+        pipeline_result = run_backend_ir_pipeline(backend_program)
     duration_ms = (perf_counter() - start) * 1000.0
     logger.debugv(1, "Ran backend IR pass pipeline in %.2f ms", duration_ms)
     return pipeline_result
@@ -266,6 +301,105 @@ def _publish_backend_ir_dump(
     print(rendered, end="" if rendered.endswith("\n") else "\n")
 
 
+def _write_opt_remarks(logger, remark_collector: OptRemarkCollector, args: argparse.Namespace) -> None:
+    input_path = Path(args.input)
+    remarks_path = Path(args.opt_remarks)
+    remarks_path.parent.mkdir(parents=True, exist_ok=True)
+    remarks_path.write_text(
+        render_opt_remarks_jsonl(
+            remark_collector.remarks,
+            project_root=_backend_ir_dump_project_root(input_path, args.project_root),
+        ),
+        encoding="utf-8",
+    )
+    logger.infov(1, "Wrote %d optimization remarks to %s", len(remark_collector.remarks), remarks_path)
+    sys.stderr.write(render_opt_remarks_summary(remark_collector.remarks))
+
+
+def _run_compiler_phases(logger, args: argparse.Namespace, remark_collector: OptRemarkCollector | None) -> int:
+    input_path = Path(args.input)
+
+    program = _resolve_program_graph(logger, input_path, args.project_root)
+    _typecheck_program_phase(logger, program)
+    lowered_program = _lower_program_phase(logger, program)
+    optimized_program = (
+        lowered_program
+        if args.disable_all_optimization
+        else _optimize_program_phase(
+            logger,
+            lowered_program,
+            disabled_pass_names=_flatten_disabled_optimization_names(args.disable_semantic_optimization),
+            remark_collector=remark_collector,
+        )
+    )
+    linked_program = _link_program_phase(logger, optimized_program)
+    require_main_function(linked_program)
+    if args.stop_after == "check":
+        return 0
+
+    dump_format = _requested_backend_ir_dump_format(args)
+    dump_project_root = _backend_ir_dump_project_root(input_path, args.project_root)
+    backend_program = _lower_backend_ir_phase(logger, linked_program)
+
+    if args.stop_after == "backend-ir":
+        _publish_backend_ir_dump(
+            logger,
+            backend_program,
+            input_path=input_path,
+            dump_format=dump_format,
+            dump_dir=args.dump_backend_ir_dir,
+            project_root=dump_project_root,
+        )
+        return 0
+
+    if args.dump_backend_ir_dir is not None:
+        _publish_backend_ir_dump(
+            logger,
+            backend_program,
+            input_path=input_path,
+            dump_format=dump_format,
+            dump_dir=args.dump_backend_ir_dir,
+            project_root=dump_project_root,
+        )
+
+    if not args.disable_all_optimization:
+        backend_program = _optimize_backend_ir_phase(
+            logger,
+            backend_program,
+            disabled_pass_names=_flatten_disabled_optimization_names(args.disable_backend_optimization),
+            remark_collector=remark_collector,
+        )
+    pipeline_result = _run_backend_ir_pipeline_phase(logger, backend_program, remark_collector=remark_collector)
+
+    if args.stop_after == "backend-ir-passes":
+        _publish_backend_ir_dump(
+            logger,
+            pipeline_result.program,
+            input_path=input_path,
+            dump_format=dump_format,
+            dump_dir=args.dump_backend_ir_dir,
+            project_root=dump_project_root,
+            preserve_block_order=True,
+        )
+        return 0
+
+    asm = _emit_backend_target_assembly_phase(
+        logger,
+        pipeline_result,
+        target_name=args.target,
+        runtime_trace_enabled=not args.omit_runtime_trace,
+        shadow_trace_enabled=args.shadow_runtime_trace,
+        function_profile_enabled=args.instrument_functions,
+        inline_caches_enabled=args.inline_caches,
+    )
+    if args.output:
+        Path(args.output).write_text(asm, encoding="utf-8")
+        logger.infov(1, "Wrote assembly to %s", args.output)
+    if args.print_asm or not args.output:
+        print(asm, end="" if asm.endswith("\n") else "\n")
+    return 0
+
+
 def main() -> int:
     parser = argparse.ArgumentParser(
         prog="nifc",
@@ -290,6 +424,11 @@ def main() -> int:
         metavar="DIR",
         help="Directory for deterministic whole-program backend IR dumps",
     )
+    output_group.add_argument(
+        "--opt-remarks",
+        metavar="FILE",
+        help="Write optimization remarks as JSON lines to FILE and print a per-function summary table to stderr",
+    )
 
     logging_group = parser.add_argument_group("Logging")
     logging_group.add_argument(
@@ -319,7 +458,28 @@ def main() -> int:
     compilation_group.add_argument(
         "--omit-runtime-trace",
         action="store_true",
-        help="Do not emit rt_trace_push/pop/set_location calls in generated assembly",
+        help="Do not emit panic stack trace metadata (PC line tables or shadow trace calls)",
+    )
+    compilation_group.add_argument(
+        "--shadow-runtime-trace",
+        action="store_true",
+        help=(
+            "Maintain panic stack traces with rt_trace_push/pop/set_location calls instead of "
+            "zero-cost PC line tables; locations follow the last executed call or safepoint"
+        ),
+    )
+    compilation_group.add_argument(
+        "--instrument-functions",
+        action="store_true",
+        help="Count calls and time spent in every callable; the program prints a flat profile to stderr at exit",
+    )
+    compilation_group.add_argument(
+        "--inline-caches",
+        action="store_true",
+        help=(
+            "Give every virtual and interface call site a cache of up to 4 (receiver type, target) pairs, "
+            "filled on a miss, in front of the type's dispatch tables"
+        ),
     )
     compilation_group.add_argument(
         "--disable-all-optimization",
@@ -349,83 +509,11 @@ def main() -> int:
 
     try:
         _validate_backend_ir_surface(args)
-
-        input_path = Path(args.input)
-
-        program = _resolve_program_graph(logger, input_path, args.project_root)
-        _typecheck_program_phase(logger, program)
-        lowered_program = _lower_program_phase(logger, program)
-        optimized_program = (
-            lowered_program
-            if args.disable_all_optimization
-            else _optimize_program_phase(
-                logger,
-                lowered_program,
-                disabled_pass_names=_flatten_disabled_optimization_names(args.disable_semantic_optimization),
-            )
-        )
-        linked_program = _link_program_phase(logger, optimized_program)
-        require_main_function(linked_program)
-        if args.stop_after == "check":
-            return 0
-
-        dump_format = _requested_backend_ir_dump_format(args)
-        dump_project_root = _backend_ir_dump_project_root(input_path, args.project_root)
-        backend_program = _lower_backend_ir_phase(logger, linked_program)
-
-        if args.stop_after == "backend-ir":
-            _publish_backend_ir_dump(
-                logger,
-                backend_program,
-                input_path=input_path,
-                dump_format=dump_format,
-                dump_dir=args.dump_backend_ir_dir,
-                project_root=dump_project_root,
-            )
-            return 0
-
-        if args.dump_backend_ir_dir is not None:
-            _publish_backend_ir_dump(
-                logger,
-                backend_program,
-                input_path=input_path,
-                dump_format=dump_format,
-                dump_dir=args.dump_backend_ir_dir,
-                project_root=dump_project_root,
-            )
-
-        if not args.disable_all_optimization:
-            backend_program = _optimize_backend_ir_phase(
-                logger,
-                backend_program,
-                disabled_pass_names=_flatten_disabled_optimization_names(args.disable_backend_optimization),
-            )
-        pipeline_result = _run_backend_ir_pipeline_phase(logger, backend_program)
-
-        if args.stop_after == "backend-ir-passes":
-            _publish_backend_ir_dump(
-                logger,
-                pipeline_result.program,
-                input_path=input_path,
-                dump_format=dump_format,
-                dump_dir=args.dump_backend_ir_dir,
-                project_root=dump_project_root,
-                preserve_block_order=True,
-            )
-            return 0
-
-        asm = _emit_backend_target_assembly_phase(
-            logger,
-            pipeline_result,
-            target_name=args.target,
-            runtime_trace_enabled=not args.omit_runtime_trace,
-        )
-        if args.output:
-            Path(args.output).write_text(asm, encoding="utf-8")
-            logger.infov(1, "Wrote assembly to %s", args.output)
-        if args.print_asm or not args.output:
-            print(asm, end="" if asm.endswith("\n") else "\n")
-        return 0
+        remark_collector = None if args.opt_remarks is None else OptRemarkCollector()
+        status = _run_compiler_phases(logger, args, remark_collector)
+        if remark_collector is not None:
+            _write_opt_remarks(logger, remark_collector, args)
+        return status
     except Exception as error:
         logger.error("%s", error)
         return 1
@@ -0,0 +1,169 @@
+from __future__ import annotations
+
+import json
+from collections.abc import Iterable, Iterator, Mapping
+from contextlib import contextmanager
+from dataclasses import dataclass, field
+from pathlib import Path
+
+from compiler.common.span import SourceSpan
+
+
+REMARK_APPLIED = "applied"
+REMARK_MISSED = "missed"
+
+
+@dataclass(frozen=True, slots=True)
+class OptRemark:
+    pass_name: str
+    status: str
+    callable_name: str | None
+    span: SourceSpan | None
+    reason: str
+
+
+@dataclass
+class OptRemarkCollector:
+    remarks: list[OptRemark] = field(default_factory=list)
+
+
+_active_collector: OptRemarkCollector | None = None
+
+
+@contextmanager
+def collecting_opt_remarks(collector: OptRemarkCollector) -> Iterator[OptRemarkCollector]:
+    """Route remarks published by optimization passes into `collector` for the duration of the block."""
+    global _active_collector
+    previous = _active_collector
+    _active_collector = collector
+    try:
+        yield collector
+    finally:
+        _active_collector = previous
+
+
+def opt_remarks_enabled() -> bool:
+    return _active_collector is not None
+
+
+def collected_opt_remarks() -> tuple[OptRemark, ...]:
+    """Remarks published into the active collector so far, in publication order."""
+    return () if _active_collector is None else tuple(_active_collector.remarks)
+
+
+class PassRemarks:
+    """Remarks buffered by one pass run; published only once the run's result is final.
+
+    Passes that re-run their transfer functions to a fixed point hand the trial runs a
+    `discarded()` buffer so speculative rewrites never show up as remarks.
+    """
+
+    __slots__ = ("pass_name", "enabled", "callable_name", "_local_names", "_remarks")
+
+    def __init__(self, pass_name: str, *, enabled: bool | None = None) -> None:
+        self.pass_name = pass_name
+        self.enabled = opt_remarks_enabled() if enabled is None else enabled
+        self.callable_name: str | None = None
+        self._local_names: Mapping[object, object] = {}
+        self._remarks: list[OptRemark] = []
+
+    @classmethod
+    def discarded(cls) -> PassRemarks:
+        return cls("", enabled=False)
+
+    def enter_callable(self, callable_id: object, local_info_by_id: Mapping[object, object] | None = None) -> None:
+        if not self.enabled:
+            return
+        self.callable_name = format_remark_callable(callable_id)
+        self._local_names = {} if local_info_by_id is None else local_info_by_id
+
+    def leave_callable(self) -> None:
+        self.callable_name = None
+        self._local_names = {}
+
+    def local_name(self, local_id: object) -> str:
+        local_info = self._local_names.get(local_id)
+        return "<local>" if local_info is None else getattr(local_info, "display_name", "<local>")
+
+    def applied(self, span: SourceSpan | None, reason: str) -> None:
+        if self.enabled:
+            self._remarks.append(OptRemark(self.pass_name, REMARK_APPLIED, self.callable_name, span, reason))
+
+    def missed(self, span: SourceSpan | None, reason: str) -> None:
+        if self.enabled:
+            self._remarks.append(OptRemark(self.pass_name, REMARK_MISSED, self.callable_name, span, reason))
+
+    def publish(self) -> None:
+        if self.enabled and _active_collector is not None:
+            _active_collector.remarks.extend(self._remarks)
+        self._remarks = []
+
+
+def format_remark_callable(callable_id: object) -> str:
+    module = ".".join(getattr(callable_id, "module_path", ()))
+    class_name = getattr(callable_id, "class_name", None)
+    if class_name is None:
+        return f"{module}::{getattr(callable_id, 'name')}"
+    ordinal = getattr(callable_id, "ordinal", None)
+    if ordinal is not None:
+        return f"{module}::{class_name}#{ordinal}"
+    return f"{module}::{class_name}.{getattr(callable_id, 'name')}"
+
+
+def render_opt_remarks_jsonl(remarks: Iterable[OptRemark], *, project_root: Path | None = None) -> str:
+    root = None if project_root is None else project_root.resolve()
+    lines = [
+        json.dumps(
+            {
+                "pass": remark.pass_name,
+                "status": remark.status,
+                "callable": remark.callable_name,
+                "span": _span_payload(remark.span, root),
+                "reason": remark.reason,
+            }
+        )
+        for remark in remarks
+    ]
+    return "".join(f"{line}\n" for line in lines)
+
+
+def render_opt_remarks_summary(remarks: Iterable[OptRemark]) -> str:
+    counts: dict[tuple[str, str], list[int]] = {}
+    for remark in remarks:
+        key = (remark.callable_name or "<global>", remark.pass_name)
+        row = counts.setdefault(key, [0, 0])
+        row[0 if remark.status == REMARK_APPLIED else 1] += 1
+
+    header = ("callable", "pass", "applied", "missed")
+    rows = [(callable_name, pass_name, str(row[0]), str(row[1])) for (callable_name, pass_name), row in sorted(counts.items())]
+    widths = [max(len(cells[index]) for cells in (header, *rows)) for index in range(len(header))]
+
+    def render_row(cells: tuple[str, ...]) -> str:
+        return (
+            f"{cells[0]:<{widths[0]}}  {cells[1]:<{widths[1]}}  {cells[2]:>{widths[2]}}  {cells[3]:>{widths[3]}}".rstrip()
+        )
+
+    return "".join(f"{render_row(cells)}\n" for cells in (header, *rows))
+
+
+def _span_payload(span: SourceSpan | None, project_root: Path | None) -> dict[str, object] | None:
+    if span is None:
+        return None
+    return {
+        "path": _remark_source_path(span.start.path, project_root),
+        "line": span.start.line,
+        "column": span.start.column,
+        "end_line": span.end.line,
+        "end_column": span.end.column,
+    }
+
+
+def _remark_source_path(path: str, project_root: Path | None) -> str:
+    normalized = path.replace("\\", "/")
+    raw_path = Path(path)
+    if project_root is None or not raw_path.is_absolute():
+        return normalized
+    try:
+        return raw_path.resolve().relative_to(project_root).as_posix()
+    except ValueError:
+        return normalized
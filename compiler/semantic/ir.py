@@ -564,6 +564,17 @@ class StringLiteralBytesExpr:
     )
 
 
+# A flattened `Str` `+` chain. Parts are string literal bytes, `Str` values, or i64/u64/double values that are
+# formatted straight into the single result buffer.
+@dataclass(frozen=True)
+class StrConcatExprS:
+    parts: list["SemanticExpr"]
+    constructor_id: ConstructorId
+    bytes_field_name: str
+    type_ref: SemanticTypeRef
+    span: SourceSpan
+
+
 SemanticStmt = (
     SemanticBlock
     | SemanticVarDecl
@@ -599,6 +610,7 @@ SemanticExpr = (
     | SliceReadExpr
     | ArrayCtorExprS
     | StringLiteralBytesExpr
+    | StrConcatExprS
 )
 
 
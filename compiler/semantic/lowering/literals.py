@@ -1,6 +1,7 @@
 from __future__ import annotations
 
 from collections.abc import Callable
+from dataclasses import replace
 
 from compiler.common.literals import IntLiteralKind, decode_char_literal, decode_string_literal
 from compiler.common.type_names import TYPE_NAME_I64
@@ -12,11 +13,16 @@ from compiler.semantic.types import semantic_primitive_type_ref
 from compiler.typecheck.constants import I64_MIN_MAGNITUDE_LITERAL
 from compiler.typecheck.context import TypeCheckContext
 from compiler.typecheck.expressions import infer_expression_type
-from compiler.semantic.lowering.ids import resolve_static_method_id
+from compiler.semantic.lowering.ids import constructor_id_from_type_name, resolve_static_method_id
+from compiler.semantic.symbols import ConstructorId, MethodId
+from compiler.typecheck.module_lookup import lookup_class_by_type_name
 
 
 LowerExpr = Callable[[object], SemanticExpr]
 
+_STRING_BYTES_FIELD_NAME = "_bytes"
+_INLINE_FORMAT_METHOD_NAMES = ("from_i64", "from_u64", "from_double")
+
 
 def lower_string_literal_expr(
     typecheck_ctx: TypeCheckContext, expr: LiteralExpr, result_type_name: str
@@ -43,20 +49,97 @@ def try_lower_string_concat_expr(
     result_type_ref: SemanticTypeRef,
     *,
     lower_expr: LowerExpr,
-) -> CallExprS | None:
-    left_type = infer_expression_type(typecheck_ctx, expr.left)
-    right_type = infer_expression_type(typecheck_ctx, expr.right)
-    if expr.operator != "+" or not is_str_type_name(left_type.name) or not is_str_type_name(right_type.name):
+) -> SemanticExpr | None:
+    if not _is_string_concat_expr(typecheck_ctx, expr):
         return None
 
-    return CallExprS(
-        target=StaticMethodCallTarget(method_id=resolve_static_method_id(typecheck_ctx, result_type_name, "concat")),
-        args=[lower_expr(expr.left), lower_expr(expr.right)],
+    class_info = lookup_class_by_type_name(typecheck_ctx, result_type_name)
+    constructor_id = None if class_info is None else _string_bytes_constructor_id(typecheck_ctx, class_info)
+    if constructor_id is None:
+        return CallExprS(
+            target=StaticMethodCallTarget(method_id=resolve_static_method_id(typecheck_ctx, result_type_name, "concat")),
+            args=[lower_expr(expr.left), lower_expr(expr.right)],
+            type_ref=result_type_ref,
+            span=expr.span,
+        )
+
+    from_u8_array_id = resolve_static_method_id(typecheck_ctx, result_type_name, "from_u8_array")
+    inline_format_ids = {
+        resolve_static_method_id(typecheck_ctx, result_type_name, method_name)
+        for method_name in _INLINE_FORMAT_METHOD_NAMES
+        if method_name in class_info.method_members
+    }
+    parts: list[SemanticExpr] = []
+    for operand in _flatten_string_concat_operands(typecheck_ctx, expr):
+        part = _string_concat_part(lower_expr(operand), from_u8_array_id, inline_format_ids)
+        previous = parts[-1] if parts else None
+        if isinstance(part, StringLiteralBytesExpr) and isinstance(previous, StringLiteralBytesExpr):
+            parts[-1] = StringLiteralBytesExpr(
+                literal_text=previous.literal_text[:-1] + part.literal_text[1:], span=previous.span
+            )
+            continue
+        parts.append(part)
+
+    if len(parts) == 1 and isinstance(parts[0], StringLiteralBytesExpr):
+        return CallExprS(
+            target=StaticMethodCallTarget(method_id=from_u8_array_id),
+            args=[replace(parts[0], span=expr.span)],
+            type_ref=result_type_ref,
+            span=expr.span,
+        )
+
+    return StrConcatExprS(
+        parts=parts,
+        constructor_id=constructor_id,
+        bytes_field_name=_STRING_BYTES_FIELD_NAME,
         type_ref=result_type_ref,
         span=expr.span,
     )
 
 
+def _is_string_concat_expr(typecheck_ctx: TypeCheckContext, expr: object) -> bool:
+    if not isinstance(expr, BinaryExpr) or expr.operator != "+":
+        return False
+    left_type = infer_expression_type(typecheck_ctx, expr.left)
+    right_type = infer_expression_type(typecheck_ctx, expr.right)
+    return is_str_type_name(left_type.name) and is_str_type_name(right_type.name)
+
+
+def _flatten_string_concat_operands(typecheck_ctx: TypeCheckContext, expr: BinaryExpr) -> list[object]:
+    operands: list[object] = []
+    for operand in (expr.left, expr.right):
+        if _is_string_concat_expr(typecheck_ctx, operand):
+            operands.extend(_flatten_string_concat_operands(typecheck_ctx, operand))
+        else:
+            operands.append(operand)
+    return operands
+
+
+def _string_concat_part(
+    lowered: SemanticExpr, from_u8_array_id: MethodId, inline_format_ids: set[MethodId]
+) -> SemanticExpr:
+    # Literal operands and `Str.from_i64(x)`-style conversions are written straight into the result buffer, so
+    # neither their temporary `u8[]` nor their temporary `Str` is ever allocated.
+    if not isinstance(lowered, CallExprS) or not isinstance(lowered.target, StaticMethodCallTarget):
+        return lowered
+    if lowered.target.method_id == from_u8_array_id and isinstance(lowered.args[0], StringLiteralBytesExpr):
+        return lowered.args[0]
+    if lowered.target.method_id in inline_format_ids:
+        return lowered.args[0]
+    return lowered
+
+
+def _string_bytes_constructor_id(typecheck_ctx: TypeCheckContext, class_info) -> ConstructorId | None:
+    bytes_field = class_info.fields.get(_STRING_BYTES_FIELD_NAME)
+    if bytes_field is None or bytes_field.name != "u8[]":
+        return None
+    for constructor in class_info.constructors:
+        if [param.name for param in constructor.params] == ["u8[]"]:
+            constructor_id = constructor_id_from_type_name(typecheck_ctx.module_path, class_info.type_name)
+            return replace(constructor_id, ordinal=constructor.ordinal)
+    return None
+
+
 def lower_non_string_literal_expr(typecheck_ctx: TypeCheckContext, expr: LiteralExpr) -> LiteralExprS:
     literal = expr.literal
     type_name = lowered_literal_type_name(typecheck_ctx, expr)
@@ -50,6 +50,9 @@ class BinaryOpKind(Enum):
     BITWISE_XOR = "bitwise_xor"
     SHIFT_LEFT = "shift_left"
     SHIFT_RIGHT = "shift_right"
+    # Backend-only: high 64 bits of the unsigned 128-bit product of the operand bit patterns. No source
+    # token produces it; backend strength reduction introduces it for division by constants.
+    MULTIPLY_HIGH = "multiply_high"
     LOGICAL_AND = "logical_and"
     LOGICAL_OR = "logical_or"
     EQUAL = "equal"
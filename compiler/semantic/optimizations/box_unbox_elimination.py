@@ -0,0 +1,295 @@
+from __future__ import annotations
+
+from dataclasses import dataclass, field, replace
+
+from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
+from compiler.semantic.ir import *
+from compiler.semantic.operations import CastSemanticsKind
+from compiler.semantic.types import semantic_type_canonical_name, semantic_type_ref_for_class_id
+
+from .helpers.assigned_locals import assigned_local_ids_in_block
+from .helpers.local_usage import is_pure_expr, read_locals_expr
+from .helpers.semantic_rewriter import SemanticTreeRewriter
+from .helpers.type_compatibility import (
+    TypeCompatibilityIndex,
+    build_type_compatibility_index,
+    exact_type_implies_runtime_compatibility,
+)
+
+
+_STD_BOX_MODULE_PATH = ("std", "box")
+# std.box factories that return a box whose `val` is their argument, either shared from the box cache or fresh.
+_STD_BOX_FACTORY_METHOD_IDS = frozenset(
+    MethodId(module_path=_STD_BOX_MODULE_PATH, class_name=class_name, name="of")
+    for class_name in ("BoxI64", "BoxU64", "BoxU8", "BoxBool")
+)
+_BOX_VALUE_FIELD_NAME = "val"
+
+
+@dataclass(frozen=True)
+class _FieldConstructorShape:
+    class_id: ClassId
+    param_index_by_field_name: dict[str, int]
+    final_field_names: frozenset[str]
+    has_pure_field_initializers: bool
+
+
+@dataclass(frozen=True)
+class _BoxedValue:
+    class_id: ClassId
+    field_values: dict[str, SemanticExpr]
+    final_field_names: frozenset[str]
+    has_pure_field_initializers: bool
+    # True when dropping the construction loses nothing but an allocation.
+    is_discardable: bool
+
+
+@dataclass
+class _BoxUnboxStats:
+    forwarded_field_reads: int = 0
+    removed_box_declarations: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
+
+
+class _BoxUnboxEliminator(SemanticTreeRewriter):
+    def __init__(
+        self,
+        shape_by_constructor_id: dict[ConstructorId, _FieldConstructorShape],
+        compatibility_index: TypeCompatibilityIndex,
+        stats: _BoxUnboxStats,
+    ) -> None:
+        self._shape_by_constructor_id = shape_by_constructor_id
+        self._compatibility_index = compatibility_index
+        self._stats = stats
+        self._assigned_local_ids: set[LocalId] = set()
+        self._boxed_value_by_local_id: dict[LocalId, _BoxedValue] = {}
+
+    def rewrite_function(self, fn: SemanticFunction) -> SemanticFunction:
+        if fn.body is None:
+            return fn
+        self._stats.remarks.enter_callable(fn.function_id, fn.local_info_by_id)
+        rewritten = replace(fn, body=self._rewrite_callable_body(fn.body))
+        self._stats.remarks.leave_callable()
+        return rewritten
+
+    def rewrite_method(self, method: SemanticMethod) -> SemanticMethod:
+        self._stats.remarks.enter_callable(method.method_id, method.local_info_by_id)
+        rewritten = replace(method, body=self._rewrite_callable_body(method.body))
+        self._stats.remarks.leave_callable()
+        return rewritten
+
+    def _rewrite_callable_body(self, body: SemanticBlock) -> SemanticBlock:
+        self._assigned_local_ids = assigned_local_ids_in_block(body)
+        self._boxed_value_by_local_id = {}
+        rewritten_body = self.rewrite_block(body)
+
+        discardable_local_ids = {
+            local_id for local_id, boxed in self._boxed_value_by_local_id.items() if boxed.is_discardable
+        }
+        if not discardable_local_ids:
+            return rewritten_body
+        dead_local_ids = discardable_local_ids - _LocalReadCollector.read_local_ids(rewritten_body)
+        if not dead_local_ids:
+            return rewritten_body
+        return _DeadBoxDeclarationPruner(dead_local_ids, self._stats).rewrite_block(rewritten_body)
+
+    def transform_stmt(self, stmt: SemanticStmt) -> SemanticStmt:
+        # Statements are rewritten in program order, so a box local is known before any read of it.
+        if isinstance(stmt, SemanticVarDecl) and stmt.local_id not in self._assigned_local_ids:
+            boxed = self._stable_boxed_value(stmt.initializer)
+            if boxed is not None:
+                self._boxed_value_by_local_id[stmt.local_id] = boxed
+        return stmt
+
+    def transform_expr(self, expr: SemanticExpr) -> SemanticExpr:
+        if not isinstance(expr, FieldReadExpr):
+            return expr
+
+        receiver = self._strip_successful_casts(expr.receiver)
+        boxed = self._boxed_value(receiver)
+        if boxed is not None:
+            # Reading a field of a fresh object drops the construction, so everything else it evaluates must be pure.
+            if not boxed.has_pure_field_initializers or not all(
+                is_pure_expr(value) for name, value in boxed.field_values.items() if name != expr.field_name
+            ):
+                return expr
+        elif isinstance(receiver, LocalRefExpr):
+            boxed = self._boxed_value_by_local_id.get(receiver.local_id)
+        if boxed is None or boxed.class_id != expr.owner_class_id:
+            return expr
+
+        value = boxed.field_values.get(expr.field_name)
+        if value is None:
+            return expr
+        if semantic_type_canonical_name(expression_type_ref(value)) != semantic_type_canonical_name(expr.type_ref):
+            return expr
+
+        self._stats.forwarded_field_reads += 1
+        self._stats.remarks.applied(expr.span, f"read of '{expr.field_name}' forwarded from the boxed value")
+        return value
+
+    def _strip_successful_casts(self, expr: SemanticExpr) -> SemanticExpr:
+        while isinstance(expr, CastExprS):
+            if expr.cast_kind is CastSemanticsKind.IDENTITY:
+                expr = expr.operand
+                continue
+            if expr.cast_kind is not CastSemanticsKind.REFERENCE_COMPATIBILITY:
+                return expr
+            class_id = self._exact_box_class_id(expr.operand)
+            if class_id is None or not exact_type_implies_runtime_compatibility(
+                self._compatibility_index, semantic_type_ref_for_class_id(class_id), expr.target_type_ref
+            ):
+                return expr
+            expr = expr.operand
+        return expr
+
+    def _exact_box_class_id(self, expr: SemanticExpr) -> ClassId | None:
+        expr = self._strip_successful_casts(expr)
+        boxed = self._boxed_value(expr)
+        if boxed is None and isinstance(expr, LocalRefExpr):
+            boxed = self._boxed_value_by_local_id.get(expr.local_id)
+        return None if boxed is None else boxed.class_id
+
+    def _boxed_value(self, expr: SemanticExpr) -> _BoxedValue | None:
+        if not isinstance(expr, CallExprS):
+            return None
+
+        if isinstance(expr.target, ConstructorCallTarget):
+            shape = self._shape_by_constructor_id.get(expr.target.constructor_id)
+            if shape is None:
+                return None
+            return _BoxedValue(
+                class_id=shape.class_id,
+                field_values={name: expr.args[index] for name, index in shape.param_index_by_field_name.items()},
+                final_field_names=shape.final_field_names,
+                has_pure_field_initializers=shape.has_pure_field_initializers,
+                is_discardable=shape.has_pure_field_initializers and all(is_pure_expr(arg) for arg in expr.args),
+            )
+
+        if isinstance(expr.target, StaticMethodCallTarget) and expr.target.method_id in _STD_BOX_FACTORY_METHOD_IDS:
+            method_id = expr.target.method_id
+            return _BoxedValue(
+                class_id=ClassId(module_path=method_id.module_path, name=method_id.class_name),
+                field_values={_BOX_VALUE_FIELD_NAME: expr.args[0]},
+                final_field_names=frozenset({_BOX_VALUE_FIELD_NAME}),
+                has_pure_field_initializers=True,
+                is_discardable=is_pure_expr(expr.args[0]),
+            )
+
+        return None
+
+    def _stable_boxed_value(self, initializer: SemanticExpr | None) -> _BoxedValue | None:
+        if initializer is None:
+            return None
+        boxed = self._boxed_value(self._strip_upcasts(initializer))
+        if boxed is None:
+            return None
+
+        # A later read sees the value the box was built from only when the field cannot be written through an
+        # alias and re-evaluating the argument cannot observe a different value.
+        stable_field_values = {
+            name: value
+            for name, value in boxed.field_values.items()
+            if name in boxed.final_field_names and self._is_stable_expr(value)
+        }
+        if not stable_field_values and not boxed.is_discardable:
+            return None
+        return replace(boxed, field_values=stable_field_values)
+
+    def _strip_upcasts(self, expr: SemanticExpr) -> SemanticExpr:
+        if not isinstance(expr, CastExprS):
+            return expr
+        operand = self._strip_upcasts(expr.operand)
+        boxed = self._boxed_value(operand)
+        if boxed is None:
+            return expr
+        if expr.cast_kind is not CastSemanticsKind.IDENTITY and not exact_type_implies_runtime_compatibility(
+            self._compatibility_index, semantic_type_ref_for_class_id(boxed.class_id), expr.target_type_ref
+        ):
+            return expr
+        return operand
+
+    def _is_stable_expr(self, expr: SemanticExpr) -> bool:
+        return is_pure_expr(expr) and not (read_locals_expr(expr) & self._assigned_local_ids)
+
+
+class _LocalReadCollector(SemanticTreeRewriter):
+    def __init__(self) -> None:
+        self.local_ids: set[LocalId] = set()
+
+    @classmethod
+    def read_local_ids(cls, block: SemanticBlock) -> set[LocalId]:
+        collector = cls()
+        collector.rewrite_block(block)
+        return collector.local_ids
+
+    def transform_expr(self, expr: SemanticExpr) -> SemanticExpr:
+        if isinstance(expr, LocalRefExpr):
+            self.local_ids.add(expr.local_id)
+        return expr
+
+
+class _DeadBoxDeclarationPruner(SemanticTreeRewriter):
+    def __init__(self, dead_local_ids: set[LocalId], stats: _BoxUnboxStats) -> None:
+        self._dead_local_ids = dead_local_ids
+        self._stats = stats
+
+    def rewrite_block(self, block: SemanticBlock) -> SemanticBlock:
+        statements: list[SemanticStmt] = []
+        for stmt in block.statements:
+            if isinstance(stmt, SemanticVarDecl) and stmt.local_id in self._dead_local_ids:
+                self._stats.removed_box_declarations += 1
+                self._stats.remarks.applied(
+                    stmt.span,
+                    f"box '{self._stats.remarks.local_name(stmt.local_id)}' removed: every read was forwarded",
+                )
+                continue
+            statements.append(self.rewrite_stmt(stmt))
+        return replace(block, statements=statements)
+
+
+def box_unbox_elimination(program: SemanticProgram) -> SemanticProgram:
+    logger = get_logger(__name__)
+    stats = _BoxUnboxStats(remarks=PassRemarks("box_unbox_elimination"))
+    optimized_program = _BoxUnboxEliminator(
+        _build_field_constructor_shapes(program), build_type_compatibility_index(program), stats
+    ).rewrite_program(program)
+    stats.remarks.publish()
+    logger.debugv(
+        1,
+        "Optimization pass box_unbox_elimination forwarded %d field reads and removed %d box declarations",
+        stats.forwarded_field_reads,
+        stats.removed_box_declarations,
+    )
+    return optimized_program
+
+
+def _build_field_constructor_shapes(program: SemanticProgram) -> dict[ConstructorId, _FieldConstructorShape]:
+    # Only compiler-generated constructors of root classes: they store each argument in the field of the same
+    # name and run nothing else, so the fields of a fresh object are known from the call alone.
+    shapes: dict[ConstructorId, _FieldConstructorShape] = {}
+    for module in program.modules.values():
+        for cls in module.classes:
+            if cls.superclass_id is not None:
+                continue
+            field_names = {class_field.name for class_field in cls.fields}
+            for constructor in cls.constructors:
+                if constructor.body is not None or constructor.super_constructor_id is not None:
+                    continue
+                param_index_by_field_name = {
+                    param.name: index for index, param in enumerate(constructor.params) if param.name in field_names
+                }
+                shapes[constructor.constructor_id] = _FieldConstructorShape(
+                    class_id=cls.class_id,
+                    param_index_by_field_name=param_index_by_field_name,
+                    final_field_names=frozenset(
+                        class_field.name for class_field in cls.fields if class_field.is_final
+                    ),
+                    has_pure_field_initializers=all(
+                        class_field.initializer is None or is_pure_expr(class_field.initializer)
+                        for class_field in cls.fields
+                        if class_field.name not in param_index_by_field_name
+                    ),
+                )
+    return shapes
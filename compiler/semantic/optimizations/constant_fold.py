@@ -204,6 +204,8 @@ def _fold_expr(expr: SemanticExpr, env: _ConstantEnv, stats: _FoldStats) -> Sema
         )
     if isinstance(expr, ArrayCtorExprS):
         return replace(expr, length_expr=_fold_expr(expr.length_expr, env, stats))
+    if isinstance(expr, StrConcatExprS):
+        return replace(expr, parts=[_fold_expr(part, env, stats) for part in expr.parts])
     if isinstance(expr, StringLiteralBytesExpr):
         return expr
     raise TypeError(f"Unsupported semantic expression for constant folding: {type(expr).__name__}")
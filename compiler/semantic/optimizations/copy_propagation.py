@@ -326,6 +326,9 @@ def _propagate_expr(
     if isinstance(expr, ArrayCtorExprS):
         return replace(expr, length_expr=_propagate_expr(expr.length_expr, state, owner, stats))
 
+    if isinstance(expr, StrConcatExprS):
+        return replace(expr, parts=[_propagate_expr(part, state, owner, stats) for part in expr.parts])
+
     raise TypeError(f"Unsupported semantic expression for copy propagation: {type(expr).__name__}")
 
 
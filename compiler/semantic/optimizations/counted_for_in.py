@@ -0,0 +1,437 @@
+from __future__ import annotations
+
+from dataclasses import dataclass, field, fields, replace
+
+from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
+from compiler.common.span import SourceSpan
+from compiler.common.type_names import TYPE_NAME_BOOL, TYPE_NAME_I64
+from compiler.semantic.ir import *
+from compiler.semantic.operations import BinaryOpFlavor, BinaryOpKind
+from compiler.semantic.types import (
+    semantic_primitive_type_ref,
+    semantic_type_canonical_name,
+    semantic_type_is_interface,
+)
+
+from .helpers.semantic_rewriter import SemanticTreeRewriter
+
+
+_I64_TYPE_REF = semantic_primitive_type_ref(TYPE_NAME_I64)
+_BOOL_TYPE_REF = semantic_primitive_type_ref(TYPE_NAME_BOOL)
+_I64_LESS_THAN = SemanticBinaryOp(kind=BinaryOpKind.LESS_THAN, flavor=BinaryOpFlavor.INTEGER_COMPARISON)
+_I64_ADD = SemanticBinaryOp(kind=BinaryOpKind.ADD, flavor=BinaryOpFlavor.INTEGER)
+
+
+@dataclass
+class _CountedForInStats:
+    counted_loops: int = 0
+    scalarized_collections: int = 0
+    skipped_dynamic_dispatch: int = 0
+    skipped_non_inlinable_methods: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
+
+
+@dataclass(frozen=True)
+class _ProgramMembers:
+    methods: dict[MethodId, SemanticMethod]
+    classes: dict[ClassId, SemanticClass]
+    constructors: dict[ConstructorId, SemanticConstructor]
+
+
+class _NotInlinable(Exception):
+    pass
+
+
+def counted_for_in(program: SemanticProgram) -> SemanticProgram:
+    logger = get_logger(__name__)
+    stats = _CountedForInStats(remarks=PassRemarks("counted_for_in"))
+    optimized_program = _CountedForInLowerer(_index_program_members(program), stats).rewrite_program(program)
+    stats.remarks.publish()
+    logger.debugv(
+        1,
+        "Optimization pass counted_for_in lowered %d for-in loops to counted loops (%d scalarized collections), skipped %d dynamic dispatches and %d non-inlinable protocol methods",
+        stats.counted_loops,
+        stats.scalarized_collections,
+        stats.skipped_dynamic_dispatch,
+        stats.skipped_non_inlinable_methods,
+    )
+    return optimized_program
+
+
+class _CountedForInLowerer(SemanticTreeRewriter):
+    """Rewrite statically dispatched for-in loops into plain counted while loops.
+
+    When both protocol methods resolve to known bodies made only of `return` and `if` guards,
+    `iter_len` is inlined once ahead of the loop and `iter_get` is inlined per iteration, so the
+    loop runs without protocol calls. A collection built in place by a field constructor is never
+    allocated: its fields are bound to locals instead. Arrays keep their direct runtime lowering.
+    """
+
+    def __init__(self, members: _ProgramMembers, stats: _CountedForInStats) -> None:
+        self._members = members
+        self._stats = stats
+        self._owner_id: LocalOwnerId | None = None
+        self._next_local_ordinal = 0
+        self._new_local_infos: dict[LocalId, SemanticLocalInfo] = {}
+
+    def rewrite_function(self, fn: SemanticFunction) -> SemanticFunction:
+        if fn.body is None:
+            return fn
+        self._enter_owner(fn.function_id, fn.local_info_by_id)
+        rewritten = super().rewrite_function(fn)
+        return replace(rewritten, local_info_by_id=self._leave_owner(fn.local_info_by_id))
+
+    def rewrite_method(self, method: SemanticMethod) -> SemanticMethod:
+        self._enter_owner(method.method_id, method.local_info_by_id)
+        rewritten = super().rewrite_method(method)
+        return replace(rewritten, local_info_by_id=self._leave_owner(method.local_info_by_id))
+
+    def transform_stmt(self, stmt: SemanticStmt) -> SemanticStmt:
+        if not isinstance(stmt, SemanticForIn):
+            return stmt
+        len_method = self._static_protocol_method(stmt, stmt.iter_len_dispatch)
+        get_method = self._static_protocol_method(stmt, stmt.iter_get_dispatch)
+        if len_method is None or get_method is None:
+            return stmt
+        if not _is_inlinable_protocol_pair(len_method, get_method, stmt.element_type_ref):
+            self._stats.skipped_non_inlinable_methods += 1
+            self._stats.remarks.missed(stmt.span, "for-in kept on protocol calls: iter_len/iter_get bodies are not inlinable")
+            return stmt
+
+        checkpoint = (self._next_local_ordinal, dict(self._new_local_infos))
+        constructor = self._scalarizable_constructor(stmt.collection)
+        if constructor is not None:
+            try:
+                lowered = self._lower_counted_loop(stmt, len_method, get_method, constructor)
+            except _NotInlinable:
+                self._next_local_ordinal, self._new_local_infos = checkpoint
+            else:
+                self._stats.scalarized_collections += 1
+                self._record_counted_loop(stmt, "collection fields bound to locals")
+                return lowered
+        try:
+            lowered = self._lower_counted_loop(stmt, len_method, get_method, None)
+        except _NotInlinable:
+            self._next_local_ordinal, self._new_local_infos = checkpoint
+            self._stats.skipped_non_inlinable_methods += 1
+            self._stats.remarks.missed(stmt.span, "for-in kept on protocol calls: iter_len/iter_get read foreign locals")
+            return stmt
+        self._record_counted_loop(stmt, "collection bound once")
+        return lowered
+
+    def _record_counted_loop(self, stmt: SemanticForIn, detail: str) -> None:
+        self._stats.counted_loops += 1
+        self._stats.remarks.applied(stmt.span, f"for-in lowered to a counted loop with inlined iter_len/iter_get: {detail}")
+
+    def _static_protocol_method(self, stmt: SemanticForIn, dispatch: SemanticDispatch) -> SemanticMethod | None:
+        if isinstance(dispatch, RuntimeDispatch):
+            return None
+        if not isinstance(dispatch, MethodDispatch):
+            self._stats.skipped_dynamic_dispatch += 1
+            self._stats.remarks.missed(stmt.span, "for-in kept on protocol calls: dispatch is not static")
+            return None
+        return self._members.methods.get(dispatch.method_id)
+
+    def _scalarizable_constructor(self, collection: SemanticExpr) -> SemanticConstructor | None:
+        if not isinstance(collection, CallExprS) or not isinstance(collection.target, ConstructorCallTarget):
+            return None
+        constructor = self._members.constructors.get(collection.target.constructor_id)
+        if constructor is None or constructor.body is not None or constructor.super_constructor_id is not None:
+            return None
+        class_id = ClassId(module_path=constructor.constructor_id.module_path, name=constructor.constructor_id.class_name)
+        owner_class = self._members.classes.get(class_id)
+        if owner_class is None:
+            return None
+        field_names = {class_field.name for class_field in owner_class.fields}
+        if any(param.name not in field_names for param in constructor.params):
+            return None
+        return constructor
+
+    def _lower_counted_loop(
+        self,
+        stmt: SemanticForIn,
+        len_method: SemanticMethod,
+        get_method: SemanticMethod,
+        constructor: SemanticConstructor | None,
+    ) -> SemanticStmt:
+        span = stmt.span
+        statements: list[SemanticStmt] = []
+        receiver_expr: SemanticExpr | None = None
+        field_locals: dict[str, LocalRefExpr] | None = None
+        if constructor is None:
+            collection = _collection_as_receiver(stmt.collection, len_method, get_method)
+            collection_local_id = self._declare_local("for_coll", collection.type_ref, span, "for_in_collection")
+            statements.append(SemanticVarDecl(local_id=collection_local_id, initializer=collection, span=span))
+            receiver_expr = LocalRefExpr(local_id=collection_local_id, type_ref=collection.type_ref, span=span)
+        else:
+            field_locals = {}
+            for param, arg in zip(constructor.params, stmt.collection.args, strict=True):
+                field_local_id = self._declare_local(f"for_{param.name}", param.type_ref, span, "for_in_collection")
+                statements.append(SemanticVarDecl(local_id=field_local_id, initializer=arg, span=span))
+                field_locals[param.name] = LocalRefExpr(local_id=field_local_id, type_ref=param.type_ref, span=span)
+
+        length_local_id = self._declare_local("for_len", _I64_TYPE_REF, span, "for_in_length")
+        length_ref = LocalRefExpr(local_id=length_local_id, type_ref=_I64_TYPE_REF, span=span)
+        len_inliner = _ProtocolBodyInliner(len_method, receiver_expr, field_locals, index_expr=None, span=span)
+        statements.extend(len_inliner.result_statements(length_local_id))
+
+        index_local_id = self._declare_local("for_i", _I64_TYPE_REF, span, "for_in_index")
+        index_ref = LocalRefExpr(local_id=index_local_id, type_ref=_I64_TYPE_REF, span=span)
+        statements.append(
+            SemanticVarDecl(
+                local_id=index_local_id,
+                initializer=LiteralExprS(constant=IntConstant(0), type_ref=_I64_TYPE_REF, span=span),
+                span=span,
+            )
+        )
+
+        get_inliner = _ProtocolBodyInliner(get_method, receiver_expr, field_locals, index_expr=index_ref, span=span)
+        step = SemanticAssign(
+            target=LocalLValue(local_id=index_local_id, type_ref=_I64_TYPE_REF, span=span),
+            value=BinaryExprS(
+                op=_I64_ADD,
+                left=index_ref,
+                right=LiteralExprS(constant=IntConstant(1), type_ref=_I64_TYPE_REF, span=span),
+                type_ref=_I64_TYPE_REF,
+                span=span,
+            ),
+            span=span,
+        )
+        loop_body = SemanticBlock(
+            statements=[
+                SemanticVarDecl(local_id=stmt.element_local_id, initializer=get_inliner.result_expr(), span=span),
+                _step_before_continue(stmt.body, step),
+                step,
+            ],
+            span=stmt.body.span,
+        )
+        statements.append(
+            SemanticWhile(
+                condition=BinaryExprS(
+                    op=_I64_LESS_THAN, left=index_ref, right=length_ref, type_ref=_BOOL_TYPE_REF, span=span
+                ),
+                body=loop_body,
+                span=span,
+            )
+        )
+        return SemanticBlock(statements=statements, span=span)
+
+    def _declare_local(self, stem: str, type_ref: SemanticTypeRef, span: SourceSpan, binding_kind: LocalBindingKind) -> LocalId:
+        assert self._owner_id is not None
+        local_id = LocalId(owner_id=self._owner_id, ordinal=self._next_local_ordinal)
+        self._next_local_ordinal += 1
+        self._new_local_infos[local_id] = SemanticLocalInfo(
+            local_id=local_id,
+            owner_id=self._owner_id,
+            display_name=f"__nif_{stem}_{local_id.ordinal}",
+            type_ref=type_ref,
+            span=span,
+            binding_kind=binding_kind,
+        )
+        return local_id
+
+    def _enter_owner(self, owner_id: LocalOwnerId, local_info_by_id: dict[LocalId, SemanticLocalInfo]) -> None:
+        self._stats.remarks.enter_callable(owner_id, local_info_by_id)
+        self._owner_id = owner_id
+        self._next_local_ordinal = max((local_id.ordinal for local_id in local_info_by_id), default=-1) + 1
+        self._new_local_infos = {}
+
+    def _leave_owner(self, local_info_by_id: dict[LocalId, SemanticLocalInfo]) -> dict[LocalId, SemanticLocalInfo]:
+        self._stats.remarks.leave_callable()
+        merged = {**local_info_by_id, **self._new_local_infos}
+        self._owner_id = None
+        self._new_local_infos = {}
+        return merged
+
+
+class _ProtocolBodyInliner(SemanticTreeRewriter):
+    """Instantiate a protocol method body at a for-in loop.
+
+    The receiver is replaced by the bound collection (or, when scalarized, its field reads by the
+    field locals) and the index parameter by the loop index. Inlined expressions take the loop's span
+    so traces and line tables stay in the caller's file. Any other local reference aborts inlining.
+    """
+
+    def __init__(
+        self,
+        method: SemanticMethod,
+        receiver_expr: SemanticExpr | None,
+        field_locals: dict[str, LocalRefExpr] | None,
+        *,
+        index_expr: SemanticExpr | None,
+        span: SourceSpan,
+    ) -> None:
+        self._method = method
+        self._field_locals = field_locals
+        self._span = span
+        self._receiver_local_id: LocalId | None = None
+        self._replacements: dict[LocalId, SemanticExpr] = {}
+        param_local_ids = []
+        for local_info in sorted(method.local_info_by_id.values(), key=lambda info: info.local_id.ordinal):
+            if local_info.binding_kind == "receiver":
+                self._receiver_local_id = local_info.local_id
+                if receiver_expr is not None:
+                    self._replacements[local_info.local_id] = receiver_expr
+            elif local_info.binding_kind == "param":
+                param_local_ids.append(local_info.local_id)
+        if index_expr is not None and param_local_ids:
+            self._replacements[param_local_ids[0]] = index_expr
+
+    def result_expr(self) -> SemanticExpr:
+        [return_stmt] = self._method.body.statements
+        assert isinstance(return_stmt, SemanticReturn) and return_stmt.value is not None
+        return self.rewrite_expr(return_stmt.value)
+
+    def result_statements(self, result_local_id: LocalId) -> list[SemanticStmt]:
+        statements = self._method.body.statements
+        if len(statements) == 1:
+            return [SemanticVarDecl(local_id=result_local_id, initializer=self._as_i64(self.result_expr()), span=self._span)]
+        zero = LiteralExprS(constant=IntConstant(0), type_ref=_I64_TYPE_REF, span=self._span)
+        return [
+            SemanticVarDecl(local_id=result_local_id, initializer=zero, span=self._span),
+            *self._guarded_assignments(statements, result_local_id),
+        ]
+
+    def _guarded_assignments(self, statements: list[SemanticStmt], result_local_id: LocalId) -> list[SemanticStmt]:
+        first, rest = statements[0], statements[1:]
+        if isinstance(first, SemanticReturn):
+            assert first.value is not None and not rest
+            return [
+                SemanticAssign(
+                    target=LocalLValue(local_id=result_local_id, type_ref=_I64_TYPE_REF, span=self._span),
+                    value=self._as_i64(self.rewrite_expr(first.value)),
+                    span=self._span,
+                )
+            ]
+        assert isinstance(first, SemanticIf)
+        else_statements = rest if first.else_block is None else first.else_block.statements
+        return [
+            SemanticIf(
+                condition=self.rewrite_expr(first.condition),
+                then_block=SemanticBlock(
+                    statements=self._guarded_assignments(first.then_block.statements, result_local_id), span=self._span
+                ),
+                else_block=SemanticBlock(
+                    statements=self._guarded_assignments(else_statements, result_local_id), span=self._span
+                ),
+                span=self._span,
+            )
+        ]
+
+    def _as_i64(self, expr: SemanticExpr) -> SemanticExpr:
+        return CastExprS(
+            operand=expr,
+            cast_kind=CastSemanticsKind.TO_INTEGER,
+            target_type_ref=_I64_TYPE_REF,
+            type_ref=_I64_TYPE_REF,
+            span=self._span,
+        )
+
+    def rewrite_expr(self, expr: SemanticExpr) -> SemanticExpr:
+        if (
+            self._field_locals is not None
+            and isinstance(expr, FieldReadExpr)
+            and isinstance(expr.receiver, LocalRefExpr)
+            and expr.receiver.local_id == self._receiver_local_id
+        ):
+            field_local = self._field_locals.get(expr.field_name)
+            if field_local is None:
+                raise _NotInlinable()
+            return field_local
+        return super().rewrite_expr(expr)
+
+    def transform_expr(self, expr: SemanticExpr) -> SemanticExpr:
+        if isinstance(expr, LocalRefExpr):
+            replacement = self._replacements.get(expr.local_id)
+            if replacement is None:
+                raise _NotInlinable()
+            return replacement
+        if isinstance(expr, CallExprS):
+            return replace(expr, span=self._span, callee_span=None)
+        if any(expr_field.name == "span" for expr_field in fields(expr)):
+            return replace(expr, span=self._span)
+        return expr
+
+
+def _collection_as_receiver(
+    collection: SemanticExpr, len_method: SemanticMethod, get_method: SemanticMethod
+) -> SemanticExpr:
+    if not semantic_type_is_interface(collection.type_ref):
+        return collection
+    # Devirtualization proved the receiver class, so one entry cast lets inlined field reads see it.
+    receiver_type_refs = {
+        semantic_type_canonical_name(local_info.type_ref): local_info.type_ref
+        for method in (len_method, get_method)
+        for local_info in method.local_info_by_id.values()
+        if local_info.binding_kind == "receiver"
+    }
+    if len(receiver_type_refs) != 1:
+        raise _NotInlinable()
+    [receiver_type_ref] = receiver_type_refs.values()
+    return CastExprS(
+        operand=collection,
+        cast_kind=CastSemanticsKind.REFERENCE_COMPATIBILITY,
+        target_type_ref=receiver_type_ref,
+        type_ref=receiver_type_ref,
+        span=collection.span,
+    )
+
+
+def _is_inlinable_protocol_pair(
+    len_method: SemanticMethod, get_method: SemanticMethod, element_type_ref: SemanticTypeRef
+) -> bool:
+    if len_method.is_static or get_method.is_static or len_method.params or len(get_method.params) != 1:
+        return False
+    if semantic_type_canonical_name(get_method.return_type_ref) != semantic_type_canonical_name(element_type_ref):
+        return False
+    if not _is_guarded_return_chain(len_method.body.statements):
+        return False
+    get_statements = get_method.body.statements
+    return len(get_statements) == 1 and isinstance(get_statements[0], SemanticReturn) and get_statements[0].value is not None
+
+
+def _is_guarded_return_chain(statements: list[SemanticStmt]) -> bool:
+    if not statements:
+        return False
+    first, rest = statements[0], statements[1:]
+    if isinstance(first, SemanticReturn):
+        return first.value is not None and not rest
+    if not isinstance(first, SemanticIf) or not _is_guarded_return_chain(first.then_block.statements):
+        return False
+    if first.else_block is None:
+        return _is_guarded_return_chain(rest)
+    return not rest and _is_guarded_return_chain(first.else_block.statements)
+
+
+def _step_before_continue(block: SemanticBlock, step: SemanticAssign) -> SemanticBlock:
+    return replace(block, statements=[_step_before_continue_in_stmt(stmt, step) for stmt in block.statements])
+
+
+def _step_before_continue_in_stmt(stmt: SemanticStmt, step: SemanticAssign) -> SemanticStmt:
+    if isinstance(stmt, SemanticContinue):
+        return SemanticBlock(statements=[step, stmt], span=stmt.span)
+    if isinstance(stmt, SemanticBlock):
+        return _step_before_continue(stmt, step)
+    if isinstance(stmt, SemanticIf):
+        return replace(
+            stmt,
+            then_block=_step_before_continue(stmt.then_block, step),
+            else_block=None if stmt.else_block is None else _step_before_continue(stmt.else_block, step),
+        )
+    # `continue` inside nested loops targets those loops.
+    return stmt
+
+
+def _index_program_members(program: SemanticProgram) -> _ProgramMembers:
+    methods: dict[MethodId, SemanticMethod] = {}
+    classes: dict[ClassId, SemanticClass] = {}
+    constructors: dict[ConstructorId, SemanticConstructor] = {}
+    for module in program.modules.values():
+        for cls in module.classes:
+            classes[cls.class_id] = cls
+            for method in cls.methods:
+                methods[method.method_id] = method
+            for constructor in cls.constructors:
+                constructors[constructor.constructor_id] = constructor
+    return _ProgramMembers(methods=methods, classes=classes, constructors=constructors)
@@ -1,8 +1,9 @@
 from __future__ import annotations
 
-from dataclasses import dataclass, replace
+from dataclasses import dataclass, field, replace
 
 from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
 from compiler.common.span import SourceSpan
 from compiler.semantic.ir import *
 
@@ -16,11 +17,12 @@ class _DeadStoreStats:
     removed_var_declarations: int = 0
     removed_local_assignments: int = 0
     rewritten_effectful_statements: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
 
 
 def dead_store_elimination(program: SemanticProgram) -> SemanticProgram:
     logger = get_logger(__name__)
-    stats = _DeadStoreStats()
+    stats = _DeadStoreStats(remarks=PassRemarks("dead_store_elimination"))
     optimized_program = rewrite_program_structure(
         program,
         rewrite_field=lambda field: field,
@@ -34,18 +36,23 @@ def dead_store_elimination(program: SemanticProgram) -> SemanticProgram:
         stats.removed_local_assignments,
         stats.rewritten_effectful_statements,
     )
+    stats.remarks.publish()
     return optimized_program
 
 
 def _eliminate_function(fn: SemanticFunction, stats: _DeadStoreStats) -> SemanticFunction:
     if fn.body is None:
         return fn
+    stats.remarks.enter_callable(fn.function_id, fn.local_info_by_id)
     body, _ = _eliminate_block(fn.body, set(), stats)
+    stats.remarks.leave_callable()
     return replace(fn, body=body)
 
 
 def _eliminate_method(method: SemanticMethod, stats: _DeadStoreStats) -> SemanticMethod:
+    stats.remarks.enter_callable(method.method_id, method.local_info_by_id)
     body, _ = _eliminate_block(method.body, set(), stats)
+    stats.remarks.leave_callable()
     return replace(method, body=body)
 
 
@@ -90,6 +97,9 @@ def _eliminate_stmt(
             return stmt, live_before
 
         stats.removed_var_declarations += 1
+        stats.remarks.applied(
+            stmt.span, f"declaration of '{stats.remarks.local_name(stmt.local_id)}' removed: its value is never read"
+        )
         replacement = _rewrite_effectful_expr_stmt(stmt.initializer, stmt.span, stats)
         live_before = set(live_after)
         if replacement is not None:
@@ -105,6 +115,10 @@ def _eliminate_stmt(
                 return stmt, live_before
 
             stats.removed_local_assignments += 1
+            stats.remarks.applied(
+                stmt.span,
+                f"store to '{stats.remarks.local_name(stmt.target.local_id)}' removed: it is overwritten or never read",
+            )
             replacement = _rewrite_effectful_expr_stmt(stmt.value, stmt.span, stats)
             live_before = set(live_after)
             if replacement is not None:
@@ -202,4 +216,5 @@ def _rewrite_effectful_expr_stmt(
     if expr is None or is_pure_expr(expr):
         return None
     stats.rewritten_effectful_statements += 1
+    stats.remarks.missed(span, "dead store's value kept as an expression statement: it may have side effects")
     return SemanticExprStmt(expr=expr, span=span)
@@ -1,10 +1,12 @@
 from __future__ import annotations
 
-from dataclasses import dataclass, replace
+from dataclasses import dataclass, field, replace
 
 from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
 from compiler.semantic.ir import *
 from compiler.semantic.operations import BinaryOpKind, CastSemanticsKind, UnaryOpKind
+from compiler.semantic.types import semantic_type_canonical_name
 
 from .helpers.program_structure import rewrite_program_structure
 from .helpers.narrowing_state import (
@@ -26,12 +28,13 @@ class _NarrowingStats:
     folded_type_tests: int = 0
     seeded_branch_facts: int = 0
     seeded_cast_facts: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
 
 
 def flow_sensitive_type_narrowing(program: SemanticProgram) -> SemanticProgram:
     logger = get_logger(__name__)
     compatibility_index = build_type_compatibility_index(program)
-    stats = _NarrowingStats()
+    stats = _NarrowingStats(remarks=PassRemarks("flow_sensitive_type_narrowing"))
     optimized_program = rewrite_program_structure(
         program,
         rewrite_field=lambda field: _narrow_field(field, compatibility_index, stats),
@@ -46,6 +49,7 @@ def flow_sensitive_type_narrowing(program: SemanticProgram) -> SemanticProgram:
         stats.seeded_branch_facts,
         stats.seeded_cast_facts,
     )
+    stats.remarks.publish()
     return optimized_program
 
 
@@ -62,14 +66,18 @@ def _narrow_function(
 ) -> SemanticFunction:
     if fn.body is None:
         return fn
+    stats.remarks.enter_callable(fn.function_id, fn.local_info_by_id)
     narrowed_body, _ = _rewrite_nested_block(fn.body, _NarrowState.empty(), compatibility_index, stats)
+    stats.remarks.leave_callable()
     return replace(fn, body=narrowed_body)
 
 
 def _narrow_method(
     method: SemanticMethod, compatibility_index: TypeCompatibilityIndex, stats: _NarrowingStats
 ) -> SemanticMethod:
+    stats.remarks.enter_callable(method.method_id, method.local_info_by_id)
     narrowed_body, _ = _rewrite_nested_block(method.body, _NarrowState.empty(), compatibility_index, stats)
+    stats.remarks.leave_callable()
     return replace(method, body=narrowed_body)
 
 
@@ -282,14 +290,25 @@ def _rewrite_expr(
     if isinstance(expr, CastExprS):
         rewritten_operand = _rewrite_expr(expr.operand, state, compatibility_index, stats)
         rewritten_expr = replace(expr, operand=rewritten_operand)
-        if (
-            rewritten_expr.cast_kind is CastSemanticsKind.REFERENCE_COMPATIBILITY
-            and isinstance(rewritten_expr.operand, LocalRefExpr)
-        ):
-            local_facts = state.facts_for_local(rewritten_expr.operand.local_id)
-            if local_facts is not None and local_facts.proves(rewritten_expr.target_type_ref):
-                stats.removed_checked_casts += 1
-                return replace(rewritten_expr.operand, type_ref=rewritten_expr.type_ref, span=rewritten_expr.span)
+        if rewritten_expr.cast_kind is not CastSemanticsKind.REFERENCE_COMPATIBILITY:
+            return rewritten_expr
+        target_name = semantic_type_canonical_name(rewritten_expr.target_type_ref)
+        if not isinstance(rewritten_expr.operand, LocalRefExpr):
+            stats.remarks.missed(
+                rewritten_expr.span, f"checked cast to {target_name} kept: operand is not a local variable"
+            )
+            return rewritten_expr
+        local_name = stats.remarks.local_name(rewritten_expr.operand.local_id)
+        local_facts = state.facts_for_local(rewritten_expr.operand.local_id)
+        if local_facts is not None and local_facts.proves(rewritten_expr.target_type_ref):
+            stats.removed_checked_casts += 1
+            stats.remarks.applied(
+                rewritten_expr.span, f"checked cast to {target_name} removed: '{local_name}' is already known to be one"
+            )
+            return replace(rewritten_expr.operand, type_ref=rewritten_expr.type_ref, span=rewritten_expr.span)
+        stats.remarks.missed(
+            rewritten_expr.span, f"checked cast to {target_name} kept: no dominating fact proves the type of '{local_name}'"
+        )
         return rewritten_expr
 
     if isinstance(expr, TypeTestExprS):
@@ -299,6 +318,11 @@ def _rewrite_expr(
             local_facts = state.facts_for_local(rewritten_expr.operand.local_id)
             if local_facts is not None and local_facts.proves(rewritten_expr.target_type_ref):
                 stats.folded_type_tests += 1
+                stats.remarks.applied(
+                    rewritten_expr.span,
+                    f"type test against {semantic_type_canonical_name(rewritten_expr.target_type_ref)} folded to true: "
+                    f"'{stats.remarks.local_name(rewritten_expr.operand.local_id)}' is already known to be one",
+                )
                 return LiteralExprS(constant=BoolConstant(True), type_ref=rewritten_expr.type_ref, span=rewritten_expr.span)
         return rewritten_expr
 
@@ -349,6 +373,9 @@ def _rewrite_expr(
     if isinstance(expr, ArrayCtorExprS):
         return replace(expr, length_expr=_rewrite_expr(expr.length_expr, state, compatibility_index, stats))
 
+    if isinstance(expr, StrConcatExprS):
+        return replace(expr, parts=[_rewrite_expr(part, state, compatibility_index, stats) for part in expr.parts])
+
     raise TypeError(f"Unsupported semantic expression for flow-sensitive narrowing: {type(expr).__name__}")
 
 
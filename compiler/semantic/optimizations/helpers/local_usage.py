@@ -74,4 +74,6 @@ def read_locals_expr(expr: SemanticExpr | None) -> set[LocalId]:
         return read_locals_expr(expr.target) | read_locals_expr(expr.begin) | read_locals_expr(expr.end)
     if isinstance(expr, ArrayCtorExprS):
         return read_locals_expr(expr.length_expr)
+    if isinstance(expr, StrConcatExprS):
+        return set().union(*(read_locals_expr(part) for part in expr.parts))
     raise TypeError(f"Unsupported semantic expression local-read analysis: {type(expr).__name__}")
@@ -11,6 +11,7 @@ from compiler.semantic.ir import (
     LocalRefExpr,
     SemanticBlock,
     SemanticExpr,
+    StrConcatExprS,
     TypeTestExprS,
     UnaryExprS,
 )
@@ -170,7 +171,7 @@ def exact_runtime_target_from_value(value: SemanticExpr) -> SemanticTypeRef | No
             )
         )
 
-    if isinstance(value, ArrayCtorExprS):
+    if isinstance(value, (ArrayCtorExprS, StrConcatExprS)):
         return value.type_ref
 
     return None
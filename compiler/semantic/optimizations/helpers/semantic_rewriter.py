@@ -160,6 +160,8 @@ class SemanticTreeRewriter:
             )
         if isinstance(expr, ArrayCtorExprS):
             return self.transform_expr(replace(expr, length_expr=self.rewrite_expr(expr.length_expr)))
+        if isinstance(expr, StrConcatExprS):
+            return self.transform_expr(replace(expr, parts=[self.rewrite_expr(part) for part in expr.parts]))
         raise TypeError(f"Unsupported semantic expression for rewriting: {type(expr).__name__}")
 
     def transform_stmt(self, stmt: SemanticStmt) -> SemanticStmt:
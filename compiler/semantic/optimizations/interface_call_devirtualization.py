@@ -1,8 +1,9 @@
 from __future__ import annotations
 
-from dataclasses import dataclass, replace
+from dataclasses import dataclass, field, replace
 
 from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
 from compiler.common.collection_protocols import CollectionOpKind, array_runtime_kind_for_element_type_name
 from compiler.semantic.ir import *
 from compiler.semantic.types import semantic_type_array_element, semantic_type_canonical_name, semantic_type_is_array
@@ -38,6 +39,7 @@ class _DevirtualizationStats:
     closed_world_virtual_dispatches: int = 0
     skipped_non_local_receivers: int = 0
     skipped_without_exact_receiver_type: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
 
 
 def interface_call_devirtualization(program: SemanticProgram) -> SemanticProgram:
@@ -45,7 +47,7 @@ def interface_call_devirtualization(program: SemanticProgram) -> SemanticProgram
     compatibility_index = build_type_compatibility_index(program)
     dispatch_index = build_interface_dispatch_index(program)
     closed_world_index = build_closed_world_dispatch_index(program, compatibility_index, dispatch_index)
-    stats = _DevirtualizationStats()
+    stats = _DevirtualizationStats(remarks=PassRemarks("interface_call_devirtualization"))
     optimized_program = rewrite_program_structure(
         program,
         rewrite_field=lambda field: _rewrite_field(field, compatibility_index, dispatch_index, closed_world_index, stats),
@@ -67,6 +69,7 @@ def interface_call_devirtualization(program: SemanticProgram) -> SemanticProgram
         stats.skipped_non_local_receivers,
         stats.skipped_without_exact_receiver_type,
     )
+    stats.remarks.publish()
     return optimized_program
 
 
@@ -94,6 +97,7 @@ def _rewrite_function(
 ) -> SemanticFunction:
     if fn.body is None:
         return fn
+    stats.remarks.enter_callable(fn.function_id, fn.local_info_by_id)
     rewritten_body, _ = _rewrite_nested_block(
         fn.body,
         NarrowState.empty(),
@@ -102,6 +106,7 @@ def _rewrite_function(
         closed_world_index,
         stats,
     )
+    stats.remarks.leave_callable()
     return replace(fn, body=rewritten_body)
 
 
@@ -112,6 +117,7 @@ def _rewrite_method(
     closed_world_index,
     stats: _DevirtualizationStats,
 ) -> SemanticMethod:
+    stats.remarks.enter_callable(method.method_id, method.local_info_by_id)
     rewritten_body, _ = _rewrite_nested_block(
         method.body,
         NarrowState.empty(),
@@ -120,6 +126,7 @@ def _rewrite_method(
         closed_world_index,
         stats,
     )
+    stats.remarks.leave_callable()
     return replace(method, body=rewritten_body)
 
 
@@ -584,6 +591,15 @@ def _rewrite_expr(
             ),
         )
 
+    if isinstance(expr, StrConcatExprS):
+        return replace(
+            expr,
+            parts=[
+                _rewrite_expr(part, state, compatibility_index, dispatch_index, closed_world_index, stats)
+                for part in expr.parts
+            ],
+        )
+
     raise TypeError(f"Unsupported semantic expression for interface devirtualization: {type(expr).__name__}")
 
 
@@ -594,23 +610,42 @@ def _maybe_devirtualize_call_target(
     closed_world_index,
     stats: _DevirtualizationStats,
 ) -> SemanticCallTarget:
+    span = target.access.receiver.span
     exact_type = _exact_local_receiver_type(target.access.receiver, state, stats)
     if exact_type is not None and exact_type.class_id is not None:
         method_id = resolve_implementing_method(dispatch_index, exact_type.class_id, target.method_id)
         if method_id is not None:
             stats.devirtualized_interface_calls += 1
+            stats.remarks.applied(
+                span,
+                f"interface call {_method_label(target.method_id)} devirtualized to {_method_label(method_id)}: "
+                "receiver has an exact class type",
+            )
             return InstanceMethodCallTarget(
                 method_id=method_id,
                 access=replace(target.access, receiver_type_ref=exact_type),
             )
         stats.skipped_without_exact_receiver_type += 1
+        stats.remarks.missed(
+            span, f"interface call {_method_label(target.method_id)} kept: exact receiver class has no implementing method"
+        )
         return target
 
     closed_world_method_id = resolve_closed_world_interface_method(closed_world_index, target.method_id)
     if closed_world_method_id is None:
+        stats.remarks.missed(
+            span,
+            f"interface call {_method_label(target.method_id)} kept: receiver type is not known exactly "
+            "and the interface has more than one implementation",
+        )
         return target
 
     stats.closed_world_interface_calls += 1
+    stats.remarks.applied(
+        span,
+        f"interface call {_method_label(target.method_id)} devirtualized to {_method_label(closed_world_method_id)}: "
+        "only implementation in the closed world",
+    )
     return InstanceMethodCallTarget(method_id=closed_world_method_id, access=target.access)
 
 
@@ -645,6 +680,11 @@ def _maybe_specialize_structural_dispatch(
         )
         if exact_type is not None:
             stats.specialized_virtual_dispatches += 1
+            stats.remarks.applied(
+                receiver.span,
+                f"{operation.name.lower()} dispatch specialized to {_method_label(dispatch.selected_method_id)}: "
+                "receiver has an exact class type",
+            )
             return MethodDispatch(method_id=dispatch.selected_method_id)
 
         closed_world_method_id = resolve_closed_world_virtual_method(
@@ -654,9 +694,19 @@ def _maybe_specialize_structural_dispatch(
             dispatch.method_name,
         )
         if closed_world_method_id is None:
+            stats.remarks.missed(
+                receiver.span,
+                f"{operation.name.lower()} dispatch kept virtual: receiver type is not known exactly and "
+                f"{dispatch.method_name} is overridden",
+            )
             return dispatch
 
         stats.closed_world_virtual_dispatches += 1
+        stats.remarks.applied(
+            receiver.span,
+            f"{operation.name.lower()} dispatch specialized to {_method_label(closed_world_method_id)}: "
+            "no override in the closed world",
+        )
         return MethodDispatch(method_id=closed_world_method_id)
 
     exact_type = _exact_local_receiver_type(receiver, state, stats)
@@ -664,15 +714,33 @@ def _maybe_specialize_structural_dispatch(
         method_id = resolve_implementing_method(dispatch_index, exact_type.class_id, dispatch.method_id)
         if method_id is not None:
             stats.specialized_interface_dispatches += 1
+            stats.remarks.applied(
+                receiver.span,
+                f"{operation.name.lower()} dispatch specialized to {_method_label(method_id)}: receiver has an exact class type",
+            )
             return MethodDispatch(method_id=method_id)
         stats.skipped_without_exact_receiver_type += 1
+        stats.remarks.missed(
+            receiver.span,
+            f"{operation.name.lower()} dispatch kept on interface: exact receiver class has no implementing method",
+        )
         return dispatch
 
     closed_world_method_id = resolve_closed_world_interface_method(closed_world_index, dispatch.method_id)
     if closed_world_method_id is None:
+        stats.remarks.missed(
+            receiver.span,
+            f"{operation.name.lower()} dispatch kept on interface {_method_label(dispatch.method_id)}: receiver type is not "
+            "known exactly and the interface has more than one implementation",
+        )
         return dispatch
 
     stats.closed_world_interface_dispatches += 1
+    stats.remarks.applied(
+        receiver.span,
+        f"{operation.name.lower()} dispatch specialized to {_method_label(closed_world_method_id)}: "
+        "only implementation in the closed world",
+    )
     return MethodDispatch(method_id=closed_world_method_id)
 
 
@@ -690,6 +758,9 @@ def _maybe_recover_array_runtime_dispatch(
     recovered_dispatch = _runtime_dispatch_for_exact_array(operation, exact_array_type)
     if dispatch != recovered_dispatch:
         stats.recovered_array_runtime_dispatches += 1
+        stats.remarks.applied(
+            receiver.span, f"{operation.name.lower()} dispatch routed to the array runtime: receiver is an exact array type"
+        )
     return recovered_dispatch
 
 
@@ -705,8 +776,13 @@ def _maybe_devirtualize_virtual_call_target(
         expected_receiver_class_id=target.access.receiver_type_ref.class_id,
         stats=stats,
     )
+    span = target.access.receiver.span
     if exact_type is not None:
         stats.devirtualized_virtual_calls += 1
+        stats.remarks.applied(
+            span,
+            f"virtual call {_method_label(target.selected_method_id)} devirtualized: receiver has an exact class type",
+        )
         return InstanceMethodCallTarget(
             method_id=target.selected_method_id,
             access=replace(target.access, receiver_type_ref=exact_type),
@@ -723,9 +799,19 @@ def _maybe_devirtualize_virtual_call_target(
         target.slot_method_name,
     )
     if closed_world_method_id is None:
+        stats.remarks.missed(
+            span,
+            f"virtual call {_method_label(target.selected_method_id)} kept: receiver type is not known exactly "
+            f"and {target.slot_method_name} is overridden",
+        )
         return target
 
     stats.closed_world_virtual_calls += 1
+    stats.remarks.applied(
+        span,
+        f"virtual call {_method_label(target.selected_method_id)} devirtualized to "
+        f"{_method_label(closed_world_method_id)}: no override in the closed world",
+    )
     return InstanceMethodCallTarget(method_id=closed_world_method_id, access=target.access)
 
 
@@ -806,6 +892,11 @@ def _runtime_dispatch_for_exact_array(operation: CollectionOpKind, exact_array_t
     )
 
 
+def _method_label(method_id: MethodId | InterfaceMethodId) -> str:
+    owner_name = method_id.interface_name if isinstance(method_id, InterfaceMethodId) else method_id.class_name
+    return f"{owner_name}.{method_id.name}"
+
+
 def _block_always_exits(block: SemanticBlock) -> bool:
     return any(_stmt_always_exits(stmt) for stmt in block.statements)
 
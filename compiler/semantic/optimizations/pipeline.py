@@ -8,8 +8,10 @@ from compiler.common.logging import get_logger
 from compiler.semantic.ir import SemanticProgram
 
 from .algebraic_simplify import algebraic_simplify
+from .box_unbox_elimination import box_unbox_elimination
 from .constant_fold import constant_fold
 from .copy_propagation import copy_propagation
+from .counted_for_in import counted_for_in
 from .dead_store_elimination import dead_store_elimination
 from .dead_stmt_prune import dead_stmt_prune
 from .flow_sensitive_type_narrowing import flow_sensitive_type_narrowing
@@ -35,6 +37,8 @@ DEFAULT_SEMANTIC_OPTIMIZATION_PASSES: tuple[SemanticOptimizationPass, ...] = (
     SemanticOptimizationPass(name="copy_propagation", transform=copy_propagation),
     SemanticOptimizationPass(name="flow_sensitive_type_narrowing", transform=flow_sensitive_type_narrowing),
     SemanticOptimizationPass(name="interface_call_devirtualization", transform=interface_call_devirtualization),
+    SemanticOptimizationPass(name="counted_for_in", transform=counted_for_in),
+    SemanticOptimizationPass(name="box_unbox_elimination", transform=box_unbox_elimination),
     SemanticOptimizationPass(name="redundant_cast_elimination", transform=redundant_cast_elimination),
     SemanticOptimizationPass(name="dead_store_elimination", transform=dead_store_elimination),
     SemanticOptimizationPass(name="constant_fold", transform=constant_fold),
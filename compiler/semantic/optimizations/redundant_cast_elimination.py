@@ -1,8 +1,9 @@
 from __future__ import annotations
 
-from dataclasses import dataclass, replace
+from dataclasses import dataclass, field, replace
 
 from compiler.common.logging import get_logger
+from compiler.common.opt_remarks import PassRemarks
 from compiler.semantic.ir import *
 from compiler.semantic.types import semantic_type_canonical_name
 
@@ -12,25 +13,42 @@ from .helpers.semantic_rewriter import SemanticTreeRewriter
 @dataclass
 class _RedundantCastStats:
     removed_redundant_casts: int = 0
+    remarks: PassRemarks = field(default_factory=PassRemarks.discarded)
 
 
 class _RedundantCastEliminator(SemanticTreeRewriter):
     def __init__(self, stats: _RedundantCastStats) -> None:
         self._stats = stats
 
+    def rewrite_function(self, fn: SemanticFunction) -> SemanticFunction:
+        self._stats.remarks.enter_callable(fn.function_id, fn.local_info_by_id)
+        rewritten = super().rewrite_function(fn)
+        self._stats.remarks.leave_callable()
+        return rewritten
+
+    def rewrite_method(self, method: SemanticMethod) -> SemanticMethod:
+        self._stats.remarks.enter_callable(method.method_id, method.local_info_by_id)
+        rewritten = super().rewrite_method(method)
+        self._stats.remarks.leave_callable()
+        return rewritten
+
     def transform_expr(self, expr: SemanticExpr) -> SemanticExpr:
         if not isinstance(expr, CastExprS):
             return expr
         if not _is_redundant_cast(expr):
             return expr
         self._stats.removed_redundant_casts += 1
+        self._stats.remarks.applied(
+            expr.span, f"cast to {semantic_type_canonical_name(expr.target_type_ref)} is an identity conversion"
+        )
         return replace(expr.operand, type_ref=expr.type_ref, span=expr.span)
 
 
 def redundant_cast_elimination(program: SemanticProgram) -> SemanticProgram:
     logger = get_logger(__name__)
-    stats = _RedundantCastStats()
+    stats = _RedundantCastStats(remarks=PassRemarks("redundant_cast_elimination"))
     optimized_program = _RedundantCastEliminator(stats).rewrite_program(program)
+    stats.remarks.publish()
     logger.debugv(
         1, "Optimization pass redundant_cast_elimination removed %d redundant casts", stats.removed_redundant_casts
     )
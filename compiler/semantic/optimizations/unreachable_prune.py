@@ -333,6 +333,13 @@ class _SemanticReachabilityWalker:
             return
         if isinstance(expr, StringLiteralBytesExpr):
             return
+        if isinstance(expr, StrConcatExprS):
+            self._enqueue_class(
+                ClassId(module_path=expr.constructor_id.module_path, name=expr.constructor_id.class_name)
+            )
+            for part in expr.parts:
+                self._walk_expr(module_path, part)
+            return
 
     def _enqueue_type_name(self, current_module_path: ModulePath, type_name: str) -> None:
         text = type_name.strip()
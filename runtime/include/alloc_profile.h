@@ -0,0 +1,38 @@
+#ifndef NIFLHEIM_RUNTIME_ALLOC_PROFILE_H
+#define NIFLHEIM_RUNTIME_ALLOC_PROFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct RtObjHeader RtObjHeader;
+
+/* Sampling allocation profiler enabled by NIF_ALLOC_PROFILE.
+ *
+ * Sampled objects are tagged through RtObjHeader.reserved0 (sample slot + 1),
+ * so the sweep can detect sampled frees without a side-table lookup. */
+typedef struct RtAllocProfileStats {
+    uint64_t sample_interval_bytes;
+    uint64_t frame_depth;
+    uint64_t sampled_objects;
+    uint64_t sampled_bytes;
+    uint64_t live_samples;
+    uint64_t survivor_samples;
+    uint64_t site_count;
+} RtAllocProfileStats;
+
+void rt_alloc_profile_note_allocation(RtObjHeader* obj);
+void rt_alloc_profile_note_free(RtObjHeader* obj);
+void rt_alloc_profile_collect_end(void);
+void rt_alloc_profile_configure(uint64_t sample_interval_bytes, uint32_t frame_depth);
+RtAllocProfileStats rt_alloc_profile_get_stats(void);
+void rt_alloc_profile_print_report(void);
+void rt_alloc_profile_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
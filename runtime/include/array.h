@@ -48,6 +48,15 @@ void rt_array_set_slice_bool(void* array_obj, int64_t start, int64_t end, const
 void rt_array_set_slice_double(void* array_obj, int64_t start, int64_t end, const void* value_array_obj);
 void rt_array_set_slice_ref(void* array_obj, int64_t start, int64_t end, const void* value_array_obj);
 
+int64_t rt_array_fill_i64(void* array_obj, int64_t start, int64_t end, int64_t value);
+int64_t rt_array_fill_u64(void* array_obj, int64_t start, int64_t end, uint64_t value);
+int64_t rt_array_fill_u8(void* array_obj, int64_t start, int64_t end, uint64_t value);
+int64_t rt_array_fill_bool(void* array_obj, int64_t start, int64_t end, int64_t value);
+int64_t rt_array_fill_double(void* array_obj, int64_t start, int64_t end, double value);
+int64_t rt_array_fill_ref(void* array_obj, int64_t start, int64_t end, void* value);
+int64_t rt_array_copy_range(void* target_obj, const void* source_obj, int64_t start, int64_t end);
+int64_t rt_array_mismatch_range(const void* left_obj, const void* right_obj, int64_t start, int64_t end);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,29 @@
+#ifndef NIFLHEIM_RUNTIME_BIGINT_RT_H
+#define NIFLHEIM_RUNTIME_BIGINT_RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t rt_bigint_compare(const void* left_limbs_obj, const void* right_limbs_obj);
+uint64_t rt_bigint_add(void* out_limbs_obj, const void* left_limbs_obj, const void* right_limbs_obj);
+uint64_t rt_bigint_sub(void* out_limbs_obj, const void* left_limbs_obj, const void* right_limbs_obj);
+uint64_t rt_bigint_mul(void* out_limbs_obj, const void* left_limbs_obj, const void* right_limbs_obj);
+uint64_t rt_bigint_mul_word_add(void* out_limbs_obj, const void* limbs_obj, uint64_t factor, uint64_t addend);
+uint64_t rt_bigint_divrem_word(void* quotient_limbs_obj, const void* limbs_obj, uint64_t divisor);
+void rt_bigint_divrem(
+    void* quotient_limbs_obj,
+    void* remainder_limbs_obj,
+    const void* numerator_limbs_obj,
+    const void* divisor_limbs_obj
+);
+uint64_t rt_bigint_to_decimal(void* out_u8_array_obj, const void* limbs_obj);
+uint64_t rt_bigint_from_decimal(void* out_limbs_obj, const void* digits_u8_array_obj, uint64_t start, uint64_t end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
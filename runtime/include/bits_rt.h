@@ -0,0 +1,22 @@
+#ifndef NIFLHEIM_RUNTIME_BITS_RT_H
+#define NIFLHEIM_RUNTIME_BITS_RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t rt_bits_popcount(uint64_t value);
+uint64_t rt_bits_clz(uint64_t value);
+uint64_t rt_bits_ctz(uint64_t value);
+uint64_t rt_bits_rotl(uint64_t value, uint64_t amount);
+uint64_t rt_bits_rotr(uint64_t value, uint64_t amount);
+uint64_t rt_bits_bswap(uint64_t value);
+uint64_t rt_bits_mulhi(uint64_t left, uint64_t right);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
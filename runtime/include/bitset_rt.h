@@ -0,0 +1,22 @@
+#ifndef NIFLHEIM_RUNTIME_BITSET_RT_H
+#define NIFLHEIM_RUNTIME_BITSET_RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void rt_bitset_and(void* target_words, const void* source_words);
+void rt_bitset_or(void* target_words, const void* source_words);
+void rt_bitset_xor(void* target_words, const void* source_words);
+void rt_bitset_and_not(void* target_words, const void* source_words);
+
+uint64_t rt_bitset_count(const void* words);
+int64_t rt_bitset_next_set(const void* words, int64_t from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
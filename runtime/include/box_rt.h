@@ -0,0 +1,23 @@
+#ifndef NIFLHEIM_RUNTIME_BOX_RT_H
+#define NIFLHEIM_RUNTIME_BOX_RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    RT_BOX_CACHE_KIND_COUNT = 4,
+    RT_BOX_CACHE_SLOT_COUNT = 1152,
+};
+
+void* rt_box_cache_get(uint64_t kind, uint64_t slot);
+void rt_box_cache_put(uint64_t kind, uint64_t slot, void* box);
+void rt_box_cache_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef NIFLHEIM_RUNTIME_CPU_FEATURES_H
+#define NIFLHEIM_RUNTIME_CPU_FEATURES_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Nonzero once the running x86-64 CPU is known to support the extension. Generated code tests these
+ * flags before an inline sequence that needs the extension and otherwise calls the matching rt_math_*
+ * or rt_bits_* wrapper, which runs rt_cpu_detect_features on first use. Both stay zero on other
+ * architectures. */
+extern uint32_t rt_cpu_has_sse41;
+extern uint32_t rt_cpu_has_popcnt;
+
+void rt_cpu_detect_features(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef NIFLHEIM_RUNTIME_FUNC_PROFILE_H
+#define NIFLHEIM_RUNTIME_FUNC_PROFILE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-callable counters for `nifc --instrument-functions` builds.
+ *
+ * The compiler emits one zero-initialized site per instrumented callable in
+ * .data with only `name` filled in, and brackets the callable body with
+ * rt_func_profile_enter(site) / rt_func_profile_exit(). Sites link themselves
+ * into the report list on first entry. Keep the layout in sync with
+ * RT_FUNC_PROFILE_SITE_* in compiler/backend/program/runtime_layout.py.
+ */
+typedef struct RtFuncProfileSite {
+    const char* name;
+    uint64_t calls;
+    uint64_t self_ticks;
+    uint64_t inclusive_ticks;
+    uint32_t active_depth;
+    uint32_t registered;
+    struct RtFuncProfileSite* next;
+} RtFuncProfileSite;
+
+void rt_func_profile_enter(RtFuncProfileSite* site);
+void rt_func_profile_exit(void);
+uint64_t rt_func_profile_ticks(void);
+uint32_t rt_func_profile_site_count(void);
+RtFuncProfileSite* rt_func_profile_sites(void);
+void rt_func_profile_print_report(void);
+void rt_func_profile_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -26,6 +26,26 @@ typedef struct RtGcStats {
     uint64_t tracked_set_active;
 } RtGcStats;
 
+typedef enum RtGcCollectReason {
+    RT_GC_COLLECT_EXPLICIT = 0,
+    RT_GC_COLLECT_THRESHOLD = 1,
+    RT_GC_COLLECT_ALLOC_FAILURE = 2,
+} RtGcCollectReason;
+
+typedef enum RtGcRootKind {
+    RT_GC_ROOT_SHADOW_STACK = 1,
+    RT_GC_ROOT_GLOBAL = 2,
+} RtGcRootKind;
+
+typedef void (*RtGcObjectVisitor)(RtObjHeader* obj, void* context);
+typedef void (*RtGcRootVisitor)(
+    void* ref,
+    RtGcRootKind kind,
+    uint32_t frame_index,
+    uint32_t slot_index,
+    void* context
+);
+
 typedef struct RtGcTrackingPoolStats {
     uint64_t allocation_requests;
     uint64_t pool_hits;
@@ -41,6 +61,10 @@ void rt_gc_unregister_global_root(void** slot);
 RtGcStats rt_gc_get_stats(void);
 RtGcTrackingPoolStats rt_gc_get_tracking_pool_stats(void);
 void rt_gc_collect(void);
+void rt_gc_collect_for(RtGcCollectReason reason);
+
+void rt_gc_visit_tracked_objects(RtGcObjectVisitor visit, void* context);
+void rt_gc_visit_roots(RtGcRootVisitor visit, void* context);
 
 void rt_gc_maybe_collect(uint64_t upcoming_bytes);
 void rt_gc_track_allocation(RtObjHeader* obj);
@@ -0,0 +1,39 @@
+#ifndef NIFLHEIM_RUNTIME_GC_HEAP_DUMP_H
+#define NIFLHEIM_RUNTIME_GC_HEAP_DUMP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Heap snapshot format (version 1), native byte order:
+ *
+ *   header:  "NIFHEAP1" u32 version u32 pointer_bytes
+ *   type:    u8 tag=1, u64 type_key, u32 type_id, u32 flags, u32 name_len, name bytes
+ *   object:  u8 tag=2, u64 address, u64 type_key, u64 size_bytes, u32 edge_count, u64 edges[edge_count]
+ *   root:    u8 tag=3, u64 address, u32 kind, u32 frame_index, u32 slot_index
+ *   end:     u8 tag=255, u64 object_count, u64 root_count
+ *
+ * Type records precede the first object that uses them. Root kinds match
+ * RtGcRootKind. scripts/analyze_heap_snapshot.py reads this format.
+ */
+enum {
+    RT_HEAP_DUMP_VERSION = 1u,
+    RT_HEAP_DUMP_TAG_TYPE = 1u,
+    RT_HEAP_DUMP_TAG_OBJECT = 2u,
+    RT_HEAP_DUMP_TAG_ROOT = 3u,
+    RT_HEAP_DUMP_TAG_END = 255u,
+};
+
+int rt_gc_dump_heap(const char* path);
+void rt_gc_heap_dump_poll(void);
+void rt_gc_heap_dump_collect_end(uint64_t live_bytes);
+void rt_gc_heap_dump_at_exit(void);
+void rt_gc_heap_dump_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,10 @@
 #ifndef NIFLHEIM_RUNTIME_GC_TRACE_H
 #define NIFLHEIM_RUNTIME_GC_TRACE_H
 
+#include "gc.h"
+
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,12 +14,23 @@ typedef enum RtGcTracePhase {
 	RT_GC_TRACE_PHASE_SWEEP = 1,
 } RtGcTracePhase;
 
-void rt_gc_trace_collect_begin(void);
+typedef struct RtGcRootCounts {
+	uint64_t shadow_stack_frames;
+	uint64_t shadow_stack_slots;
+	uint64_t shadow_stack_refs;
+	uint64_t global_roots;
+	uint64_t global_refs;
+} RtGcRootCounts;
+
+void rt_gc_trace_poll(void);
+void rt_gc_trace_collect_begin(RtGcCollectReason reason);
+void rt_gc_trace_note_roots(const RtGcRootCounts* counts);
 void rt_gc_trace_phase_begin(RtGcTracePhase phase);
 void rt_gc_trace_phase_end(RtGcTracePhase phase);
 void rt_gc_trace_collect_end(void);
 void rt_gc_trace_reset(void);
 void rt_gc_trace_print_summary(void);
+void rt_gc_trace_set_event_log_path(const char* path);
 
 #ifdef __cplusplus
 }
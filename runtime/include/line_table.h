@@ -0,0 +1,64 @@
+#ifndef NIFLHEIM_RUNTIME_LINE_TABLE_H
+#define NIFLHEIM_RUNTIME_LINE_TABLE_H
+
+#include "runtime.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PC-to-line tables for panic stack traces.
+ *
+ * Unless a program is built with `--omit-runtime-trace` or
+ * `--shadow-runtime-trace`, the compiler emits one RtLineTable per emitted
+ * callable into the `nif_line_tables` section and every generated frame keeps
+ * a frame-pointer record. Nothing runs on the non-panicking path: a trace is
+ * recovered by walking saved frame pointers and symbolizing each return
+ * address against these tables.
+ *
+ * Every pointer-like field is a 32-bit offset relative to the address of the
+ * field itself, so the section needs no dynamic relocations. Keep the layout
+ * in sync with RT_LINE_TABLE_* in compiler/backend/program/runtime_layout.py.
+ */
+typedef struct RtLineTableEntry {
+    uint32_t pc_offset;
+    uint32_t line;
+    uint32_t column;
+} RtLineTableEntry;
+
+enum {
+    /* Constructor init bodies share their entry wrapper's name; when the
+     * caller frame is that wrapper (it may also have been inlined into the
+     * caller), it is the same logical frame and is not reported twice. */
+    RT_LINE_TABLE_FLAG_FOLDS_CALLER = 1u,
+};
+
+typedef struct RtLineTable {
+    int32_t code_start;
+    uint32_t code_size;
+    int32_t function_name;
+    int32_t file_path;
+    int32_t entries;
+    uint32_t entry_count;
+    uint32_t line;
+    uint32_t column;
+    uint32_t flags;
+    uint32_t reserved;
+} RtLineTable;
+
+/* Return nonzero to keep walking. Frames are visited innermost first. */
+typedef int (*RtTraceFrameVisitor)(const RtTraceFrame* frame, void* context);
+
+uint32_t rt_line_table_count(void);
+const RtLineTable* rt_line_table_find(uintptr_t pc);
+int rt_line_table_symbolize(uintptr_t return_address, RtTraceFrame* out_frame);
+uint32_t rt_trace_visit(RtTraceFrameVisitor visitor, void* context);
+uint32_t rt_trace_capture(RtTraceFrame* frames, uint32_t max_frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef NIFLHEIM_RUNTIME_PERF_COUNTERS_H
+#define NIFLHEIM_RUNTIME_PERF_COUNTERS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Optional hardware counter group (Linux perf_event_open) enabled by
+ * NIF_PERF_COUNTERS. When the kernel refuses the counters (containers,
+ * perf_event_paranoid, non-Linux hosts) every read returns an empty sample
+ * and reporting omits the counter fields.
+ */
+typedef enum RtPerfCounterId {
+    RT_PERF_COUNTER_CYCLES = 0,
+    RT_PERF_COUNTER_INSTRUCTIONS = 1,
+    RT_PERF_COUNTER_CACHE_MISSES = 2,
+    RT_PERF_COUNTER_BRANCH_MISSES = 3,
+    RT_PERF_COUNTER_COUNT = 4,
+} RtPerfCounterId;
+
+typedef struct RtPerfCounterSample {
+    uint64_t values[RT_PERF_COUNTER_COUNT];
+    uint32_t valid_mask;
+    uint32_t reserved0;
+} RtPerfCounterSample;
+
+void rt_perf_counters_poll(void);
+int rt_perf_counters_available(void);
+RtPerfCounterSample rt_perf_counters_read(void);
+RtPerfCounterSample rt_perf_counters_program_elapsed(void);
+RtPerfCounterSample rt_perf_counters_delta(RtPerfCounterSample end, RtPerfCounterSample start);
+void rt_perf_counters_accumulate(RtPerfCounterSample* total, RtPerfCounterSample delta);
+const char* rt_perf_counter_name(RtPerfCounterId id);
+void rt_perf_counters_configure(int enabled);
+void rt_perf_counters_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -4,10 +4,17 @@
 #include <stdint.h>
 
 #include "array.h"
+#include "bigint_rt.h"
+#include "bitset_rt.h"
+#include "bits_rt.h"
+#include "box_rt.h"
+#include "cpu_features.h"
 #include "gc.h"
 #include "io.h"
 #include "math_rt.h"
 #include "panic.h"
+#include "sort_rt.h"
+#include "str_rt.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,8 +62,15 @@ struct RtType {
     void (*trace_fn)(void* obj, void (*mark_ref)(void** slot));
     const uint32_t* pointer_offsets;
     uint32_t pointer_offsets_count;
-    uint32_t reserved0;
+    /* Compiled classes are numbered in preorder over the inheritance forest,
+     * starting at 1, so a class's subclasses have type ids in
+     * [type_id, subtype_id_end). Zero means the type has no range and is
+     * matched by walking super_type. */
+    uint32_t subtype_id_end;
     const RtType* super_type;
+    /* Compiled classes place interface_tables (one entry per program
+     * interface) immediately before this record and class_vtable immediately
+     * after it; generated dispatch indexes both from the type pointer. */
     const void* const* interface_tables;
     uint32_t interface_slot_count;
     uint32_t reserved1;
@@ -0,0 +1,24 @@
+#ifndef NIFLHEIM_RUNTIME_SORT_RT_H
+#define NIFLHEIM_RUNTIME_SORT_RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void rt_sort_i64(void* array_obj, int64_t start, int64_t end);
+void rt_sort_u64(void* array_obj, int64_t start, int64_t end);
+void rt_sort_u8(void* array_obj, int64_t start, int64_t end);
+void rt_sort_double(void* array_obj, int64_t start, int64_t end);
+
+int64_t rt_sort_search_i64(const void* array_obj, int64_t start, int64_t end, int64_t value);
+int64_t rt_sort_search_u64(const void* array_obj, int64_t start, int64_t end, uint64_t value);
+int64_t rt_sort_search_u8(const void* array_obj, int64_t start, int64_t end, uint64_t value);
+int64_t rt_sort_search_double(const void* array_obj, int64_t start, int64_t end, double value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
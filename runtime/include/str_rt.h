@@ -0,0 +1,24 @@
+#ifndef NIFLHEIM_RUNTIME_STR_RT_H
+#define NIFLHEIM_RUNTIME_STR_RT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t rt_str_len_i64(int64_t value);
+uint64_t rt_str_len_u64(uint64_t value);
+uint64_t rt_str_len_double(double value);
+
+uint64_t rt_str_write_literal(void* bytes, uint64_t offset, const uint8_t* data, uint64_t len);
+uint64_t rt_str_write_bytes(void* bytes, uint64_t offset, const void* source);
+uint64_t rt_str_write_i64(void* bytes, uint64_t offset, int64_t value);
+uint64_t rt_str_write_u64(void* bytes, uint64_t offset, uint64_t value);
+uint64_t rt_str_write_double(void* bytes, uint64_t offset, double value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
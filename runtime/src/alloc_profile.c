@@ -0,0 +1,583 @@
+#include "alloc_profile.h"
+#include "line_table.h"
+#include "runtime.h"
+
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+enum {
+    RT_ALLOC_PROFILE_DEFAULT_INTERVAL_BYTES = 64u * 1024u,
+    RT_ALLOC_PROFILE_DEFAULT_FRAME_DEPTH = 4u,
+    RT_ALLOC_PROFILE_MAX_FRAME_DEPTH = 8u,
+    RT_ALLOC_PROFILE_DEFAULT_REPORT_ROWS = 20u,
+    RT_ALLOC_PROFILE_INITIAL_SITE_CAPACITY = 64u,
+    RT_ALLOC_PROFILE_INITIAL_SAMPLE_CAPACITY = 256u,
+};
+
+
+typedef struct RtAllocProfileFrame {
+    const char* function_name;
+    const char* file_path;
+    uint32_t line;
+} RtAllocProfileFrame;
+
+
+typedef struct RtAllocProfileSite {
+    const RtType* type;
+    uint32_t frame_count;
+    RtAllocProfileFrame frames[RT_ALLOC_PROFILE_MAX_FRAME_DEPTH];
+    uint64_t hash;
+    uint64_t samples;
+    uint64_t survivor_samples;
+    double estimated_objects;
+    double estimated_bytes;
+    double estimated_survivor_bytes;
+    double estimated_live_bytes;
+} RtAllocProfileSite;
+
+
+typedef struct RtAllocProfileSample {
+    RtObjHeader* obj;
+    uint32_t site_index;
+    uint32_t survived_collections;
+    double estimated_objects;
+    double estimated_bytes;
+} RtAllocProfileSample;
+
+
+static int g_alloc_profile_enabled = -1;
+static int g_alloc_profile_report_registered = 0;
+static int g_alloc_profile_report_emitted = 0;
+static uint64_t g_sample_interval_bytes = RT_ALLOC_PROFILE_DEFAULT_INTERVAL_BYTES;
+static uint32_t g_frame_depth = RT_ALLOC_PROFILE_DEFAULT_FRAME_DEPTH;
+static uint64_t g_bytes_until_sample = 0;
+static uint64_t g_rng_state = 0x9e3779b97f4a7c15u;
+static uint64_t g_sampled_objects = 0;
+static uint64_t g_sampled_bytes = 0;
+static uint64_t g_survivor_samples = 0;
+
+static RtAllocProfileSite* g_sites = NULL;
+static uint32_t g_site_count = 0;
+static uint32_t g_site_capacity = 0;
+static uint32_t* g_site_buckets = NULL;
+static uint32_t g_site_bucket_capacity = 0;
+
+static RtAllocProfileSample* g_samples = NULL;
+static uint32_t g_sample_count = 0;
+static uint32_t g_sample_capacity = 0;
+
+
+static uint64_t rt_alloc_profile_next_random(void) {
+    /* xorshift64*: deterministic across runs so profiles are comparable. */
+    uint64_t x = g_rng_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    g_rng_state = x;
+    return x * 0x2545f4914f6cdd1du;
+}
+
+
+/* Draw the distance to the next sample from an exponential distribution with
+ * the configured mean, which makes sample points a Poisson process over the
+ * allocated byte stream.
+ */
+static uint64_t rt_alloc_profile_next_interval(void) {
+    if (g_sample_interval_bytes <= 1u) {
+        return 0u;
+    }
+
+    const double unit = (double)((rt_alloc_profile_next_random() >> 11) + 1u) / 9007199254740992.0;
+    const double interval = -log(unit) * (double)g_sample_interval_bytes;
+    if (interval >= 18446744073709551615.0) {
+        return UINT64_MAX;
+    }
+    return (uint64_t)interval;
+}
+
+
+/* Inverse of the probability that an allocation of size_bytes was sampled. */
+static double rt_alloc_profile_sample_scale(uint64_t size_bytes) {
+    if (g_sample_interval_bytes <= 1u || size_bytes == 0u) {
+        return 1.0;
+    }
+    const double probability = 1.0 - exp(-(double)size_bytes / (double)g_sample_interval_bytes);
+    if (probability <= 0.0) {
+        return 1.0;
+    }
+    return 1.0 / probability;
+}
+
+
+static uint64_t rt_alloc_profile_parse_u64(const char* value, uint64_t fallback) {
+    if (value == NULL || value[0] == '\0') {
+        return fallback;
+    }
+    char* end = NULL;
+    unsigned long long parsed = strtoull(value, &end, 10);
+    if (end == value || *end != '\0') {
+        return fallback;
+    }
+    return (uint64_t)parsed;
+}
+
+
+static uint32_t rt_alloc_profile_clamp_depth(uint64_t depth) {
+    if (depth > RT_ALLOC_PROFILE_MAX_FRAME_DEPTH) {
+        return RT_ALLOC_PROFILE_MAX_FRAME_DEPTH;
+    }
+    return (uint32_t)depth;
+}
+
+
+static void rt_alloc_profile_report_atexit(void) {
+    rt_alloc_profile_print_report();
+}
+
+
+static void rt_alloc_profile_register_report(void) {
+    if (!g_alloc_profile_report_registered) {
+        g_alloc_profile_report_registered = 1;
+        (void)atexit(rt_alloc_profile_report_atexit);
+    }
+}
+
+
+/* NIF_ALLOC_PROFILE=1 samples with the default mean interval; any larger
+ * value is taken as the mean interval in bytes. NIF_ALLOC_PROFILE_DEPTH
+ * selects how many trace frames identify an allocation site.
+ */
+static int rt_alloc_profile_is_enabled(void) {
+    if (g_alloc_profile_enabled >= 0) {
+        return g_alloc_profile_enabled;
+    }
+
+    const char* value = getenv("NIF_ALLOC_PROFILE");
+    if (value == NULL || value[0] == '\0' || value[0] == '0') {
+        g_alloc_profile_enabled = 0;
+        return 0;
+    }
+
+    uint64_t interval = rt_alloc_profile_parse_u64(value, RT_ALLOC_PROFILE_DEFAULT_INTERVAL_BYTES);
+    if (interval <= 1u) {
+        interval = RT_ALLOC_PROFILE_DEFAULT_INTERVAL_BYTES;
+    }
+    uint64_t depth = rt_alloc_profile_parse_u64(
+        getenv("NIF_ALLOC_PROFILE_DEPTH"),
+        RT_ALLOC_PROFILE_DEFAULT_FRAME_DEPTH
+    );
+    rt_alloc_profile_configure(interval, rt_alloc_profile_clamp_depth(depth));
+    rt_alloc_profile_register_report();
+    return g_alloc_profile_enabled;
+}
+
+
+static void* rt_alloc_profile_grow(void* buffer, uint32_t* capacity, uint32_t initial, size_t element_size) {
+    uint32_t new_capacity = *capacity == 0u ? initial : *capacity * 2u;
+    if (new_capacity <= *capacity) {
+        rt_panic_oom();
+    }
+    void* grown = realloc(buffer, (size_t)new_capacity * element_size);
+    if (grown == NULL) {
+        rt_panic_oom();
+    }
+    *capacity = new_capacity;
+    return grown;
+}
+
+
+static uint64_t rt_alloc_profile_mix(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15u + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+
+static uint64_t rt_alloc_profile_site_hash(const RtType* type, const RtAllocProfileFrame* frames, uint32_t frame_count) {
+    uint64_t hash = rt_alloc_profile_mix(0u, (uint64_t)(uintptr_t)type);
+    for (uint32_t i = 0; i < frame_count; i++) {
+        hash = rt_alloc_profile_mix(hash, (uint64_t)(uintptr_t)frames[i].function_name);
+        hash = rt_alloc_profile_mix(hash, (uint64_t)(uintptr_t)frames[i].file_path);
+        hash = rt_alloc_profile_mix(hash, (uint64_t)frames[i].line);
+    }
+    return hash;
+}
+
+
+static int rt_alloc_profile_site_matches(
+    const RtAllocProfileSite* site,
+    uint64_t hash,
+    const RtType* type,
+    const RtAllocProfileFrame* frames,
+    uint32_t frame_count
+) {
+    if (site->hash != hash || site->type != type || site->frame_count != frame_count) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < frame_count; i++) {
+        if (site->frames[i].function_name != frames[i].function_name
+            || site->frames[i].file_path != frames[i].file_path
+            || site->frames[i].line != frames[i].line) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+static void rt_alloc_profile_rehash_sites(uint32_t bucket_capacity) {
+    uint32_t* buckets = (uint32_t*)malloc((size_t)bucket_capacity * sizeof(uint32_t));
+    if (buckets == NULL) {
+        rt_panic_oom();
+    }
+    for (uint32_t i = 0; i < bucket_capacity; i++) {
+        buckets[i] = UINT32_MAX;
+    }
+    for (uint32_t site_index = 0; site_index < g_site_count; site_index++) {
+        uint32_t bucket = (uint32_t)(g_sites[site_index].hash & (bucket_capacity - 1u));
+        while (buckets[bucket] != UINT32_MAX) {
+            bucket = (bucket + 1u) & (bucket_capacity - 1u);
+        }
+        buckets[bucket] = site_index;
+    }
+    free(g_site_buckets);
+    g_site_buckets = buckets;
+    g_site_bucket_capacity = bucket_capacity;
+}
+
+
+static uint32_t rt_alloc_profile_intern_site(const RtType* type, const RtAllocProfileFrame* frames, uint32_t frame_count) {
+    const uint64_t hash = rt_alloc_profile_site_hash(type, frames, frame_count);
+
+    if (g_site_bucket_capacity != 0u) {
+        uint32_t bucket = (uint32_t)(hash & (g_site_bucket_capacity - 1u));
+        while (g_site_buckets[bucket] != UINT32_MAX) {
+            uint32_t site_index = g_site_buckets[bucket];
+            if (rt_alloc_profile_site_matches(&g_sites[site_index], hash, type, frames, frame_count)) {
+                return site_index;
+            }
+            bucket = (bucket + 1u) & (g_site_bucket_capacity - 1u);
+        }
+    }
+
+    if (g_site_count == g_site_capacity) {
+        g_sites = (RtAllocProfileSite*)rt_alloc_profile_grow(
+            g_sites,
+            &g_site_capacity,
+            RT_ALLOC_PROFILE_INITIAL_SITE_CAPACITY,
+            sizeof(RtAllocProfileSite)
+        );
+    }
+
+    const uint32_t site_index = g_site_count;
+    RtAllocProfileSite* site = &g_sites[site_index];
+    memset(site, 0, sizeof(*site));
+    site->type = type;
+    site->hash = hash;
+    site->frame_count = frame_count;
+    memcpy(site->frames, frames, (size_t)frame_count * sizeof(RtAllocProfileFrame));
+    g_site_count += 1u;
+
+    /* Keep the bucket table at most half full. */
+    if ((uint64_t)g_site_count * 2u > g_site_bucket_capacity) {
+        uint32_t bucket_capacity = g_site_bucket_capacity == 0u
+            ? RT_ALLOC_PROFILE_INITIAL_SITE_CAPACITY * 2u
+            : g_site_bucket_capacity * 2u;
+        rt_alloc_profile_rehash_sites(bucket_capacity);
+    } else {
+        uint32_t bucket = (uint32_t)(hash & (g_site_bucket_capacity - 1u));
+        while (g_site_buckets[bucket] != UINT32_MAX) {
+            bucket = (bucket + 1u) & (g_site_bucket_capacity - 1u);
+        }
+        g_site_buckets[bucket] = site_index;
+    }
+    return site_index;
+}
+
+
+static uint32_t rt_alloc_profile_capture_frames(RtAllocProfileFrame* frames) {
+    RtTraceFrame trace[RT_ALLOC_PROFILE_MAX_FRAME_DEPTH];
+    const uint32_t frame_count = rt_trace_capture(trace, g_frame_depth);
+    for (uint32_t index = 0; index < frame_count; index++) {
+        frames[index].function_name = trace[index].function_name;
+        frames[index].file_path = trace[index].file_path;
+        frames[index].line = trace[index].line;
+    }
+    return frame_count;
+}
+
+
+static void rt_alloc_profile_take_sample(RtObjHeader* obj) {
+    RtAllocProfileFrame frames[RT_ALLOC_PROFILE_MAX_FRAME_DEPTH];
+    const uint32_t frame_count = rt_alloc_profile_capture_frames(frames);
+    const uint32_t site_index = rt_alloc_profile_intern_site(obj->type, frames, frame_count);
+    const double scale = rt_alloc_profile_sample_scale(obj->size_bytes);
+
+    RtAllocProfileSite* site = &g_sites[site_index];
+    site->samples += 1u;
+    site->estimated_objects += scale;
+    site->estimated_bytes += scale * (double)obj->size_bytes;
+
+    if (g_sample_count == UINT32_MAX - 1u) {
+        return;
+    }
+    if (g_sample_count == g_sample_capacity) {
+        g_samples = (RtAllocProfileSample*)rt_alloc_profile_grow(
+            g_samples,
+            &g_sample_capacity,
+            RT_ALLOC_PROFILE_INITIAL_SAMPLE_CAPACITY,
+            sizeof(RtAllocProfileSample)
+        );
+    }
+
+    RtAllocProfileSample* sample = &g_samples[g_sample_count];
+    sample->obj = obj;
+    sample->site_index = site_index;
+    sample->survived_collections = 0u;
+    sample->estimated_objects = scale;
+    sample->estimated_bytes = scale * (double)obj->size_bytes;
+    g_sample_count += 1u;
+    obj->reserved0 = g_sample_count;
+
+    g_sampled_objects += 1u;
+    g_sampled_bytes += obj->size_bytes;
+}
+
+
+void rt_alloc_profile_note_allocation(RtObjHeader* obj) {
+    if (!rt_alloc_profile_is_enabled()) {
+        return;
+    }
+
+    if (obj->size_bytes < g_bytes_until_sample) {
+        g_bytes_until_sample -= obj->size_bytes;
+        return;
+    }
+
+    g_bytes_until_sample = rt_alloc_profile_next_interval();
+    rt_alloc_profile_take_sample(obj);
+}
+
+
+void rt_alloc_profile_note_free(RtObjHeader* obj) {
+    const uint32_t slot = obj->reserved0;
+    if (slot == 0u || slot > g_sample_count) {
+        return;
+    }
+    obj->reserved0 = 0u;
+
+    const uint32_t last = g_sample_count - 1u;
+    if (slot - 1u != last) {
+        g_samples[slot - 1u] = g_samples[last];
+        g_samples[slot - 1u].obj->reserved0 = slot;
+    }
+    g_sample_count = last;
+}
+
+
+void rt_alloc_profile_collect_end(void) {
+    for (uint32_t i = 0; i < g_sample_count; i++) {
+        RtAllocProfileSample* sample = &g_samples[i];
+        if (sample->survived_collections < UINT32_MAX) {
+            sample->survived_collections += 1u;
+        }
+        if (sample->survived_collections == 1u) {
+            RtAllocProfileSite* site = &g_sites[sample->site_index];
+            site->survivor_samples += 1u;
+            site->estimated_survivor_bytes += sample->estimated_bytes;
+            g_survivor_samples += 1u;
+        }
+    }
+}
+
+
+void rt_alloc_profile_configure(uint64_t sample_interval_bytes, uint32_t frame_depth) {
+    g_alloc_profile_enabled = sample_interval_bytes == 0u ? 0 : 1;
+    g_sample_interval_bytes = sample_interval_bytes;
+    g_frame_depth = rt_alloc_profile_clamp_depth(frame_depth);
+    g_bytes_until_sample = rt_alloc_profile_next_interval();
+}
+
+
+RtAllocProfileStats rt_alloc_profile_get_stats(void) {
+    RtAllocProfileStats stats;
+    stats.sample_interval_bytes = g_alloc_profile_enabled > 0 ? g_sample_interval_bytes : 0u;
+    stats.frame_depth = g_frame_depth;
+    stats.sampled_objects = g_sampled_objects;
+    stats.sampled_bytes = g_sampled_bytes;
+    stats.live_samples = g_sample_count;
+    stats.survivor_samples = g_survivor_samples;
+    stats.site_count = g_site_count;
+    return stats;
+}
+
+
+typedef enum RtAllocProfileOrder {
+    RT_ALLOC_PROFILE_ORDER_BYTES,
+    RT_ALLOC_PROFILE_ORDER_SURVIVOR_BYTES,
+} RtAllocProfileOrder;
+
+
+static int rt_alloc_profile_compare_doubles_desc(double lhs, double rhs) {
+    if (lhs > rhs) {
+        return -1;
+    }
+    if (lhs < rhs) {
+        return 1;
+    }
+    return 0;
+}
+
+
+static int rt_alloc_profile_compare_by_bytes(const void* lhs, const void* rhs) {
+    const RtAllocProfileSite* a = &g_sites[*(const uint32_t*)lhs];
+    const RtAllocProfileSite* b = &g_sites[*(const uint32_t*)rhs];
+    return rt_alloc_profile_compare_doubles_desc(a->estimated_bytes, b->estimated_bytes);
+}
+
+
+static int rt_alloc_profile_compare_by_survivor_bytes(const void* lhs, const void* rhs) {
+    const RtAllocProfileSite* a = &g_sites[*(const uint32_t*)lhs];
+    const RtAllocProfileSite* b = &g_sites[*(const uint32_t*)rhs];
+    int order = rt_alloc_profile_compare_doubles_desc(a->estimated_survivor_bytes, b->estimated_survivor_bytes);
+    if (order != 0) {
+        return order;
+    }
+    return rt_alloc_profile_compare_doubles_desc(a->estimated_bytes, b->estimated_bytes);
+}
+
+
+static void rt_alloc_profile_print_site(FILE* out, uint32_t rank, const RtAllocProfileSite* site) {
+    const char* type_name = (site->type != NULL && site->type->debug_name != NULL) ? site->type->debug_name : "<unknown>";
+    fprintf(
+        out,
+        "[alloc-profile] %3" PRIu32 " bytes=%.0f objects=%.0f samples=%" PRIu64
+        " survivor_bytes=%.0f live_bytes=%.0f type=%s\n",
+        rank,
+        site->estimated_bytes,
+        site->estimated_objects,
+        site->samples,
+        site->estimated_survivor_bytes,
+        site->estimated_live_bytes,
+        type_name
+    );
+    if (site->frame_count == 0u) {
+        fprintf(out, "[alloc-profile]       at <no trace frames>\n");
+        return;
+    }
+    for (uint32_t i = 0; i < site->frame_count; i++) {
+        const RtAllocProfileFrame* frame = &site->frames[i];
+        fprintf(
+            out,
+            "[alloc-profile]       at %s (%s:%u)\n",
+            frame->function_name ? frame->function_name : "<unknown>",
+            frame->file_path ? frame->file_path : "<unknown>",
+            frame->line
+        );
+    }
+}
+
+
+static void rt_alloc_profile_print_table(FILE* out, uint32_t* order, RtAllocProfileOrder kind, uint32_t rows) {
+    qsort(
+        order,
+        g_site_count,
+        sizeof(uint32_t),
+        kind == RT_ALLOC_PROFILE_ORDER_BYTES ? rt_alloc_profile_compare_by_bytes : rt_alloc_profile_compare_by_survivor_bytes
+    );
+    fprintf(
+        out,
+        "[alloc-profile] top sites by %s:\n",
+        kind == RT_ALLOC_PROFILE_ORDER_BYTES ? "allocated bytes" : "survivor bytes"
+    );
+    for (uint32_t rank = 0; rank < g_site_count && rank < rows; rank++) {
+        const RtAllocProfileSite* site = &g_sites[order[rank]];
+        if (kind == RT_ALLOC_PROFILE_ORDER_SURVIVOR_BYTES && site->estimated_survivor_bytes <= 0.0) {
+            break;
+        }
+        rt_alloc_profile_print_site(out, rank + 1u, site);
+    }
+}
+
+
+void rt_alloc_profile_print_report(void) {
+    if (g_alloc_profile_report_emitted || g_alloc_profile_enabled <= 0) {
+        return;
+    }
+    g_alloc_profile_report_emitted = 1;
+
+    double total_bytes = 0.0;
+    double total_survivor_bytes = 0.0;
+    for (uint32_t i = 0; i < g_site_count; i++) {
+        g_sites[i].estimated_live_bytes = 0.0;
+        total_bytes += g_sites[i].estimated_bytes;
+        total_survivor_bytes += g_sites[i].estimated_survivor_bytes;
+    }
+    for (uint32_t i = 0; i < g_sample_count; i++) {
+        g_sites[g_samples[i].site_index].estimated_live_bytes += g_samples[i].estimated_bytes;
+    }
+
+    FILE* out = stderr;
+    fprintf(
+        out,
+        "[alloc-profile] summary interval=%" PRIu64 "B depth=%" PRIu32 " samples=%" PRIu64
+        " sampled_bytes=%" PRIu64 "B est_bytes=%.0f est_survivor_bytes=%.0f sites=%" PRIu32 "\n",
+        g_sample_interval_bytes,
+        g_frame_depth,
+        g_sampled_objects,
+        g_sampled_bytes,
+        total_bytes,
+        total_survivor_bytes,
+        g_site_count
+    );
+    if (g_site_count == 0u) {
+        return;
+    }
+
+    uint32_t* order = (uint32_t*)malloc((size_t)g_site_count * sizeof(uint32_t));
+    if (order == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < g_site_count; i++) {
+        order[i] = i;
+    }
+
+    uint32_t rows = (uint32_t)rt_alloc_profile_parse_u64(
+        getenv("NIF_ALLOC_PROFILE_ROWS"),
+        RT_ALLOC_PROFILE_DEFAULT_REPORT_ROWS
+    );
+    rt_alloc_profile_print_table(out, order, RT_ALLOC_PROFILE_ORDER_BYTES, rows);
+    rt_alloc_profile_print_table(out, order, RT_ALLOC_PROFILE_ORDER_SURVIVOR_BYTES, rows);
+    free(order);
+}
+
+
+void rt_alloc_profile_reset(void) {
+    for (uint32_t i = 0; i < g_sample_count; i++) {
+        g_samples[i].obj->reserved0 = 0u;
+    }
+    free(g_sites);
+    free(g_site_buckets);
+    free(g_samples);
+    g_sites = NULL;
+    g_site_count = 0u;
+    g_site_capacity = 0u;
+    g_site_buckets = NULL;
+    g_site_bucket_capacity = 0u;
+    g_samples = NULL;
+    g_sample_count = 0u;
+    g_sample_capacity = 0u;
+    g_sampled_objects = 0u;
+    g_sampled_bytes = 0u;
+    g_survivor_samples = 0u;
+    g_bytes_until_sample = 0u;
+    g_rng_state = 0x9e3779b97f4a7c15u;
+    g_sample_interval_bytes = RT_ALLOC_PROFILE_DEFAULT_INTERVAL_BYTES;
+    g_frame_depth = RT_ALLOC_PROFILE_DEFAULT_FRAME_DEPTH;
+    g_alloc_profile_enabled = -1;
+    g_alloc_profile_report_emitted = 0;
+}
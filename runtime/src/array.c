@@ -36,7 +36,7 @@ RtType rt_type_array_primitive_desc = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0u,
@@ -56,7 +56,7 @@ RtType rt_type_array_reference_desc = {
     .trace_fn = rt_array_trace_ref,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0u,
@@ -167,6 +167,17 @@ static void* rt_array_slice(const void* array_obj, uint64_t kind, int64_t start,
     return (void*)slice;
 }
 
+static void rt_array_copy_elements(RtArrayObj* target, uint64_t target_index, const RtArrayObj* source, uint64_t source_index, uint64_t count) {
+    uint64_t copy_bytes = rt_mul_u64_checked(count, target->element_size);
+    if (copy_bytes > 0) {
+        memmove(
+            target->data + rt_mul_u64_checked(target_index, target->element_size),
+            source->data + rt_mul_u64_checked(source_index, source->element_size),
+            (size_t)copy_bytes
+        );
+    }
+}
+
 static void rt_array_set_slice(void* array_obj, uint64_t kind, int64_t start, int64_t end, const void* value_array_obj, const char* api_name) {
     RtArrayObj* target = rt_require_array_kind(array_obj, kind, api_name);
     RtArrayObj* value = rt_require_array_kind(value_array_obj, kind, api_name);
@@ -180,11 +191,18 @@ static void rt_array_set_slice(void* array_obj, uint64_t kind, int64_t start, in
         rt_panic(api_name);
     }
 
-    uint64_t byte_offset = rt_mul_u64_checked(start_u, target->element_size);
-    uint64_t copy_bytes = rt_mul_u64_checked(slice_len, target->element_size);
-    if (copy_bytes > 0) {
-        memcpy(target->data + byte_offset, value->data, (size_t)copy_bytes);
+    rt_array_copy_elements(target, start_u, value, 0u, slice_len);
+}
+
+/* Loop-idiom kernels handle the prefix of [start, end) that a compiled loop over the array
+ * would complete without panicking, and return the first index they left untouched. The
+ * loop resumes from there, so null arrays and out-of-range indices still fail inside the
+ * loop body with the usual diagnostics. */
+static int64_t rt_array_idiom_stop(const RtArrayObj* array, int64_t start, int64_t end) {
+    if (array == NULL || start < 0 || end <= start || (uint64_t)start >= array->len) {
+        return start;
     }
+    return (uint64_t)end < array->len ? end : (int64_t)array->len;
 }
 
 void* rt_array_new_i64(uint64_t len) {
@@ -351,3 +369,93 @@ void rt_array_set_slice_double(void* array_obj, int64_t start, int64_t end, cons
 void rt_array_set_slice_ref(void* array_obj, int64_t start, int64_t end, const void* value_array_obj) {
     rt_array_set_slice(array_obj, RT_ARRAY_KIND_REF, start, end, value_array_obj, "rt_array_set_slice_ref: invalid slice assignment");
 }
+
+int64_t rt_array_fill_i64(void* array_obj, int64_t start, int64_t end, int64_t value) {
+    RtArrayObj* array = (RtArrayObj*)array_obj;
+    int64_t stop = rt_array_idiom_stop(array, start, end);
+    for (int64_t index = start; index < stop; index++) {
+        ((int64_t*)(void*)array->data)[index] = value;
+    }
+    return stop;
+}
+
+int64_t rt_array_fill_u64(void* array_obj, int64_t start, int64_t end, uint64_t value) {
+    RtArrayObj* array = (RtArrayObj*)array_obj;
+    int64_t stop = rt_array_idiom_stop(array, start, end);
+    for (int64_t index = start; index < stop; index++) {
+        ((uint64_t*)(void*)array->data)[index] = value;
+    }
+    return stop;
+}
+
+int64_t rt_array_fill_u8(void* array_obj, int64_t start, int64_t end, uint64_t value) {
+    RtArrayObj* array = (RtArrayObj*)array_obj;
+    int64_t stop = rt_array_idiom_stop(array, start, end);
+    if (stop > start) {
+        memset(array->data + start, (int)(uint8_t)value, (size_t)(stop - start));
+    }
+    return stop;
+}
+
+int64_t rt_array_fill_bool(void* array_obj, int64_t start, int64_t end, int64_t value) {
+    return rt_array_fill_i64(array_obj, start, end, value != 0 ? 1 : 0);
+}
+
+int64_t rt_array_fill_double(void* array_obj, int64_t start, int64_t end, double value) {
+    RtArrayObj* array = (RtArrayObj*)array_obj;
+    int64_t stop = rt_array_idiom_stop(array, start, end);
+    for (int64_t index = start; index < stop; index++) {
+        ((double*)(void*)array->data)[index] = value;
+    }
+    return stop;
+}
+
+int64_t rt_array_fill_ref(void* array_obj, int64_t start, int64_t end, void* value) {
+    RtArrayObj* array = (RtArrayObj*)array_obj;
+    int64_t stop = rt_array_idiom_stop(array, start, end);
+    for (int64_t index = start; index < stop; index++) {
+        ((void**)(void*)array->data)[index] = value;
+    }
+    return stop;
+}
+
+int64_t rt_array_copy_range(void* target_obj, const void* source_obj, int64_t start, int64_t end) {
+    RtArrayObj* target = (RtArrayObj*)target_obj;
+    const RtArrayObj* source = (const RtArrayObj*)source_obj;
+    int64_t stop = rt_array_idiom_stop(source, start, end);
+    stop = rt_array_idiom_stop(target, start, stop);
+    if (stop > start) {
+        rt_array_copy_elements(target, (uint64_t)start, source, (uint64_t)start, (uint64_t)(stop - start));
+    }
+    return stop;
+}
+
+int64_t rt_array_mismatch_range(const void* left_obj, const void* right_obj, int64_t start, int64_t end) {
+    enum { RT_ARRAY_MISMATCH_CHUNK_BYTES = 256u };
+    const RtArrayObj* left = (const RtArrayObj*)left_obj;
+    const RtArrayObj* right = (const RtArrayObj*)right_obj;
+    int64_t stop = rt_array_idiom_stop(left, start, end);
+    stop = rt_array_idiom_stop(right, start, stop);
+    if (stop == start) {
+        return start;
+    }
+
+    uint64_t element_size = left->element_size;
+    uint64_t chunk_elements = RT_ARRAY_MISMATCH_CHUNK_BYTES / element_size;
+    int64_t index = start;
+    while (index < stop) {
+        uint64_t remaining = (uint64_t)(stop - index);
+        uint64_t count = remaining < chunk_elements ? remaining : chunk_elements;
+        const uint8_t* left_bytes = left->data + (uint64_t)index * element_size;
+        const uint8_t* right_bytes = right->data + (uint64_t)index * element_size;
+        if (memcmp(left_bytes, right_bytes, (size_t)(count * element_size)) != 0) {
+            for (uint64_t offset = 0u; offset < count; offset++) {
+                if (memcmp(left_bytes + offset * element_size, right_bytes + offset * element_size, (size_t)element_size) != 0) {
+                    return index + (int64_t)offset;
+                }
+            }
+        }
+        index += (int64_t)count;
+    }
+    return stop;
+}
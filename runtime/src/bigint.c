@@ -0,0 +1,796 @@
+#include "bigint_rt.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "array.h"
+#include "panic.h"
+
+
+/* Magnitude kernels behind std.bigint. Operands are u64[] arrays of little-endian limbs; every kernel writes
+ * into an output array the caller allocated, so none of them touches the managed heap. Scratch space for the
+ * recursive algorithms comes from malloc. */
+
+typedef unsigned __int128 RtLimbWide;
+
+enum {
+    /* Balanced products at or above this many limbs split with Karatsuba. */
+    RT_BIGINT_KARATSUBA_THRESHOLD = 32,
+    /* Divisors and quotients at or above this many limbs use Burnikel-Ziegler recursive division. */
+    RT_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD = 48,
+    /* Decimal conversion splits values above this many limbs around a power of ten. */
+    RT_BIGINT_DECIMAL_BASE_LIMBS = 24,
+    RT_BIGINT_DECIMAL_CHUNK_DIGITS = 19,
+    RT_BIGINT_MAX_DECIMAL_POWERS = 64,
+};
+
+static const uint64_t RT_BIGINT_DECIMAL_CHUNK = 10000000000000000000u;
+
+typedef struct RtBigIntDecimalPowers {
+    /* limbs[k] holds 10^(19 * 2^k). */
+    uint64_t* limbs[RT_BIGINT_MAX_DECIMAL_POWERS];
+    size_t lens[RT_BIGINT_MAX_DECIMAL_POWERS];
+    size_t count;
+} RtBigIntDecimalPowers;
+
+
+static uint64_t* rt_bigint_scratch(size_t count) {
+    uint64_t* limbs = (uint64_t*)calloc(count == 0u ? 1u : count, sizeof(uint64_t));
+    if (limbs == NULL) {
+        rt_panic_oom();
+    }
+    return limbs;
+}
+
+static const uint64_t* rt_bigint_limbs(const void* limbs_obj) {
+    return (const uint64_t*)rt_array_data_ptr(limbs_obj);
+}
+
+static uint64_t* rt_bigint_mutable_limbs(void* limbs_obj) {
+    return (uint64_t*)rt_array_data_ptr(limbs_obj);
+}
+
+static size_t rt_bigint_trimmed_len(const uint64_t* limbs, size_t len) {
+    while (len > 0u && limbs[len - 1u] == 0u) {
+        len--;
+    }
+    return len;
+}
+
+static size_t rt_bigint_array_trimmed_len(const void* limbs_obj) {
+    return rt_bigint_trimmed_len(rt_bigint_limbs(limbs_obj), (size_t)rt_array_len(limbs_obj));
+}
+
+static void rt_bigint_require_capacity(const void* out_obj, size_t required, const char* message) {
+    if ((size_t)rt_array_len(out_obj) < required) {
+        rt_panic(message);
+    }
+}
+
+/* Zeroes the unused tail of an output array and returns the trimmed length of what was written. */
+static uint64_t rt_bigint_finish_output(void* out_obj, size_t written) {
+    uint64_t* out = rt_bigint_mutable_limbs(out_obj);
+    const size_t capacity = (size_t)rt_array_len(out_obj);
+    if (written < capacity) {
+        memset(out + written, 0, (capacity - written) * sizeof(uint64_t));
+    }
+    return (uint64_t)rt_bigint_trimmed_len(out, written);
+}
+
+static int rt_bigint_compare_limbs(const uint64_t* left, size_t left_len, const uint64_t* right, size_t right_len) {
+    left_len = rt_bigint_trimmed_len(left, left_len);
+    right_len = rt_bigint_trimmed_len(right, right_len);
+    if (left_len != right_len) {
+        return left_len < right_len ? -1 : 1;
+    }
+    while (left_len > 0u) {
+        left_len--;
+        if (left[left_len] != right[left_len]) {
+            return left[left_len] < right[left_len] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/* out = left + right over left_len limbs (left_len >= right_len); returns the carry out. out may alias left. */
+static uint64_t rt_bigint_add_limbs(
+    uint64_t* out,
+    const uint64_t* left,
+    size_t left_len,
+    const uint64_t* right,
+    size_t right_len
+) {
+    uint64_t carry = 0u;
+    size_t i = 0u;
+    for (; i < right_len; i++) {
+        uint64_t sum;
+        const uint64_t overflow = (uint64_t)__builtin_add_overflow(left[i], right[i], &sum);
+        carry = overflow | (uint64_t)__builtin_add_overflow(sum, carry, &out[i]);
+    }
+    for (; i < left_len; i++) {
+        carry = (uint64_t)__builtin_add_overflow(left[i], carry, &out[i]);
+    }
+    return carry;
+}
+
+/* out = left - right over left_len limbs (left_len >= right_len); returns the borrow out. out may alias left. */
+static uint64_t rt_bigint_sub_limbs(
+    uint64_t* out,
+    const uint64_t* left,
+    size_t left_len,
+    const uint64_t* right,
+    size_t right_len
+) {
+    uint64_t borrow = 0u;
+    size_t i = 0u;
+    for (; i < right_len; i++) {
+        uint64_t diff;
+        const uint64_t underflow = (uint64_t)__builtin_sub_overflow(left[i], right[i], &diff);
+        borrow = underflow | (uint64_t)__builtin_sub_overflow(diff, borrow, &out[i]);
+    }
+    for (; i < left_len; i++) {
+        borrow = (uint64_t)__builtin_sub_overflow(left[i], borrow, &out[i]);
+    }
+    return borrow;
+}
+
+static void rt_bigint_propagate_carry(uint64_t* limbs, size_t len, uint64_t carry) {
+    for (size_t i = 0u; carry != 0u && i < len; i++) {
+        carry = (uint64_t)__builtin_add_overflow(limbs[i], carry, &limbs[i]);
+    }
+}
+
+/* out = limbs * factor + addend over len limbs; returns the high limb. out may alias limbs. */
+static uint64_t rt_bigint_mul_word_add_limbs(
+    uint64_t* out,
+    const uint64_t* limbs,
+    size_t len,
+    uint64_t factor,
+    uint64_t addend
+) {
+    uint64_t carry = addend;
+    for (size_t i = 0u; i < len; i++) {
+        const RtLimbWide product = (RtLimbWide)limbs[i] * factor + carry;
+        out[i] = (uint64_t)product;
+        carry = (uint64_t)(product >> 64);
+    }
+    return carry;
+}
+
+/* acc += limbs * factor over len limbs; returns the carry into acc[len]. */
+static uint64_t rt_bigint_addmul_word(uint64_t* acc, const uint64_t* limbs, size_t len, uint64_t factor) {
+    uint64_t carry = 0u;
+    for (size_t i = 0u; i < len; i++) {
+        const RtLimbWide product = (RtLimbWide)limbs[i] * factor + acc[i] + carry;
+        acc[i] = (uint64_t)product;
+        carry = (uint64_t)(product >> 64);
+    }
+    return carry;
+}
+
+/* acc -= limbs * factor over len limbs; returns the borrow out of acc[len - 1]. */
+static uint64_t rt_bigint_submul_word(uint64_t* acc, const uint64_t* limbs, size_t len, uint64_t factor) {
+    uint64_t borrow = 0u;
+    for (size_t i = 0u; i < len; i++) {
+        const RtLimbWide product = (RtLimbWide)limbs[i] * factor + borrow;
+        const uint64_t low = (uint64_t)product;
+        const uint64_t value = acc[i];
+        borrow = (uint64_t)(product >> 64) + (uint64_t)(value < low);
+        acc[i] = value - low;
+    }
+    return borrow;
+}
+
+/* quotient = limbs / divisor; returns the remainder. quotient may alias limbs. */
+static uint64_t rt_bigint_divrem_word_limbs(uint64_t* quotient, const uint64_t* limbs, size_t len, uint64_t divisor) {
+    uint64_t remainder = 0u;
+    while (len > 0u) {
+        len--;
+        const RtLimbWide current = ((RtLimbWide)remainder << 64) | limbs[len];
+        const uint64_t digit = (uint64_t)(current / divisor);
+        remainder = (uint64_t)(current - (RtLimbWide)digit * divisor);
+        quotient[len] = digit;
+    }
+    return remainder;
+}
+
+static uint64_t rt_bigint_shift_left(uint64_t* out, const uint64_t* limbs, size_t len, unsigned shift) {
+    if (shift == 0u) {
+        memmove(out, limbs, len * sizeof(uint64_t));
+        return 0u;
+    }
+    uint64_t carry = 0u;
+    for (size_t i = 0u; i < len; i++) {
+        const uint64_t limb = limbs[i];
+        out[i] = (limb << shift) | carry;
+        carry = limb >> (64u - shift);
+    }
+    return carry;
+}
+
+static void rt_bigint_shift_right(uint64_t* out, const uint64_t* limbs, size_t len, unsigned shift) {
+    if (shift == 0u) {
+        memmove(out, limbs, len * sizeof(uint64_t));
+        return;
+    }
+    for (size_t i = 0u; i < len; i++) {
+        const uint64_t high = i + 1u < len ? limbs[i + 1u] << (64u - shift) : 0u;
+        out[i] = (limbs[i] >> shift) | high;
+    }
+}
+
+
+static void rt_bigint_mul_limbs(
+    uint64_t* out,
+    const uint64_t* left,
+    size_t left_len,
+    const uint64_t* right,
+    size_t right_len
+);
+
+static void rt_bigint_mul_schoolbook(
+    uint64_t* out,
+    const uint64_t* left,
+    size_t left_len,
+    const uint64_t* right,
+    size_t right_len
+) {
+    memset(out, 0, (left_len + right_len) * sizeof(uint64_t));
+    for (size_t i = 0u; i < right_len; i++) {
+        out[i + left_len] = rt_bigint_addmul_word(out + i, left, left_len, right[i]);
+    }
+}
+
+/* Karatsuba on two len-limb operands: three half-size products instead of four. */
+static void rt_bigint_mul_karatsuba(uint64_t* out, const uint64_t* left, const uint64_t* right, size_t len) {
+    const size_t low_len = len / 2u;
+    const size_t high_len = len - low_len;
+    const size_t sum_capacity = high_len + 1u;
+
+    rt_bigint_mul_limbs(out, left, low_len, right, low_len);
+    rt_bigint_mul_limbs(out + 2u * low_len, left + low_len, high_len, right + low_len, high_len);
+
+    uint64_t* scratch = rt_bigint_scratch(4u * sum_capacity);
+    uint64_t* left_sum = scratch;
+    uint64_t* right_sum = scratch + sum_capacity;
+    uint64_t* middle = scratch + 2u * sum_capacity;
+
+    left_sum[high_len] = rt_bigint_add_limbs(left_sum, left + low_len, high_len, left, low_len);
+    right_sum[high_len] = rt_bigint_add_limbs(right_sum, right + low_len, high_len, right, low_len);
+    const size_t sum_len = (left_sum[high_len] | right_sum[high_len]) != 0u ? sum_capacity : high_len;
+
+    rt_bigint_mul_limbs(middle, left_sum, sum_len, right_sum, sum_len);
+    size_t middle_len = 2u * sum_len;
+    rt_bigint_sub_limbs(middle, middle, middle_len, out, 2u * low_len);
+    rt_bigint_sub_limbs(middle, middle, middle_len, out + 2u * low_len, 2u * high_len);
+    middle_len = rt_bigint_trimmed_len(middle, middle_len);
+    rt_bigint_add_limbs(out + low_len, out + low_len, 2u * len - low_len, middle, middle_len);
+    free(scratch);
+}
+
+/* out[0, left_len + right_len) = left * right. out must not alias either operand. */
+static void rt_bigint_mul_limbs(
+    uint64_t* out,
+    const uint64_t* left,
+    size_t left_len,
+    const uint64_t* right,
+    size_t right_len
+) {
+    if (left_len < right_len) {
+        const uint64_t* swapped = left;
+        left = right;
+        right = swapped;
+        const size_t swapped_len = left_len;
+        left_len = right_len;
+        right_len = swapped_len;
+    }
+    if (right_len < RT_BIGINT_KARATSUBA_THRESHOLD) {
+        rt_bigint_mul_schoolbook(out, left, left_len, right, right_len);
+        return;
+    }
+    if (left_len == right_len) {
+        rt_bigint_mul_karatsuba(out, left, right, left_len);
+        return;
+    }
+
+    /* Unbalanced operands: multiply right by right_len-sized slices of left and accumulate. */
+    const size_t out_len = left_len + right_len;
+    memset(out, 0, out_len * sizeof(uint64_t));
+    uint64_t* partial = rt_bigint_scratch(2u * right_len);
+    for (size_t offset = 0u; offset < left_len; offset += right_len) {
+        const size_t slice_len = left_len - offset < right_len ? left_len - offset : right_len;
+        const size_t partial_len = slice_len + right_len;
+        rt_bigint_mul_limbs(partial, left + offset, slice_len, right, right_len);
+        const uint64_t carry = rt_bigint_add_limbs(out + offset, out + offset, partial_len, partial, partial_len);
+        rt_bigint_propagate_carry(out + offset + partial_len, out_len - offset - partial_len, carry);
+    }
+    free(partial);
+}
+
+
+/* Knuth algorithm D. The divisor is normalized (top bit set, divisor_len >= 2) and the top divisor_len limbs
+ * of the numerator are below it. On return quotient holds numerator_len - divisor_len limbs and the
+ * numerator holds the remainder in its low divisor_len limbs, zero above. */
+static void rt_bigint_divrem_schoolbook(
+    uint64_t* quotient,
+    uint64_t* numerator,
+    size_t numerator_len,
+    const uint64_t* divisor,
+    size_t divisor_len
+) {
+    const uint64_t divisor_high = divisor[divisor_len - 1u];
+    const uint64_t divisor_next = divisor[divisor_len - 2u];
+    for (size_t j = numerator_len - divisor_len; j-- > 0u;) {
+        uint64_t* window = numerator + j;
+        const RtLimbWide top = ((RtLimbWide)window[divisor_len] << 64) | window[divisor_len - 1u];
+        RtLimbWide digit = top / divisor_high;
+        RtLimbWide rest = top - digit * divisor_high;
+        while (digit > UINT64_MAX || digit * divisor_next > ((rest << 64) | window[divisor_len - 2u])) {
+            digit--;
+            rest += divisor_high;
+            if (rest > UINT64_MAX) {
+                break;
+            }
+        }
+
+        const uint64_t borrow = rt_bigint_submul_word(window, divisor, divisor_len, (uint64_t)digit);
+        const uint64_t head = window[divisor_len];
+        window[divisor_len] = head - borrow;
+        if (head < borrow) {
+            digit--;
+            window[divisor_len] += rt_bigint_add_limbs(window, window, divisor_len, divisor, divisor_len);
+        }
+        quotient[j] = (uint64_t)digit;
+    }
+}
+
+static void rt_bigint_div_3n_by_2n(uint64_t* quotient, uint64_t* window, const uint64_t* divisor, size_t half);
+
+/* Burnikel-Ziegler: divides the 2 * len limb window by the normalized len-limb divisor, which must exceed the
+ * window's top len limbs. The quotient gets len limbs; the window keeps the remainder in its low len limbs. */
+static void rt_bigint_div_2n_by_n(uint64_t* quotient, uint64_t* window, const uint64_t* divisor, size_t len) {
+    if (len < RT_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD) {
+        rt_bigint_divrem_schoolbook(quotient, window, 2u * len, divisor, len);
+        return;
+    }
+    if ((len & 1u) != 0u) {
+        /* Scale both operands by one limb so the halves split evenly; the quotient is unchanged. */
+        const size_t padded_len = len + 1u;
+        uint64_t* scratch = rt_bigint_scratch(4u * padded_len);
+        uint64_t* padded_window = scratch;
+        uint64_t* padded_divisor = scratch + 2u * padded_len;
+        uint64_t* padded_quotient = padded_divisor + padded_len;
+        memcpy(padded_window + 1u, window, 2u * len * sizeof(uint64_t));
+        memcpy(padded_divisor + 1u, divisor, len * sizeof(uint64_t));
+        rt_bigint_div_2n_by_n(padded_quotient, padded_window, padded_divisor, padded_len);
+        memcpy(quotient, padded_quotient, len * sizeof(uint64_t));
+        memcpy(window, padded_window + 1u, 2u * len * sizeof(uint64_t));
+        free(scratch);
+        return;
+    }
+
+    const size_t half = len / 2u;
+    rt_bigint_div_3n_by_2n(quotient + half, window + half, divisor, half);
+    rt_bigint_div_3n_by_2n(quotient, window, divisor, half);
+}
+
+/* Divides the 3 * half limb window by the 2 * half limb divisor, which must exceed the window's top 2 * half
+ * limbs. The quotient gets half limbs; the window keeps the remainder in its low 2 * half limbs. */
+static void rt_bigint_div_3n_by_2n(uint64_t* quotient, uint64_t* window, const uint64_t* divisor, size_t half) {
+    const size_t len = 2u * half;
+    const uint64_t* divisor_high = divisor + half;
+    uint64_t* scratch = rt_bigint_scratch(2u * len + 1u);
+    uint64_t* remainder = scratch;
+    uint64_t* product = scratch + len + 1u;
+
+    if (memcmp(window + len, divisor_high, half * sizeof(uint64_t)) == 0) {
+        /* The top halves match, so the estimate saturates at B^half - 1 with remainder a2 + b1. */
+        memset(quotient, 0xff, half * sizeof(uint64_t));
+        memcpy(remainder, window, half * sizeof(uint64_t));
+        remainder[len] = rt_bigint_add_limbs(remainder + half, window + half, half, divisor_high, half);
+    } else {
+        rt_bigint_div_2n_by_n(quotient, window + half, divisor_high, half);
+        memcpy(remainder, window, len * sizeof(uint64_t));
+    }
+
+    rt_bigint_mul_limbs(product, quotient, half, divisor, half);
+    while (rt_bigint_compare_limbs(remainder, len + 1u, product, len) < 0) {
+        rt_bigint_sub_limbs(quotient, quotient, half, (const uint64_t[]){1u}, 1u);
+        remainder[len] += rt_bigint_add_limbs(remainder, remainder, len, divisor, len);
+    }
+    rt_bigint_sub_limbs(remainder, remainder, len + 1u, product, len);
+    memcpy(window, remainder, len * sizeof(uint64_t));
+    memset(window + len, 0, half * sizeof(uint64_t));
+    free(scratch);
+}
+
+/* Same contract as rt_bigint_divrem_schoolbook; large operands run as a sequence of 2n-by-n block steps. */
+static void rt_bigint_divrem_normalized(
+    uint64_t* quotient,
+    uint64_t* numerator,
+    size_t numerator_len,
+    const uint64_t* divisor,
+    size_t divisor_len
+) {
+    const size_t quotient_len = numerator_len - divisor_len;
+    if (divisor_len < RT_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD || quotient_len < RT_BIGINT_BURNIKEL_ZIEGLER_THRESHOLD) {
+        rt_bigint_divrem_schoolbook(quotient, numerator, numerator_len, divisor, divisor_len);
+        return;
+    }
+
+    /* Zero-extend the numerator so the quotient is a whole number of divisor-sized blocks. */
+    const size_t block_count = (quotient_len + divisor_len - 1u) / divisor_len;
+    const size_t padded_quotient_len = block_count * divisor_len;
+    uint64_t* scratch = rt_bigint_scratch(2u * padded_quotient_len + divisor_len);
+    uint64_t* padded_numerator = scratch;
+    uint64_t* padded_quotient = scratch + padded_quotient_len + divisor_len;
+    memcpy(padded_numerator, numerator, numerator_len * sizeof(uint64_t));
+
+    for (size_t block = block_count; block-- > 0u;) {
+        const size_t offset = block * divisor_len;
+        rt_bigint_div_2n_by_n(padded_quotient + offset, padded_numerator + offset, divisor, divisor_len);
+    }
+
+    memcpy(quotient, padded_quotient, quotient_len * sizeof(uint64_t));
+    memcpy(numerator, padded_numerator, numerator_len * sizeof(uint64_t));
+    free(scratch);
+}
+
+/* quotient[0, numerator_len - divisor_len + 1) and remainder[0, divisor_len) for trimmed operands with
+ * numerator_len >= divisor_len >= 1. */
+static void rt_bigint_divrem_limbs(
+    uint64_t* quotient,
+    uint64_t* remainder,
+    const uint64_t* numerator,
+    size_t numerator_len,
+    const uint64_t* divisor,
+    size_t divisor_len
+) {
+    if (divisor_len == 1u) {
+        remainder[0] = rt_bigint_divrem_word_limbs(quotient, numerator, numerator_len, divisor[0]);
+        return;
+    }
+
+    const unsigned shift = (unsigned)__builtin_clzll(divisor[divisor_len - 1u]);
+    uint64_t* scratch = rt_bigint_scratch(numerator_len + 1u + divisor_len);
+    uint64_t* shifted_numerator = scratch;
+    uint64_t* shifted_divisor = scratch + numerator_len + 1u;
+    rt_bigint_shift_left(shifted_divisor, divisor, divisor_len, shift);
+    shifted_numerator[numerator_len] = rt_bigint_shift_left(shifted_numerator, numerator, numerator_len, shift);
+    rt_bigint_divrem_normalized(quotient, shifted_numerator, numerator_len + 1u, shifted_divisor, divisor_len);
+    rt_bigint_shift_right(remainder, shifted_numerator, divisor_len, shift);
+    free(scratch);
+}
+
+
+static void rt_bigint_decimal_powers_init(RtBigIntDecimalPowers* powers) {
+    powers->count = 1u;
+    powers->limbs[0] = rt_bigint_scratch(1u);
+    powers->limbs[0][0] = RT_BIGINT_DECIMAL_CHUNK;
+    powers->lens[0] = 1u;
+}
+
+/* Squares the largest power until the next one would have more than max_len limbs. */
+static void rt_bigint_decimal_powers_extend(RtBigIntDecimalPowers* powers, size_t max_len) {
+    while (powers->count < RT_BIGINT_MAX_DECIMAL_POWERS && 2u * powers->lens[powers->count - 1u] <= max_len) {
+        const uint64_t* base = powers->limbs[powers->count - 1u];
+        const size_t base_len = powers->lens[powers->count - 1u];
+        uint64_t* square = rt_bigint_scratch(2u * base_len);
+        rt_bigint_mul_limbs(square, base, base_len, base, base_len);
+        powers->limbs[powers->count] = square;
+        powers->lens[powers->count] = rt_bigint_trimmed_len(square, 2u * base_len);
+        powers->count++;
+    }
+}
+
+static void rt_bigint_decimal_powers_free(RtBigIntDecimalPowers* powers) {
+    for (size_t i = 0u; i < powers->count; i++) {
+        free(powers->limbs[i]);
+    }
+}
+
+/* Writes exactly width digits of the value, zero-padded on the left; the value must be below 10^width. */
+static void rt_bigint_write_decimal(
+    uint8_t* out,
+    size_t width,
+    const uint64_t* limbs,
+    size_t len,
+    const RtBigIntDecimalPowers* powers
+) {
+    len = rt_bigint_trimmed_len(limbs, len);
+    if (len <= RT_BIGINT_DECIMAL_BASE_LIMBS) {
+        uint64_t value[RT_BIGINT_DECIMAL_BASE_LIMBS];
+        memcpy(value, limbs, len * sizeof(uint64_t));
+        size_t position = width;
+        while (len > 0u) {
+            uint64_t chunk = rt_bigint_divrem_word_limbs(value, value, len, RT_BIGINT_DECIMAL_CHUNK);
+            len = rt_bigint_trimmed_len(value, len);
+            for (int digit = 0; digit < RT_BIGINT_DECIMAL_CHUNK_DIGITS && position > 0u; digit++) {
+                out[--position] = (uint8_t)('0' + chunk % 10u);
+                chunk /= 10u;
+            }
+        }
+        memset(out, '0', position);
+        return;
+    }
+
+    /* Split around the largest cached power with at most half the limbs; it is below the value, so the
+     * high part needs at least one digit of the width. */
+    size_t level = 0u;
+    while (level + 1u < powers->count && 2u * powers->lens[level + 1u] <= len) {
+        level++;
+    }
+    const uint64_t* power = powers->limbs[level];
+    const size_t power_len = powers->lens[level];
+    const size_t low_width = (size_t)RT_BIGINT_DECIMAL_CHUNK_DIGITS << level;
+    const size_t quotient_len = len - power_len + 1u;
+
+    uint64_t* scratch = rt_bigint_scratch(quotient_len + power_len);
+    uint64_t* quotient = scratch;
+    uint64_t* remainder = scratch + quotient_len;
+    rt_bigint_divrem_limbs(quotient, remainder, limbs, len, power, power_len);
+    rt_bigint_write_decimal(out, width - low_width, quotient, quotient_len, powers);
+    rt_bigint_write_decimal(out + width - low_width, low_width, remainder, power_len, powers);
+    free(scratch);
+}
+
+/* Parses count ASCII digits into out, which holds count / 19 + 1 limbs; returns the trimmed length. */
+static size_t rt_bigint_read_decimal(
+    uint64_t* out,
+    const uint8_t* digits,
+    size_t count,
+    const RtBigIntDecimalPowers* powers
+) {
+    const size_t capacity = count / RT_BIGINT_DECIMAL_CHUNK_DIGITS + 1u;
+    memset(out, 0, capacity * sizeof(uint64_t));
+    if (count <= (size_t)RT_BIGINT_DECIMAL_CHUNK_DIGITS * RT_BIGINT_DECIMAL_BASE_LIMBS) {
+        size_t len = 0u;
+        size_t index = 0u;
+        size_t chunk_digits = count % RT_BIGINT_DECIMAL_CHUNK_DIGITS;
+        if (chunk_digits == 0u) {
+            chunk_digits = RT_BIGINT_DECIMAL_CHUNK_DIGITS;
+        }
+        while (index < count) {
+            uint64_t chunk = 0u;
+            uint64_t scale = 1u;
+            for (size_t digit = 0u; digit < chunk_digits; digit++) {
+                chunk = chunk * 10u + (uint64_t)(digits[index + digit] - '0');
+                scale *= 10u;
+            }
+            out[len] = rt_bigint_mul_word_add_limbs(out, out, len, scale, chunk);
+            if (out[len] != 0u) {
+                len++;
+            }
+            index += chunk_digits;
+            chunk_digits = RT_BIGINT_DECIMAL_CHUNK_DIGITS;
+        }
+        return len;
+    }
+
+    /* value = high * 10^low_count + low, splitting at the largest cached power below the digit count. */
+    size_t level = 0u;
+    while (level + 1u < powers->count && ((size_t)RT_BIGINT_DECIMAL_CHUNK_DIGITS << (level + 1u)) < count) {
+        level++;
+    }
+    const size_t low_count = (size_t)RT_BIGINT_DECIMAL_CHUNK_DIGITS << level;
+    const size_t high_count = count - low_count;
+    const uint64_t* power = powers->limbs[level];
+    const size_t power_len = powers->lens[level];
+
+    const size_t high_capacity = high_count / RT_BIGINT_DECIMAL_CHUNK_DIGITS + 1u;
+    const size_t low_capacity = low_count / RT_BIGINT_DECIMAL_CHUNK_DIGITS + 1u;
+    uint64_t* scratch = rt_bigint_scratch(high_capacity + low_capacity + high_capacity + power_len);
+    uint64_t* high = scratch;
+    uint64_t* low = high + high_capacity;
+    uint64_t* product = low + low_capacity;
+    const size_t high_len = rt_bigint_read_decimal(high, digits, high_count, powers);
+    const size_t low_len = rt_bigint_read_decimal(low, digits + high_count, low_count, powers);
+
+    size_t len = low_len;
+    if (high_len == 0u) {
+        memcpy(out, low, low_len * sizeof(uint64_t));
+    } else {
+        size_t product_len = high_len + power_len;
+        rt_bigint_mul_limbs(product, high, high_len, power, power_len);
+        rt_bigint_add_limbs(product, product, product_len, low, low_len);
+        len = rt_bigint_trimmed_len(product, product_len);
+        memcpy(out, product, len * sizeof(uint64_t));
+    }
+    free(scratch);
+    return len;
+}
+
+
+int64_t rt_bigint_compare(const void* left_limbs_obj, const void* right_limbs_obj) {
+    return (int64_t)rt_bigint_compare_limbs(
+        rt_bigint_limbs(left_limbs_obj),
+        (size_t)rt_array_len(left_limbs_obj),
+        rt_bigint_limbs(right_limbs_obj),
+        (size_t)rt_array_len(right_limbs_obj)
+    );
+}
+
+uint64_t rt_bigint_add(void* out_limbs_obj, const void* left_limbs_obj, const void* right_limbs_obj) {
+    size_t left_len = rt_bigint_array_trimmed_len(left_limbs_obj);
+    size_t right_len = rt_bigint_array_trimmed_len(right_limbs_obj);
+    const uint64_t* left = rt_bigint_limbs(left_limbs_obj);
+    const uint64_t* right = rt_bigint_limbs(right_limbs_obj);
+    if (left_len < right_len) {
+        const uint64_t* swapped = left;
+        left = right;
+        right = swapped;
+        const size_t swapped_len = left_len;
+        left_len = right_len;
+        right_len = swapped_len;
+    }
+    rt_bigint_require_capacity(out_limbs_obj, left_len, "rt_bigint_add: output too small");
+
+    /* Callers may leave out the carry limb when they know the top limbs cannot overflow. */
+    uint64_t* out = rt_bigint_mutable_limbs(out_limbs_obj);
+    const uint64_t carry = rt_bigint_add_limbs(out, left, left_len, right, right_len);
+    if ((size_t)rt_array_len(out_limbs_obj) == left_len) {
+        if (carry != 0u) {
+            rt_panic("rt_bigint_add: output too small");
+        }
+        return rt_bigint_finish_output(out_limbs_obj, left_len);
+    }
+    out[left_len] = carry;
+    return rt_bigint_finish_output(out_limbs_obj, left_len + 1u);
+}
+
+uint64_t rt_bigint_sub(void* out_limbs_obj, const void* left_limbs_obj, const void* right_limbs_obj) {
+    const size_t left_len = rt_bigint_array_trimmed_len(left_limbs_obj);
+    const size_t right_len = rt_bigint_array_trimmed_len(right_limbs_obj);
+    const uint64_t* left = rt_bigint_limbs(left_limbs_obj);
+    const uint64_t* right = rt_bigint_limbs(right_limbs_obj);
+    if (rt_bigint_compare_limbs(left, left_len, right, right_len) < 0) {
+        rt_panic("rt_bigint_sub: right magnitude exceeds left");
+    }
+    rt_bigint_require_capacity(out_limbs_obj, left_len, "rt_bigint_sub: output too small");
+
+    rt_bigint_sub_limbs(rt_bigint_mutable_limbs(out_limbs_obj), left, left_len, right, right_len);
+    return rt_bigint_finish_output(out_limbs_obj, left_len);
+}
+
+uint64_t rt_bigint_mul(void* out_limbs_obj, const void* left_limbs_obj, const void* right_limbs_obj) {
+    const size_t left_len = rt_bigint_array_trimmed_len(left_limbs_obj);
+    const size_t right_len = rt_bigint_array_trimmed_len(right_limbs_obj);
+    if (left_len == 0u || right_len == 0u) {
+        return rt_bigint_finish_output(out_limbs_obj, 0u);
+    }
+    const size_t product_len = left_len + right_len;
+    rt_bigint_require_capacity(out_limbs_obj, product_len - 1u, "rt_bigint_mul: output too small");
+
+    const uint64_t* left = rt_bigint_limbs(left_limbs_obj);
+    const uint64_t* right = rt_bigint_limbs(right_limbs_obj);
+    uint64_t* out = rt_bigint_mutable_limbs(out_limbs_obj);
+    if (out == left || out == right) {
+        rt_panic("rt_bigint_mul: output aliases an operand");
+    }
+    if ((size_t)rt_array_len(out_limbs_obj) >= product_len) {
+        rt_bigint_mul_limbs(out, left, left_len, right, right_len);
+        return rt_bigint_finish_output(out_limbs_obj, product_len);
+    }
+
+    /* Callers size the output one limb short when the top limbs show the product cannot fill it. */
+    uint64_t* product = rt_bigint_scratch(product_len);
+    rt_bigint_mul_limbs(product, left, left_len, right, right_len);
+    if (product[product_len - 1u] != 0u) {
+        rt_panic("rt_bigint_mul: output too small");
+    }
+    memcpy(out, product, (product_len - 1u) * sizeof(uint64_t));
+    free(product);
+    return rt_bigint_finish_output(out_limbs_obj, product_len - 1u);
+}
+
+uint64_t rt_bigint_mul_word_add(void* out_limbs_obj, const void* limbs_obj, uint64_t factor, uint64_t addend) {
+    const size_t len = rt_bigint_array_trimmed_len(limbs_obj);
+    rt_bigint_require_capacity(out_limbs_obj, len + 1u, "rt_bigint_mul_word_add: output too small");
+
+    uint64_t* out = rt_bigint_mutable_limbs(out_limbs_obj);
+    out[len] = rt_bigint_mul_word_add_limbs(out, rt_bigint_limbs(limbs_obj), len, factor, addend);
+    return rt_bigint_finish_output(out_limbs_obj, len + 1u);
+}
+
+uint64_t rt_bigint_divrem_word(void* quotient_limbs_obj, const void* limbs_obj, uint64_t divisor) {
+    if (divisor == 0u) {
+        rt_panic("rt_bigint_divrem_word: division by zero");
+    }
+    const size_t len = rt_bigint_array_trimmed_len(limbs_obj);
+    rt_bigint_require_capacity(quotient_limbs_obj, len, "rt_bigint_divrem_word: output too small");
+
+    const uint64_t remainder = rt_bigint_divrem_word_limbs(
+        rt_bigint_mutable_limbs(quotient_limbs_obj),
+        rt_bigint_limbs(limbs_obj),
+        len,
+        divisor
+    );
+    rt_bigint_finish_output(quotient_limbs_obj, len);
+    return remainder;
+}
+
+void rt_bigint_divrem(
+    void* quotient_limbs_obj,
+    void* remainder_limbs_obj,
+    const void* numerator_limbs_obj,
+    const void* divisor_limbs_obj
+) {
+    const size_t numerator_len = rt_bigint_array_trimmed_len(numerator_limbs_obj);
+    const size_t divisor_len = rt_bigint_array_trimmed_len(divisor_limbs_obj);
+    if (divisor_len == 0u) {
+        rt_panic("rt_bigint_divrem: division by zero");
+    }
+    const uint64_t* numerator = rt_bigint_limbs(numerator_limbs_obj);
+    const uint64_t* divisor = rt_bigint_limbs(divisor_limbs_obj);
+    uint64_t* quotient = rt_bigint_mutable_limbs(quotient_limbs_obj);
+    uint64_t* remainder = rt_bigint_mutable_limbs(remainder_limbs_obj);
+
+    if (numerator_len < divisor_len) {
+        rt_bigint_require_capacity(remainder_limbs_obj, numerator_len, "rt_bigint_divrem: output too small");
+        memmove(remainder, numerator, numerator_len * sizeof(uint64_t));
+        rt_bigint_finish_output(quotient_limbs_obj, 0u);
+        rt_bigint_finish_output(remainder_limbs_obj, numerator_len);
+        return;
+    }
+
+    const size_t quotient_len = numerator_len - divisor_len + 1u;
+    rt_bigint_require_capacity(quotient_limbs_obj, quotient_len, "rt_bigint_divrem: output too small");
+    rt_bigint_require_capacity(remainder_limbs_obj, divisor_len, "rt_bigint_divrem: output too small");
+    rt_bigint_divrem_limbs(quotient, remainder, numerator, numerator_len, divisor, divisor_len);
+    rt_bigint_finish_output(quotient_limbs_obj, quotient_len);
+    rt_bigint_finish_output(remainder_limbs_obj, divisor_len);
+}
+
+uint64_t rt_bigint_to_decimal(void* out_u8_array_obj, const void* limbs_obj) {
+    const size_t len = rt_bigint_array_trimmed_len(limbs_obj);
+    uint8_t* out = (uint8_t*)rt_array_data_ptr(out_u8_array_obj);
+    if (len == 0u) {
+        if (rt_array_len(out_u8_array_obj) == 0u) {
+            rt_panic("rt_bigint_to_decimal: output too small");
+        }
+        out[0] = '0';
+        return 1u;
+    }
+
+    /* 64 * len * log10(2) bounds the digit count from above. */
+    const size_t width = (size_t)(((uint64_t)len * 64u * 30103u) / 100000u) + 1u;
+    if ((size_t)rt_array_len(out_u8_array_obj) < width) {
+        rt_panic("rt_bigint_to_decimal: output too small");
+    }
+
+    RtBigIntDecimalPowers powers;
+    rt_bigint_decimal_powers_init(&powers);
+    rt_bigint_decimal_powers_extend(&powers, len);
+    rt_bigint_write_decimal(out, width, rt_bigint_limbs(limbs_obj), len, &powers);
+    rt_bigint_decimal_powers_free(&powers);
+
+    size_t leading_zeros = 0u;
+    while (leading_zeros + 1u < width && out[leading_zeros] == '0') {
+        leading_zeros++;
+    }
+    memmove(out, out + leading_zeros, width - leading_zeros);
+    return (uint64_t)(width - leading_zeros);
+}
+
+uint64_t rt_bigint_from_decimal(void* out_limbs_obj, const void* digits_u8_array_obj, uint64_t start, uint64_t end) {
+    if (start > end || end > rt_array_len(digits_u8_array_obj)) {
+        rt_panic("rt_bigint_from_decimal: invalid digit range");
+    }
+    const size_t count = (size_t)(end - start);
+    const uint8_t* digits = (const uint8_t*)rt_array_data_ptr(digits_u8_array_obj) + start;
+    for (size_t i = 0u; i < count; i++) {
+        if (digits[i] < '0' || digits[i] > '9') {
+            rt_panic("rt_bigint_from_decimal: invalid digit");
+        }
+    }
+    const size_t capacity = count / RT_BIGINT_DECIMAL_CHUNK_DIGITS + 1u;
+    rt_bigint_require_capacity(out_limbs_obj, capacity, "rt_bigint_from_decimal: output too small");
+
+    RtBigIntDecimalPowers powers;
+    rt_bigint_decimal_powers_init(&powers);
+    rt_bigint_decimal_powers_extend(&powers, capacity / 2u + 1u);
+    const size_t len = rt_bigint_read_decimal(rt_bigint_mutable_limbs(out_limbs_obj), digits, count, &powers);
+    rt_bigint_decimal_powers_free(&powers);
+    return rt_bigint_finish_output(out_limbs_obj, len);
+}
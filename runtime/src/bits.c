@@ -0,0 +1,55 @@
+#include "bits_rt.h"
+#include "cpu_features.h"
+
+
+/* Portable definitions of the std.bits intrinsics. Compiled code normally lowers these inline; the
+ * wrappers back callable values and CPUs without POPCNT. */
+
+uint64_t rt_bits_popcount(uint64_t value) {
+    rt_cpu_detect_features();
+    value = value - ((value >> 1) & 0x5555555555555555u);
+    value = (value & 0x3333333333333333u) + ((value >> 2) & 0x3333333333333333u);
+    value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0fu;
+    return (value * 0x0101010101010101u) >> 56;
+}
+
+uint64_t rt_bits_clz(uint64_t value) {
+    if (value == 0u) {
+        return 64u;
+    }
+    return (uint64_t)__builtin_clzll(value);
+}
+
+uint64_t rt_bits_ctz(uint64_t value) {
+    if (value == 0u) {
+        return 64u;
+    }
+    return (uint64_t)__builtin_ctzll(value);
+}
+
+uint64_t rt_bits_rotl(uint64_t value, uint64_t amount) {
+    amount &= 63u;
+    return (value << amount) | (value >> ((64u - amount) & 63u));
+}
+
+uint64_t rt_bits_rotr(uint64_t value, uint64_t amount) {
+    amount &= 63u;
+    return (value >> amount) | (value << ((64u - amount) & 63u));
+}
+
+uint64_t rt_bits_bswap(uint64_t value) {
+    return __builtin_bswap64(value);
+}
+
+uint64_t rt_bits_mulhi(uint64_t left, uint64_t right) {
+    uint64_t left_low = left & 0xffffffffu;
+    uint64_t left_high = left >> 32;
+    uint64_t right_low = right & 0xffffffffu;
+    uint64_t right_high = right >> 32;
+    uint64_t low_low = left_low * right_low;
+    uint64_t high_low = left_high * right_low;
+    uint64_t low_high = left_low * right_high;
+    uint64_t high_high = left_high * right_high;
+    uint64_t middle = (low_low >> 32) + (high_low & 0xffffffffu) + (low_high & 0xffffffffu);
+    return high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+}
@@ -0,0 +1,158 @@
+#include "bitset_rt.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "array.h"
+#include "cpu_features.h"
+#include "panic.h"
+
+
+/* Word-parallel kernels behind std.bitset over u64[] word arrays. The binary operations run on 16-byte
+ * vectors (SSE2 on x86-64, AdvSIMD on aarch64) through the compiler's generic vector extension, two
+ * vectors per step. On x86-64, count uses POPCNT when the CPU has it and a SWAR popcount otherwise. */
+
+typedef uint64_t RtBitsetVector __attribute__((vector_size(16)));
+
+enum {
+    RT_BITSET_VECTOR_WORDS = sizeof(RtBitsetVector) / sizeof(uint64_t),
+    RT_BITSET_STEP_WORDS = 2 * RT_BITSET_VECTOR_WORDS,
+};
+
+typedef enum RtBitsetOp {
+    RT_BITSET_AND,
+    RT_BITSET_OR,
+    RT_BITSET_XOR,
+    RT_BITSET_AND_NOT,
+} RtBitsetOp;
+
+
+static size_t rt_bitset_checked_len(const void* target_words, const void* source_words, const char* message) {
+    const uint64_t len = rt_array_len(target_words);
+    if (rt_array_len(source_words) != len) {
+        rt_panic(message);
+    }
+    return (size_t)len;
+}
+
+static RtBitsetVector rt_bitset_load(const uint64_t* words) {
+    RtBitsetVector vector;
+    memcpy(&vector, words, sizeof(vector));
+    return vector;
+}
+
+static void rt_bitset_store(uint64_t* words, RtBitsetVector vector) {
+    memcpy(words, &vector, sizeof(vector));
+}
+
+/* op is a compile-time constant at every call site, so each public kernel inlines to a branch-free loop. */
+static inline __attribute__((always_inline)) void rt_bitset_apply(
+    void* target_words,
+    const void* source_words,
+    RtBitsetOp op,
+    const char* message
+) {
+    const size_t len = rt_bitset_checked_len(target_words, source_words, message);
+    uint64_t* target = (uint64_t*)rt_array_data_ptr(target_words);
+    const uint64_t* source = (const uint64_t*)rt_array_data_ptr(source_words);
+    size_t i = 0u;
+    for (; i + RT_BITSET_STEP_WORDS <= len; i += RT_BITSET_STEP_WORDS) {
+        RtBitsetVector low = rt_bitset_load(target + i);
+        RtBitsetVector high = rt_bitset_load(target + i + RT_BITSET_VECTOR_WORDS);
+        const RtBitsetVector source_low = rt_bitset_load(source + i);
+        const RtBitsetVector source_high = rt_bitset_load(source + i + RT_BITSET_VECTOR_WORDS);
+        switch (op) {
+            case RT_BITSET_AND: low &= source_low; high &= source_high; break;
+            case RT_BITSET_OR: low |= source_low; high |= source_high; break;
+            case RT_BITSET_XOR: low ^= source_low; high ^= source_high; break;
+            case RT_BITSET_AND_NOT: low &= ~source_low; high &= ~source_high; break;
+        }
+        rt_bitset_store(target + i, low);
+        rt_bitset_store(target + i + RT_BITSET_VECTOR_WORDS, high);
+    }
+    for (; i < len; i++) {
+        switch (op) {
+            case RT_BITSET_AND: target[i] &= source[i]; break;
+            case RT_BITSET_OR: target[i] |= source[i]; break;
+            case RT_BITSET_XOR: target[i] ^= source[i]; break;
+            case RT_BITSET_AND_NOT: target[i] &= ~source[i]; break;
+        }
+    }
+}
+
+void rt_bitset_and(void* target_words, const void* source_words) {
+    rt_bitset_apply(target_words, source_words, RT_BITSET_AND, "rt_bitset_and: length mismatch");
+}
+
+void rt_bitset_or(void* target_words, const void* source_words) {
+    rt_bitset_apply(target_words, source_words, RT_BITSET_OR, "rt_bitset_or: length mismatch");
+}
+
+void rt_bitset_xor(void* target_words, const void* source_words) {
+    rt_bitset_apply(target_words, source_words, RT_BITSET_XOR, "rt_bitset_xor: length mismatch");
+}
+
+void rt_bitset_and_not(void* target_words, const void* source_words) {
+    rt_bitset_apply(target_words, source_words, RT_BITSET_AND_NOT, "rt_bitset_and_not: length mismatch");
+}
+
+#if defined(__x86_64__)
+static uint64_t rt_bitset_count_swar(const uint64_t* words, size_t len) {
+    uint64_t total = 0u;
+    for (size_t i = 0u; i < len; i++) {
+        uint64_t value = words[i];
+        value = value - ((value >> 1) & 0x5555555555555555u);
+        value = (value & 0x3333333333333333u) + ((value >> 2) & 0x3333333333333333u);
+        value = (value + (value >> 4)) & 0x0f0f0f0f0f0f0f0fu;
+        total += (value * 0x0101010101010101u) >> 56;
+    }
+    return total;
+}
+
+__attribute__((target("popcnt"))) static uint64_t rt_bitset_count_popcnt(const uint64_t* words, size_t len) {
+    uint64_t total = 0u;
+    for (size_t i = 0u; i < len; i++) {
+        total += (uint64_t)__builtin_popcountll(words[i]);
+    }
+    return total;
+}
+#endif
+
+uint64_t rt_bitset_count(const void* words) {
+    const uint64_t* data = (const uint64_t*)rt_array_data_ptr(words);
+    const size_t len = (size_t)rt_array_len(words);
+#if defined(__x86_64__)
+    rt_cpu_detect_features();
+    if (rt_cpu_has_popcnt != 0u) {
+        return rt_bitset_count_popcnt(data, len);
+    }
+    return rt_bitset_count_swar(data, len);
+#else
+    uint64_t total = 0u;
+    for (size_t i = 0u; i < len; i++) {
+        total += (uint64_t)__builtin_popcountll(data[i]);
+    }
+    return total;
+#endif
+}
+
+int64_t rt_bitset_next_set(const void* words, int64_t from) {
+    if (from < 0) {
+        rt_panic("rt_bitset_next_set: negative start");
+    }
+    const uint64_t* data = (const uint64_t*)rt_array_data_ptr(words);
+    const uint64_t len = rt_array_len(words);
+    uint64_t word_index = (uint64_t)from >> 6;
+    if (word_index >= len) {
+        return -1;
+    }
+    uint64_t word = data[word_index] & (~0ull << ((uint64_t)from & 63u));
+    while (word == 0u) {
+        word_index++;
+        if (word_index == len) {
+            return -1;
+        }
+        word = data[word_index];
+    }
+    return (int64_t)((word_index << 6) + (uint64_t)__builtin_ctzll(word));
+}
@@ -0,0 +1,46 @@
+#include "box_rt.h"
+
+#include <stddef.h>
+
+#include "runtime.h"
+
+
+/* Canonical boxes behind BoxI64.of, BoxU64.of, BoxU8.of and BoxBool.of in std/box.nif. Each kind owns one
+ * ref[] table of RT_BOX_CACHE_SLOT_COUNT slots, allocated on the first put and registered as a global root,
+ * so a cached box is never collected. std.box maps values to slots; get returns NULL for an empty slot. */
+
+static void* g_box_cache_tables[RT_BOX_CACHE_KIND_COUNT];
+
+
+static void rt_box_cache_require_slot(uint64_t kind, uint64_t slot, const char* message) {
+    if (kind >= RT_BOX_CACHE_KIND_COUNT || slot >= RT_BOX_CACHE_SLOT_COUNT) {
+        rt_panic(message);
+    }
+}
+
+void* rt_box_cache_get(uint64_t kind, uint64_t slot) {
+    rt_box_cache_require_slot(kind, slot, "rt_box_cache_get: slot out of range");
+    void* table = g_box_cache_tables[kind];
+    if (table == NULL) {
+        return NULL;
+    }
+    return rt_array_get_ref(table, (int64_t)slot);
+}
+
+/* May collect: the first put for a kind allocates its table. */
+void rt_box_cache_put(uint64_t kind, uint64_t slot, void* box) {
+    rt_box_cache_require_slot(kind, slot, "rt_box_cache_put: slot out of range");
+    if (g_box_cache_tables[kind] == NULL) {
+        void* table = rt_array_new_ref(RT_BOX_CACHE_SLOT_COUNT);
+        g_box_cache_tables[kind] = table;
+        rt_gc_register_global_root(&g_box_cache_tables[kind]);
+    }
+    rt_array_set_ref(g_box_cache_tables[kind], (int64_t)slot, box);
+}
+
+/* The tables die with the heap when the collector resets, which also drops their global roots. */
+void rt_box_cache_reset(void) {
+    for (size_t kind = 0u; kind < RT_BOX_CACHE_KIND_COUNT; kind++) {
+        g_box_cache_tables[kind] = NULL;
+    }
+}
@@ -0,0 +1,27 @@
+#include "cpu_features.h"
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+
+uint32_t rt_cpu_has_sse41 = 0u;
+uint32_t rt_cpu_has_popcnt = 0u;
+
+void rt_cpu_detect_features(void) {
+    static int detected = 0;
+    if (detected) {
+        return;
+    }
+    detected = 1;
+#if defined(__x86_64__)
+    unsigned int eax = 0u;
+    unsigned int ebx = 0u;
+    unsigned int ecx = 0u;
+    unsigned int edx = 0u;
+    if (__get_cpuid(1u, &eax, &ebx, &ecx, &edx)) {
+        rt_cpu_has_sse41 = (ecx & bit_SSE4_1) != 0u ? 1u : 0u;
+        rt_cpu_has_popcnt = (ecx & bit_POPCNT) != 0u ? 1u : 0u;
+    }
+#endif
+}
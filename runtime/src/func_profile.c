@@ -0,0 +1,273 @@
+#include "func_profile.h"
+#include "runtime.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+
+enum {
+    RT_FUNC_PROFILE_DEFAULT_REPORT_ROWS = 40u,
+    RT_FUNC_PROFILE_INITIAL_FRAME_CAPACITY = 64u,
+};
+
+
+typedef struct RtFuncProfileFrame {
+    RtFuncProfileSite* site;
+    uint64_t start_ticks;
+    uint64_t child_ticks;
+} RtFuncProfileFrame;
+
+
+static RtFuncProfileSite* g_func_profile_sites = NULL;
+static uint32_t g_func_profile_site_count = 0;
+static RtFuncProfileFrame* g_func_profile_frames = NULL;
+static uint32_t g_func_profile_depth = 0;
+static uint32_t g_func_profile_capacity = 0;
+static int g_func_profile_report_registered = 0;
+static int g_func_profile_report_emitted = 0;
+static uint64_t g_func_profile_start_ticks = 0;
+static uint64_t g_func_profile_start_ns = 0;
+
+
+static uint64_t rt_func_profile_wall_ns(void) {
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) != TIME_UTC) {
+        return 0u;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+/* rdtsc on x86_64 and the virtual counter on AArch64 are both constant-rate
+ * on the hosts we target; the report converts ticks to time by calibrating
+ * against the wall clock over the whole run.
+ */
+uint64_t rt_func_profile_ticks(void) {
+#if defined(__x86_64__)
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | (uint64_t)lo;
+#elif defined(__aarch64__)
+    uint64_t value = 0;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return rt_func_profile_wall_ns();
+#endif
+}
+
+
+static void rt_func_profile_report_atexit(void) {
+    rt_func_profile_print_report();
+}
+
+
+static void rt_func_profile_register_site(RtFuncProfileSite* site) {
+    if (g_func_profile_site_count == 0u) {
+        g_func_profile_start_ns = rt_func_profile_wall_ns();
+        g_func_profile_start_ticks = rt_func_profile_ticks();
+    }
+    site->registered = 1u;
+    site->next = g_func_profile_sites;
+    g_func_profile_sites = site;
+    g_func_profile_site_count += 1u;
+    if (!g_func_profile_report_registered) {
+        g_func_profile_report_registered = 1;
+        (void)atexit(rt_func_profile_report_atexit);
+    }
+}
+
+
+static void rt_func_profile_grow_frames(void) {
+    uint32_t new_capacity = g_func_profile_capacity == 0u
+        ? RT_FUNC_PROFILE_INITIAL_FRAME_CAPACITY
+        : g_func_profile_capacity * 2u;
+    if (new_capacity <= g_func_profile_capacity) {
+        rt_panic_oom();
+    }
+    RtFuncProfileFrame* grown = (RtFuncProfileFrame*)realloc(
+        g_func_profile_frames,
+        (size_t)new_capacity * sizeof(RtFuncProfileFrame)
+    );
+    if (grown == NULL) {
+        rt_panic_oom();
+    }
+    g_func_profile_frames = grown;
+    g_func_profile_capacity = new_capacity;
+}
+
+
+void rt_func_profile_enter(RtFuncProfileSite* site) {
+    if (!site->registered) {
+        rt_func_profile_register_site(site);
+    }
+    if (g_func_profile_depth >= g_func_profile_capacity) {
+        rt_func_profile_grow_frames();
+    }
+    site->active_depth += 1u;
+    RtFuncProfileFrame* frame = &g_func_profile_frames[g_func_profile_depth++];
+    frame->site = site;
+    frame->child_ticks = 0u;
+    frame->start_ticks = rt_func_profile_ticks();
+}
+
+
+static void rt_func_profile_close_frame(uint64_t now) {
+    RtFuncProfileFrame* frame = &g_func_profile_frames[--g_func_profile_depth];
+    RtFuncProfileSite* site = frame->site;
+    const uint64_t elapsed = now >= frame->start_ticks ? now - frame->start_ticks : 0u;
+    const uint64_t self = elapsed >= frame->child_ticks ? elapsed - frame->child_ticks : 0u;
+
+    site->calls += 1u;
+    site->self_ticks += self;
+    site->active_depth -= 1u;
+    /* Only the outermost activation of a recursive callable counts toward
+     * inclusive time, so recursion does not double-count its own subtree. */
+    if (site->active_depth == 0u) {
+        site->inclusive_ticks += elapsed;
+    }
+    if (g_func_profile_depth > 0u) {
+        g_func_profile_frames[g_func_profile_depth - 1u].child_ticks += elapsed;
+    }
+}
+
+
+void rt_func_profile_exit(void) {
+    const uint64_t now = rt_func_profile_ticks();
+    if (g_func_profile_depth == 0u) {
+        rt_panic("rt_func_profile_exit: profile stack underflow");
+    }
+    rt_func_profile_close_frame(now);
+}
+
+
+uint32_t rt_func_profile_site_count(void) {
+    return g_func_profile_site_count;
+}
+
+
+RtFuncProfileSite* rt_func_profile_sites(void) {
+    return g_func_profile_sites;
+}
+
+
+static int rt_func_profile_compare_self(const void* lhs, const void* rhs) {
+    const RtFuncProfileSite* left = *(const RtFuncProfileSite* const*)lhs;
+    const RtFuncProfileSite* right = *(const RtFuncProfileSite* const*)rhs;
+    if (left->self_ticks != right->self_ticks) {
+        return left->self_ticks < right->self_ticks ? 1 : -1;
+    }
+    if (left->calls != right->calls) {
+        return left->calls < right->calls ? 1 : -1;
+    }
+    return 0;
+}
+
+
+static uint64_t rt_func_profile_report_rows(void) {
+    const char* value = getenv("NIF_FUNC_PROFILE_ROWS");
+    if (value == NULL || value[0] == '\0') {
+        return RT_FUNC_PROFILE_DEFAULT_REPORT_ROWS;
+    }
+    char* end = NULL;
+    unsigned long long parsed = strtoull(value, &end, 10);
+    if (end == value || *end != '\0') {
+        return RT_FUNC_PROFILE_DEFAULT_REPORT_ROWS;
+    }
+    return (uint64_t)parsed;
+}
+
+
+/* Flat profile sorted by self time. Frames still open at exit (a panic or an
+ * explicit exit below main) are closed first so their time is not lost. */
+void rt_func_profile_print_report(void) {
+    if (g_func_profile_report_emitted || g_func_profile_site_count == 0u) {
+        return;
+    }
+    g_func_profile_report_emitted = 1;
+
+    const uint64_t end_ticks = rt_func_profile_ticks();
+    const uint64_t end_ns = rt_func_profile_wall_ns();
+    while (g_func_profile_depth > 0u) {
+        rt_func_profile_close_frame(end_ticks);
+    }
+
+    const uint64_t run_ticks = end_ticks >= g_func_profile_start_ticks ? end_ticks - g_func_profile_start_ticks : 0u;
+    const uint64_t run_ns = end_ns >= g_func_profile_start_ns ? end_ns - g_func_profile_start_ns : 0u;
+    const double ns_per_tick = run_ticks > 0u && run_ns > 0u ? (double)run_ns / (double)run_ticks : 1.0;
+
+    RtFuncProfileSite** order = (RtFuncProfileSite**)malloc(
+        (size_t)g_func_profile_site_count * sizeof(RtFuncProfileSite*)
+    );
+    if (order == NULL) {
+        return;
+    }
+    uint64_t total_calls = 0u;
+    uint64_t total_self_ticks = 0u;
+    uint32_t count = 0u;
+    for (RtFuncProfileSite* site = g_func_profile_sites; site != NULL; site = site->next) {
+        order[count++] = site;
+        total_calls += site->calls;
+        total_self_ticks += site->self_ticks;
+    }
+    qsort(order, count, sizeof(RtFuncProfileSite*), rt_func_profile_compare_self);
+
+    FILE* out = stderr;
+    fprintf(
+        out,
+        "[func-profile] summary functions=%" PRIu32 " calls=%" PRIu64 " ticks=%" PRIu64 " ns_per_tick=%.4f\n",
+        count,
+        total_calls,
+        total_self_ticks,
+        ns_per_tick
+    );
+    fprintf(out, "[func-profile] %7s %12s %12s %12s %12s  %s\n", "self%", "self_ms", "incl_ms", "calls", "incl_ns/call", "function");
+
+    const uint64_t rows = rt_func_profile_report_rows();
+    for (uint32_t i = 0; i < count && (rows == 0u || i < rows); i++) {
+        const RtFuncProfileSite* site = order[i];
+        const double self_ns = (double)site->self_ticks * ns_per_tick;
+        const double inclusive_ns = (double)site->inclusive_ticks * ns_per_tick;
+        const double self_percent = total_self_ticks > 0u
+            ? 100.0 * (double)site->self_ticks / (double)total_self_ticks
+            : 0.0;
+        fprintf(
+            out,
+            "[func-profile] %6.2f%% %12.3f %12.3f %12" PRIu64 " %12.1f  %s\n",
+            self_percent,
+            self_ns / 1e6,
+            inclusive_ns / 1e6,
+            site->calls,
+            site->calls > 0u ? inclusive_ns / (double)site->calls : 0.0,
+            site->name != NULL ? site->name : "<unknown>"
+        );
+    }
+    free(order);
+}
+
+
+void rt_func_profile_reset(void) {
+    RtFuncProfileSite* site = g_func_profile_sites;
+    while (site != NULL) {
+        RtFuncProfileSite* next = site->next;
+        site->calls = 0u;
+        site->self_ticks = 0u;
+        site->inclusive_ticks = 0u;
+        site->active_depth = 0u;
+        site->registered = 0u;
+        site->next = NULL;
+        site = next;
+    }
+    free(g_func_profile_frames);
+    g_func_profile_sites = NULL;
+    g_func_profile_site_count = 0u;
+    g_func_profile_frames = NULL;
+    g_func_profile_depth = 0u;
+    g_func_profile_capacity = 0u;
+    g_func_profile_report_emitted = 0;
+    g_func_profile_start_ticks = 0u;
+    g_func_profile_start_ns = 0u;
+}
@@ -1,4 +1,6 @@
 #include "runtime.h"
+#include "alloc_profile.h"
+#include "gc_heap_dump.h"
 #include "gc_trace.h"
 #include "gc_tracked_set.h"
 
@@ -248,20 +250,29 @@ static void rt_clear_all_marks(void) {
 }
 
 
-static void rt_mark_from_global_roots(void) {
+static void rt_mark_from_global_roots(RtGcRootCounts* counts) {
     for (RtGlobalRoot* root = g_global_roots; root != NULL; root = root->next) {
+        counts->global_roots++;
+        if (root->slot != NULL && *root->slot != NULL) {
+            counts->global_refs++;
+        }
         rt_mark_ref_slot(root->slot);
     }
 }
 
 
-static void rt_mark_from_shadow_stack(RtThreadState* ts) {
+static void rt_mark_from_shadow_stack(RtThreadState* ts, RtGcRootCounts* counts) {
     if (ts == NULL) {
         return;
     }
 
     for (RtRootFrame* frame = ts->roots_top; frame != NULL; frame = frame->prev) {
+        counts->shadow_stack_frames++;
+        counts->shadow_stack_slots += frame->slot_count;
         for (uint32_t i = 0; i < frame->slot_count; i++) {
+            if (frame->slots[i] != NULL) {
+                counts->shadow_stack_refs++;
+            }
             rt_mark_ref_slot(&frame->slots[i]);
         }
     }
@@ -298,6 +309,9 @@ static uint64_t rt_sweep_unmarked(void) {
         if (rt_gc_should_remove_tracked_set_entry()) {
             rt_gc_tracked_set_remove(obj);
         }
+        if (obj->reserved0 != 0u) {
+            rt_alloc_profile_note_free(obj);
+        }
         free(obj);
         rt_gc_release_tracked_object_node(node);
         if (g_tracked_object_count > 0) {
@@ -312,7 +326,7 @@ static uint64_t rt_sweep_unmarked(void) {
 void rt_gc_maybe_collect(uint64_t upcoming_bytes) {
     const uint64_t projected = rt_saturating_add_u64(g_allocated_bytes, upcoming_bytes);
     if (projected >= g_next_gc_threshold) {
-        rt_gc_collect();
+        rt_gc_collect_for(RT_GC_COLLECT_THRESHOLD);
     }
 }
 
@@ -332,6 +346,40 @@ void rt_gc_track_allocation(RtObjHeader* obj) {
 }
 
 
+void rt_gc_visit_tracked_objects(RtGcObjectVisitor visit, void* context) {
+    for (RtTrackedObject* node = g_tracked_objects; node != NULL; node = node->next) {
+        if (node->obj != NULL) {
+            visit(node->obj, context);
+        }
+    }
+}
+
+
+/* Shadow-stack frame indices count from the innermost frame (0); global roots
+ * report frame index 0 and their registration order from newest.
+ */
+void rt_gc_visit_roots(RtGcRootVisitor visit, void* context) {
+    uint32_t global_index = 0;
+    for (RtGlobalRoot* root = g_global_roots; root != NULL; root = root->next) {
+        if (root->slot != NULL && *root->slot != NULL) {
+            visit(*root->slot, RT_GC_ROOT_GLOBAL, 0u, global_index, context);
+        }
+        global_index++;
+    }
+
+    RtThreadState* ts = rt_thread_state();
+    uint32_t frame_index = 0;
+    for (RtRootFrame* frame = ts->roots_top; frame != NULL; frame = frame->prev) {
+        for (uint32_t i = 0; i < frame->slot_count; i++) {
+            if (frame->slots[i] != NULL) {
+                visit(frame->slots[i], RT_GC_ROOT_SHADOW_STACK, frame_index, i, context);
+            }
+        }
+        frame_index++;
+    }
+}
+
+
 void rt_gc_register_global_root(void** slot) {
     if (slot == NULL) {
         rt_panic("rt_gc_register_global_root: slot is NULL");
@@ -373,6 +421,10 @@ void rt_gc_unregister_global_root(void** slot) {
 
 
 void rt_gc_reset_state(void) {
+    rt_alloc_profile_reset();
+    rt_gc_heap_dump_reset();
+    rt_box_cache_reset();
+
     RtTrackedObject* object_node = g_tracked_objects;
     while (object_node != NULL) {
         RtTrackedObject* next = object_node->next;
@@ -428,15 +480,22 @@ RtGcTrackingPoolStats rt_gc_get_tracking_pool_stats(void) {
 }
 
 void rt_gc_collect(void) {
+    rt_gc_collect_for(RT_GC_COLLECT_EXPLICIT);
+}
+
+
+void rt_gc_collect_for(RtGcCollectReason reason) {
     RtThreadState* ts = rt_thread_state();
+    RtGcRootCounts root_counts = {0};
 
-    rt_gc_trace_collect_begin();
+    rt_gc_trace_collect_begin(reason);
 
     rt_gc_trace_phase_begin(RT_GC_TRACE_PHASE_MARK);
     rt_clear_all_marks();
-    rt_mark_from_global_roots();
-    rt_mark_from_shadow_stack(ts);
+    rt_mark_from_global_roots(&root_counts);
+    rt_mark_from_shadow_stack(ts, &root_counts);
     rt_gc_trace_phase_end(RT_GC_TRACE_PHASE_MARK);
+    rt_gc_trace_note_roots(&root_counts);
 
     rt_gc_trace_phase_begin(RT_GC_TRACE_PHASE_SWEEP);
     g_live_bytes = rt_sweep_unmarked();
@@ -444,5 +503,7 @@ void rt_gc_collect(void) {
     g_allocated_bytes = g_live_bytes;
     rt_update_threshold_from_live(g_live_bytes);
 
+    rt_alloc_profile_collect_end();
+    rt_gc_heap_dump_collect_end(g_live_bytes);
     rt_gc_trace_collect_end();
 }
@@ -0,0 +1,327 @@
+#include "gc_heap_dump.h"
+#include "runtime.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+enum {
+    RT_HEAP_DUMP_INITIAL_EDGE_CAPACITY = 64u,
+    RT_HEAP_DUMP_INITIAL_TYPE_CAPACITY = 64u,
+};
+
+
+typedef enum RtHeapDumpMode {
+    RT_HEAP_DUMP_MODE_OFF = 0,
+    RT_HEAP_DUMP_MODE_AT_EXIT = 1,
+    RT_HEAP_DUMP_MODE_AT_THRESHOLD = 2,
+} RtHeapDumpMode;
+
+
+typedef struct RtHeapDumpWriter {
+    FILE* out;
+    int failed;
+    uint64_t object_count;
+    uint64_t root_count;
+    const RtType** seen_types;
+    uint64_t seen_type_capacity;
+    uint64_t seen_type_count;
+} RtHeapDumpWriter;
+
+
+static int g_heap_dump_mode = -1;
+static int g_heap_dump_emitted = 0;
+static int g_heap_dump_exit_registered = 0;
+static const char* g_heap_dump_path = NULL;
+static uint64_t g_heap_dump_threshold_bytes = 0;
+
+/* trace_fn callbacks carry no context, so edge collection goes through a
+ * file-level buffer that is only live during one object visit.
+ */
+static uint64_t* g_edge_buffer = NULL;
+static uint64_t g_edge_count = 0;
+static uint64_t g_edge_capacity = 0;
+
+
+static void rt_heap_dump_write(RtHeapDumpWriter* writer, const void* data, size_t size) {
+    if (writer->failed) {
+        return;
+    }
+    if (size != 0u && fwrite(data, 1, size, writer->out) != size) {
+        writer->failed = 1;
+    }
+}
+
+
+static void rt_heap_dump_write_u8(RtHeapDumpWriter* writer, uint8_t value) {
+    rt_heap_dump_write(writer, &value, sizeof(value));
+}
+
+
+static void rt_heap_dump_write_u32(RtHeapDumpWriter* writer, uint32_t value) {
+    rt_heap_dump_write(writer, &value, sizeof(value));
+}
+
+
+static void rt_heap_dump_write_u64(RtHeapDumpWriter* writer, uint64_t value) {
+    rt_heap_dump_write(writer, &value, sizeof(value));
+}
+
+
+static void rt_heap_dump_collect_edge(void** slot) {
+    if (slot == NULL || *slot == NULL) {
+        return;
+    }
+    if (g_edge_count == g_edge_capacity) {
+        uint64_t new_capacity = g_edge_capacity == 0u ? RT_HEAP_DUMP_INITIAL_EDGE_CAPACITY : g_edge_capacity * 2u;
+        uint64_t* grown = (uint64_t*)realloc(g_edge_buffer, (size_t)new_capacity * sizeof(uint64_t));
+        if (grown == NULL) {
+            rt_panic_oom();
+        }
+        g_edge_buffer = grown;
+        g_edge_capacity = new_capacity;
+    }
+    g_edge_buffer[g_edge_count++] = (uint64_t)(uintptr_t)*slot;
+}
+
+
+static void rt_heap_dump_collect_edges(RtObjHeader* obj) {
+    g_edge_count = 0u;
+    const RtType* type = obj->type;
+    if (type == NULL) {
+        return;
+    }
+
+    if (type->trace_fn != NULL) {
+        type->trace_fn((void*)obj, rt_heap_dump_collect_edge);
+        return;
+    }
+
+    if (type->pointer_offsets != NULL && type->pointer_offsets_count > 0u) {
+        unsigned char* base = (unsigned char*)obj;
+        for (uint32_t i = 0; i < type->pointer_offsets_count; i++) {
+            rt_heap_dump_collect_edge((void**)(void*)(base + type->pointer_offsets[i]));
+        }
+    }
+}
+
+
+static uint64_t rt_heap_dump_hash_type(const RtType* type) {
+    uint64_t x = (uint64_t)(uintptr_t)type;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdu;
+    x ^= x >> 33;
+    return x;
+}
+
+
+static void rt_heap_dump_grow_seen_types(RtHeapDumpWriter* writer) {
+    const uint64_t old_capacity = writer->seen_type_capacity;
+    const RtType** old_types = writer->seen_types;
+    const uint64_t new_capacity = old_capacity == 0u ? RT_HEAP_DUMP_INITIAL_TYPE_CAPACITY : old_capacity * 2u;
+
+    const RtType** types = (const RtType**)calloc((size_t)new_capacity, sizeof(const RtType*));
+    if (types == NULL) {
+        rt_panic_oom();
+    }
+    for (uint64_t i = 0; i < old_capacity; i++) {
+        if (old_types[i] == NULL) {
+            continue;
+        }
+        uint64_t index = rt_heap_dump_hash_type(old_types[i]) & (new_capacity - 1u);
+        while (types[index] != NULL) {
+            index = (index + 1u) & (new_capacity - 1u);
+        }
+        types[index] = old_types[i];
+    }
+    free(old_types);
+    writer->seen_types = types;
+    writer->seen_type_capacity = new_capacity;
+}
+
+
+/* Returns 1 when the type was not yet written to this snapshot. */
+static int rt_heap_dump_mark_type_seen(RtHeapDumpWriter* writer, const RtType* type) {
+    if ((writer->seen_type_count + 1u) * 2u > writer->seen_type_capacity) {
+        rt_heap_dump_grow_seen_types(writer);
+    }
+    const uint64_t mask = writer->seen_type_capacity - 1u;
+    uint64_t index = rt_heap_dump_hash_type(type) & mask;
+    while (writer->seen_types[index] != NULL) {
+        if (writer->seen_types[index] == type) {
+            return 0;
+        }
+        index = (index + 1u) & mask;
+    }
+    writer->seen_types[index] = type;
+    writer->seen_type_count++;
+    return 1;
+}
+
+
+static void rt_heap_dump_write_type(RtHeapDumpWriter* writer, const RtType* type) {
+    const char* name = (type != NULL && type->debug_name != NULL) ? type->debug_name : "<unknown>";
+    const size_t name_len = strlen(name);
+
+    rt_heap_dump_write_u8(writer, RT_HEAP_DUMP_TAG_TYPE);
+    rt_heap_dump_write_u64(writer, (uint64_t)(uintptr_t)type);
+    rt_heap_dump_write_u32(writer, type != NULL ? type->type_id : 0u);
+    rt_heap_dump_write_u32(writer, type != NULL ? type->flags : 0u);
+    rt_heap_dump_write_u32(writer, (uint32_t)name_len);
+    rt_heap_dump_write(writer, name, name_len);
+}
+
+
+static void rt_heap_dump_visit_object(RtObjHeader* obj, void* context) {
+    RtHeapDumpWriter* writer = (RtHeapDumpWriter*)context;
+
+    if (obj->type != NULL && rt_heap_dump_mark_type_seen(writer, obj->type)) {
+        rt_heap_dump_write_type(writer, obj->type);
+    }
+
+    rt_heap_dump_collect_edges(obj);
+    rt_heap_dump_write_u8(writer, RT_HEAP_DUMP_TAG_OBJECT);
+    rt_heap_dump_write_u64(writer, (uint64_t)(uintptr_t)obj);
+    rt_heap_dump_write_u64(writer, (uint64_t)(uintptr_t)obj->type);
+    rt_heap_dump_write_u64(writer, obj->size_bytes);
+    rt_heap_dump_write_u32(writer, (uint32_t)g_edge_count);
+    rt_heap_dump_write(writer, g_edge_buffer, (size_t)g_edge_count * sizeof(uint64_t));
+    writer->object_count++;
+}
+
+
+static void rt_heap_dump_visit_root(
+    void* ref,
+    RtGcRootKind kind,
+    uint32_t frame_index,
+    uint32_t slot_index,
+    void* context
+) {
+    RtHeapDumpWriter* writer = (RtHeapDumpWriter*)context;
+
+    rt_heap_dump_write_u8(writer, RT_HEAP_DUMP_TAG_ROOT);
+    rt_heap_dump_write_u64(writer, (uint64_t)(uintptr_t)ref);
+    rt_heap_dump_write_u32(writer, (uint32_t)kind);
+    rt_heap_dump_write_u32(writer, frame_index);
+    rt_heap_dump_write_u32(writer, slot_index);
+    writer->root_count++;
+}
+
+
+int rt_gc_dump_heap(const char* path) {
+    if (path == NULL || path[0] == '\0') {
+        return -1;
+    }
+
+    RtHeapDumpWriter writer = {0};
+    writer.out = fopen(path, "wb");
+    if (writer.out == NULL) {
+        fprintf(stderr, "[heap-dump] warning: cannot open '%s'\n", path);
+        return -1;
+    }
+
+    rt_heap_dump_write(&writer, "NIFHEAP1", 8u);
+    rt_heap_dump_write_u32(&writer, RT_HEAP_DUMP_VERSION);
+    rt_heap_dump_write_u32(&writer, (uint32_t)sizeof(void*));
+
+    rt_gc_visit_tracked_objects(rt_heap_dump_visit_object, &writer);
+    rt_gc_visit_roots(rt_heap_dump_visit_root, &writer);
+
+    rt_heap_dump_write_u8(&writer, RT_HEAP_DUMP_TAG_END);
+    rt_heap_dump_write_u64(&writer, writer.object_count);
+    rt_heap_dump_write_u64(&writer, writer.root_count);
+
+    free(writer.seen_types);
+    free(g_edge_buffer);
+    g_edge_buffer = NULL;
+    g_edge_count = 0u;
+    g_edge_capacity = 0u;
+
+    if (fclose(writer.out) != 0) {
+        writer.failed = 1;
+    }
+    if (writer.failed) {
+        fprintf(stderr, "[heap-dump] warning: failed writing '%s'\n", path);
+        return -1;
+    }
+    fprintf(
+        stderr,
+        "[heap-dump] wrote %s objects=%" PRIu64 " roots=%" PRIu64 "\n",
+        path,
+        writer.object_count,
+        writer.root_count
+    );
+    return 0;
+}
+
+
+static void rt_gc_heap_dump_atexit(void) {
+    rt_gc_heap_dump_at_exit();
+}
+
+
+/* NIF_HEAP_DUMP=<path> writes a snapshot at exit. With
+ * NIF_HEAP_DUMP_THRESHOLD=<bytes>, the snapshot is instead taken once, right
+ * after the first collection that leaves at least that many live bytes, so
+ * shadow-stack roots are still meaningful.
+ */
+void rt_gc_heap_dump_poll(void) {
+    if (g_heap_dump_mode >= 0) {
+        return;
+    }
+
+    const char* path = getenv("NIF_HEAP_DUMP");
+    if (path == NULL || path[0] == '\0') {
+        g_heap_dump_mode = RT_HEAP_DUMP_MODE_OFF;
+        return;
+    }
+    g_heap_dump_path = path;
+
+    const char* threshold = getenv("NIF_HEAP_DUMP_THRESHOLD");
+    if (threshold != NULL && threshold[0] != '\0') {
+        char* end = NULL;
+        unsigned long long parsed = strtoull(threshold, &end, 10);
+        if (end != threshold && *end == '\0' && parsed > 0u) {
+            g_heap_dump_threshold_bytes = (uint64_t)parsed;
+            g_heap_dump_mode = RT_HEAP_DUMP_MODE_AT_THRESHOLD;
+            return;
+        }
+    }
+
+    g_heap_dump_mode = RT_HEAP_DUMP_MODE_AT_EXIT;
+    if (!g_heap_dump_exit_registered) {
+        g_heap_dump_exit_registered = 1;
+        (void)atexit(rt_gc_heap_dump_atexit);
+    }
+}
+
+
+void rt_gc_heap_dump_collect_end(uint64_t live_bytes) {
+    if (g_heap_dump_mode != RT_HEAP_DUMP_MODE_AT_THRESHOLD || g_heap_dump_emitted) {
+        return;
+    }
+    if (live_bytes < g_heap_dump_threshold_bytes) {
+        return;
+    }
+    g_heap_dump_emitted = 1;
+    (void)rt_gc_dump_heap(g_heap_dump_path);
+}
+
+
+void rt_gc_heap_dump_at_exit(void) {
+    if (g_heap_dump_mode != RT_HEAP_DUMP_MODE_AT_EXIT || g_heap_dump_emitted) {
+        return;
+    }
+    g_heap_dump_emitted = 1;
+    (void)rt_gc_dump_heap(g_heap_dump_path);
+}
+
+
+void rt_gc_heap_dump_reset(void) {
+    g_heap_dump_mode = -1;
+    g_heap_dump_emitted = 0;
+    g_heap_dump_path = NULL;
+    g_heap_dump_threshold_bytes = 0u;
+}
@@ -1,16 +1,27 @@
 #include "gc_trace.h"
 #include "gc.h"
+#include "gc_tracked_set.h"
+#include "perf_counters.h"
 
 #include <inttypes.h>
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 
+enum {
+    RT_GC_TRACE_INITIAL_PAUSE_CAPACITY = 64u,
+};
+
 static int g_gc_trace_enabled = -1;
+static int g_gc_event_log_enabled = -1;
 static int g_gc_summary_registered = 0;
 static int g_gc_summary_emitted = 0;
+static FILE* g_gc_event_log = NULL;
+static const char* g_gc_event_log_path = NULL;
+static int g_gc_event_log_opened_before = 0;
 
 typedef struct RtGcTraceTotals {
     uint64_t cycle_count;
@@ -18,20 +29,31 @@ typedef struct RtGcTraceTotals {
     uint64_t total_collect_ns;
     uint64_t total_mark_ns;
     uint64_t total_sweep_ns;
+    RtPerfCounterSample mark_perf;
+    RtPerfCounterSample sweep_perf;
 } RtGcTraceTotals;
 
 typedef struct RtGcTraceCycle {
     uint64_t index;
+    RtGcCollectReason reason;
     RtGcStats before;
+    RtGcRootCounts roots;
     uint64_t collect_start_ns;
     uint64_t mark_start_ns;
     uint64_t mark_end_ns;
     uint64_t sweep_start_ns;
     uint64_t sweep_end_ns;
+    RtPerfCounterSample mark_perf_start;
+    RtPerfCounterSample mark_perf;
+    RtPerfCounterSample sweep_perf_start;
+    RtPerfCounterSample sweep_perf;
 } RtGcTraceCycle;
 
 static RtGcTraceTotals g_totals = {0};
 static RtGcTraceCycle g_cycle = {0};
+static uint64_t* g_pause_ns = NULL;
+static uint64_t g_pause_count = 0;
+static uint64_t g_pause_capacity = 0;
 
 
 static uint64_t rt_saturating_add_u64(uint64_t a, uint64_t b) {
@@ -103,13 +125,21 @@ static void rt_gc_trace_summary_atexit(void) {
     if (g_gc_summary_emitted) {
         return;
     }
-    if (g_totals.cycle_count == 0u || g_totals.timing_start_ns == 0u) {
+    if (g_gc_event_log_enabled <= 0 && (g_totals.cycle_count == 0u || g_totals.timing_start_ns == 0u)) {
         return;
     }
     rt_gc_trace_print_summary();
 }
 
 
+static void rt_gc_trace_register_summary(void) {
+    if (!g_gc_summary_registered) {
+        g_gc_summary_registered = 1;
+        (void)atexit(rt_gc_trace_summary_atexit);
+    }
+}
+
+
 static int rt_gc_trace_is_enabled(void) {
     if (g_gc_trace_enabled >= 0) {
         return g_gc_trace_enabled;
@@ -120,21 +150,288 @@ static int rt_gc_trace_is_enabled(void) {
         g_gc_trace_enabled = 0;
     } else {
         g_gc_trace_enabled = 1;
-        if (!g_gc_summary_registered) {
-            g_gc_summary_registered = 1;
-            (void)atexit(rt_gc_trace_summary_atexit);
-        }
+        rt_gc_trace_register_summary();
     }
     return g_gc_trace_enabled;
 }
 
 
-void rt_gc_trace_collect_begin(void) {
+/* NIF_GC_EVENT_LOG names a file that receives one JSON object per collection
+ * cycle plus a closing summary record. Reopening after a reset appends, so
+ * harnesses that reset GC state keep a single stream.
+ */
+static int rt_gc_event_log_is_enabled(void) {
+    if (g_gc_event_log_enabled >= 0) {
+        return g_gc_event_log_enabled;
+    }
+
+    const char* path = g_gc_event_log_path != NULL ? g_gc_event_log_path : getenv("NIF_GC_EVENT_LOG");
+    if (path == NULL || path[0] == '\0') {
+        g_gc_event_log_enabled = 0;
+        return 0;
+    }
+
+    g_gc_event_log = fopen(path, g_gc_event_log_opened_before ? "a" : "w");
+    if (g_gc_event_log == NULL) {
+        fprintf(stderr, "[gc] warning: cannot open NIF_GC_EVENT_LOG file '%s'\n", path);
+        g_gc_event_log_enabled = 0;
+        return 0;
+    }
+    g_gc_event_log_opened_before = 1;
+    g_gc_event_log_enabled = 1;
+    if (NIF_GC_VALIDATE_TRACKED_SET) {
+        rt_gc_tracked_set_enable_probe_stats(1);
+    }
+    rt_gc_trace_register_summary();
+    return 1;
+}
+
+
+static int rt_gc_trace_timing_is_enabled(void) {
+    const int trace_enabled = rt_gc_trace_is_enabled();
+    const int event_log_enabled = rt_gc_event_log_is_enabled();
+    return trace_enabled || event_log_enabled;
+}
+
+
+/* Resolves NIF_GC_TRACE / NIF_GC_EVENT_LOG on the first allocation so the
+ * summary record is still written for programs that never collect.
+ */
+void rt_gc_trace_poll(void) {
+    if (g_gc_trace_enabled >= 0 && g_gc_event_log_enabled >= 0) {
+        return;
+    }
+    (void)rt_gc_trace_timing_is_enabled();
+}
+
+
+static const char* rt_gc_collect_reason_name(RtGcCollectReason reason) {
+    switch (reason) {
+        case RT_GC_COLLECT_EXPLICIT:
+            return "explicit";
+        case RT_GC_COLLECT_THRESHOLD:
+            return "threshold";
+        case RT_GC_COLLECT_ALLOC_FAILURE:
+            return "alloc_failure";
+        default:
+            return "unknown";
+    }
+}
+
+
+static void rt_gc_trace_record_pause(uint64_t pause_ns) {
+    if (g_pause_count == g_pause_capacity) {
+        uint64_t new_capacity = g_pause_capacity == 0u ? RT_GC_TRACE_INITIAL_PAUSE_CAPACITY : g_pause_capacity * 2u;
+        uint64_t* grown = (uint64_t*)realloc(g_pause_ns, (size_t)new_capacity * sizeof(uint64_t));
+        if (grown == NULL) {
+            return;
+        }
+        g_pause_ns = grown;
+        g_pause_capacity = new_capacity;
+    }
+    g_pause_ns[g_pause_count++] = pause_ns;
+}
+
+
+static int rt_compare_u64(const void* lhs, const void* rhs) {
+    const uint64_t a = *(const uint64_t*)lhs;
+    const uint64_t b = *(const uint64_t*)rhs;
+    return (a > b) - (a < b);
+}
+
+
+typedef struct RtGcPausePercentiles {
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+} RtGcPausePercentiles;
+
+
+/* Nearest-rank percentiles over the recorded per-cycle pause times. */
+static RtGcPausePercentiles rt_gc_trace_pause_percentiles(void) {
+    RtGcPausePercentiles result = {0};
+    if (g_pause_count == 0u) {
+        return result;
+    }
+
+    qsort(g_pause_ns, (size_t)g_pause_count, sizeof(uint64_t), rt_compare_u64);
+    const uint64_t p50_rank = (g_pause_count * 50u + 99u) / 100u;
+    const uint64_t p99_rank = (g_pause_count * 99u + 99u) / 100u;
+    result.p50_ns = g_pause_ns[p50_rank - 1u];
+    result.p99_ns = g_pause_ns[p99_rank - 1u];
+    result.max_ns = g_pause_ns[g_pause_count - 1u];
+    return result;
+}
+
+
+static void rt_gc_event_log_write_stats(const char* key, RtGcStats stats) {
+    fprintf(
+        g_gc_event_log,
+        "\"%s\":{\"allocated_bytes\":%" PRIu64 ",\"live_bytes\":%" PRIu64
+        ",\"next_gc_threshold\":%" PRIu64 ",\"tracked_object_count\":%" PRIu64 "}",
+        key,
+        stats.allocated_bytes,
+        stats.live_bytes,
+        stats.next_gc_threshold,
+        stats.tracked_object_count
+    );
+}
+
+
+static void rt_gc_event_log_write_perf(const char* key, RtPerfCounterSample sample) {
+    fprintf(g_gc_event_log, "\"%s\":{", key);
+    int first = 1;
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if ((sample.valid_mask & (1u << id)) == 0u) {
+            continue;
+        }
+        fprintf(
+            g_gc_event_log,
+            "%s\"%s\":%" PRIu64,
+            first ? "" : ",",
+            rt_perf_counter_name((RtPerfCounterId)id),
+            sample.values[id]
+        );
+        first = 0;
+    }
+    fputc('}', g_gc_event_log);
+}
+
+
+static void rt_gc_event_log_write_cycle(
+    RtGcStats after_stats,
+    uint64_t mark_ns,
+    uint64_t sweep_ns,
+    uint64_t collect_ns,
+    uint64_t freed_objects,
+    uint64_t freed_bytes
+) {
+    fprintf(
+        g_gc_event_log,
+        "{\"event\":\"gc_cycle\",\"cycle\":%" PRIu64 ",\"reason\":\"%s\",",
+        g_cycle.index,
+        rt_gc_collect_reason_name(g_cycle.reason)
+    );
+    rt_gc_event_log_write_stats("before", g_cycle.before);
+    fputc(',', g_gc_event_log);
+    rt_gc_event_log_write_stats("after", after_stats);
+    fprintf(
+        g_gc_event_log,
+        ",\"mark_ns\":%" PRIu64 ",\"sweep_ns\":%" PRIu64 ",\"total_ns\":%" PRIu64
+        ",\"freed_objects\":%" PRIu64 ",\"freed_bytes\":%" PRIu64
+        ",\"roots\":{\"shadow_stack_frames\":%" PRIu64 ",\"shadow_stack_slots\":%" PRIu64
+        ",\"shadow_stack_refs\":%" PRIu64 ",\"global_roots\":%" PRIu64 ",\"global_refs\":%" PRIu64 "}",
+        mark_ns,
+        sweep_ns,
+        collect_ns,
+        freed_objects,
+        freed_bytes,
+        g_cycle.roots.shadow_stack_frames,
+        g_cycle.roots.shadow_stack_slots,
+        g_cycle.roots.shadow_stack_refs,
+        g_cycle.roots.global_roots,
+        g_cycle.roots.global_refs
+    );
+    if (NIF_GC_VALIDATE_TRACKED_SET) {
+        RtGcTrackedSetProbeStats probes = rt_gc_tracked_set_get_probe_stats();
+        fprintf(
+            g_gc_event_log,
+            ",\"tracked_set_probes\":{\"insert_calls\":%" PRIu64 ",\"contains_calls\":%" PRIu64
+            ",\"remove_calls\":%" PRIu64 ",\"insert_probes\":%" PRIu64 ",\"contains_probes\":%" PRIu64
+            ",\"remove_probes\":%" PRIu64 ",\"max_probe_depth\":%" PRIu64 ",\"maintenance_calls\":%" PRIu64
+            ",\"tombstone_compactions\":%" PRIu64 "}",
+            probes.insert_calls,
+            probes.contains_calls,
+            probes.remove_calls,
+            probes.insert_probes,
+            probes.contains_probes,
+            probes.remove_probes,
+            probes.max_probe_depth,
+            probes.maintenance_calls,
+            probes.tombstone_compactions
+        );
+    }
+    if (rt_perf_counters_available()) {
+        fputs(",\"perf\":{", g_gc_event_log);
+        rt_gc_event_log_write_perf("mark", g_cycle.mark_perf);
+        fputc(',', g_gc_event_log);
+        rt_gc_event_log_write_perf("sweep", g_cycle.sweep_perf);
+        fputc('}', g_gc_event_log);
+    }
+    fputs("}\n", g_gc_event_log);
+}
+
+
+/* VmHWM is tracked per address space, so unlike getrusage(RUSAGE_SELF) it does
+ * not inherit the peak of the process image that exec replaced. Returns 0 when
+ * unavailable.
+ */
+static uint64_t rt_gc_trace_peak_rss_kb(void) {
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status == NULL) {
+        return 0u;
+    }
+    char line[256];
+    uint64_t peak_kb = 0u;
+    while (fgets(line, sizeof(line), status) != NULL) {
+        if (strncmp(line, "VmHWM:", 6) == 0) {
+            peak_kb = (uint64_t)strtoull(line + 6, NULL, 10);
+            break;
+        }
+    }
+    fclose(status);
+    return peak_kb;
+}
+
+
+static void rt_gc_event_log_write_summary(uint64_t total_window_ns, RtGcPausePercentiles pauses) {
+    fprintf(
+        g_gc_event_log,
+        "{\"event\":\"gc_summary\",\"cycles\":%" PRIu64 ",\"wall_ns\":%" PRIu64
+        ",\"total_collect_ns\":%" PRIu64 ",\"total_mark_ns\":%" PRIu64 ",\"total_sweep_ns\":%" PRIu64
+        ",\"pause_ns\":{\"p50\":%" PRIu64 ",\"p99\":%" PRIu64 ",\"max\":%" PRIu64 "}",
+        g_totals.cycle_count,
+        total_window_ns,
+        g_totals.total_collect_ns,
+        g_totals.total_mark_ns,
+        g_totals.total_sweep_ns,
+        pauses.p50_ns,
+        pauses.p99_ns,
+        pauses.max_ns
+    );
+    const uint64_t peak_rss_kb = rt_gc_trace_peak_rss_kb();
+    if (peak_rss_kb != 0u) {
+        fprintf(g_gc_event_log, ",\"peak_rss_kb\":%" PRIu64, peak_rss_kb);
+    }
+    fprintf(g_gc_event_log, ",\"perf_available\":%s", rt_perf_counters_available() ? "true" : "false");
+    if (rt_perf_counters_available()) {
+        fputs(",\"perf\":{", g_gc_event_log);
+        rt_gc_event_log_write_perf("mark", g_totals.mark_perf);
+        fputc(',', g_gc_event_log);
+        rt_gc_event_log_write_perf("sweep", g_totals.sweep_perf);
+        fputc(',', g_gc_event_log);
+        rt_gc_event_log_write_perf("program", rt_perf_counters_program_elapsed());
+        fputc('}', g_gc_event_log);
+    }
+    fputs("}\n", g_gc_event_log);
+}
+
+
+static void rt_gc_event_log_close(void) {
+    if (g_gc_event_log != NULL) {
+        fclose(g_gc_event_log);
+        g_gc_event_log = NULL;
+    }
+}
+
+
+void rt_gc_trace_collect_begin(RtGcCollectReason reason) {
     g_cycle = (RtGcTraceCycle){0};
     g_cycle.index = g_totals.cycle_count + 1u;
+    g_cycle.reason = reason;
     g_cycle.before = rt_gc_get_stats();
 
-    if (!rt_gc_trace_is_enabled()) {
+    if (!rt_gc_trace_timing_is_enabled()) {
         return;
     }
 
@@ -143,6 +440,10 @@ void rt_gc_trace_collect_begin(void) {
         g_totals.timing_start_ns = g_cycle.collect_start_ns;
     }
 
+    if (!rt_gc_trace_is_enabled()) {
+        return;
+    }
+
     fprintf(
         stderr,
         "[gc] cycle=%" PRIu64 " phase=start"
@@ -159,17 +460,25 @@ void rt_gc_trace_collect_begin(void) {
 }
 
 
+void rt_gc_trace_note_roots(const RtGcRootCounts* counts) {
+    g_cycle.roots = *counts;
+}
+
+
 void rt_gc_trace_phase_begin(RtGcTracePhase phase) {
-    if (!rt_gc_trace_is_enabled()) {
+    if (!rt_gc_trace_timing_is_enabled()) {
         return;
     }
+    const RtPerfCounterSample perf = rt_perf_counters_read();
     const uint64_t now_ns = rt_time_now_ns_impl();
     switch (phase) {
         case RT_GC_TRACE_PHASE_MARK:
             g_cycle.mark_start_ns = now_ns;
+            g_cycle.mark_perf_start = perf;
             break;
         case RT_GC_TRACE_PHASE_SWEEP:
             g_cycle.sweep_start_ns = now_ns;
+            g_cycle.sweep_perf_start = perf;
             break;
         default:
             break;
@@ -178,16 +487,19 @@ void rt_gc_trace_phase_begin(RtGcTracePhase phase) {
 
 
 void rt_gc_trace_phase_end(RtGcTracePhase phase) {
-    if (!rt_gc_trace_is_enabled()) {
+    if (!rt_gc_trace_timing_is_enabled()) {
         return;
     }
     const uint64_t now_ns = rt_time_now_ns_impl();
+    const RtPerfCounterSample perf = rt_perf_counters_read();
     switch (phase) {
         case RT_GC_TRACE_PHASE_MARK:
             g_cycle.mark_end_ns = now_ns;
+            g_cycle.mark_perf = rt_perf_counters_delta(perf, g_cycle.mark_perf_start);
             break;
         case RT_GC_TRACE_PHASE_SWEEP:
             g_cycle.sweep_end_ns = now_ns;
+            g_cycle.sweep_perf = rt_perf_counters_delta(perf, g_cycle.sweep_perf_start);
             break;
         default:
             break;
@@ -198,7 +510,7 @@ void rt_gc_trace_phase_end(RtGcTracePhase phase) {
 void rt_gc_trace_collect_end(void) {
     g_totals.cycle_count = g_cycle.index;
 
-    if (!rt_gc_trace_is_enabled()) {
+    if (!rt_gc_trace_timing_is_enabled()) {
         return;
     }
 
@@ -218,6 +530,19 @@ void rt_gc_trace_collect_end(void) {
     g_totals.total_mark_ns = rt_saturating_add_u64(g_totals.total_mark_ns, mark_ns);
     g_totals.total_sweep_ns = rt_saturating_add_u64(g_totals.total_sweep_ns, sweep_ns);
     g_totals.total_collect_ns = rt_saturating_add_u64(g_totals.total_collect_ns, collect_ns);
+    rt_gc_trace_record_pause(collect_ns);
+    if (rt_perf_counters_available()) {
+        rt_perf_counters_accumulate(&g_totals.mark_perf, g_cycle.mark_perf);
+        rt_perf_counters_accumulate(&g_totals.sweep_perf, g_cycle.sweep_perf);
+    }
+
+    if (rt_gc_event_log_is_enabled()) {
+        rt_gc_event_log_write_cycle(after_stats, mark_ns, sweep_ns, collect_ns, collected_objects, collected_bytes);
+    }
+
+    if (!rt_gc_trace_is_enabled()) {
+        return;
+    }
 
     fprintf(
         stderr,
@@ -243,11 +568,34 @@ void rt_gc_trace_collect_end(void) {
 }
 
 
+static void rt_gc_trace_print_perf(const char* phase, RtPerfCounterSample sample) {
+    fprintf(stderr, "[gc] perf phase=%s", phase);
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if ((sample.valid_mask & (1u << id)) != 0u) {
+            fprintf(stderr, " %s=%" PRIu64, rt_perf_counter_name((RtPerfCounterId)id), sample.values[id]);
+        }
+    }
+    const uint64_t cycles = sample.values[RT_PERF_COUNTER_CYCLES];
+    if ((sample.valid_mask & (1u << RT_PERF_COUNTER_INSTRUCTIONS)) != 0u && cycles != 0u) {
+        fprintf(stderr, " ipc=%.3f", (double)sample.values[RT_PERF_COUNTER_INSTRUCTIONS] / (double)cycles);
+    }
+    fputc('\n', stderr);
+}
+
+
 void rt_gc_trace_print_summary(void) {
     if (g_gc_summary_emitted) {
         return;
     }
+    if (rt_gc_event_log_is_enabled()) {
+        const uint64_t window_ns = g_totals.timing_start_ns == 0u
+            ? 0u
+            : rt_duration_or_zero(rt_time_now_ns_impl(), g_totals.timing_start_ns);
+        rt_gc_event_log_write_summary(window_ns, rt_gc_trace_pause_percentiles());
+        rt_gc_event_log_close();
+    }
     if (!rt_gc_trace_is_enabled()) {
+        g_gc_summary_emitted = 1;
         return;
     }
     if (g_totals.cycle_count == 0u || g_totals.timing_start_ns == 0u) {
@@ -283,6 +631,7 @@ void rt_gc_trace_print_summary(void) {
     const uint64_t mark_bps = rt_pct_basis_points(g_totals.total_mark_ns, total_window_ns);
     const uint64_t sweep_bps = rt_pct_basis_points(g_totals.total_sweep_ns, total_window_ns);
     const uint64_t outside_bps = rt_pct_basis_points(outside_gc_ns, total_window_ns);
+    const RtGcPausePercentiles pauses = rt_gc_trace_pause_percentiles();
 
     fprintf(
         stderr,
@@ -290,7 +639,10 @@ void rt_gc_trace_print_summary(void) {
         " total_collect=%" PRIu64 ".%03" PRIu64 "ms(%" PRIu64 ".%02" PRIu64 "%%)"
         " total_mark=%" PRIu64 ".%03" PRIu64 "ms(%" PRIu64 ".%02" PRIu64 "%%)"
         " total_sweep=%" PRIu64 ".%03" PRIu64 "ms(%" PRIu64 ".%02" PRIu64 "%%)"
-        " outside_gc=%" PRIu64 ".%03" PRIu64 "ms(%" PRIu64 ".%02" PRIu64 "%%)\n",
+        " outside_gc=%" PRIu64 ".%03" PRIu64 "ms(%" PRIu64 ".%02" PRIu64 "%%)"
+        " pause_p50=%" PRIu64 ".%03" PRIu64 "ms"
+        " pause_p99=%" PRIu64 ".%03" PRIu64 "ms"
+        " pause_max=%" PRIu64 ".%03" PRIu64 "ms\n",
         g_totals.cycle_count,
         wall_ms_whole,
         wall_ms_frac,
@@ -309,15 +661,39 @@ void rt_gc_trace_print_summary(void) {
         outside_ms_whole,
         outside_ms_frac,
         rt_pct_whole_from_bps(outside_bps),
-        rt_pct_frac2_from_bps(outside_bps)
+        rt_pct_frac2_from_bps(outside_bps),
+        rt_ms_whole_from_ns(pauses.p50_ns),
+        rt_ms_frac3_from_ns(pauses.p50_ns),
+        rt_ms_whole_from_ns(pauses.p99_ns),
+        rt_ms_frac3_from_ns(pauses.p99_ns),
+        rt_ms_whole_from_ns(pauses.max_ns),
+        rt_ms_frac3_from_ns(pauses.max_ns)
     );
+    if (rt_perf_counters_available()) {
+        rt_gc_trace_print_perf("mark", g_totals.mark_perf);
+        rt_gc_trace_print_perf("sweep", g_totals.sweep_perf);
+    }
     g_gc_summary_emitted = 1;
 }
 
 
 void rt_gc_trace_reset(void) {
+    rt_gc_event_log_close();
+    free(g_pause_ns);
+    g_pause_ns = NULL;
+    g_pause_count = 0;
+    g_pause_capacity = 0;
     g_gc_trace_enabled = -1;
+    g_gc_event_log_enabled = -1;
     g_totals = (RtGcTraceTotals){0};
     g_cycle = (RtGcTraceCycle){0};
     g_gc_summary_emitted = 0;
+}
+
+
+void rt_gc_trace_set_event_log_path(const char* path) {
+    rt_gc_event_log_close();
+    g_gc_event_log_path = path;
+    g_gc_event_log_opened_before = 0;
+    g_gc_event_log_enabled = -1;
 }
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "line_table.h"
+
+#include <stdlib.h>
+
+
+enum {
+    /* Runtime C frames (panic helpers, allocator, GC) allowed between the
+     * capture point and the innermost generated frame. */
+    RT_LINE_TABLE_MAX_RUNTIME_FRAMES = 32u,
+};
+
+
+/* Provided by the linker for the compiler-emitted section; both stay NULL in
+ * binaries without generated code, such as the runtime test harnesses. */
+extern const RtLineTable __start_nif_line_tables[] __attribute__((weak));
+extern const RtLineTable __stop_nif_line_tables[] __attribute__((weak));
+
+
+static const RtLineTable** g_line_table_index = NULL;
+static uint32_t g_line_table_index_count = 0;
+static int g_line_table_index_built = 0;
+
+
+static const void* rt_line_table_resolve(const int32_t* field) {
+    return (const char*)field + *field;
+}
+
+
+static uintptr_t rt_line_table_code_start(const RtLineTable* table) {
+    return (uintptr_t)rt_line_table_resolve(&table->code_start);
+}
+
+
+uint32_t rt_line_table_count(void) {
+    if (__start_nif_line_tables == NULL || __stop_nif_line_tables == NULL) {
+        return 0u;
+    }
+    return (uint32_t)(__stop_nif_line_tables - __start_nif_line_tables);
+}
+
+
+static int rt_line_table_compare_start(const void* lhs, const void* rhs) {
+    const uintptr_t left = rt_line_table_code_start(*(const RtLineTable* const*)lhs);
+    const uintptr_t right = rt_line_table_code_start(*(const RtLineTable* const*)rhs);
+    if (left != right) {
+        return left < right ? -1 : 1;
+    }
+    return 0;
+}
+
+
+/* Sorted lazily on the first lookup; a failed allocation (we may be reporting
+ * an out-of-memory panic) falls back to a linear scan. */
+static void rt_line_table_build_index(void) {
+    g_line_table_index_built = 1;
+    const uint32_t count = rt_line_table_count();
+    if (count == 0u) {
+        return;
+    }
+    const RtLineTable** index = (const RtLineTable**)malloc((size_t)count * sizeof(const RtLineTable*));
+    if (index == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        index[i] = &__start_nif_line_tables[i];
+    }
+    qsort((void*)index, count, sizeof(const RtLineTable*), rt_line_table_compare_start);
+    g_line_table_index = index;
+    g_line_table_index_count = count;
+}
+
+
+static int rt_line_table_contains(const RtLineTable* table, uintptr_t pc) {
+    const uintptr_t start = rt_line_table_code_start(table);
+    return pc >= start && pc - start < (uintptr_t)table->code_size;
+}
+
+
+const RtLineTable* rt_line_table_find(uintptr_t pc) {
+    if (!g_line_table_index_built) {
+        rt_line_table_build_index();
+    }
+    if (g_line_table_index == NULL) {
+        const uint32_t count = rt_line_table_count();
+        for (uint32_t i = 0; i < count; i++) {
+            if (rt_line_table_contains(&__start_nif_line_tables[i], pc)) {
+                return &__start_nif_line_tables[i];
+            }
+        }
+        return NULL;
+    }
+
+    uint32_t low = 0;
+    uint32_t high = g_line_table_index_count;
+    while (low < high) {
+        const uint32_t mid = low + (high - low) / 2u;
+        if (rt_line_table_code_start(g_line_table_index[mid]) <= pc) {
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == 0u || !rt_line_table_contains(g_line_table_index[low - 1u], pc)) {
+        return NULL;
+    }
+    return g_line_table_index[low - 1u];
+}
+
+
+static void rt_line_table_symbolize_in(const RtLineTable* table, uintptr_t pc, RtTraceFrame* out_frame) {
+    const RtLineTableEntry* entries = (const RtLineTableEntry*)rt_line_table_resolve(&table->entries);
+    const uintptr_t offset = pc - rt_line_table_code_start(table);
+
+    out_frame->function_name = (const char*)rt_line_table_resolve(&table->function_name);
+    out_frame->file_path = (const char*)rt_line_table_resolve(&table->file_path);
+    out_frame->line = table->line;
+    out_frame->column = table->column;
+
+    /* Entries are sorted by pc_offset; the location covering `pc` is the last
+     * one that starts at or before it. */
+    uint32_t low = 0;
+    uint32_t high = table->entry_count;
+    while (low < high) {
+        const uint32_t mid = low + (high - low) / 2u;
+        if ((uintptr_t)entries[mid].pc_offset <= offset) {
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    if (low > 0u) {
+        out_frame->line = entries[low - 1u].line;
+        out_frame->column = entries[low - 1u].column;
+    }
+}
+
+
+int rt_line_table_symbolize(uintptr_t return_address, RtTraceFrame* out_frame) {
+    if (return_address == 0u) {
+        return 0;
+    }
+    /* A return address may sit one past the callable when the call is its
+     * last instruction; look up the call instruction itself. */
+    const uintptr_t pc = return_address - 1u;
+    const RtLineTable* table = rt_line_table_find(pc);
+    if (table == NULL) {
+        return 0;
+    }
+    rt_line_table_symbolize_in(table, pc, out_frame);
+    return 1;
+}
+
+
+static uint32_t rt_trace_visit_shadow_stack(RtTraceFrameVisitor visitor, void* context) {
+    const RtThreadState* ts = rt_thread_state();
+    uint32_t visited = 0;
+    for (uint32_t index = ts->trace_size; index > 0u; index--) {
+        visited += 1u;
+        if (!visitor(&ts->trace_frames[index - 1u], context)) {
+            break;
+        }
+    }
+    return visited;
+}
+
+
+/* Generated code always links rbp/x29 frame records, and the runtime is built
+ * with -fno-omit-frame-pointer, so the chain is intact from here down to the
+ * outermost generated frame. The walk stops at the first return address
+ * outside the tables once generated code has been seen (libc start-up frames
+ * may not keep a valid chain), and validates each step so a stray pointer
+ * ends the walk instead of faulting inside a panic. */
+__attribute__((noinline)) static uint32_t rt_trace_visit_frame_chain(RtTraceFrameVisitor visitor, void* context) {
+    const uintptr_t* fp = (const uintptr_t*)__builtin_frame_address(0);
+    uint32_t visited = 0;
+    uint32_t runtime_frames = 0;
+    int in_generated_code = 0;
+    const char* folded_caller_name = NULL;
+
+    while (fp != NULL) {
+        const uintptr_t return_address = fp[1];
+        const uintptr_t* next_fp = (const uintptr_t*)fp[0];
+        const RtLineTable* table = return_address != 0u ? rt_line_table_find(return_address - 1u) : NULL;
+
+        if (table == NULL) {
+            if (in_generated_code || ++runtime_frames > RT_LINE_TABLE_MAX_RUNTIME_FRAMES) {
+                break;
+            }
+        } else {
+            in_generated_code = 1;
+            RtTraceFrame frame;
+            rt_line_table_symbolize_in(table, return_address - 1u, &frame);
+            if (folded_caller_name == NULL || frame.function_name != folded_caller_name) {
+                visited += 1u;
+                if (!visitor(&frame, context)) {
+                    break;
+                }
+            }
+            folded_caller_name = (table->flags & RT_LINE_TABLE_FLAG_FOLDS_CALLER) != 0u ? frame.function_name : NULL;
+        }
+
+        if (next_fp <= fp || ((uintptr_t)next_fp & (sizeof(uintptr_t) - 1u)) != 0u) {
+            break;
+        }
+        fp = next_fp;
+    }
+    return visited;
+}
+
+
+uint32_t rt_trace_visit(RtTraceFrameVisitor visitor, void* context) {
+    const RtThreadState* ts = rt_thread_state();
+    if (ts->trace_size > 0u && ts->trace_frames != NULL) {
+        return rt_trace_visit_shadow_stack(visitor, context);
+    }
+    if (rt_line_table_count() == 0u) {
+        return 0u;
+    }
+    return rt_trace_visit_frame_chain(visitor, context);
+}
+
+
+typedef struct RtTraceCaptureBuffer {
+    RtTraceFrame* frames;
+    uint32_t capacity;
+    uint32_t count;
+} RtTraceCaptureBuffer;
+
+
+static int rt_trace_capture_frame(const RtTraceFrame* frame, void* context) {
+    RtTraceCaptureBuffer* buffer = (RtTraceCaptureBuffer*)context;
+    buffer->frames[buffer->count++] = *frame;
+    return buffer->count < buffer->capacity;
+}
+
+
+uint32_t rt_trace_capture(RtTraceFrame* frames, uint32_t max_frames) {
+    if (max_frames == 0u) {
+        return 0u;
+    }
+    RtTraceCaptureBuffer buffer = {frames, max_frames, 0u};
+    (void)rt_trace_visit(rt_trace_capture_frame, &buffer);
+    return buffer.count;
+}
@@ -1,4 +1,5 @@
 #include "math_rt.h"
+#include "cpu_features.h"
 
 #include <math.h>
 
@@ -70,18 +71,22 @@ double rt_math_cbrt(double value) {
 }
 
 double rt_math_floor(double value) {
+    rt_cpu_detect_features();
     return floor(value);
 }
 
 double rt_math_ceil(double value) {
+    rt_cpu_detect_features();
     return ceil(value);
 }
 
 double rt_math_round(double value) {
+    rt_cpu_detect_features();
     return round(value);
 }
 
 double rt_math_trunc(double value) {
+    rt_cpu_detect_features();
     return trunc(value);
 }
 
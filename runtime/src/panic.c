@@ -1,4 +1,5 @@
 #include "runtime.h"
+#include "line_table.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -12,29 +13,30 @@ enum {
     RT_ARRAY_KIND_REF = 6u,
 };
 
-static void rt_print_stacktrace(void) {
-    RtThreadState* ts = rt_thread_state();
-    if (ts->trace_size == 0u || ts->trace_frames == NULL) {
-        return;
+static int rt_print_trace_frame(const RtTraceFrame* frame, void* context) {
+    int* printed_header = (int*)context;
+    if (!*printed_header) {
+        fprintf(stderr, "stacktrace:\n");
+        *printed_header = 1;
     }
+    const char* function_name = frame->function_name ? frame->function_name : "<unknown>";
+    const char* file_path = frame->file_path ? frame->file_path : "<unknown>";
+    fprintf(stderr, "  at %s (%s:%u:%u)\n", function_name, file_path, frame->line, frame->column);
+    return 1;
+}
 
-    fprintf(stderr, "stacktrace:\n");
-    for (uint32_t index = ts->trace_size; index > 0u; index--) {
-        const RtTraceFrame* frame = &ts->trace_frames[index - 1u];
-        const char* function_name = frame->function_name ? frame->function_name : "<unknown>";
-        const char* file_path = frame->file_path ? frame->file_path : "<unknown>";
-        fprintf(stderr, "  at %s (%s:%u:%u)\n", function_name, file_path, frame->line, frame->column);
-    }
+static void rt_print_stacktrace(void) {
+    int printed_header = 0;
+    (void)rt_trace_visit(rt_print_trace_frame, &printed_header);
 }
 
 static __attribute__((noreturn)) void rt_abort_with_message(const char* message) {
-    RtThreadState* ts = rt_thread_state();
+    RtTraceFrame top;
 
     fprintf(stderr, "panic: %s\n", message ? message : "unknown");
-    if (ts->trace_size > 0u && ts->trace_frames != NULL) {
-        const RtTraceFrame* top = &ts->trace_frames[ts->trace_size - 1u];
-        const char* file_path = top->file_path ? top->file_path : "<unknown>";
-        fprintf(stderr, "location: %s:%u:%u\n", file_path, top->line, top->column);
+    if (rt_trace_capture(&top, 1u) == 1u) {
+        const char* file_path = top.file_path ? top.file_path : "<unknown>";
+        fprintf(stderr, "location: %s:%u:%u\n", file_path, top.line, top.column);
     }
     rt_print_stacktrace();
     abort();
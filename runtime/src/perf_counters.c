@@ -0,0 +1,290 @@
+#if defined(__linux__)
+#define _GNU_SOURCE
+#endif
+
+#include "perf_counters.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define RT_PERF_COUNTERS_SUPPORTED 1
+#else
+#define RT_PERF_COUNTERS_SUPPORTED 0
+#endif
+
+
+static int g_perf_enabled = -1;
+static int g_perf_report_registered = 0;
+static int g_perf_open_attempted = 0;
+static const char* g_perf_unavailable_reason = NULL;
+static RtPerfCounterSample g_perf_program_start = {0};
+
+#if RT_PERF_COUNTERS_SUPPORTED
+static int g_perf_leader_fd = -1;
+static int g_perf_fds[RT_PERF_COUNTER_COUNT] = {-1, -1, -1, -1};
+/* Group reads return values in member creation order, which skips members the
+ * kernel refused; this maps read positions back to counter ids. */
+static RtPerfCounterId g_perf_read_order[RT_PERF_COUNTER_COUNT];
+static uint32_t g_perf_member_count = 0;
+#endif
+
+
+const char* rt_perf_counter_name(RtPerfCounterId id) {
+    switch (id) {
+        case RT_PERF_COUNTER_CYCLES:
+            return "cycles";
+        case RT_PERF_COUNTER_INSTRUCTIONS:
+            return "instructions";
+        case RT_PERF_COUNTER_CACHE_MISSES:
+            return "cache_misses";
+        case RT_PERF_COUNTER_BRANCH_MISSES:
+            return "branch_misses";
+        default:
+            return "unknown";
+    }
+}
+
+
+#if RT_PERF_COUNTERS_SUPPORTED
+static uint64_t rt_perf_hw_config(RtPerfCounterId id) {
+    switch (id) {
+        case RT_PERF_COUNTER_CYCLES:
+            return PERF_COUNT_HW_CPU_CYCLES;
+        case RT_PERF_COUNTER_INSTRUCTIONS:
+            return PERF_COUNT_HW_INSTRUCTIONS;
+        case RT_PERF_COUNTER_CACHE_MISSES:
+            return PERF_COUNT_HW_CACHE_MISSES;
+        case RT_PERF_COUNTER_BRANCH_MISSES:
+        default:
+            return PERF_COUNT_HW_BRANCH_MISSES;
+    }
+}
+
+
+static int rt_perf_open_counter(RtPerfCounterId id, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = rt_perf_hw_config(id);
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = group_fd == -1 ? 1 : 0;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+
+static void rt_perf_open_group(void) {
+    g_perf_leader_fd = rt_perf_open_counter(RT_PERF_COUNTER_CYCLES, -1);
+    if (g_perf_leader_fd < 0) {
+        g_perf_unavailable_reason = strerror(errno);
+        return;
+    }
+    g_perf_fds[RT_PERF_COUNTER_CYCLES] = g_perf_leader_fd;
+    g_perf_read_order[g_perf_member_count++] = RT_PERF_COUNTER_CYCLES;
+
+    for (int id = RT_PERF_COUNTER_INSTRUCTIONS; id < RT_PERF_COUNTER_COUNT; id++) {
+        int fd = rt_perf_open_counter((RtPerfCounterId)id, g_perf_leader_fd);
+        if (fd < 0) {
+            continue;
+        }
+        g_perf_fds[id] = fd;
+        g_perf_read_order[g_perf_member_count++] = (RtPerfCounterId)id;
+    }
+
+    (void)ioctl(g_perf_leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    (void)ioctl(g_perf_leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+
+static void rt_perf_close_group(void) {
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if (g_perf_fds[id] >= 0) {
+            close(g_perf_fds[id]);
+            g_perf_fds[id] = -1;
+        }
+    }
+    g_perf_leader_fd = -1;
+    g_perf_member_count = 0;
+}
+#endif
+
+
+static void rt_perf_ensure_open(void) {
+    if (g_perf_open_attempted) {
+        return;
+    }
+    g_perf_open_attempted = 1;
+#if RT_PERF_COUNTERS_SUPPORTED
+    rt_perf_open_group();
+#else
+    g_perf_unavailable_reason = "perf_event_open is not supported on this platform";
+#endif
+    g_perf_program_start = rt_perf_counters_read();
+}
+
+
+static void rt_perf_print_sample(FILE* out, const char* label, RtPerfCounterSample sample) {
+    fprintf(out, "[perf] %s", label);
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if ((sample.valid_mask & (1u << id)) != 0u) {
+            fprintf(out, " %s=%" PRIu64, rt_perf_counter_name((RtPerfCounterId)id), sample.values[id]);
+        }
+    }
+    const uint32_t ipc_mask = (1u << RT_PERF_COUNTER_CYCLES) | (1u << RT_PERF_COUNTER_INSTRUCTIONS);
+    if ((sample.valid_mask & ipc_mask) == ipc_mask && sample.values[RT_PERF_COUNTER_CYCLES] != 0u) {
+        fprintf(
+            out,
+            " ipc=%.3f",
+            (double)sample.values[RT_PERF_COUNTER_INSTRUCTIONS] / (double)sample.values[RT_PERF_COUNTER_CYCLES]
+        );
+    }
+    fputc('\n', out);
+}
+
+
+static void rt_perf_report_atexit(void) {
+    if (g_perf_enabled <= 0) {
+        return;
+    }
+    if (!rt_perf_counters_available()) {
+        fprintf(
+            stderr,
+            "[perf] counters unavailable: %s\n",
+            g_perf_unavailable_reason != NULL ? g_perf_unavailable_reason : "unknown"
+        );
+        return;
+    }
+    rt_perf_print_sample(stderr, "program", rt_perf_counters_program_elapsed());
+}
+
+
+void rt_perf_counters_configure(int enabled) {
+    g_perf_enabled = enabled ? 1 : 0;
+    if (g_perf_enabled) {
+        rt_perf_ensure_open();
+    }
+}
+
+
+/* NIF_PERF_COUNTERS=1 opens the counter group on the first allocation and
+ * prints whole-program totals at exit. GC tracing reports per-phase deltas
+ * when the group is open.
+ */
+void rt_perf_counters_poll(void) {
+    if (g_perf_enabled >= 0) {
+        return;
+    }
+
+    const char* value = getenv("NIF_PERF_COUNTERS");
+    if (value == NULL || value[0] == '\0' || value[0] == '0') {
+        g_perf_enabled = 0;
+        return;
+    }
+
+    rt_perf_counters_configure(1);
+    if (!g_perf_report_registered) {
+        g_perf_report_registered = 1;
+        (void)atexit(rt_perf_report_atexit);
+    }
+}
+
+
+int rt_perf_counters_available(void) {
+#if RT_PERF_COUNTERS_SUPPORTED
+    return g_perf_enabled > 0 && g_perf_leader_fd >= 0;
+#else
+    return 0;
+#endif
+}
+
+
+RtPerfCounterSample rt_perf_counters_read(void) {
+    RtPerfCounterSample sample = {0};
+#if RT_PERF_COUNTERS_SUPPORTED
+    if (g_perf_leader_fd < 0) {
+        return sample;
+    }
+
+    uint64_t buffer[3 + RT_PERF_COUNTER_COUNT];
+    ssize_t read_bytes = read(g_perf_leader_fd, buffer, sizeof(buffer));
+    if (read_bytes < (ssize_t)(3 * sizeof(uint64_t))) {
+        return sample;
+    }
+
+    const uint64_t member_count = buffer[0];
+    const uint64_t time_enabled = buffer[1];
+    const uint64_t time_running = buffer[2];
+    if (member_count != g_perf_member_count || time_running == 0u) {
+        return sample;
+    }
+
+    for (uint32_t i = 0; i < g_perf_member_count; i++) {
+        uint64_t value = buffer[3 + i];
+        /* Scale up when the kernel multiplexed the group off the PMU. */
+        if (time_running < time_enabled) {
+            value = (uint64_t)((long double)value * (long double)time_enabled / (long double)time_running);
+        }
+        const RtPerfCounterId id = g_perf_read_order[i];
+        sample.values[id] = value;
+        sample.valid_mask |= 1u << id;
+    }
+#endif
+    return sample;
+}
+
+
+RtPerfCounterSample rt_perf_counters_program_elapsed(void) {
+    if (!rt_perf_counters_available()) {
+        return (RtPerfCounterSample){0};
+    }
+    return rt_perf_counters_delta(rt_perf_counters_read(), g_perf_program_start);
+}
+
+
+RtPerfCounterSample rt_perf_counters_delta(RtPerfCounterSample end, RtPerfCounterSample start) {
+    RtPerfCounterSample delta = {0};
+    delta.valid_mask = end.valid_mask & start.valid_mask;
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if ((delta.valid_mask & (1u << id)) != 0u && end.values[id] >= start.values[id]) {
+            delta.values[id] = end.values[id] - start.values[id];
+        }
+    }
+    return delta;
+}
+
+
+void rt_perf_counters_accumulate(RtPerfCounterSample* total, RtPerfCounterSample delta) {
+    if (total->valid_mask == 0u) {
+        total->valid_mask = delta.valid_mask;
+    } else {
+        total->valid_mask &= delta.valid_mask;
+    }
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if (UINT64_MAX - total->values[id] < delta.values[id]) {
+            total->values[id] = UINT64_MAX;
+        } else {
+            total->values[id] += delta.values[id];
+        }
+    }
+}
+
+
+void rt_perf_counters_reset(void) {
+#if RT_PERF_COUNTERS_SUPPORTED
+    rt_perf_close_group();
+#endif
+    g_perf_enabled = -1;
+    g_perf_open_attempted = 0;
+    g_perf_unavailable_reason = NULL;
+    g_perf_program_start = (RtPerfCounterSample){0};
+}
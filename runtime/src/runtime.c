@@ -1,5 +1,9 @@
 #include "runtime.h"
+#include "alloc_profile.h"
+#include "func_profile.h"
+#include "gc_heap_dump.h"
 #include "gc_trace.h"
+#include "perf_counters.h"
 
 #include <math.h>
 #include <limits.h>
@@ -45,7 +49,7 @@ static RtObjHeader* rt_try_alloc_zeroed(uint64_t total_bytes) {
         return obj;
     }
 
-    rt_gc_collect();
+    rt_gc_collect_for(RT_GC_COLLECT_ALLOC_FAILURE);
     return (RtObjHeader*)calloc(1, (size_t)total_bytes);
 }
 
@@ -92,6 +96,9 @@ void rt_init(void) {
 
 void rt_shutdown(void) {
     rt_gc_trace_print_summary();
+    rt_alloc_profile_print_report();
+    rt_func_profile_print_report();
+    rt_gc_heap_dump_at_exit();
     rt_gc_reset_state();
     rt_trace_release_stack();
 }
@@ -141,6 +148,9 @@ void* rt_alloc_obj(RtThreadState* ts, const RtType* type, uint64_t payload_bytes
     }
 
     const uint64_t total = rt_checked_total_size(payload_bytes);
+    rt_gc_trace_poll();
+    rt_gc_heap_dump_poll();
+    rt_perf_counters_poll();
     rt_gc_maybe_collect(total);
 
     RtObjHeader* obj = rt_try_alloc_zeroed(total);
@@ -153,6 +163,7 @@ void* rt_alloc_obj(RtThreadState* ts, const RtType* type, uint64_t payload_bytes
     obj->gc_flags = 0;
     obj->reserved0 = 0;
     rt_gc_track_allocation(obj);
+    rt_alloc_profile_note_allocation(obj);
     return (void*)obj;
 }
 
@@ -162,6 +173,10 @@ static uint64_t rt_type_is_instance_of(const RtType* concrete_type, const RtType
         rt_panic("rt_type_is_instance_of called with NULL expected_type");
     }
 
+    if (expected_type->subtype_id_end != 0u && concrete_type != NULL && concrete_type->subtype_id_end != 0u) {
+        return concrete_type->type_id - expected_type->type_id < expected_type->subtype_id_end - expected_type->type_id ? 1u : 0u;
+    }
+
     for (const RtType* current_type = concrete_type; current_type != NULL; current_type = current_type->super_type) {
         if (current_type == expected_type) {
             return 1u;
@@ -0,0 +1,483 @@
+#include "sort_rt.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "array.h"
+#include "panic.h"
+
+
+/* Unboxed sort and search kernels behind std.sort. i64 and double elements are mapped in place onto u64 keys
+ * whose unsigned order matches theirs (sign-flipped for i64, IEEE 754 totalOrder for double), so one u64
+ * pattern-defeating quicksort and one LSD radix sort serve every 64-bit element type. u8 ranges are counted.
+ * Radix scratch comes from malloc; if that fails the sort falls back to the in-place quicksort. */
+
+enum {
+    /* Partitions below this many elements finish with insertion sort. */
+    RT_SORT_INSERTION_THRESHOLD = 24,
+    /* Partitions above this many elements pick their pivot with Tukey's ninther. */
+    RT_SORT_NINTHER_THRESHOLD = 128,
+    /* An already-partitioned split tries insertion sort first but gives up after this many moves. */
+    RT_SORT_PARTIAL_INSERTION_LIMIT = 8,
+    /* 64-bit ranges at or above this many elements use LSD radix sort. */
+    RT_SORT_RADIX_THRESHOLD = 256,
+    /* u8 ranges at or above this many elements use counting sort. */
+    RT_SORT_COUNTING_THRESHOLD = 64,
+};
+
+static const uint64_t RT_SORT_SIGN_BIT = 0x8000000000000000u;
+
+
+static size_t rt_sort_checked_len(const void* array_obj, int64_t start, int64_t end, const char* message) {
+    if (start < 0 || end < start || (uint64_t)end > rt_array_len(array_obj)) {
+        rt_panic(message);
+    }
+    return (size_t)(end - start);
+}
+
+static uint64_t* rt_sort_words(void* array_obj, int64_t start) {
+    return (uint64_t*)rt_array_data_ptr(array_obj) + start;
+}
+
+static uint64_t rt_sort_double_key(uint64_t bits) {
+    return (bits & RT_SORT_SIGN_BIT) != 0u ? ~bits : bits ^ RT_SORT_SIGN_BIT;
+}
+
+static uint64_t rt_sort_double_bits(uint64_t key) {
+    return (key & RT_SORT_SIGN_BIT) != 0u ? key ^ RT_SORT_SIGN_BIT : ~key;
+}
+
+static void rt_sort_swap(uint64_t* left, uint64_t* right) {
+    const uint64_t value = *left;
+    *left = *right;
+    *right = value;
+}
+
+static void rt_sort_insertion(uint64_t* begin, uint64_t* end) {
+    if (begin == end) {
+        return;
+    }
+    for (uint64_t* cur = begin + 1; cur != end; cur++) {
+        const uint64_t value = *cur;
+        uint64_t* sift = cur;
+        while (sift != begin && value < sift[-1]) {
+            *sift = sift[-1];
+            sift--;
+        }
+        *sift = value;
+    }
+}
+
+/* Insertion sort that relies on begin[-1] being no greater than any element of the range. */
+static void rt_sort_unguarded_insertion(uint64_t* begin, uint64_t* end) {
+    if (begin == end) {
+        return;
+    }
+    for (uint64_t* cur = begin + 1; cur != end; cur++) {
+        const uint64_t value = *cur;
+        uint64_t* sift = cur;
+        while (value < sift[-1]) {
+            *sift = sift[-1];
+            sift--;
+        }
+        *sift = value;
+    }
+}
+
+/* Insertion sort that abandons the range once it has moved too many elements; returns whether it finished. */
+static bool rt_sort_partial_insertion(uint64_t* begin, uint64_t* end) {
+    if (begin == end) {
+        return true;
+    }
+    size_t moves = 0u;
+    for (uint64_t* cur = begin + 1; cur != end; cur++) {
+        if (!(*cur < cur[-1])) {
+            continue;
+        }
+        const uint64_t value = *cur;
+        uint64_t* sift = cur;
+        do {
+            *sift = sift[-1];
+            sift--;
+        } while (sift != begin && value < sift[-1]);
+        *sift = value;
+        moves += (size_t)(cur - sift);
+        if (moves > RT_SORT_PARTIAL_INSERTION_LIMIT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void rt_sort_sort2(uint64_t* left, uint64_t* right) {
+    if (*right < *left) {
+        rt_sort_swap(left, right);
+    }
+}
+
+static void rt_sort_sort3(uint64_t* first, uint64_t* second, uint64_t* third) {
+    rt_sort_sort2(first, second);
+    rt_sort_sort2(second, third);
+    rt_sort_sort2(first, second);
+}
+
+static void rt_sort_sift_down(uint64_t* heap, size_t len, size_t root) {
+    const uint64_t value = heap[root];
+    for (;;) {
+        size_t child = 2u * root + 1u;
+        if (child >= len) {
+            break;
+        }
+        if (child + 1u < len && heap[child] < heap[child + 1u]) {
+            child++;
+        }
+        if (!(value < heap[child])) {
+            break;
+        }
+        heap[root] = heap[child];
+        root = child;
+    }
+    heap[root] = value;
+}
+
+static void rt_sort_heapsort(uint64_t* begin, uint64_t* end) {
+    const size_t len = (size_t)(end - begin);
+    for (size_t root = len / 2u; root > 0u; root--) {
+        rt_sort_sift_down(begin, len, root - 1u);
+    }
+    for (size_t last = len; last > 1u; last--) {
+        rt_sort_swap(begin, begin + last - 1u);
+        rt_sort_sift_down(begin, last - 1u, 0u);
+    }
+}
+
+/* Partitions around the pivot at *begin into [< pivot] pivot [>= pivot]; returns the pivot's final position and
+ * reports whether the range needed no swaps. Requires an element >= pivot before end, which pivot selection
+ * guarantees. */
+static uint64_t* rt_sort_partition_right(uint64_t* begin, uint64_t* end, bool* already_partitioned) {
+    const uint64_t pivot = *begin;
+    uint64_t* first = begin;
+    uint64_t* last = end;
+
+    while (*++first < pivot) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !(*--last < pivot)) {
+        }
+    } else {
+        while (!(*--last < pivot)) {
+        }
+    }
+
+    *already_partitioned = first >= last;
+    while (first < last) {
+        rt_sort_swap(first, last);
+        while (*++first < pivot) {
+        }
+        while (!(*--last < pivot)) {
+        }
+    }
+
+    uint64_t* pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+/* Partitions into [<= pivot] pivot [> pivot]. Used when the pivot equals the element before the range, so the
+ * whole left side is a run of equal keys that never needs sorting again. */
+static uint64_t* rt_sort_partition_left(uint64_t* begin, uint64_t* end) {
+    const uint64_t pivot = *begin;
+    uint64_t* first = begin;
+    uint64_t* last = end;
+
+    while (pivot < *--last) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !(pivot < *++first)) {
+        }
+    } else {
+        while (!(pivot < *++first)) {
+        }
+    }
+
+    while (first < last) {
+        rt_sort_swap(first, last);
+        while (pivot < *--last) {
+        }
+        while (!(pivot < *++first)) {
+        }
+    }
+
+    uint64_t* pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+static void rt_sort_pdq_loop(uint64_t* begin, uint64_t* end, int bad_allowed, bool leftmost) {
+    for (;;) {
+        const size_t size = (size_t)(end - begin);
+        if (size < RT_SORT_INSERTION_THRESHOLD) {
+            if (leftmost) {
+                rt_sort_insertion(begin, end);
+            } else {
+                rt_sort_unguarded_insertion(begin, end);
+            }
+            return;
+        }
+
+        const size_t half = size / 2u;
+        if (size > RT_SORT_NINTHER_THRESHOLD) {
+            rt_sort_sort3(begin, begin + half, end - 1);
+            rt_sort_sort3(begin + 1, begin + (half - 1u), end - 2);
+            rt_sort_sort3(begin + 2, begin + (half + 1u), end - 3);
+            rt_sort_sort3(begin + (half - 1u), begin + half, begin + (half + 1u));
+            rt_sort_swap(begin, begin + half);
+        } else {
+            rt_sort_sort3(begin + half, begin, end - 1);
+        }
+
+        if (!leftmost && !(begin[-1] < *begin)) {
+            begin = rt_sort_partition_left(begin, end) + 1;
+            continue;
+        }
+
+        bool already_partitioned = false;
+        uint64_t* pivot_pos = rt_sort_partition_right(begin, end, &already_partitioned);
+        const size_t left_size = (size_t)(pivot_pos - begin);
+        const size_t right_size = (size_t)(end - (pivot_pos + 1));
+
+        if (left_size < size / 8u || right_size < size / 8u) {
+            /* A lopsided split: after too many of them fall back to heapsort, otherwise break up the pattern
+             * that produced it by swapping a few elements out of place. */
+            if (--bad_allowed == 0) {
+                rt_sort_heapsort(begin, end);
+                return;
+            }
+            if (left_size >= RT_SORT_INSERTION_THRESHOLD) {
+                rt_sort_swap(begin, begin + left_size / 4u);
+                rt_sort_swap(pivot_pos - 1, pivot_pos - left_size / 4u);
+                if (left_size > RT_SORT_NINTHER_THRESHOLD) {
+                    rt_sort_swap(begin + 1, begin + (left_size / 4u + 1u));
+                    rt_sort_swap(begin + 2, begin + (left_size / 4u + 2u));
+                    rt_sort_swap(pivot_pos - 2, pivot_pos - (left_size / 4u + 1u));
+                    rt_sort_swap(pivot_pos - 3, pivot_pos - (left_size / 4u + 2u));
+                }
+            }
+            if (right_size >= RT_SORT_INSERTION_THRESHOLD) {
+                rt_sort_swap(pivot_pos + 1, pivot_pos + (1u + right_size / 4u));
+                rt_sort_swap(end - 1, end - right_size / 4u);
+                if (right_size > RT_SORT_NINTHER_THRESHOLD) {
+                    rt_sort_swap(pivot_pos + 2, pivot_pos + (2u + right_size / 4u));
+                    rt_sort_swap(pivot_pos + 3, pivot_pos + (3u + right_size / 4u));
+                    rt_sort_swap(end - 2, end - (1u + right_size / 4u));
+                    rt_sort_swap(end - 3, end - (2u + right_size / 4u));
+                }
+            }
+        } else if (
+            already_partitioned
+            && rt_sort_partial_insertion(begin, pivot_pos)
+            && rt_sort_partial_insertion(pivot_pos + 1, end)
+        ) {
+            return;
+        }
+
+        rt_sort_pdq_loop(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+static void rt_sort_pdq(uint64_t* keys, size_t len) {
+    int bad_allowed = 1;
+    for (size_t remaining = len; remaining > 1u; remaining >>= 1u) {
+        bad_allowed++;
+    }
+    rt_sort_pdq_loop(keys, keys + len, bad_allowed, true);
+}
+
+/* Byte-wise LSD radix sort; passes whose byte is the same in every key are skipped. Returns false when scratch
+ * space is unavailable. */
+static bool rt_sort_radix(uint64_t* keys, size_t len) {
+    uint64_t* scratch = (uint64_t*)malloc(len * sizeof(uint64_t));
+    if (scratch == NULL) {
+        return false;
+    }
+
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0u; i < len; i++) {
+        const uint64_t key = keys[i];
+        for (unsigned byte = 0u; byte < 8u; byte++) {
+            counts[byte][(key >> (8u * byte)) & 0xffu]++;
+        }
+    }
+
+    uint64_t* source = keys;
+    uint64_t* target = scratch;
+    for (unsigned byte = 0u; byte < 8u; byte++) {
+        const unsigned shift = 8u * byte;
+        size_t* bucket = counts[byte];
+        if (bucket[(keys[0] >> shift) & 0xffu] == len) {
+            continue;
+        }
+        size_t offset = 0u;
+        for (unsigned digit = 0u; digit < 256u; digit++) {
+            const size_t count = bucket[digit];
+            bucket[digit] = offset;
+            offset += count;
+        }
+        for (size_t i = 0u; i < len; i++) {
+            const uint64_t key = source[i];
+            target[bucket[(key >> shift) & 0xffu]++] = key;
+        }
+        uint64_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != keys) {
+        memcpy(keys, source, len * sizeof(uint64_t));
+    }
+    free(scratch);
+    return true;
+}
+
+static void rt_sort_keys(uint64_t* keys, size_t len) {
+    if (len >= RT_SORT_RADIX_THRESHOLD && rt_sort_radix(keys, len)) {
+        return;
+    }
+    rt_sort_pdq(keys, len);
+}
+
+void rt_sort_i64(void* array_obj, int64_t start, int64_t end) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_i64: invalid range");
+    uint64_t* keys = rt_sort_words(array_obj, start);
+    for (size_t i = 0u; i < len; i++) {
+        keys[i] ^= RT_SORT_SIGN_BIT;
+    }
+    rt_sort_keys(keys, len);
+    for (size_t i = 0u; i < len; i++) {
+        keys[i] ^= RT_SORT_SIGN_BIT;
+    }
+}
+
+void rt_sort_u64(void* array_obj, int64_t start, int64_t end) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_u64: invalid range");
+    rt_sort_keys(rt_sort_words(array_obj, start), len);
+}
+
+void rt_sort_double(void* array_obj, int64_t start, int64_t end) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_double: invalid range");
+    uint64_t* keys = rt_sort_words(array_obj, start);
+    for (size_t i = 0u; i < len; i++) {
+        keys[i] = rt_sort_double_key(keys[i]);
+    }
+    rt_sort_keys(keys, len);
+    for (size_t i = 0u; i < len; i++) {
+        keys[i] = rt_sort_double_bits(keys[i]);
+    }
+}
+
+void rt_sort_u8(void* array_obj, int64_t start, int64_t end) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_u8: invalid range");
+    uint8_t* bytes = (uint8_t*)rt_array_data_ptr(array_obj) + start;
+    if (len < RT_SORT_COUNTING_THRESHOLD) {
+        for (size_t i = 1u; i < len; i++) {
+            const uint8_t value = bytes[i];
+            size_t sift = i;
+            while (sift > 0u && value < bytes[sift - 1u]) {
+                bytes[sift] = bytes[sift - 1u];
+                sift--;
+            }
+            bytes[sift] = value;
+        }
+        return;
+    }
+
+    size_t counts[256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0u; i < len; i++) {
+        counts[bytes[i]]++;
+    }
+    for (unsigned value = 0u; value < 256u; value++) {
+        memset(bytes, (int)value, counts[value]);
+        bytes += counts[value];
+    }
+}
+
+/* Searches return the index of the first element equal to value, or -(insertion point) - 1 when it is absent. */
+static int64_t rt_sort_search_result(int64_t start, size_t lower, bool found) {
+    const int64_t index = start + (int64_t)lower;
+    return found ? index : -index - 1;
+}
+
+int64_t rt_sort_search_i64(const void* array_obj, int64_t start, int64_t end, int64_t value) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_search_i64: invalid range");
+    const int64_t* values = (const int64_t*)rt_array_data_ptr(array_obj) + start;
+    size_t lower = 0u;
+    size_t upper = len;
+    while (lower < upper) {
+        const size_t middle = lower + (upper - lower) / 2u;
+        if (values[middle] < value) {
+            lower = middle + 1u;
+        } else {
+            upper = middle;
+        }
+    }
+    return rt_sort_search_result(start, lower, lower < len && values[lower] == value);
+}
+
+int64_t rt_sort_search_u64(const void* array_obj, int64_t start, int64_t end, uint64_t value) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_search_u64: invalid range");
+    const uint64_t* values = (const uint64_t*)rt_array_data_ptr(array_obj) + start;
+    size_t lower = 0u;
+    size_t upper = len;
+    while (lower < upper) {
+        const size_t middle = lower + (upper - lower) / 2u;
+        if (values[middle] < value) {
+            lower = middle + 1u;
+        } else {
+            upper = middle;
+        }
+    }
+    return rt_sort_search_result(start, lower, lower < len && values[lower] == value);
+}
+
+int64_t rt_sort_search_u8(const void* array_obj, int64_t start, int64_t end, uint64_t value) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_search_u8: invalid range");
+    const uint8_t* values = (const uint8_t*)rt_array_data_ptr(array_obj) + start;
+    size_t lower = 0u;
+    size_t upper = len;
+    while (lower < upper) {
+        const size_t middle = lower + (upper - lower) / 2u;
+        if (values[middle] < value) {
+            lower = middle + 1u;
+        } else {
+            upper = middle;
+        }
+    }
+    return rt_sort_search_result(start, lower, lower < len && values[lower] == value);
+}
+
+int64_t rt_sort_search_double(const void* array_obj, int64_t start, int64_t end, double value) {
+    const size_t len = rt_sort_checked_len(array_obj, start, end, "rt_sort_search_double: invalid range");
+    const uint64_t* values = (const uint64_t*)rt_array_data_ptr(array_obj) + start;
+    uint64_t value_bits;
+    memcpy(&value_bits, &value, sizeof(value_bits));
+    const uint64_t key = rt_sort_double_key(value_bits);
+    size_t lower = 0u;
+    size_t upper = len;
+    while (lower < upper) {
+        const size_t middle = lower + (upper - lower) / 2u;
+        if (rt_sort_double_key(values[middle]) < key) {
+            lower = middle + 1u;
+        } else {
+            upper = middle;
+        }
+    }
+    return rt_sort_search_result(start, lower, lower < len && values[lower] == value_bits);
+}
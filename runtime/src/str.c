@@ -0,0 +1,136 @@
+#include "str_rt.h"
+
+#include <string.h>
+
+#include "runtime.h"
+
+
+/* Kernels behind the compiler's fused Str concatenation: the length of every part is summed first, one u8[]
+ * of that size is allocated, and each part is written at a running offset that the call returns. Numeric
+ * parts are formatted byte-for-byte like Str.from_i64, Str.from_u64 and Str.from_double in std/str.nif. */
+
+enum {
+    RT_STR_U64_DIGITS_MAX = 20,
+    RT_STR_DOUBLE_FRACTION_DIGITS = 6,
+};
+
+typedef struct RtStrDoubleParts {
+    int negative;
+    uint64_t int_part;
+    uint64_t frac_part;
+} RtStrDoubleParts;
+
+
+static uint64_t rt_str_u64_digit_count(uint64_t value) {
+    uint64_t count = 1u;
+    while (value >= 10u) {
+        value /= 10u;
+        count += 1u;
+    }
+    return count;
+}
+
+static uint64_t rt_str_i64_magnitude(int64_t value) {
+    return value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+}
+
+/* Same steps as Str.from_double, including the checked double-to-u64 casts that panic on NaN, infinities
+ * and magnitudes of 2^64 or more. */
+static RtStrDoubleParts rt_str_double_parts(double value) {
+    RtStrDoubleParts parts;
+    parts.negative = value < 0.0;
+    if (parts.negative) {
+        value = -value;
+    }
+    parts.int_part = rt_cast_double_to_u64(value);
+    const double frac = value - (double)parts.int_part;
+    parts.frac_part = rt_cast_double_to_u64(frac * 1000000.0 + 0.5);
+    if (parts.frac_part == 1000000u) {
+        parts.int_part += 1u;
+        parts.frac_part = 0u;
+    }
+    return parts;
+}
+
+static uint8_t* rt_str_reserve(void* bytes, uint64_t offset, uint64_t len, const char* message) {
+    const uint64_t capacity = rt_array_len(bytes);
+    if (offset > capacity || len > capacity - offset) {
+        rt_panic(message);
+    }
+    return (uint8_t*)rt_array_data_ptr(bytes) + offset;
+}
+
+/* Writes exactly `digits` decimal digits of value ending just before `end`, zero-padded on the left. */
+static void rt_str_put_digits(uint8_t* end, uint64_t value, uint64_t digits) {
+    while (digits > 0u) {
+        end -= 1;
+        *end = (uint8_t)('0' + value % 10u);
+        value /= 10u;
+        digits -= 1u;
+    }
+}
+
+
+uint64_t rt_str_len_i64(int64_t value) {
+    return (value < 0 ? 1u : 0u) + rt_str_u64_digit_count(rt_str_i64_magnitude(value));
+}
+
+uint64_t rt_str_len_u64(uint64_t value) {
+    return rt_str_u64_digit_count(value);
+}
+
+uint64_t rt_str_len_double(double value) {
+    const RtStrDoubleParts parts = rt_str_double_parts(value);
+    return (parts.negative ? 1u : 0u) + rt_str_u64_digit_count(parts.int_part) + 1u + RT_STR_DOUBLE_FRACTION_DIGITS;
+}
+
+uint64_t rt_str_write_literal(void* bytes, uint64_t offset, const uint8_t* data, uint64_t len) {
+    uint8_t* out = rt_str_reserve(bytes, offset, len, "rt_str_write_literal: buffer overflow");
+    if (len > 0u) {
+        memcpy(out, data, (size_t)len);
+    }
+    return offset + len;
+}
+
+uint64_t rt_str_write_bytes(void* bytes, uint64_t offset, const void* source) {
+    const uint64_t len = rt_array_len(source);
+    uint8_t* out = rt_str_reserve(bytes, offset, len, "rt_str_write_bytes: buffer overflow");
+    if (len > 0u) {
+        memcpy(out, rt_array_data_ptr(source), (size_t)len);
+    }
+    return offset + len;
+}
+
+uint64_t rt_str_write_i64(void* bytes, uint64_t offset, int64_t value) {
+    const uint64_t magnitude = rt_str_i64_magnitude(value);
+    const uint64_t digits = rt_str_u64_digit_count(magnitude);
+    const uint64_t len = (value < 0 ? 1u : 0u) + digits;
+    uint8_t* out = rt_str_reserve(bytes, offset, len, "rt_str_write_i64: buffer overflow");
+    if (value < 0) {
+        out[0] = '-';
+    }
+    rt_str_put_digits(out + len, magnitude, digits);
+    return offset + len;
+}
+
+uint64_t rt_str_write_u64(void* bytes, uint64_t offset, uint64_t value) {
+    const uint64_t digits = rt_str_u64_digit_count(value);
+    uint8_t* out = rt_str_reserve(bytes, offset, digits, "rt_str_write_u64: buffer overflow");
+    rt_str_put_digits(out + digits, value, digits);
+    return offset + digits;
+}
+
+uint64_t rt_str_write_double(void* bytes, uint64_t offset, double value) {
+    const RtStrDoubleParts parts = rt_str_double_parts(value);
+    const uint64_t sign_len = parts.negative ? 1u : 0u;
+    const uint64_t int_digits = rt_str_u64_digit_count(parts.int_part);
+    const uint64_t len = sign_len + int_digits + 1u + RT_STR_DOUBLE_FRACTION_DIGITS;
+    uint8_t* out = rt_str_reserve(bytes, offset, len, "rt_str_write_double: buffer overflow");
+    if (parts.negative) {
+        out[0] = '-';
+    }
+    rt_str_put_digits(out + sign_len + int_digits, parts.int_part, int_digits);
+    out[sign_len + int_digits] = '.';
+    rt_str_put_digits(out + len, parts.frac_part, RT_STR_DOUBLE_FRACTION_DIGITS);
+    return offset + len;
+}
@@ -0,0 +1,419 @@
+#!/usr/bin/env python3
+"""Analyze heap snapshots written by rt_gc_dump_heap / NIF_HEAP_DUMP.
+
+Builds the object graph from the snapshot, computes the dominator tree from a
+virtual super-root through one node per root slot, and reports retained sizes
+per type and per root.
+"""
+from __future__ import annotations
+
+import argparse
+import json
+import struct
+import sys
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+
+MAGIC = b"NIFHEAP1"
+SUPPORTED_VERSION = 1
+
+TAG_TYPE = 1
+TAG_OBJECT = 2
+TAG_ROOT = 3
+TAG_END = 255
+
+ROOT_KIND_NAMES = {1: "stack", 2: "global"}
+
+
+@dataclass(frozen=True)
+class SnapshotType:
+    key: int
+    type_id: int
+    flags: int
+    name: str
+
+
+@dataclass(frozen=True)
+class SnapshotObject:
+    address: int
+    type_key: int
+    size_bytes: int
+    edges: tuple[int, ...]
+
+
+@dataclass(frozen=True)
+class SnapshotRoot:
+    address: int
+    kind: int
+    frame_index: int
+    slot_index: int
+
+    @property
+    def label(self) -> str:
+        kind_name = ROOT_KIND_NAMES.get(self.kind, f"kind{self.kind}")
+        if self.kind == 2:
+            return f"global[{self.slot_index}]"
+        return f"{kind_name}[frame={self.frame_index} slot={self.slot_index}]"
+
+
+@dataclass
+class HeapSnapshot:
+    types: dict[int, SnapshotType] = field(default_factory=dict)
+    objects: list[SnapshotObject] = field(default_factory=list)
+    roots: list[SnapshotRoot] = field(default_factory=list)
+
+    def type_name(self, type_key: int) -> str:
+        snapshot_type = self.types.get(type_key)
+        return "<unknown>" if snapshot_type is None else snapshot_type.name
+
+
+class SnapshotFormatError(ValueError):
+    pass
+
+
+class _Reader:
+    def __init__(self, data: bytes, endian: str) -> None:
+        self._data = data
+        self._offset = 0
+        self._endian = endian
+
+    def take(self, size: int) -> bytes:
+        end = self._offset + size
+        if end > len(self._data):
+            raise SnapshotFormatError("snapshot ended unexpectedly")
+        chunk = self._data[self._offset : end]
+        self._offset = end
+        return chunk
+
+    def u8(self) -> int:
+        return self.take(1)[0]
+
+    def u32(self) -> int:
+        return struct.unpack(self._endian + "I", self.take(4))[0]
+
+    def u64(self) -> int:
+        return struct.unpack(self._endian + "Q", self.take(8))[0]
+
+    def u64_array(self, count: int) -> tuple[int, ...]:
+        return struct.unpack(self._endian + f"{count}Q", self.take(8 * count))
+
+
+def read_snapshot(path: Path) -> HeapSnapshot:
+    data = path.read_bytes()
+    if data[:8] != MAGIC:
+        raise SnapshotFormatError(f"{path}: not a Niflheim heap snapshot")
+
+    endian = "<"
+    if struct.unpack("<I", data[8:12])[0] != SUPPORTED_VERSION:
+        endian = ">"
+        if struct.unpack(">I", data[8:12])[0] != SUPPORTED_VERSION:
+            raise SnapshotFormatError(f"{path}: unsupported snapshot version")
+
+    reader = _Reader(data, endian)
+    reader.take(8)
+    reader.u32()
+    pointer_bytes = reader.u32()
+    if pointer_bytes != 8:
+        raise SnapshotFormatError(f"{path}: unsupported pointer width {pointer_bytes}")
+
+    snapshot = HeapSnapshot()
+    while True:
+        tag = reader.u8()
+        if tag == TAG_TYPE:
+            key = reader.u64()
+            type_id = reader.u32()
+            flags = reader.u32()
+            name = reader.take(reader.u32()).decode("utf-8", errors="replace")
+            snapshot.types[key] = SnapshotType(key=key, type_id=type_id, flags=flags, name=name)
+        elif tag == TAG_OBJECT:
+            address = reader.u64()
+            type_key = reader.u64()
+            size_bytes = reader.u64()
+            edges = reader.u64_array(reader.u32())
+            snapshot.objects.append(SnapshotObject(address, type_key, size_bytes, edges))
+        elif tag == TAG_ROOT:
+            address = reader.u64()
+            kind = reader.u32()
+            frame_index = reader.u32()
+            slot_index = reader.u32()
+            snapshot.roots.append(SnapshotRoot(address, kind, frame_index, slot_index))
+        elif tag == TAG_END:
+            object_count = reader.u64()
+            root_count = reader.u64()
+            if object_count != len(snapshot.objects) or root_count != len(snapshot.roots):
+                raise SnapshotFormatError(f"{path}: end record counts do not match snapshot contents")
+            return snapshot
+        else:
+            raise SnapshotFormatError(f"{path}: unknown record tag {tag}")
+
+
+@dataclass(frozen=True)
+class DominatorResult:
+    """Node 0 is the super-root, nodes 1..root_count are root slots, and the
+    remaining nodes are objects in snapshot order."""
+
+    root_count: int
+    idom: list[int]
+    retained: list[int]
+    reachable: list[bool]
+
+
+def _build_successors(snapshot: HeapSnapshot) -> list[list[int]]:
+    root_count = len(snapshot.roots)
+    object_base = 1 + root_count
+    index_by_address = {obj.address: object_base + index for index, obj in enumerate(snapshot.objects)}
+
+    successors: list[list[int]] = [list(range(1, 1 + root_count))]
+    for root in snapshot.roots:
+        target = index_by_address.get(root.address)
+        successors.append([] if target is None else [target])
+    for obj in snapshot.objects:
+        targets: list[int] = []
+        seen: set[int] = set()
+        for edge in obj.edges:
+            target = index_by_address.get(edge)
+            if target is not None and target not in seen:
+                seen.add(target)
+                targets.append(target)
+        successors.append(targets)
+    return successors
+
+
+def _reverse_postorder(successors: list[list[int]]) -> list[int]:
+    visited = [False] * len(successors)
+    order: list[int] = []
+    stack: list[tuple[int, int]] = [(0, 0)]
+    visited[0] = True
+    while stack:
+        node, child_index = stack[-1]
+        children = successors[node]
+        if child_index < len(children):
+            stack[-1] = (node, child_index + 1)
+            child = children[child_index]
+            if not visited[child]:
+                visited[child] = True
+                stack.append((child, 0))
+        else:
+            stack.pop()
+            order.append(node)
+    order.reverse()
+    return order
+
+
+def compute_dominators(snapshot: HeapSnapshot) -> DominatorResult:
+    """Iterative dominator computation (Cooper, Harvey, Kennedy)."""
+    successors = _build_successors(snapshot)
+    node_count = len(successors)
+    rpo = _reverse_postorder(successors)
+    rpo_index = [-1] * node_count
+    for index, node in enumerate(rpo):
+        rpo_index[node] = index
+
+    predecessors: list[list[int]] = [[] for _ in range(node_count)]
+    for node in rpo:
+        for child in successors[node]:
+            predecessors[child].append(node)
+
+    undefined = -1
+    idom = [undefined] * node_count
+    idom[0] = 0
+
+    def intersect(lhs: int, rhs: int) -> int:
+        while lhs != rhs:
+            while rpo_index[lhs] > rpo_index[rhs]:
+                lhs = idom[lhs]
+            while rpo_index[rhs] > rpo_index[lhs]:
+                rhs = idom[rhs]
+        return lhs
+
+    changed = True
+    while changed:
+        changed = False
+        for node in rpo[1:]:
+            new_idom = undefined
+            for pred in predecessors[node]:
+                if idom[pred] == undefined:
+                    continue
+                new_idom = pred if new_idom == undefined else intersect(pred, new_idom)
+            if new_idom != idom[node]:
+                idom[node] = new_idom
+                changed = True
+
+    root_count = len(snapshot.roots)
+    object_base = 1 + root_count
+    retained = [0] * node_count
+    for index, obj in enumerate(snapshot.objects):
+        retained[object_base + index] = obj.size_bytes
+    for node in reversed(rpo[1:]):
+        retained[idom[node]] += retained[node]
+
+    reachable = [index != -1 for index in rpo_index]
+    return DominatorResult(root_count=root_count, idom=idom, retained=retained, reachable=reachable)
+
+
+@dataclass(frozen=True)
+class TypeSummary:
+    type_name: str
+    count: int
+    shallow_bytes: int
+    retained_bytes: int
+
+
+@dataclass(frozen=True)
+class RootSummary:
+    root: str
+    type_name: str
+    retained_bytes: int
+
+
+@dataclass(frozen=True)
+class HeapReport:
+    object_count: int
+    total_bytes: int
+    reachable_bytes: int
+    unreachable_bytes: int
+    root_count: int
+    types: list[TypeSummary]
+    roots: list[RootSummary]
+
+
+def _type_retained_bytes(snapshot: HeapSnapshot, result: DominatorResult) -> dict[int, int]:
+    """Sum retained sizes per type, skipping objects dominated by another
+    object of the same type so nested structures are not double counted."""
+    object_base = 1 + result.root_count
+    children: list[list[int]] = [[] for _ in result.idom]
+    for node, parent in enumerate(result.idom):
+        if node != 0 and parent >= 0:
+            children[parent].append(node)
+
+    retained_by_type: dict[int, int] = {}
+    active: dict[int, int] = {}
+    stack: list[tuple[int, bool]] = [(0, False)]
+    while stack:
+        node, leaving = stack.pop()
+        type_key = snapshot.objects[node - object_base].type_key if node >= object_base else None
+        if leaving:
+            if type_key is not None:
+                active[type_key] -= 1
+            continue
+        if type_key is not None:
+            if active.get(type_key, 0) == 0:
+                retained_by_type[type_key] = retained_by_type.get(type_key, 0) + result.retained[node]
+            active[type_key] = active.get(type_key, 0) + 1
+        stack.append((node, True))
+        for child in children[node]:
+            stack.append((child, False))
+    return retained_by_type
+
+
+def analyze(snapshot: HeapSnapshot) -> HeapReport:
+    result = compute_dominators(snapshot)
+    object_base = 1 + result.root_count
+
+    counts: dict[int, int] = {}
+    shallow: dict[int, int] = {}
+    reachable_bytes = 0
+    for index, obj in enumerate(snapshot.objects):
+        counts[obj.type_key] = counts.get(obj.type_key, 0) + 1
+        shallow[obj.type_key] = shallow.get(obj.type_key, 0) + obj.size_bytes
+        if result.reachable[object_base + index]:
+            reachable_bytes += obj.size_bytes
+
+    retained_by_type = _type_retained_bytes(snapshot, result)
+    types = sorted(
+        (
+            TypeSummary(
+                type_name=snapshot.type_name(type_key),
+                count=counts[type_key],
+                shallow_bytes=shallow[type_key],
+                retained_bytes=retained_by_type.get(type_key, 0),
+            )
+            for type_key in counts
+        ),
+        key=lambda summary: (-summary.retained_bytes, -summary.shallow_bytes, summary.type_name),
+    )
+
+    type_by_address = {obj.address: obj.type_key for obj in snapshot.objects}
+    roots = sorted(
+        (
+            RootSummary(
+                root=root.label,
+                type_name=snapshot.type_name(type_by_address.get(root.address, 0)),
+                retained_bytes=result.retained[1 + index],
+            )
+            for index, root in enumerate(snapshot.roots)
+        ),
+        key=lambda summary: (-summary.retained_bytes, summary.root),
+    )
+
+    total_bytes = sum(obj.size_bytes for obj in snapshot.objects)
+    return HeapReport(
+        object_count=len(snapshot.objects),
+        total_bytes=total_bytes,
+        reachable_bytes=reachable_bytes,
+        unreachable_bytes=total_bytes - reachable_bytes,
+        root_count=len(snapshot.roots),
+        types=types,
+        roots=roots,
+    )
+
+
+def _print_table(header: tuple[str, ...], rows: list[tuple[str, ...]]) -> None:
+    widths = [len(column) for column in header]
+    for row in rows:
+        for index, cell in enumerate(row):
+            widths[index] = max(widths[index], len(cell))
+
+    def format_row(row: tuple[str, ...]) -> str:
+        return "  ".join(cell.ljust(widths[index]) for index, cell in enumerate(row))
+
+    print(format_row(header))
+    print("  ".join("-" * width for width in widths))
+    for row in rows:
+        print(format_row(row))
+
+
+def _print_report(report: HeapReport, *, top: int) -> None:
+    print(
+        f"objects={report.object_count} total_bytes={report.total_bytes} "
+        f"reachable_bytes={report.reachable_bytes} unreachable_bytes={report.unreachable_bytes} "
+        f"roots={report.root_count}"
+    )
+    print()
+    _print_table(
+        ("type", "count", "shallow_bytes", "retained_bytes"),
+        [
+            (summary.type_name, str(summary.count), str(summary.shallow_bytes), str(summary.retained_bytes))
+            for summary in report.types[:top]
+        ],
+    )
+    print()
+    _print_table(
+        ("root", "type", "retained_bytes"),
+        [(summary.root, summary.type_name, str(summary.retained_bytes)) for summary in report.roots[:top]],
+    )
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compute retained sizes from a Niflheim heap snapshot")
+    parser.add_argument("snapshot", type=Path, help="Snapshot written by rt_gc_dump_heap or NIF_HEAP_DUMP")
+    parser.add_argument("--top", type=int, default=20, help="Number of rows per table")
+    parser.add_argument("--json", action="store_true", help="Emit the full report as JSON")
+    args = parser.parse_args()
+
+    try:
+        snapshot = read_snapshot(args.snapshot)
+    except (OSError, SnapshotFormatError) as error:
+        print(f"analyze_heap_snapshot: {error}", file=sys.stderr)
+        return 1
+
+    report = analyze(snapshot)
+    if args.json:
+        print(json.dumps(asdict(report), indent=2))
+    else:
+        _print_report(report, top=args.top)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,419 @@
+#!/usr/bin/env python3
+from __future__ import annotations
+
+import argparse
+import json
+import math
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from dataclasses import asdict, dataclass
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[1]
+if str(REPO_ROOT) not in sys.path:
+    sys.path.insert(0, str(REPO_ROOT))
+
+from compiler.backend.measurement import analyze_assembly_metrics
+
+
+BENCH_ROOT = REPO_ROOT / "bench"
+BUILD_ROOT = REPO_ROOT / "build" / "bench"
+RESULT_SCHEMA_VERSION = 1
+
+
+@dataclass(frozen=True)
+class BenchSpec:
+    name: str
+    source_path: Path
+    expected_stdout: str
+
+
+BENCH_SPECS: tuple[BenchSpec, ...] = (
+    BenchSpec("alloc_churn", BENCH_ROOT / "alloc_churn.nif", "32508532500\n"),
+    BenchSpec("map_str_hash", BENCH_ROOT / "map_str_hash.nif", "3050908280\n"),
+    BenchSpec("map_counter", BENCH_ROOT / "map_counter.nif", "21064737\n"),
+    BenchSpec("array_loops", BENCH_ROOT / "array_loops.nif", "3979062352439\n"),
+    BenchSpec("dispatch", BENCH_ROOT / "dispatch.nif", "6774200000\n"),
+    BenchSpec("bigint", BENCH_ROOT / "bigint.nif", "8589\n"),
+    BenchSpec("sort", BENCH_ROOT / "sort.nif", "3310965\n"),
+    BenchSpec("grid_search", BENCH_ROOT / "grid_search.nif", "689375716\n"),
+    BenchSpec("vm_benchmark", BENCH_ROOT / "vm_benchmark.nif", "8283210253781781596\n"),
+    BenchSpec("traci_parse", BENCH_ROOT / "traci_parse.nif", "238\n"),
+    BenchSpec("vector_math", BENCH_ROOT / "vector_math.nif", "74231898\n"),
+)
+
+
+@dataclass(frozen=True)
+class BenchResult:
+    name: str
+    source_path: str
+    binary_size_bytes: int
+    assembly: dict[str, int]
+    samples_seconds: list[float]
+    median_seconds: float
+    mean_seconds: float
+    stdev_seconds: float
+    min_seconds: float
+    max_seconds: float
+    max_rss_kb: int | None
+    gc: dict[str, int] | None
+
+
+@dataclass(frozen=True)
+class Comparison:
+    name: str
+    base_median_seconds: float
+    new_median_seconds: float
+    delta_percent: float
+    p_value: float
+    verdict: str
+    base_max_rss_kb: int | None
+    new_max_rss_kb: int | None
+    base_instruction_count: int
+    new_instruction_count: int
+
+
+def _build_bench(spec: BenchSpec, *, label: str, nifc_args: list[str], cc_args: list[str]) -> tuple[Path, Path]:
+    build_dir = BUILD_ROOT / label
+    build_dir.mkdir(parents=True, exist_ok=True)
+    binary_path = build_dir / spec.name
+    env = dict(os.environ)
+    if cc_args:
+        env["NIF_CC_ARGS"] = " ".join(cc_args)
+    command = [str(REPO_ROOT / "scripts" / "build.sh"), str(spec.source_path), str(binary_path)]
+    if nifc_args:
+        command += ["--", *nifc_args]
+    proc = subprocess.run(command, cwd=REPO_ROOT, env=env, capture_output=True, text=True, check=False)
+    if proc.returncode != 0:
+        raise RuntimeError(f"failed to build {spec.name}:\n{proc.stderr}")
+    return binary_path, binary_path.with_name(binary_path.name + ".s")
+
+
+def _run_trial(binary_path: Path, spec: BenchSpec, *, env: dict[str, str] | None = None) -> float:
+    start = time.perf_counter()
+    proc = subprocess.run([str(binary_path)], cwd=REPO_ROOT, env=env, capture_output=True, text=True, check=False)
+    seconds = time.perf_counter() - start
+    if proc.returncode != 0:
+        raise RuntimeError(f"{spec.name} exited with status {proc.returncode}")
+    if proc.stdout != spec.expected_stdout:
+        raise RuntimeError(f"{spec.name} printed {proc.stdout!r}, expected {spec.expected_stdout!r}")
+    return seconds
+
+
+def _collect_gc_stats(binary_path: Path, spec: BenchSpec) -> dict[str, int] | None:
+    with tempfile.TemporaryDirectory() as temp_dir:
+        log_path = Path(temp_dir) / "gc_events.jsonl"
+        env = dict(os.environ)
+        env["NIF_GC_EVENT_LOG"] = str(log_path)
+        _run_trial(binary_path, spec, env=env)
+        if not log_path.exists():
+            return None
+        peak_live_bytes = 0
+        freed_bytes = 0
+        summary: dict[str, object] | None = None
+        for line in log_path.read_text(encoding="utf-8").splitlines():
+            record = json.loads(line)
+            if record["event"] == "gc_cycle":
+                peak_live_bytes = max(peak_live_bytes, int(record["before"]["live_bytes"]))
+                freed_bytes += int(record["freed_bytes"])
+            elif record["event"] == "gc_summary":
+                summary = record
+        if summary is None:
+            return None
+        pauses = summary["pause_ns"]
+        assert isinstance(pauses, dict)
+        # Peak RSS comes from the runtime's VmHWM: rusage for a child forked
+        # from this script would include the interpreter's own footprint.
+        return {
+            "peak_rss_kb": int(summary.get("peak_rss_kb", 0)),
+            "cycles": int(summary["cycles"]),
+            "total_collect_ns": int(summary["total_collect_ns"]),
+            "pause_p50_ns": int(pauses["p50"]),
+            "pause_p99_ns": int(pauses["p99"]),
+            "pause_max_ns": int(pauses["max"]),
+            "peak_live_bytes": peak_live_bytes,
+            "freed_bytes": freed_bytes,
+        }
+
+
+def _measure_bench(
+    spec: BenchSpec,
+    *,
+    label: str,
+    nifc_args: list[str],
+    cc_args: list[str],
+    warmups: int,
+    trials: int,
+) -> BenchResult:
+    binary_path, asm_path = _build_bench(spec, label=label, nifc_args=nifc_args, cc_args=cc_args)
+    assembly = analyze_assembly_metrics(asm_path.read_text(encoding="utf-8"))
+    for _ in range(warmups):
+        _run_trial(binary_path, spec)
+    samples = [_run_trial(binary_path, spec) for _ in range(trials)]
+    gc_stats = _collect_gc_stats(binary_path, spec)
+    return BenchResult(
+        name=spec.name,
+        source_path=str(spec.source_path.relative_to(REPO_ROOT)),
+        binary_size_bytes=binary_path.stat().st_size,
+        assembly=assembly.to_dict(),
+        samples_seconds=samples,
+        median_seconds=statistics.median(samples),
+        mean_seconds=statistics.fmean(samples),
+        stdev_seconds=statistics.stdev(samples) if len(samples) > 1 else 0.0,
+        min_seconds=min(samples),
+        max_seconds=max(samples),
+        max_rss_kb=None if gc_stats is None or gc_stats["peak_rss_kb"] == 0 else gc_stats["peak_rss_kb"],
+        gc=gc_stats,
+    )
+
+
+def _git_revision() -> str | None:
+    proc = subprocess.run(
+        ["git", "rev-parse", "--short", "HEAD"], cwd=REPO_ROOT, capture_output=True, text=True, check=False
+    )
+    return proc.stdout.strip() if proc.returncode == 0 else None
+
+
+def _regularized_incomplete_beta(x: float, a: float, b: float) -> float:
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    # Use the symmetry relation where the continued fraction converges fastest.
+    if x > (a + 1.0) / (a + b + 2.0):
+        return 1.0 - _regularized_incomplete_beta(1.0 - x, b, a)
+
+    log_front = math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log1p(-x)
+    tiny = 1e-300
+    c = 1.0
+    d = 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    fraction = d
+    for m in range(1, 300):
+        for numerator in (
+            m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m)),
+            -(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0)),
+        ):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            fraction *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return math.exp(log_front) * fraction / a
+
+
+def welch_t_test(base: list[float], new: list[float]) -> float:
+    """Two-sided p-value for the null hypothesis that both samples share a mean."""
+    if len(base) < 2 or len(new) < 2:
+        return 1.0
+    base_var = statistics.variance(base) / len(base)
+    new_var = statistics.variance(new) / len(new)
+    mean_delta = statistics.fmean(new) - statistics.fmean(base)
+    if base_var + new_var == 0.0:
+        return 1.0 if mean_delta == 0.0 else 0.0
+    t = mean_delta / math.sqrt(base_var + new_var)
+    dof = (base_var + new_var) ** 2 / (
+        base_var**2 / (len(base) - 1) + new_var**2 / (len(new) - 1)
+    )
+    return _regularized_incomplete_beta(dof / (dof + t * t), dof / 2.0, 0.5)
+
+
+def compare_results(
+    base: dict[str, object],
+    new: dict[str, object],
+    *,
+    alpha: float,
+    threshold_percent: float,
+) -> list[Comparison]:
+    base_benches = base["benchmarks"]
+    new_benches = new["benchmarks"]
+    assert isinstance(base_benches, dict) and isinstance(new_benches, dict)
+    comparisons: list[Comparison] = []
+    for name in sorted(set(base_benches) & set(new_benches)):
+        base_bench = base_benches[name]
+        new_bench = new_benches[name]
+        base_median = float(base_bench["median_seconds"])
+        new_median = float(new_bench["median_seconds"])
+        delta_percent = 0.0 if base_median == 0.0 else (new_median - base_median) / base_median * 100.0
+        p_value = welch_t_test(list(base_bench["samples_seconds"]), list(new_bench["samples_seconds"]))
+        verdict = "same"
+        if p_value < alpha and abs(delta_percent) >= threshold_percent:
+            verdict = "slower" if delta_percent > 0.0 else "faster"
+        comparisons.append(
+            Comparison(
+                name=name,
+                base_median_seconds=base_median,
+                new_median_seconds=new_median,
+                delta_percent=delta_percent,
+                p_value=p_value,
+                verdict=verdict,
+                base_max_rss_kb=base_bench["max_rss_kb"],
+                new_max_rss_kb=new_bench["max_rss_kb"],
+                base_instruction_count=int(base_bench["assembly"]["instruction_count"]),
+                new_instruction_count=int(new_bench["assembly"]["instruction_count"]),
+            )
+        )
+    return comparisons
+
+
+def _print_rows(header: tuple[str, ...], rows: list[tuple[str, ...]]) -> None:
+    widths = [len(column) for column in header]
+    for row in rows:
+        for index, cell in enumerate(row):
+            widths[index] = max(widths[index], len(cell))
+
+    def format_row(row: tuple[str, ...]) -> str:
+        return "  ".join(cell.ljust(widths[index]) for index, cell in enumerate(row))
+
+    print(format_row(header))
+    print("  ".join("-" * width for width in widths))
+    for row in rows:
+        print(format_row(row))
+
+
+def _print_run_table(results: list[BenchResult]) -> None:
+    rows = [
+        (
+            result.name,
+            f"{result.median_seconds * 1000.0:.3f}",
+            f"{result.stdev_seconds * 1000.0:.3f}",
+            "-" if result.max_rss_kb is None else str(result.max_rss_kb),
+            "-" if result.gc is None else str(result.gc["cycles"]),
+            "-" if result.gc is None else f"{result.gc['pause_p99_ns'] / 1e6:.3f}",
+            str(result.assembly["instruction_count"]),
+            str(result.binary_size_bytes),
+        )
+        for result in results
+    ]
+    _print_rows(
+        ("bench", "median_ms", "stdev_ms", "max_rss_kb", "gc_cycles", "pause_p99_ms", "instr", "binary_bytes"),
+        rows,
+    )
+
+
+def _print_compare_table(comparisons: list[Comparison]) -> None:
+    rows = [
+        (
+            comparison.name,
+            f"{comparison.base_median_seconds * 1000.0:.3f}",
+            f"{comparison.new_median_seconds * 1000.0:.3f}",
+            f"{comparison.delta_percent:+.2f}%",
+            f"{comparison.p_value:.4f}",
+            comparison.verdict,
+            f"{comparison.base_max_rss_kb or '-'}->{comparison.new_max_rss_kb or '-'}",
+            f"{comparison.base_instruction_count}->{comparison.new_instruction_count}",
+        )
+        for comparison in comparisons
+    ]
+    _print_rows(("bench", "base_ms", "new_ms", "delta", "p_value", "verdict", "max_rss_kb", "instr"), rows)
+
+
+def _load_results(path: Path) -> dict[str, object]:
+    payload = json.loads(path.read_text(encoding="utf-8"))
+    if not isinstance(payload, dict) or payload.get("schema_version") != RESULT_SCHEMA_VERSION:
+        raise ValueError(f"{path}: not a schema v{RESULT_SCHEMA_VERSION} bench result file")
+    return payload
+
+
+def _run_command(args: argparse.Namespace) -> int:
+    if args.trials < 2:
+        print("bench.py: --trials must be at least 2 for significance testing", file=sys.stderr)
+        return 2
+    selected = [spec for spec in BENCH_SPECS if args.bench is None or spec.name in set(args.bench)]
+    results = [
+        _measure_bench(
+            spec,
+            label=args.label,
+            nifc_args=args.nifc_arg or [],
+            cc_args=args.cc_arg or [],
+            warmups=args.warmup,
+            trials=args.trials,
+        )
+        for spec in selected
+    ]
+
+    output_path = args.output or (BUILD_ROOT / args.label / "results.json")
+    output_path.parent.mkdir(parents=True, exist_ok=True)
+    payload = {
+        "schema_version": RESULT_SCHEMA_VERSION,
+        "label": args.label,
+        "git_revision": _git_revision(),
+        "host": platform.node(),
+        "machine": platform.machine(),
+        "nifc_args": args.nifc_arg or [],
+        "cc_args": args.cc_arg or [],
+        "warmups": args.warmup,
+        "trials": args.trials,
+        "benchmarks": {result.name: asdict(result) for result in results},
+    }
+    output_path.write_text(json.dumps(payload, indent=2) + "\n", encoding="utf-8")
+
+    _print_run_table(results)
+    print(f"\nWrote JSON results to {output_path}")
+    return 0
+
+
+def _compare_command(args: argparse.Namespace) -> int:
+    try:
+        base = _load_results(args.base)
+        new = _load_results(args.new)
+    except (OSError, ValueError) as error:
+        print(f"bench.py: {error}", file=sys.stderr)
+        return 2
+
+    comparisons = compare_results(base, new, alpha=args.alpha, threshold_percent=args.threshold)
+    if args.json:
+        print(json.dumps([asdict(comparison) for comparison in comparisons], indent=2))
+    else:
+        _print_compare_table(comparisons)
+
+    regressions = [comparison.name for comparison in comparisons if comparison.verdict == "slower"]
+    if regressions and args.fail_on_regression:
+        print(f"\nSignificant regressions: {', '.join(regressions)}", file=sys.stderr)
+        return 1
+    return 0
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Build, run, and compare the bench/ performance suite")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    run_parser = subparsers.add_parser("run", help="Build and time the suite, writing a JSON result file")
+    run_parser.add_argument(
+        "--bench",
+        action="append",
+        choices=[spec.name for spec in BENCH_SPECS],
+        help="Limit the run to one or more named benchmarks",
+    )
+    run_parser.add_argument("--label", default="default", help="Result label; also names the build directory")
+    run_parser.add_argument("--nifc-arg", action="append", help="Extra compiler argument (repeatable)")
+    run_parser.add_argument("--cc-arg", action="append", help="Extra C compiler/linker argument (repeatable)")
+    run_parser.add_argument("--warmup", type=int, default=1, help="Untimed runs per benchmark before trials")
+    run_parser.add_argument("--trials", type=int, default=10, help="Timed runs per benchmark")
+    run_parser.add_argument("--output", type=Path, help="Result path (default: build/bench/<label>/results.json)")
+
+    compare_parser = subparsers.add_parser("compare", help="Compare two result files with a Welch t-test")
+    compare_parser.add_argument("base", type=Path)
+    compare_parser.add_argument("new", type=Path)
+    compare_parser.add_argument("--alpha", type=float, default=0.01, help="Significance level (default 0.01)")
+    compare_parser.add_argument(
+        "--threshold", type=float, default=2.0, help="Minimum median change in percent to report (default 2.0)"
+    )
+    compare_parser.add_argument("--fail-on-regression", action="store_true", help="Exit 1 on significant slowdowns")
+    compare_parser.add_argument("--json", action="store_true", help="Emit comparisons as JSON")
+
+    args = parser.parse_args()
+    if args.command == "run":
+        return _run_command(args)
+    return _compare_command(args)
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -53,9 +53,9 @@ if [[ -n "${NIFC_BUILD_ARGS:-}" ]]; then
   read -r -a extra_nifc_args <<< "$NIFC_BUILD_ARGS"
 fi
 
-cc_args=(-O2 -std=c11)
+cc_args=(-O2 -std=c11 -fno-omit-frame-pointer)
 if [[ "${NIF_PROFILE_BUILD:-0}" != "0" ]]; then
-  cc_args+=(-g -fno-omit-frame-pointer)
+  cc_args+=(-g)
 fi
 if [[ -n "${NIF_CC_ARGS:-}" ]]; then
   read -r -a extra_cc_args <<< "$NIF_CC_ARGS"
@@ -82,9 +82,21 @@ else
     "$repo_root/runtime/src/gc.c"
     "$repo_root/runtime/src/gc_trace.c"
     "$repo_root/runtime/src/gc_tracked_set.c"
+    "$repo_root/runtime/src/alloc_profile.c"
+    "$repo_root/runtime/src/gc_heap_dump.c"
+    "$repo_root/runtime/src/perf_counters.c"
+    "$repo_root/runtime/src/func_profile.c"
+    "$repo_root/runtime/src/line_table.c"
     "$repo_root/runtime/src/io.c"
     "$repo_root/runtime/src/array.c"
+    "$repo_root/runtime/src/cpu_features.c"
     "$repo_root/runtime/src/math.c"
+    "$repo_root/runtime/src/bits.c"
+    "$repo_root/runtime/src/bigint.c"
+    "$repo_root/runtime/src/bitset.c"
+    "$repo_root/runtime/src/box.c"
+    "$repo_root/runtime/src/sort.c"
+    "$repo_root/runtime/src/str.c"
     "$repo_root/runtime/src/panic.c"
     "$asm_out"
   )
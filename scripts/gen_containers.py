@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+from __future__ import annotations
+
+import argparse
+import sys
+from dataclasses import dataclass
+from pathlib import Path
+from string import Template
+
+
+REPO_ROOT = Path(__file__).resolve().parents[1]
+STD_ROOT = REPO_ROOT / "std"
+
+
+@dataclass(frozen=True)
+class ContainerSpec:
+    class_name: str
+    element_type: str
+    output_name: str
+
+
+@dataclass(frozen=True)
+class ContainerFamily:
+    template_path: Path
+    specs: tuple[ContainerSpec, ...]
+
+
+CONTAINER_FAMILIES: tuple[ContainerFamily, ...] = (
+    ContainerFamily(
+        template_path=STD_ROOT / "vec_impl" / "vec_T.nif.template",
+        specs=(
+            ContainerSpec(class_name="VecU8", element_type="u8", output_name="vec_u8.nif"),
+            ContainerSpec(class_name="VecI64", element_type="i64", output_name="vec_i64.nif"),
+            ContainerSpec(class_name="VecU64", element_type="u64", output_name="vec_u64.nif"),
+            ContainerSpec(class_name="VecDouble", element_type="double", output_name="vec_double.nif"),
+        ),
+    ),
+    ContainerFamily(
+        template_path=STD_ROOT / "heap_impl" / "heap_T.nif.template",
+        specs=(
+            ContainerSpec(class_name="HeapI64", element_type="i64", output_name="heap_i64.nif"),
+            ContainerSpec(class_name="HeapU64", element_type="u64", output_name="heap_u64.nif"),
+        ),
+    ),
+    ContainerFamily(
+        template_path=STD_ROOT / "deque_impl" / "deque_T.nif.template",
+        specs=(
+            ContainerSpec(class_name="DequeI64", element_type="i64", output_name="deque_i64.nif"),
+            ContainerSpec(class_name="DequeU64", element_type="u64", output_name="deque_u64.nif"),
+        ),
+    ),
+)
+
+
+def _render(template: Template, spec: ContainerSpec) -> str:
+    rendered = template.substitute(
+        CLASS_NAME=spec.class_name,
+        ELEMENT_TYPE=spec.element_type,
+    )
+    return rendered.rstrip() + "\n"
+
+
+def _check_or_write(family: ContainerFamily, *, check_only: bool) -> bool:
+    template = Template(family.template_path.read_text(encoding="utf-8"))
+    dirty = False
+
+    for spec in family.specs:
+        output_path = family.template_path.parent / spec.output_name
+        rendered = _render(template, spec)
+        current = output_path.read_text(encoding="utf-8") if output_path.exists() else None
+        if current == rendered:
+            continue
+
+        dirty = True
+        if check_only:
+            print(f"out of date: {output_path.relative_to(REPO_ROOT)}")
+            continue
+
+        output_path.write_text(rendered, encoding="utf-8")
+        print(f"updated {output_path.relative_to(REPO_ROOT)}")
+
+    return dirty
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Generate specialized primitive container modules.")
+    parser.add_argument(
+        "--check",
+        action="store_true",
+        help="Exit non-zero if generated files differ from the template output.",
+    )
+    args = parser.parse_args()
+
+    dirty = False
+    for family in CONTAINER_FAMILIES:
+        if not family.template_path.exists():
+            print(f"template not found: {family.template_path}", file=sys.stderr)
+            return 2
+        dirty = _check_or_write(family, check_only=args.check) or dirty
+
+    if args.check and dirty:
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
\ No newline at end of file
@@ -0,0 +1,110 @@
+from __future__ import annotations
+
+from compiler.backend.analysis import analyze_callable_induction_variables
+from compiler.backend.ir import BackendArrayLoadInst, BackendArrayStoreInst
+from compiler.backend.optimizations import rotate_callable_loops
+from tests.compiler.backend.analysis.helpers import lower_source_to_backend_callable_fixture
+
+
+def _array_access_ids(callable_decl) -> list:
+    return [
+        instruction.inst_id
+        for block in callable_decl.blocks
+        for instruction in block.instructions
+        if isinstance(instruction, (BackendArrayLoadInst, BackendArrayStoreInst))
+    ]
+
+
+def test_induction_variables_prove_counted_loop_reads_in_bounds(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn sum(values: i64[]) -> i64 {
+            var total: i64 = 0;
+            var n: i64 = (i64)values.len();
+            var i: i64 = 0;
+            while i < n {
+                total = total + values[i];
+                i = i + 1;
+            }
+            return total;
+        }
+
+        fn main() -> i64 {
+            return sum(i64[](4u));
+        }
+        """,
+        callable_name="sum",
+    )
+    access_ids = _array_access_ids(fixture.callable_decl)
+
+    facts = analyze_callable_induction_variables(fixture.callable_decl, cfg=fixture.cfg)
+    rotated_facts = analyze_callable_induction_variables(rotate_callable_loops(fixture.callable_decl))
+
+    assert len(access_ids) == 1
+    assert facts.in_bounds_access_ids() == tuple(access_ids)
+    assert rotated_facts.in_bounds_access_ids() == tuple(access_ids)
+
+
+def test_induction_variables_prove_unsigned_guard_against_allocated_length(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn build(count: u64) -> i64[] {
+            var values: i64[] = i64[](count);
+            var i: i64 = 0;
+            while (u64)i < count {
+                values[i] = i;
+                i = i + 1;
+            }
+            return values;
+        }
+
+        fn main() -> i64 {
+            return build(4u)[0];
+        }
+        """,
+        callable_name="build",
+    )
+
+    facts = analyze_callable_induction_variables(fixture.callable_decl)
+
+    assert facts.in_bounds_access_ids() == tuple(_array_access_ids(fixture.callable_decl))
+
+
+def test_induction_variables_keep_checks_the_loop_does_not_prove(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn mixed(values: i64[], other: i64[], start: i64) -> i64 {
+            var total: i64 = 0;
+            var n: i64 = (i64)values.len();
+            var i: i64 = 0;
+            while i <= n {
+                total = total + values[i];
+                i = i + 1;
+            }
+            var j: i64 = 0;
+            while j < n {
+                total = total + other[j];
+                j = j + 2;
+            }
+            var k: i64 = start;
+            while k < n {
+                total = total + values[k];
+                k = k + 1;
+            }
+            return total;
+        }
+
+        fn main() -> i64 {
+            return mixed(i64[](4u), i64[](4u), 0);
+        }
+        """,
+        callable_name="mixed",
+    )
+
+    facts = analyze_callable_induction_variables(fixture.callable_decl)
+
+    assert len(_array_access_ids(fixture.callable_decl)) == 3
+    assert facts.in_bounds_access_ids() == ()
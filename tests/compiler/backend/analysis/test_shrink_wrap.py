@@ -0,0 +1,88 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from compiler.backend.analysis import analyze_callable_shrink_wrap
+from compiler.backend.ir import BackendReturnTerminator
+from tests.compiler.backend.analysis.helpers import lower_source_to_backend_callable_fixture
+
+
+def _block_by_name(callable_decl, debug_name: str):
+    return next(block for block in callable_decl.blocks if block.debug_name == debug_name)
+
+
+def test_shrink_wrap_moves_root_frame_setup_past_early_return(tmp_path: Path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn keep(value: Obj, fast: bool) -> Obj {
+            if fast {
+                return null;
+            }
+            rt_gc_collect();
+            return value;
+        }
+
+        fn main() -> i64 {
+            keep(null, true);
+            return 0;
+        }
+        """,
+        callable_name="keep",
+    )
+
+    shrink_wrap = analyze_callable_shrink_wrap(fixture.callable_decl)
+    fast_return = _block_by_name(fixture.callable_decl, "if.then")
+    slow_path = _block_by_name(fixture.callable_decl, "if.end")
+
+    assert not shrink_wrap.sets_up_root_frame_in_prologue()
+    assert shrink_wrap.block_sets_up_root_frame(slow_path.block_id)
+    assert isinstance(fast_return.terminator, BackendReturnTerminator)
+    assert shrink_wrap.unframed_return_block_ids == frozenset({fast_return.block_id})
+    assert not shrink_wrap.return_skips_root_frame(slow_path.block_id)
+
+
+def test_shrink_wrap_keeps_prologue_setup_for_safepoints_in_loops_and_merging_returns(tmp_path: Path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn in_loop(value: Obj, count: i64) -> Obj {
+            var i: i64 = 0;
+            while i < count {
+                rt_gc_collect();
+                i = i + 1;
+            }
+            return value;
+        }
+
+        fn merged(value: Obj, slow: bool) -> Obj {
+            var result: Obj = null;
+            if slow {
+                rt_gc_collect();
+                result = value;
+            }
+            return result;
+        }
+
+        fn main() -> i64 {
+            in_loop(null, 1);
+            merged(null, true);
+            return 0;
+        }
+        """,
+        callable_name="in_loop",
+    )
+
+    loop_wrap = analyze_callable_shrink_wrap(fixture.callable_decl)
+    merged_decl = next(
+        callable_decl for callable_decl in fixture.program.callables if getattr(callable_decl.callable_id, "name", None) == "merged"
+    )
+    merged_wrap = analyze_callable_shrink_wrap(merged_decl)
+
+    assert loop_wrap.sets_up_root_frame_in_prologue()
+    assert merged_wrap.sets_up_root_frame_in_prologue()
+    assert merged_wrap.unframed_return_block_ids == frozenset()
@@ -7,6 +7,7 @@ from compiler.backend.ir import (
     BackendConstOperand,
     BackendCopyInst,
     BackendDirectCallTarget,
+    BackendEffects,
     BackendIndirectCallTarget,
     BackendNullConst,
     BackendReturnTerminator,
@@ -17,6 +18,7 @@ from tests.compiler.backend.lowering.helpers import (
     block_by_ordinal,
     callable_by_name,
     callable_by_suffix,
+    lower_project_to_backend_program,
     lower_source_to_backend_program,
 )
 
@@ -231,6 +233,89 @@ def test_lower_to_backend_ir_preserves_mixed_scalar_call_signatures_with_double_
     assert mix_call.signature.return_type.canonical_name == "double"
 
 
+def test_lower_to_backend_ir_marks_std_math_intrinsic_calls_pure(tmp_path) -> None:
+    program = lower_project_to_backend_program(
+        tmp_path,
+        {
+            "std/math.nif": """
+            extern fn rt_math_sqrt(value: double) -> double;
+            extern fn rt_math_pow(base: double, exponent: double) -> double;
+
+            export fn sqrt(value: double) -> double {
+                return rt_math_sqrt(value);
+            }
+
+            export fn pow(base: double, exponent: double) -> double {
+                return rt_math_pow(base, exponent);
+            }
+            """,
+            "main.nif": """
+            import std.math as math;
+
+            fn main() -> i64 {
+                if math.sqrt(4.0) == math.pow(2.0, 1.0) {
+                    return 0;
+                }
+                return 1;
+            }
+            """,
+        },
+        skip_optimize=True,
+    )
+
+    main_calls = {
+        instruction.target.callable_id.name: instruction
+        for instruction in block_by_ordinal(callable_by_name(program, "main"), 0).instructions
+        if isinstance(instruction, BackendCallInst)
+    }
+    wrapper_call = next(
+        instruction
+        for instruction in block_by_ordinal(callable_by_name(program, "sqrt"), 0).instructions
+        if isinstance(instruction, BackendCallInst)
+    )
+
+    assert main_calls["sqrt"].effects == BackendEffects()
+    assert main_calls["pow"].effects.may_gc
+    assert wrapper_call.target.callable_id.name == "rt_math_sqrt"
+    assert wrapper_call.effects == BackendEffects()
+
+
+def test_lower_to_backend_ir_marks_std_bits_intrinsic_calls_pure_only_for_u64_signatures(tmp_path) -> None:
+    program = lower_project_to_backend_program(
+        tmp_path,
+        {
+            "std/bits.nif": """
+            extern fn rt_bits_popcount(value: u64) -> u64;
+
+            export fn popcount(value: u64) -> u64 {
+                return rt_bits_popcount(value);
+            }
+
+            export fn clz(value: i64) -> i64 {
+                return value;
+            }
+            """,
+            "main.nif": """
+            import std.bits as bits;
+
+            fn main() -> i64 {
+                return (i64)bits.popcount(7u) + bits.clz(1);
+            }
+            """,
+        },
+        skip_optimize=True,
+    )
+
+    main_calls = {
+        instruction.target.callable_id.name: instruction
+        for instruction in block_by_ordinal(callable_by_name(program, "main"), 0).instructions
+        if isinstance(instruction, BackendCallInst)
+    }
+
+    assert main_calls["popcount"].effects == BackendEffects()
+    assert main_calls["clz"].effects.may_gc
+
+
 def test_lower_to_backend_ir_materializes_function_refs_for_callable_value_calls(tmp_path) -> None:
     program = lower_source_to_backend_program(
         tmp_path,
@@ -118,6 +118,109 @@ def test_algebraic_simplify_rewrites_bool_identities_and_double_not() -> None:
     assert _copy_source(instructions[9]) == _reg(0)
 
 
+def test_algebraic_simplify_rewrites_power_of_two_division_into_shift_and_mask() -> None:
+    program = _program_with_instructions(
+        (
+            _binary_i64(0, 1, BinaryOpKind.DIVIDE, _reg(0), _i64(8)),
+            _binary_i64(1, 2, BinaryOpKind.REMAINDER, _reg(1), _i64(8)),
+        ),
+        return_reg_id=_reg_id(2),
+        registers=tuple(_register(ordinal, TYPE_NAME_I64) for ordinal in range(3)),
+        param_type_name=TYPE_NAME_I64,
+    )
+
+    optimized = algebraic_simplify(program)
+    verify_backend_program(optimized)
+
+    instructions = optimized.callables[0].blocks[0].instructions
+    assert [(instruction.op.kind, instruction.right) for instruction in instructions] == [
+        (BinaryOpKind.SHIFT_RIGHT, _u64(3)),
+        (BinaryOpKind.BITWISE_AND, _i64(7)),
+    ]
+
+
+def test_algebraic_simplify_expands_constant_division_into_multiply_high_sequence() -> None:
+    program = _program_with_instructions(
+        (
+            _binary_i64(0, 1, BinaryOpKind.REMAINDER, _reg(0), _i64(10)),
+            _binary_i64(1, 2, BinaryOpKind.ADD, _reg(1), _reg(0)),
+        ),
+        return_reg_id=_reg_id(2),
+        registers=tuple(_register(ordinal, TYPE_NAME_I64) for ordinal in range(3)),
+        param_type_name=TYPE_NAME_I64,
+    )
+
+    optimized = algebraic_simplify(program)
+    verify_backend_program(optimized)
+
+    callable_decl = optimized.callables[0]
+    instructions = callable_decl.blocks[0].instructions
+    assert [instruction.inst_id.ordinal for instruction in instructions] == list(range(len(instructions)))
+    assert [instruction.op.kind for instruction in instructions] == [
+        BinaryOpKind.SHIFT_RIGHT,
+        BinaryOpKind.BITWISE_XOR,
+        BinaryOpKind.MULTIPLY_HIGH,
+        BinaryOpKind.SHIFT_RIGHT,
+        BinaryOpKind.BITWISE_XOR,
+        BinaryOpKind.MULTIPLY,
+        BinaryOpKind.SUBTRACT,
+        BinaryOpKind.ADD,
+    ]
+    assert instructions[-2].dest == _reg_id(1)
+    assert len(callable_decl.registers) == 3 + 6
+
+
+def test_algebraic_simplify_constant_division_matches_floor_division() -> None:
+    numerators_by_type = {
+        TYPE_NAME_I64: [-(1 << 63), -(1 << 63) + 1, -1001, -10, -7, -1, 0, 1, 6, 7, 1001, (1 << 63) - 1],
+        TYPE_NAME_U64: [0, 1, 6, 7, 1001, (1 << 63) - 1, 1 << 63, (1 << 64) - 2, (1 << 64) - 1],
+    }
+    divisors_by_type = {
+        TYPE_NAME_I64: [2, 3, 5, 6, 7, 10, 16, 641, 1000000007, 1 << 62, (1 << 63) - 1],
+        TYPE_NAME_U64: [2, 3, 5, 6, 7, 10, 16, 641, 1000000007, 1 << 63, (1 << 63) + 1, (1 << 64) - 1],
+    }
+    for type_name, divisors in divisors_by_type.items():
+        numerators = numerators_by_type[type_name]
+        mask = (1 << 64) - 1
+        numerators += [_canonical((n * 0x9E3779B97F4A7C15) & mask, type_name) for n in range(1, 200)]
+        for divisor in divisors:
+            for kind in (BinaryOpKind.DIVIDE, BinaryOpKind.REMAINDER):
+                program = _program_with_instructions(
+                    (_binary_i64(0, 1, kind, _reg(0), _int(type_name, divisor)),),
+                    return_reg_id=_reg_id(1),
+                    registers=(_register(0, type_name), _register(1, type_name)),
+                    param_type_name=type_name,
+                    return_type_name=type_name,
+                )
+                optimized = algebraic_simplify(program)
+                verify_backend_program(optimized)
+                instructions = optimized.callables[0].blocks[0].instructions
+                assert all(
+                    instruction.op.kind not in (BinaryOpKind.DIVIDE, BinaryOpKind.REMAINDER)
+                    for instruction in instructions
+                )
+
+                for numerator in numerators:
+                    expected = numerator // divisor if kind is BinaryOpKind.DIVIDE else numerator % divisor
+                    assert _evaluate(instructions, numerator, type_name) == expected, (
+                        type_name,
+                        kind,
+                        numerator,
+                        divisor,
+                    )
+
+
+def test_algebraic_simplify_keeps_hardware_divide_for_negative_divisors() -> None:
+    program = _program_with_instructions(
+        (_binary_i64(0, 1, BinaryOpKind.DIVIDE, _reg(0), _i64(-7)),),
+        return_reg_id=_reg_id(1),
+        registers=(_register(0, TYPE_NAME_I64), _register(1, TYPE_NAME_I64)),
+        param_type_name=TYPE_NAME_I64,
+    )
+
+    assert algebraic_simplify(program) == program
+
+
 def test_backend_pipeline_propagates_algebraic_simplify_copies() -> None:
     program = _program_with_instructions(
         (_binary_i64(0, 1, BinaryOpKind.ADD, _reg(0), _i64(0)),),
@@ -260,6 +363,48 @@ def _u64(value: int) -> BackendConstOperand:
     return BackendConstOperand(constant=BackendIntConst(type_name=TYPE_NAME_U64, value=value))
 
 
+def _int(type_name: str, value: int) -> BackendConstOperand:
+    return BackendConstOperand(constant=BackendIntConst(type_name=type_name, value=value))
+
+
+def _canonical(value: int, type_name: str) -> int:
+    value &= (1 << 64) - 1
+    if type_name == TYPE_NAME_I64 and value >= 1 << 63:
+        return value - (1 << 64)
+    return value
+
+
+def _evaluate(instructions, numerator: int, type_name: str) -> int:
+    values = {_reg_id(0): numerator}
+    mask = (1 << 64) - 1
+
+    def read(operand) -> int:
+        if isinstance(operand, BackendRegOperand):
+            return values[operand.reg_id]
+        return operand.constant.value
+
+    for instruction in instructions:
+        left, right = read(instruction.left), read(instruction.right)
+        kind = instruction.op.kind
+        if kind is BinaryOpKind.MULTIPLY_HIGH:
+            result = ((left & mask) * (right & mask)) >> 64
+        elif kind is BinaryOpKind.SHIFT_RIGHT:
+            result = left >> right
+        elif kind is BinaryOpKind.BITWISE_AND:
+            result = left & right
+        elif kind is BinaryOpKind.BITWISE_XOR:
+            result = left ^ right
+        elif kind is BinaryOpKind.ADD:
+            result = left + right
+        elif kind is BinaryOpKind.SUBTRACT:
+            result = left - right
+        else:
+            assert kind is BinaryOpKind.MULTIPLY
+            result = left * right
+        values[instruction.dest] = _canonical(result, type_name)
+    return values[_reg_id(1)]
+
+
 def _bool(value: bool) -> BackendConstOperand:
     return BackendConstOperand(constant=BackendBoolConst(value=value))
 
@@ -129,6 +129,31 @@ def test_constant_fold_folds_safe_double_to_integer_cast() -> None:
     assert folded.constant == BackendIntConst(type_name=TYPE_NAME_I64, value=7)
 
 
+def test_constant_fold_folds_multiply_high_as_unsigned_product() -> None:
+    program = _program_with_instructions(
+        (
+            _const_i64(0, 0, -1),
+            BackendBinaryInst(
+                inst_id=_inst_id(1),
+                dest=_reg_id(1),
+                op=SemanticBinaryOp(kind=BinaryOpKind.MULTIPLY_HIGH, flavor=BinaryOpFlavor.INTEGER),
+                left=BackendRegOperand(reg_id=_reg_id(0)),
+                right=BackendConstOperand(constant=BackendIntConst(type_name=TYPE_NAME_I64, value=-1)),
+                span=make_source_span(),
+            ),
+        ),
+        return_reg_id=_reg_id(1),
+        register_ordinals=(0, 1),
+    )
+
+    optimized = constant_fold(program)
+    verify_backend_program(optimized)
+
+    folded = optimized.callables[0].blocks[0].instructions[1]
+    assert isinstance(folded, BackendConstInst)
+    assert folded.constant == BackendIntConst(type_name=TYPE_NAME_I64, value=-2)
+
+
 def test_constant_fold_preserves_out_of_range_shift_and_double_to_integer_cast() -> None:
     program = _program_with_instructions(
         (
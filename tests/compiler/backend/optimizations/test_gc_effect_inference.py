@@ -0,0 +1,133 @@
+from __future__ import annotations
+
+from compiler.backend.analysis import analyze_callable_safepoints, analyze_program_gc_effects
+from compiler.backend.ir import BackendCallInst, BackendDirectCallTarget, BackendRuntimeCallTarget
+from compiler.backend.ir.verify import verify_backend_program
+from compiler.backend.optimizations import gc_effect_inference
+from compiler.semantic.symbols import FunctionId
+from tests.compiler.backend.analysis.helpers import lower_source_to_backend_callable_fixture
+from tests.compiler.backend.lowering.helpers import callable_by_name
+
+
+def _user_calls(callable_decl) -> list[BackendCallInst]:
+    return [
+        instruction
+        for block in callable_decl.blocks
+        for instruction in block.instructions
+        if isinstance(instruction, BackendCallInst) and not isinstance(instruction.target, BackendRuntimeCallTarget)
+    ]
+
+
+def _callable_names(callable_ids) -> set[str]:
+    return {getattr(callable_id, "name", None) for callable_id in callable_ids if callable_id.module_path == ("main",)}
+
+
+def test_analyze_program_gc_effects_propagates_collection_through_calls_and_externs(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+        extern fn rt_math_sqrt(value: double) -> double;
+
+        class Box {
+            value: i64;
+
+            fn get() -> i64 {
+                return __self.value;
+            }
+        }
+
+        fn leaf(box: Box) -> i64 {
+            return box.get() + (i64)rt_math_sqrt(4.0);
+        }
+
+        fn countdown(n: i64) -> i64 {
+            if n <= 0 {
+                return 0;
+            }
+            return countdown(n - 1);
+        }
+
+        fn collects() -> i64 {
+            rt_gc_collect();
+            return 1;
+        }
+
+        fn calls_collects() -> i64 {
+            return collects();
+        }
+
+        fn allocates() -> Box {
+            return Box(1);
+        }
+
+        fn main() -> i64 {
+            return leaf(allocates()) + countdown(3) + calls_collects();
+        }
+        """,
+        callable_name="leaf",
+    )
+
+    gc_effects = analyze_program_gc_effects(fixture.program)
+    names = _callable_names(gc_effects.gc_callable_ids)
+
+    assert {"rt_gc_collect", "collects", "calls_collects", "allocates", "main"} <= names
+    assert not {"leaf", "countdown", "get", "rt_math_sqrt"} & names
+
+
+def test_gc_effect_inference_clears_may_gc_on_non_collecting_calls_and_drops_safepoints(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        class Point {
+            x: i64;
+            y: i64;
+
+            fn sum() -> i64 {
+                return __self.x + __self.y;
+            }
+        }
+
+        fn total(points: Point[]) -> i64 {
+            var acc: i64 = 0;
+            var i: i64 = 0;
+            while i < (i64)points.len() {
+                acc = acc + points[i].sum();
+                i = i + 1;
+            }
+            return acc;
+        }
+
+        fn flush(points: Point[]) -> i64 {
+            rt_gc_collect();
+            return (i64)points.len();
+        }
+
+        fn main() -> i64 {
+            var points: Point[] = Point[](1u);
+            points[0] = Point(1, 2);
+            return total(points) + flush(points);
+        }
+        """,
+        callable_name="total",
+    )
+    assert any(call.effects.may_gc for call in _user_calls(fixture.callable_decl))
+
+    optimized_program = gc_effect_inference(fixture.program)
+    verify_backend_program(optimized_program)
+
+    total = callable_by_name(optimized_program, "total")
+    assert _user_calls(total)
+    assert not any(call.effects.may_gc for call in _user_calls(total))
+    assert analyze_callable_safepoints(total).safepoint_instruction_ids() == ()
+
+    main = callable_by_name(optimized_program, "main")
+    may_gc_by_callee = {
+        call.target.callable_id.name: call.effects.may_gc
+        for call in _user_calls(main)
+        if isinstance(call.target, BackendDirectCallTarget) and isinstance(call.target.callable_id, FunctionId)
+    }
+    assert may_gc_by_callee["total"] is False
+    assert may_gc_by_callee["flush"] is True
@@ -0,0 +1,152 @@
+from __future__ import annotations
+
+from compiler.backend.ir import BackendCallInst, BackendCastInst, BackendRegOperand, BackendRuntimeCallTarget
+from compiler.backend.ir.verify import verify_backend_program
+from compiler.backend.optimizations import idiom_recognition, recognize_callable_loop_idioms
+from tests.compiler.backend.analysis.helpers import lower_source_to_backend_callable_fixture, replace_callable
+
+
+def _block_by_name(callable_decl, debug_name: str):
+    return next(block for block in callable_decl.blocks if block.debug_name == debug_name)
+
+
+def _runtime_calls(callable_decl) -> list[BackendCallInst]:
+    return [
+        instruction
+        for block in callable_decl.blocks
+        for instruction in block.instructions
+        if isinstance(instruction, BackendCallInst) and isinstance(instruction.target, BackendRuntimeCallTarget)
+    ]
+
+
+def test_recognize_callable_loop_idioms_fast_forwards_fill_loop_from_preheader(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn fill(values: i64[], value: i64) -> i64 {
+            var i: i64 = 0;
+            while i < (i64)values.len() - 1 {
+                values[i] = value;
+                i = i + 1;
+            }
+            return i;
+        }
+
+        fn main() -> i64 {
+            return fill(i64[](4u), 7);
+        }
+        """,
+        callable_name="fill",
+    )
+
+    rewritten = recognize_callable_loop_idioms(fixture.callable_decl)
+    verify_backend_program(replace_callable(fixture.program, rewritten))
+
+    entry = _block_by_name(rewritten, "entry")
+    [call] = _runtime_calls(rewritten)
+    assert entry.instructions[-1] == call
+    assert call.target.name == "rt_array_fill_i64"
+    assert call.target.ref_arg_indices == (0,)
+    assert call.args[0] == BackendRegOperand(reg_id=fixture.callable_decl.param_regs[0])
+    assert call.args[3] == BackendRegOperand(reg_id=fixture.callable_decl.param_regs[1])
+    assert call.dest == call.args[1].reg_id
+    assert not call.effects.may_gc and not call.effects.needs_safepoint_hooks
+    for debug_name in ("while.cond", "while.body", "while.continue"):
+        assert _block_by_name(rewritten, debug_name) == _block_by_name(fixture.callable_decl, debug_name)
+
+
+def test_recognize_callable_loop_idioms_reinterprets_u64_counter_for_mismatch_kernel(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn same(left: u8[], right: u8[], length: u64) -> bool {
+            var i: u64 = 0u;
+            while i < length {
+                if left[(i64)i] != right[(i64)i] {
+                    return false;
+                }
+                i = i + 1u;
+            }
+            return true;
+        }
+
+        fn main() -> i64 {
+            if same(u8[](2u), u8[](2u), 2u) {
+                return 0;
+            }
+            return 1;
+        }
+        """,
+        callable_name="same",
+    )
+
+    rewritten = recognize_callable_loop_idioms(fixture.callable_decl)
+    verify_backend_program(replace_callable(fixture.program, rewritten))
+
+    entry = _block_by_name(rewritten, "entry")
+    start_cast, end_cast, call, result_cast = entry.instructions[-4:]
+    assert isinstance(start_cast, BackendCastInst) and isinstance(end_cast, BackendCastInst)
+    assert call.target.name == "rt_array_mismatch_range"
+    assert call.target.ref_arg_indices == (0, 1)
+    assert call.args[2:] == (BackendRegOperand(reg_id=start_cast.dest), BackendRegOperand(reg_id=end_cast.dest))
+    assert not call.effects.writes_memory
+    assert isinstance(result_cast, BackendCastInst)
+    assert result_cast.operand == BackendRegOperand(reg_id=call.dest)
+    assert start_cast.operand == BackendRegOperand(reg_id=result_cast.dest)
+
+
+def test_idiom_recognition_matches_reference_copy_and_skips_loops_with_observed_body_values(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        class Box {
+            value: i64;
+        }
+
+        fn copy(dst: Box[], src: Box[], count: i64) -> unit {
+            var i: i64 = 0;
+            while i < count {
+                dst[i] = src[i];
+                i = i + 1;
+            }
+        }
+
+        fn copy_last(dst: i64[], src: i64[], count: i64) -> i64 {
+            var i: i64 = 0;
+            var last: i64 = 0;
+            while i < count {
+                last = src[i];
+                dst[i] = last;
+                i = i + 1;
+            }
+            return last;
+        }
+
+        fn sum(values: i64[]) -> i64 {
+            var i: i64 = 0;
+            var total: i64 = 0;
+            while i < (i64)values.len() {
+                total = total + values[i];
+                i = i + 1;
+            }
+            return total;
+        }
+
+        fn main() -> i64 {
+            copy(Box[](1u), Box[](1u), 1);
+            return copy_last(i64[](1u), i64[](1u), 1) + sum(i64[](1u));
+        }
+        """,
+        callable_name="copy",
+    )
+
+    optimized_program = idiom_recognition(fixture.program)
+    verify_backend_program(optimized_program)
+    calls_by_callable = {
+        callable_decl.callable_id.name: [call.target.name for call in _runtime_calls(callable_decl)]
+        for callable_decl in optimized_program.callables
+        if callable_decl.kind == "function"
+    }
+    assert calls_by_callable["copy"] == ["rt_array_copy_range"]
+    assert calls_by_callable["copy_last"] == []
+    assert calls_by_callable["sum"] == []
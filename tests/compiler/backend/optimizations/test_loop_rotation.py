@@ -0,0 +1,120 @@
+from __future__ import annotations
+
+from compiler.backend.ir import BackendBranchTerminator, BackendCallInst, BackendJumpTerminator
+from compiler.backend.ir.verify import verify_backend_program
+from compiler.backend.optimizations import loop_rotation, rotate_callable_loops
+from tests.compiler.backend.analysis.helpers import lower_source_to_backend_callable_fixture, replace_callable
+
+
+def _block_by_name(callable_decl, debug_name: str):
+    return next(block for block in callable_decl.blocks if block.debug_name == debug_name)
+
+
+def test_rotate_callable_loops_copies_header_test_into_latch(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn count_to(limit: i64) -> i64 {
+            var i: i64 = 0;
+            while i < limit {
+                i = i + 1;
+            }
+            return i;
+        }
+
+        fn main() -> i64 {
+            return count_to(3);
+        }
+        """,
+        callable_name="count_to",
+    )
+    header = _block_by_name(fixture.callable_decl, "while.cond")
+    latch = _block_by_name(fixture.callable_decl, "while.continue")
+    assert isinstance(latch.terminator, BackendJumpTerminator)
+
+    rotated = rotate_callable_loops(fixture.callable_decl)
+    verify_backend_program(replace_callable(fixture.program, rotated))
+
+    rotated_header = _block_by_name(rotated, "while.cond")
+    rotated_latch = _block_by_name(rotated, "while.continue")
+    assert rotated_header == header
+    assert rotated_latch.terminator == header.terminator
+    cloned = rotated_latch.instructions[len(latch.instructions) :]
+    assert [type(instruction) for instruction in cloned] == [type(instruction) for instruction in header.instructions]
+    max_original_ordinal = max(
+        instruction.inst_id.ordinal for block in fixture.callable_decl.blocks for instruction in block.instructions
+    )
+    assert all(instruction.inst_id.ordinal > max_original_ordinal for instruction in cloned)
+
+
+def test_rotate_callable_loops_leaves_headers_with_calls_alone(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn keep_going(i: i64) -> bool {
+            return i < 3;
+        }
+
+        fn count() -> i64 {
+            var i: i64 = 0;
+            while keep_going(i) {
+                i = i + 1;
+            }
+            return i;
+        }
+
+        fn main() -> i64 {
+            return count();
+        }
+        """,
+        callable_name="count",
+    )
+    header = _block_by_name(fixture.callable_decl, "while.cond")
+    assert any(isinstance(instruction, BackendCallInst) for instruction in header.instructions)
+
+    assert rotate_callable_loops(fixture.callable_decl) is fixture.callable_decl
+
+
+def test_loop_rotation_rewrites_each_latch_of_a_loop_with_continue(tmp_path) -> None:
+    fixture = lower_source_to_backend_callable_fixture(
+        tmp_path,
+        """
+        fn skip_two(limit: i64) -> i64 {
+            var i: i64 = 0;
+            var total: i64 = 0;
+            while i < limit {
+                i = i + 1;
+                if i == 2 {
+                    continue;
+                }
+                total = total + i;
+            }
+            return total;
+        }
+
+        fn main() -> i64 {
+            return skip_two(4);
+        }
+        """,
+        callable_name="skip_two",
+    )
+    header = _block_by_name(fixture.callable_decl, "while.cond")
+
+    rotated_program = loop_rotation(fixture.program)
+    verify_backend_program(rotated_program)
+    rotated = next(
+        callable_decl
+        for callable_decl in rotated_program.callables
+        if callable_decl.callable_id == fixture.callable_decl.callable_id
+    )
+
+    jumps_to_header = [
+        block.debug_name
+        for block in rotated.blocks
+        if isinstance(block.terminator, BackendJumpTerminator) and block.terminator.target_block_id == header.block_id
+    ]
+    assert jumps_to_header == ["entry"]
+    for latch_name in ("continue.edge", "while.continue"):
+        latch = _block_by_name(rotated, latch_name)
+        assert isinstance(latch.terminator, BackendBranchTerminator)
+        assert latch.terminator == header.terminator
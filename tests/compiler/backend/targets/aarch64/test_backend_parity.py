@@ -44,7 +44,7 @@ def test_emit_source_asm_emits_expected_call_shapes(tmp_path) -> None:
     assert "    bl __nif_method_main__Math_inc" in asm
     assert "    bl rt_alloc_obj" in main_body
     assert "    bl __nif_ctor_init_main__Box" in main_body
-    assert "    ldr x10, [x10, #80]" in main_body
+    assert "    ldr x16, [x10, #96]" in main_body
     assert "    blr x16" in main_body
 
 
@@ -71,7 +71,8 @@ def test_emit_source_asm_emits_expected_arrays_strings_and_casts(tmp_path) -> No
         nums[0] = (u8)1;
         var x: u8 = nums[0];
         var s: u8[] = nums[1:3];
-        var msg: Str = "hi" + " there";
+        var greeting: Str = "hi";
+        var msg: Str = greeting + " there";
         var obj: Obj = (Obj)Person(7);
         var p: Person = (Person)obj;
         if p == null {
@@ -88,7 +89,9 @@ def test_emit_source_asm_emits_expected_arrays_strings_and_casts(tmp_path) -> No
         f"    bl {ARRAY_SLICE_GET_RUNTIME_CALLS[ArrayRuntimeKind.U8]}",
         f"    bl {ARRAY_FROM_BYTES_U8_RUNTIME_CALL}",
         "    bl __nif_method_main__Str_from_u8_array",
-        "    bl __nif_method_main__Str_concat",
+        "    bl rt_str_write_bytes",
+        "    bl rt_str_write_literal",
+        "    bl __nif_ctor_init_main__Str",
         "    bl rt_checked_cast",
         "__nif_type_name_Person:",
         "__nif_type_Person:",
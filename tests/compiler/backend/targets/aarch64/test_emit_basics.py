@@ -1,7 +1,9 @@
 from __future__ import annotations
 
+from compiler.backend.optimizations import optimize_backend_ir_program
 from compiler.backend.program.symbols import epilogue_label, mangle_function_symbol
 from tests.compiler.backend.targets.aarch64.helpers import emit_program, emit_source_asm
+from tests.compiler.backend.lowering.helpers import lower_source_to_backend_program
 from tests.compiler.backend.targets.support import unit_function_backend_program
 
 
@@ -125,4 +127,38 @@ def test_emit_source_asm_emits_checked_shift_sequences(tmp_path) -> None:
     assert "    lslv x0, x0, x1" in lshift_body
 
     assert "    cmp x1, #64" in urshift_body
-    assert "    lsrv x0, x0, x1" in urshift_body
\ No newline at end of file
+    assert "    lsrv x0, x0, x1" in urshift_body
+
+
+def test_emit_source_asm_strength_reduces_division_by_constants(tmp_path) -> None:
+    program = lower_source_to_backend_program(
+        tmp_path,
+        """
+        fn udiv10(a: u64) -> u64 {
+            return a / 10u;
+        }
+
+        fn smod10(a: i64) -> i64 {
+            return a % 10;
+        }
+
+        fn smod8(a: i64) -> i64 {
+            return a % 8;
+        }
+
+        fn main() -> i64 {
+            return (i64)udiv10(123u) + smod10(-45) + smod8(-45);
+        }
+        """,
+    )
+    asm = emit_program(optimize_backend_ir_program(program))
+
+    for name in ("udiv10", "smod10"):
+        body = _body_for_label(asm, mangle_function_symbol(("main",), name))
+        assert "    umulh x0, x0, x1" in body
+        assert "div x0, x0, x1" not in body
+        assert "rt_panic_invalid_shift_count" not in body
+
+    smod8_body = _body_for_label(asm, mangle_function_symbol(("main",), "smod8"))
+    assert "    umulh x0, x0, x1" not in smod8_body
+    assert "div x0, x0, x1" not in smod8_body
@@ -0,0 +1,89 @@
+from __future__ import annotations
+
+from compiler.backend.program.symbols import epilogue_label, mangle_function_symbol
+from tests.compiler.backend.targets.aarch64.helpers import emit_source_asm
+
+
+def _body_for_label(asm: str, label: str) -> str:
+    return asm[asm.index(f"{label}:") : asm.index(f"{epilogue_label(label)}:")]
+
+
+_STD_BITS_STUB = """
+extern fn rt_bits_popcount(value: u64) -> u64;
+extern fn rt_bits_clz(value: u64) -> u64;
+extern fn rt_bits_ctz(value: u64) -> u64;
+extern fn rt_bits_rotl(value: u64, amount: u64) -> u64;
+extern fn rt_bits_rotr(value: u64, amount: u64) -> u64;
+extern fn rt_bits_bswap(value: u64) -> u64;
+extern fn rt_bits_mulhi(left: u64, right: u64) -> u64;
+
+export fn popcount(value: u64) -> u64 {
+    return rt_bits_popcount(value);
+}
+
+export fn clz(value: u64) -> u64 {
+    return rt_bits_clz(value);
+}
+
+export fn ctz(value: u64) -> u64 {
+    return rt_bits_ctz(value);
+}
+
+export fn rotl(value: u64, amount: u64) -> u64 {
+    return rt_bits_rotl(value, amount);
+}
+
+export fn rotr(value: u64, amount: u64) -> u64 {
+    return rt_bits_rotr(value, amount);
+}
+
+export fn bswap(value: u64) -> u64 {
+    return rt_bits_bswap(value);
+}
+
+export fn mulhi(left: u64, right: u64) -> u64 {
+    return rt_bits_mulhi(left, right);
+}
+"""
+
+
+def _emit_std_bits_asm(tmp_path) -> str:
+    (tmp_path / "std").mkdir(parents=True)
+    (tmp_path / "std" / "bits.nif").write_text(_STD_BITS_STUB, encoding="utf-8")
+    return emit_source_asm(
+        tmp_path,
+        """
+        import std.bits as bits;
+
+        fn mix(x: u64, y: u64) -> u64 {
+            var counts: u64 = bits.popcount(x) + bits.clz(y) + bits.ctz(x);
+            return counts ^ bits.rotl(x, y) ^ bits.rotr(y, x) ^ bits.bswap(x) ^ bits.mulhi(x, y);
+        }
+
+        fn main() -> i64 {
+            if mix(3u, 5u) != 0u {
+                return 0;
+            }
+            return 1;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+
+def test_emit_source_asm_lowers_std_bits_intrinsics_inline(tmp_path) -> None:
+    asm = _emit_std_bits_asm(tmp_path)
+    mix_label = mangle_function_symbol(("main",), "mix")
+    mix_body = _body_for_label(asm, mix_label)
+    popcount_label = mangle_function_symbol(("std", "bits"), "popcount")
+    popcount_wrapper_body = _body_for_label(asm, popcount_label)
+
+    assert "    fmov d16, x0\n    cnt v16.8b, v16.8b\n    addv b16, v16.8b\n    fmov x0, d16\n" in mix_body
+    assert "    rbit x0, x0\n    clz x0, x0\n" in mix_body
+    assert "    neg x1, x1\n    ror x0, x0, x1\n" in mix_body
+    assert "    rev x0, x0" in mix_body
+    assert "    umulh x0, x0, x1" in mix_body
+    assert "bl rt_bits_" not in mix_body
+    assert "bl __nif_fn_std_bits" not in mix_body
+    assert "    cnt v16.8b, v16.8b" in popcount_wrapper_body
+    assert "bl " not in popcount_wrapper_body
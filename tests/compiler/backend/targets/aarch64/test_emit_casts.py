@@ -9,20 +9,28 @@ def _body_for_label(asm: str, label: str) -> str:
     return asm[asm.index(f"{label}:") : asm.index(epilogue)]
 
 
-def test_emit_source_asm_emits_class_cast_and_type_test_helpers(tmp_path) -> None:
+def test_emit_source_asm_inlines_class_cast_and_type_test_as_type_id_range_checks(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
         """
-        class Person {
-            age: i64;
+        class Shape {
+            sides: i64;
         }
 
-        fn keep(value: Obj) -> Person {
-            return (Person)value;
+        class Circle extends Shape {}
+
+        class Square extends Shape {}
+
+        fn keep(value: Obj) -> Shape {
+            return (Shape)value;
+        }
+
+        fn keep_square(value: Obj) -> Square {
+            return (Square)value;
         }
 
         fn matches(value: Obj) -> bool {
-            return value is Person;
+            return value is Shape;
         }
 
         fn main() -> i64 {
@@ -32,11 +40,16 @@ def test_emit_source_asm_emits_class_cast_and_type_test_helpers(tmp_path) -> Non
         skip_optimize=True,
     )
 
-    assert "    bl rt_checked_cast" in asm
-    assert "    bl rt_is_instance_of_type" in asm
-    assert "    adrp x1, __nif_type_main__Person" in asm
-    assert "    add x1, x1, :lo12:__nif_type_main__Person" in asm
+    keep_body = _body_for_label(asm, "__nif_fn_main__keep")
+    keep_square_body = _body_for_label(asm, "__nif_fn_main__keep_square")
+    matches_body = _body_for_label(asm, "__nif_fn_main__matches")
 
+    assert "__nif_type_main__Shape:\n.long 1\n" in asm
+    assert "    ldr x1, [x0]\n    ldr w1, [x1]\n    sub w1, w1, #1\n    cmp w1, #3\n    b.lo" in keep_body
+    assert "    bl rt_checked_cast" in keep_body
+    assert "    cmp w1, #3\n    b.eq .L__nif_fn_main__keep_square_i" in keep_square_body
+    assert "    cset w0, lo" in matches_body
+    assert "rt_is_instance_of_type" not in asm
 
 def test_emit_source_asm_inlines_interface_cast_and_type_test(tmp_path) -> None:
     asm = emit_source_asm(
@@ -129,6 +142,30 @@ def test_emit_source_asm_handles_primitive_cast_families(tmp_path) -> None:
     assert "    orr w0, w0, w1" in main_body
 
 
+def test_emit_source_asm_emits_line_tables_by_default(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        fn bump(value: i64) -> i64 {
+            return value + 1;
+        }
+
+        fn main() -> i64 {
+            return bump(41);
+        }
+        """,
+        skip_optimize=True,
+    )
+
+    main_body = _body_for_label(asm, "main")
+
+    assert "rt_trace_" not in asm
+    assert '.section nif_line_tables,"a",@progbits' in asm
+    assert ".Lmain_loc0:" in main_body
+    assert main_body.index(".Lmain_loc0:") < main_body.index("    bl __nif_fn_main__bump")
+    assert ".long .Lmain_end - main" in asm
+
+
 def test_emit_source_asm_can_omit_runtime_trace_hooks(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
@@ -148,4 +185,5 @@ def test_emit_source_asm_can_omit_runtime_trace_hooks(tmp_path) -> None:
 
     assert "rt_trace_push" not in asm
     assert "rt_trace_pop" not in asm
-    assert "rt_trace_set_location" not in asm
\ No newline at end of file
+    assert "rt_trace_set_location" not in asm
+    assert "nif_line_tables" not in asm
\ No newline at end of file
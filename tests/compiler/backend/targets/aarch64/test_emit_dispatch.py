@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+from compiler.backend.targets import BackendTargetOptions
 from tests.compiler.backend.lowering.helpers import lower_project_to_backend_program
 from tests.compiler.backend.targets.aarch64.helpers import emit_program, emit_source_asm
 
@@ -39,7 +40,7 @@ def test_emit_source_asm_emits_direct_instance_method_calls_without_vtable_looku
     assert "    bl rt_panic_null_deref" in expose_body
     assert "    bl __nif_method_main__Box_hidden" in expose_body
     assert "    blr x16" not in expose_body
-    assert "    ldr x10, [x10, #80]" not in expose_body
+    assert "    ldr x16, [x10, #96]" not in expose_body
 
 
 def test_emit_source_asm_emits_virtual_dispatch_through_class_vtable(tmp_path) -> None:
@@ -73,8 +74,7 @@ def test_emit_source_asm_emits_virtual_dispatch_through_class_vtable(tmp_path) -
 
     assert "    bl rt_panic_null_deref" in read_body
     assert "    ldr x10, [x0]" in read_body
-    assert "    ldr x10, [x10, #80]" in read_body
-    assert "    ldr x16, [x10]" in read_body
+    assert "    ldr x16, [x10, #96]" in read_body
     assert "    blr x16" in read_body
     assert "    bl __nif_method_main__Base_head" not in read_body
     assert "    bl __nif_method_main__Derived_head" not in read_body
@@ -109,14 +109,19 @@ def test_emit_source_asm_emits_interface_dispatch_and_metadata_sections(tmp_path
 
     assert "    bl rt_panic_null_deref" in use_body
     assert "    ldr x10, [x0]" in use_body
-    assert "    ldr x10, [x10, #64]" in use_body
-    assert "    ldr x10, [x10]" in use_body
+    assert "    ldur x10, [x10, #-8]" in use_body
     assert "    ldr x16, [x10]" in use_body
     assert "    blr x16" in use_body
     assert "__nif_interface_main__Metric:" in asm
     assert "__nif_interface_name_main__Metric:" in asm
     assert "__nif_interface_methods_main__Box__main__Metric:" in asm
-    assert "__nif_interface_tables_main__Box:" in asm
+    assert (
+        "__nif_interface_tables_main__Box:\n"
+        ".quad __nif_interface_methods_main__Box__main__Metric\n"
+        "__nif_type_Box:\n"
+        "__nif_type_main__Box:\n"
+    ) in asm
+    assert "\n.long 0\n__nif_vtable_main__Box:\n.quad __nif_method_main__Box_score\n" in asm
 
 
 def test_emit_source_asm_is_byte_stable_for_multimodule_dispatch_metadata(tmp_path) -> None:
@@ -166,4 +171,76 @@ def test_emit_source_asm_is_byte_stable_for_multimodule_dispatch_metadata(tmp_pa
 
     assert first == second
     assert first.index("__nif_interface_left__Metric:") < first.index("__nif_interface_right__Metric:")
-    assert first.index("__nif_vtable_left__Key:") < first.index("__nif_vtable_right__Token:")
\ No newline at end of file
+    assert first.index("__nif_vtable_left__Key:") < first.index("__nif_vtable_right__Token:")
+
+def test_emit_source_asm_fronts_dispatch_with_inline_caches_when_requested(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        interface Metric {
+            fn score() -> i64;
+        }
+
+        class Box implements Metric {
+            fn score() -> i64 {
+                return 7;
+            }
+
+            fn head() -> i64 {
+                return 1;
+            }
+        }
+
+        fn use(value: Metric, box: Box) -> i64 {
+            return value.score() + box.head();
+        }
+
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+        skip_optimize=True,
+        options=BackendTargetOptions(inline_caches_enabled=True),
+    )
+
+    use_body = _body_for_label(asm, "__nif_fn_main__use")
+    cache_labels = [line[:-1] for line in asm.splitlines() if line.startswith(".L__nif_fn_main__use_i") and line.endswith("_ic:")]
+
+    assert len(cache_labels) == 2
+    for cache_label in cache_labels:
+        assert f"    adrp x17, {cache_label}\n    add x17, x17, :lo12:{cache_label}\n    ldp x9, x16, [x17]\n" in use_body
+        assert "    cmp x10, x9\n    b.eq " in use_body
+        assert f"    cmp x9, #1\n    b.eq {cache_label}_megamorphic\n" in use_body
+        assert "    ldp x9, x16, [x17, #48]" in use_body
+        assert "    stp x10, x16, [x17, #48]" in use_body
+        assert f"{cache_label}_hit:\n    blr x16" in use_body
+        assert f".p2align 4\n{cache_label}:\n.zero 64" in asm
+    assert "    ldur x9, [x10, #-8]" in use_body
+    assert "    ldur x10, [x10, #-8]" in use_body
+    assert use_body.count("    ldr x16, [x10, #96]") == 2
+    assert "\n.bss\n" in asm
+
+
+def test_emit_source_asm_omits_inline_caches_by_default(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        class Base {
+            fn head() -> i64 {
+                return 1;
+            }
+        }
+
+        fn read(value: Base) -> i64 {
+            return value.head();
+        }
+
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+    assert "_ic:" not in asm
+    assert "\n.bss\n" not in asm
@@ -8,6 +8,69 @@ def _body_for_label(asm: str, label: str) -> str:
     return asm[asm.index(f"{label}:") : asm.index(f"{epilogue_label(label)}:")]
 
 
+_STD_MATH_STUB = """
+extern fn rt_math_sqrt(value: double) -> double;
+extern fn rt_math_floor(value: double) -> double;
+extern fn rt_math_round(value: double) -> double;
+extern fn rt_math_abs(value: double) -> double;
+extern fn rt_math_min(left: double, right: double) -> double;
+extern fn rt_math_max(left: double, right: double) -> double;
+extern fn rt_math_pow(base: double, exponent: double) -> double;
+
+export fn sqrt(value: double) -> double {
+    return rt_math_sqrt(value);
+}
+
+export fn floor(value: double) -> double {
+    return rt_math_floor(value);
+}
+
+export fn round(value: double) -> double {
+    return rt_math_round(value);
+}
+
+export fn abs(value: double) -> double {
+    return rt_math_abs(value);
+}
+
+export fn min(left: double, right: double) -> double {
+    return rt_math_min(left, right);
+}
+
+export fn max(left: double, right: double) -> double {
+    return rt_math_max(left, right);
+}
+
+export fn pow(base: double, exponent: double) -> double {
+    return rt_math_pow(base, exponent);
+}
+"""
+
+
+def _emit_std_math_asm(tmp_path) -> str:
+    (tmp_path / "std").mkdir(parents=True)
+    (tmp_path / "std" / "math.nif").write_text(_STD_MATH_STUB, encoding="utf-8")
+    return emit_source_asm(
+        tmp_path,
+        """
+        import std.math as math;
+
+        fn shade(x: double, y: double) -> double {
+            var lit: double = math.sqrt(x) + math.floor(y) + math.round(x) + math.abs(y);
+            return lit + math.min(x, y) + math.max(x, y) + math.pow(x, y);
+        }
+
+        fn main() -> i64 {
+            if shade(2.0, -1.5) > 0.0 {
+                return 0;
+            }
+            return 1;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+
 def test_emit_source_asm_emits_double_constants_and_arithmetic_sequences(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
@@ -112,4 +175,26 @@ def test_emit_source_asm_is_byte_stable_for_double_programs(tmp_path) -> None:
     first = emit_source_asm(tmp_path / "run_a", source, skip_optimize=True)
     second = emit_source_asm(tmp_path / "run_b", source, skip_optimize=True)
 
-    assert first == second
\ No newline at end of file
+    assert first == second
+
+
+def test_emit_source_asm_lowers_std_math_intrinsics_inline(tmp_path) -> None:
+    asm = _emit_std_math_asm(tmp_path)
+    shade_body = _body_for_label(asm, mangle_function_symbol(("main",), "shade"))
+    sqrt_label = mangle_function_symbol(("std", "math"), "sqrt")
+    pow_label = mangle_function_symbol(("std", "math"), "pow")
+    sqrt_wrapper_body = _body_for_label(asm, sqrt_label)
+
+    assert "    fsqrt d0, d0" in shade_body
+    assert "    frintm d0, d0" in shade_body
+    assert "    frinta d0, d0" in shade_body
+    assert "    fabs d0, d0" in shade_body
+    assert "    fcmp d0, d1\n    fmin d0, d0, d1\n" in shade_body
+    assert "    fcmp d0, d1\n    fmax d0, d0, d1\n" in shade_body
+    assert "    movz x9, #32760, lsl #48\n    fmov d16, x9\n    fcsel d0, d16, d0, vs\n" in shade_body
+    assert "fminnm" not in shade_body
+    assert "bl rt_math_" not in shade_body
+    assert f"bl {sqrt_label}" not in shade_body
+    assert f"    bl {pow_label}" in shade_body
+    assert "    fsqrt d0, d0" in sqrt_wrapper_body
+    assert "bl " not in sqrt_wrapper_body
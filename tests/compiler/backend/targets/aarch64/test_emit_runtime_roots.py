@@ -3,7 +3,11 @@ from __future__ import annotations
 import re
 
 from compiler.backend.targets import BackendTargetOptions
-from compiler.backend.program.symbols import mangle_function_symbol
+from compiler.backend.program.symbols import (
+    mangle_function_symbol,
+    mangle_profile_name_symbol,
+    mangle_profile_site_symbol,
+)
 from tests.compiler.backend.targets.aarch64.helpers import emit_source_asm
 
 
@@ -63,6 +67,7 @@ def test_emit_source_asm_emits_root_frame_setup_before_trace_push(tmp_path) -> N
         }
         """,
         skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True),
     )
 
     keep_label = mangle_function_symbol(("main",), "keep")
@@ -171,4 +176,73 @@ def test_emit_program_can_omit_runtime_trace_calls_while_keeping_root_frames(tmp
     assert "    bl rt_thread_state" in keep_body
     assert "rt_trace_push" not in asm
     assert "rt_trace_pop" not in asm
-    assert "rt_trace_set_location" not in asm
\ No newline at end of file
+    assert "rt_trace_set_location" not in asm
+
+
+def test_emit_source_asm_brackets_callables_with_function_profile_hooks(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn keep(value: Obj) -> Obj {
+            rt_gc_collect();
+            return value;
+        }
+
+        class Counter {
+            value: i64;
+        }
+
+        fn main() -> i64 {
+            keep(null);
+            var counter: Counter = Counter(1);
+            return counter.value;
+        }
+        """,
+        skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True, function_profile_enabled=True),
+    )
+
+    keep_label = mangle_function_symbol(("main",), "keep")
+    keep_body = _body_for_label(asm, keep_label)
+    keep_function = _function_with_epilogue_for_label(asm, keep_label)
+    keep_epilogue = keep_function[keep_function.index(f".L{keep_label}_epilogue:") :]
+    site_symbol = mangle_profile_site_symbol(keep_label)
+
+    assert keep_body.index("    bl rt_trace_push") < keep_body.index(f"    adrp x0, {site_symbol}")
+    assert keep_body.index(f"    adrp x0, {site_symbol}") < keep_body.index("    bl rt_func_profile_enter")
+    assert keep_epilogue.index("    str x0, [sp]") < keep_epilogue.index("    bl rt_func_profile_exit")
+    assert keep_epilogue.index("    bl rt_func_profile_exit") < keep_epilogue.index("    bl rt_trace_pop")
+    assert asm.count("    bl rt_func_profile_enter") == asm.count("    bl rt_func_profile_exit") == 3
+    assert f"{site_symbol}:\n.quad {mangle_profile_name_symbol(keep_label)}\n.zero 40\n" in asm
+    assert f'{mangle_profile_name_symbol(keep_label)}:\n.asciz "main::keep"\n' in asm
+    assert '.asciz "main::Counter#0"' in asm
+
+
+def test_emit_source_asm_omits_function_profile_hooks_by_default(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn keep(value: Obj) -> Obj {
+            rt_gc_collect();
+            return value;
+        }
+
+        class Counter {
+            value: i64;
+        }
+
+        fn main() -> i64 {
+            keep(null);
+            var counter: Counter = Counter(1);
+            return counter.value;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+    assert "rt_func_profile" not in asm
+    assert "__nif_profile_site_" not in asm
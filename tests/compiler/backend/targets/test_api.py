@@ -37,6 +37,7 @@ def test_backend_target_options_defaults_are_stable() -> None:
 
     assert options.runtime_trace_enabled is True
     assert options.emit_debug_comments is False
+    assert options.function_profile_enabled is False
     assert options.extra_flags == ()
 
 
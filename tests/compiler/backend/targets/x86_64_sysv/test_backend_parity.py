@@ -72,7 +72,8 @@ def test_emit_source_asm_emits_expected_arrays_strings_and_casts(tmp_path) -> No
         nums[0] = (u8)1;
         var x: u8 = nums[0];
         var s: u8[] = nums[1:3];
-        var msg: Str = "hi" + " there";
+        var greeting: Str = "hi";
+        var msg: Str = greeting + " there";
         var obj: Obj = (Obj)Person(7);
         var p: Person = (Person)obj;
         if p == null {
@@ -89,7 +90,9 @@ def test_emit_source_asm_emits_expected_arrays_strings_and_casts(tmp_path) -> No
         f"    call {ARRAY_SLICE_GET_RUNTIME_CALLS[ArrayRuntimeKind.U8]}",
         f"    call {ARRAY_FROM_BYTES_U8_RUNTIME_CALL}",
         "    call __nif_method_main__Str_from_u8_array",
-        "    call __nif_method_main__Str_concat",
+        "    call rt_str_write_bytes",
+        "    call rt_str_write_literal",
+        "    call __nif_ctor_init_main__Str",
         "    call rt_checked_cast",
         "__nif_type_name_Person:",
         "__nif_type_Person:",
@@ -214,7 +217,8 @@ def test_emit_source_asm_emits_while_control_flow_shape(tmp_path) -> None:
     loop_label = mangle_function_symbol(("main",), "loop_to")
     assert f"{loop_label}:" in asm
     assert f".L{loop_label}_b" in asm
-    assert f"    je .L{loop_label}_b" in asm
+    assert f"    jne .L{loop_label}_b" in asm
+    assert f"    jmp .L{loop_label}_b" in asm
 
 
 def test_emit_source_asm_emits_if_else_control_flow_shape(tmp_path) -> None:
@@ -239,5 +243,5 @@ def test_emit_source_asm_emits_if_else_control_flow_shape(tmp_path) -> None:
     choose_label = mangle_function_symbol(("main",), "choose")
     assert f"{choose_label}:" in asm
     assert f".L{choose_label}_b" in asm
-    assert f"    je .L{choose_label}_b" in asm
-    assert f"    jmp .L{choose_label}_b" in asm
\ No newline at end of file
+    assert f"    jne .L{choose_label}_b" in asm
+    assert f"    jmp .L{choose_label}_b" not in asm
\ No newline at end of file
@@ -1,7 +1,10 @@
 from __future__ import annotations
 
+from compiler.backend.optimizations import optimize_backend_ir_program
+from compiler.backend.program.symbols import mangle_function_symbol
 from compiler.backend.targets import BackendTargetOptions
-from tests.compiler.backend.targets.x86_64_sysv.helpers import emit_source_asm
+from tests.compiler.backend.lowering.helpers import lower_source_to_backend_program
+from tests.compiler.backend.targets.x86_64_sysv.helpers import emit_program, emit_source_asm
 
 
 def _body_for_label(asm: str, label: str) -> str:
@@ -272,6 +275,63 @@ def test_emit_source_asm_emits_array_set_out_of_bounds_guard(tmp_path) -> None:
     assert "    call rt_array_set_i64" not in main_body
 
 
+def test_emit_source_asm_omits_bounds_check_for_counted_loop_index(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        fn sum(values: i64[], other: i64[]) -> i64 {
+            var total: i64 = 0;
+            var n: i64 = (i64)values.len();
+            var i: i64 = 0;
+            while i < n {
+                total = total + values[i] + other[i];
+                i = i + 1;
+            }
+            return total;
+        }
+
+        fn main() -> i64 {
+            return sum(i64[](2u), i64[](2u));
+        }
+        """,
+    )
+
+    sum_body = _body_for_label(asm, mangle_function_symbol(("main",), "sum"))
+
+    # Only `other[i]` keeps its guard: `i` is proven to stay within `values`, not `other`.
+    assert sum_body.count("_array_in_bounds_panic:") == 1
+    assert sum_body.count("    call rt_panic_array_get_out_of_bounds") == 1
+    assert sum_body.count("    mov rax, qword ptr [rax + rcx * 8 + 48]") == 2
+
+
+def test_emit_program_fast_forwards_fill_loop_through_runtime_kernel(tmp_path) -> None:
+    program = lower_source_to_backend_program(
+        tmp_path,
+        """
+        fn fill(values: double[]) -> unit {
+            var i: i64 = 0;
+            while i < (i64)values.len() {
+                values[i] = 0.5;
+                i = i + 1;
+            }
+        }
+
+        fn main() -> i64 {
+            fill(double[](3u));
+            return 0;
+        }
+        """,
+    )
+    asm = emit_program(optimize_backend_ir_program(program))
+
+    fill_body = _body_for_label(asm, mangle_function_symbol(("main",), "fill"))
+    assert fill_body.count("    call rt_array_fill_double") == 1
+    kernel_setup = fill_body[: fill_body.index("    call rt_array_fill_double")]
+    assert "movq xmm0" in kernel_setup
+    # The loop stays behind the kernel call to finish any iteration that has to panic.
+    assert "rt_panic_array_set_out_of_bounds" in fill_body
+
+
 def test_emit_source_asm_emits_fast_path_double_array_access(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
@@ -2,11 +2,13 @@ from __future__ import annotations
 
 import pytest
 
+from compiler.backend.optimizations import optimize_backend_ir_program
 from compiler.backend.program.symbols import epilogue_label, mangle_function_symbol
 from compiler.backend.targets import BackendTargetOptions
 from compiler.backend.targets.x86_64_sysv import X86_64_SYSV_ABI, X86_64SysVFrameError, plan_callable_frame_layout
 from tests.compiler.backend.analysis.helpers import lower_source_to_backend_callable_fixture
 from tests.compiler.backend.ir.helpers import FIXTURE_ENTRY_FUNCTION_ID, callable_by_id, one_function_backend_program
+from tests.compiler.backend.lowering.helpers import lower_source_to_backend_program
 from tests.compiler.backend.targets.support import make_target_input, unit_function_backend_program, with_root_slot
 from tests.compiler.backend.targets.x86_64_sysv.helpers import (
     emit_program,
@@ -256,6 +258,40 @@ def test_emit_source_asm_emits_checked_shift_sequences(tmp_path) -> None:
     assert "    shr rax, cl" in urshift_body
 
 
+def test_emit_source_asm_strength_reduces_division_by_constants(tmp_path) -> None:
+    program = lower_source_to_backend_program(
+        tmp_path,
+        """
+        fn udiv10(a: u64) -> u64 {
+            return a / 10u;
+        }
+
+        fn smod10(a: i64) -> i64 {
+            return a % 10;
+        }
+
+        fn smod8(a: i64) -> i64 {
+            return a % 8;
+        }
+
+        fn main() -> i64 {
+            return (i64)udiv10(123u) + smod10(-45) + smod8(-45);
+        }
+        """,
+    )
+    asm = emit_program(optimize_backend_ir_program(program))
+
+    for name in ("udiv10", "smod10"):
+        body = _body_for_label(asm, mangle_function_symbol(("main",), name))
+        assert "    mul rcx\n    mov rax, rdx" in body
+        assert "div rcx" not in body
+        assert "rt_panic_invalid_shift_count" not in body
+
+    smod8_body = _body_for_label(asm, mangle_function_symbol(("main",), "smod8"))
+    assert "    mul rcx\n    mov rax, rdx" not in smod8_body
+    assert "div rcx" not in smod8_body
+
+
 def test_emit_source_asm_is_byte_stable_across_repeated_runs(tmp_path) -> None:
     source = """
     fn main() -> i64 {
@@ -0,0 +1,95 @@
+from __future__ import annotations
+
+from compiler.backend.program.symbols import epilogue_label, mangle_function_symbol
+from tests.compiler.backend.targets.x86_64_sysv.helpers import emit_source_asm
+
+
+def _body_for_label(asm: str, label: str) -> str:
+    return asm[asm.index(f"{label}:") : asm.index(f"{epilogue_label(label)}:")]
+
+
+_STD_BITS_STUB = """
+extern fn rt_bits_popcount(value: u64) -> u64;
+extern fn rt_bits_clz(value: u64) -> u64;
+extern fn rt_bits_ctz(value: u64) -> u64;
+extern fn rt_bits_rotl(value: u64, amount: u64) -> u64;
+extern fn rt_bits_rotr(value: u64, amount: u64) -> u64;
+extern fn rt_bits_bswap(value: u64) -> u64;
+extern fn rt_bits_mulhi(left: u64, right: u64) -> u64;
+
+export fn popcount(value: u64) -> u64 {
+    return rt_bits_popcount(value);
+}
+
+export fn clz(value: u64) -> u64 {
+    return rt_bits_clz(value);
+}
+
+export fn ctz(value: u64) -> u64 {
+    return rt_bits_ctz(value);
+}
+
+export fn rotl(value: u64, amount: u64) -> u64 {
+    return rt_bits_rotl(value, amount);
+}
+
+export fn rotr(value: u64, amount: u64) -> u64 {
+    return rt_bits_rotr(value, amount);
+}
+
+export fn bswap(value: u64) -> u64 {
+    return rt_bits_bswap(value);
+}
+
+export fn mulhi(left: u64, right: u64) -> u64 {
+    return rt_bits_mulhi(left, right);
+}
+"""
+
+
+def _emit_std_bits_asm(tmp_path) -> str:
+    (tmp_path / "std").mkdir(parents=True)
+    (tmp_path / "std" / "bits.nif").write_text(_STD_BITS_STUB, encoding="utf-8")
+    return emit_source_asm(
+        tmp_path,
+        """
+        import std.bits as bits;
+
+        fn mix(x: u64, y: u64) -> u64 {
+            var counts: u64 = bits.popcount(x) + bits.clz(y) + bits.ctz(x);
+            return counts ^ bits.rotl(x, y) ^ bits.rotr(y, x) ^ bits.bswap(x) ^ bits.mulhi(x, y);
+        }
+
+        fn main() -> i64 {
+            if mix(3u, 5u) != 0u {
+                return 0;
+            }
+            return 1;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+
+def test_emit_source_asm_lowers_std_bits_intrinsics_inline(tmp_path) -> None:
+    asm = _emit_std_bits_asm(tmp_path)
+    mix_label = mangle_function_symbol(("main",), "mix")
+    mix_body = _body_for_label(asm, mix_label)
+    popcount_label = mangle_function_symbol(("std", "bits"), "popcount")
+    popcount_wrapper_body = _body_for_label(asm, popcount_label)
+
+    assert "    cmp dword ptr [rip + rt_cpu_has_popcnt], 0" in mix_body
+    assert "    popcnt rax, rax" in mix_body
+    assert f"{mix_label}_i0_bits_fallback:\n    mov rdi, rax\n    call rt_bits_popcount\n" in mix_body
+    assert "    mov rcx, 127\n    bsr rax, rax\n    cmovz rax, rcx\n    xor rax, 63\n" in mix_body
+    assert "    mov rcx, 64\n    bsf rax, rax\n    cmovz rax, rcx\n" in mix_body
+    assert "    rol rax, cl" in mix_body
+    assert "    ror rax, cl" in mix_body
+    assert "    bswap rax" in mix_body
+    assert "    mul rcx\n    mov rax, rdx\n" in mix_body
+    assert "lzcnt" not in mix_body
+    assert "tzcnt" not in mix_body
+    assert "call rt_bits_clz" not in mix_body
+    assert "call __nif_fn_std_bits" not in mix_body
+    assert "    popcnt rax, rax" in popcount_wrapper_body
+    assert "    call rt_bits_popcount" in popcount_wrapper_body
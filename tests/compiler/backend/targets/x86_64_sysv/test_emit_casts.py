@@ -9,20 +9,28 @@ def _body_for_label(asm: str, label: str) -> str:
     return asm[asm.index(f"{label}:") : asm.index(epilogue)]
 
 
-def test_emit_source_asm_emits_class_cast_and_type_test_helpers(tmp_path) -> None:
+def test_emit_source_asm_inlines_class_cast_and_type_test_as_type_id_range_checks(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
         """
-        class Person {
-            age: i64;
+        class Shape {
+            sides: i64;
         }
 
-        fn keep(value: Obj) -> Person {
-            return (Person)value;
+        class Circle extends Shape {}
+
+        class Square extends Shape {}
+
+        fn keep(value: Obj) -> Shape {
+            return (Shape)value;
+        }
+
+        fn keep_square(value: Obj) -> Square {
+            return (Square)value;
         }
 
         fn matches(value: Obj) -> bool {
-            return value is Person;
+            return value is Shape;
         }
 
         fn main() -> i64 {
@@ -32,10 +40,18 @@ def test_emit_source_asm_emits_class_cast_and_type_test_helpers(tmp_path) -> Non
         skip_optimize=True,
     )
 
-    assert "    call rt_checked_cast" in asm
-    assert "    call rt_is_instance_of_type" in asm
-    assert "    lea rsi, [rip + __nif_type_main__Person]" in asm
+    keep_body = _body_for_label(asm, "__nif_fn_main__keep")
+    keep_square_body = _body_for_label(asm, "__nif_fn_main__keep_square")
+    matches_body = _body_for_label(asm, "__nif_fn_main__matches")
 
+    assert "__nif_type_main__Shape:\n.long 1\n" in asm
+    assert "__nif_type_main__Square:\n.long 3\n" in asm
+    assert "    sub ecx, 1\n    cmp ecx, 3\n    jb .L__nif_fn_main__keep_i" in keep_body
+    assert "    call rt_checked_cast" in keep_body
+    assert "    cmp dword ptr [rcx], 3\n    je .L__nif_fn_main__keep_square_i" in keep_square_body
+    assert "    mov rcx, qword ptr [rax]\n    mov ecx, dword ptr [rcx]\n" in matches_body
+    assert "    setb al" in matches_body
+    assert "rt_is_instance_of_type" not in asm
 
 def test_emit_source_asm_inlines_interface_cast_and_type_test(tmp_path) -> None:
     asm = emit_source_asm(
@@ -128,7 +144,7 @@ def test_emit_source_asm_handles_primitive_cast_families(tmp_path) -> None:
     assert "    or al, dl" in main_body
 
 
-def test_emit_source_asm_emits_runtime_trace_hooks_by_default(tmp_path) -> None:
+def test_emit_source_asm_emits_line_tables_by_default(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
         """
@@ -145,6 +161,36 @@ def test_emit_source_asm_emits_runtime_trace_hooks_by_default(tmp_path) -> None:
 
     main_body = _body_for_label(asm, "main")
 
+    assert "rt_trace_" not in asm
+    assert '.section nif_line_tables,"a",@progbits' in asm
+    assert ".Lmain_loc0:" in main_body
+    assert main_body.index(".Lmain_loc0:") < main_body.index("    call __nif_fn_main__bump")
+    assert ".Lmain_end:" in asm
+    assert ".long main - ." in asm
+    assert ".long .Lmain_end - main" in asm
+    assert ".long __nif_debug_fn_main - ." in asm
+
+
+def test_emit_source_asm_emits_shadow_runtime_trace_hooks_when_requested(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        fn bump(value: i64) -> i64 {
+            return value + 1;
+        }
+
+        fn main() -> i64 {
+            return bump(41);
+        }
+        """,
+        skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True),
+    )
+
+    main_body = _body_for_label(asm, "main")
+
+    assert "nif_line_tables" not in asm
+
     assert "    call rt_trace_push" in asm
     assert "    call rt_trace_pop" in asm
     assert "__nif_debug_fn_main:" in asm
@@ -166,6 +212,7 @@ def test_emit_source_asm_emits_caller_call_site_trace_location(tmp_path) -> None
         }
         """,
         skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True),
     )
 
     main_body = _body_for_label(asm, "main")
@@ -196,6 +243,7 @@ fn main() -> i64 {
 }
 """,
         skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True),
     )
 
     main_body = _body_for_label(asm, "main")
@@ -204,8 +252,7 @@ fn main() -> i64 {
     assert "    call __nif_fn_main__make_box" in main_body
     assert "    call rt_panic_null_deref" in main_body
     assert "    mov r10, qword ptr [rdi]" in main_body
-    assert "    mov r10, qword ptr [r10 + 80]" in main_body
-    assert "    mov r11, qword ptr [r10]" in main_body
+    assert "    mov r11, qword ptr [r10 + 96]" in main_body
     assert "    call r11" in main_body
 
 
@@ -228,4 +275,5 @@ def test_emit_source_asm_can_omit_runtime_trace_hooks(tmp_path) -> None:
 
     assert "rt_trace_push" not in asm
     assert "rt_trace_pop" not in asm
-    assert "rt_trace_set_location" not in asm
\ No newline at end of file
+    assert "rt_trace_set_location" not in asm
+    assert "nif_line_tables" not in asm
\ No newline at end of file
@@ -58,8 +58,10 @@ def test_emit_source_asm_emits_branch_edges_and_single_epilogue(tmp_path) -> Non
     choose_body = asm[asm.index(f"{choose_label}:") : asm.index(f"{epilogue_label(choose_label)}:")]
 
     assert "    cmp rax, 0" in choose_body
-    assert f"    je {false_label}" in choose_body
-    assert f"    jmp {true_label}" in choose_body
+    assert choose_body.index(f"{false_label}:") < choose_body.index(f"{true_label}:")
+    assert f"    jne {true_label}" in choose_body
+    assert f"    je {false_label}" not in choose_body
+    assert f"    jmp {true_label}" not in choose_body
     assert asm.count(f"{epilogue_label(choose_label)}:") == 1
     assert asm.count(f"    jmp {epilogue_label(choose_label)}") >= 2
 
@@ -1,5 +1,6 @@
 from __future__ import annotations
 
+from compiler.backend.targets import BackendTargetOptions
 from tests.compiler.backend.lowering.helpers import lower_project_to_backend_program
 from tests.compiler.backend.targets.x86_64_sysv.helpers import emit_program, emit_source_asm
 
@@ -73,8 +74,7 @@ def test_emit_source_asm_emits_virtual_dispatch_through_class_vtable(tmp_path) -
 
     assert "    call rt_panic_null_deref" in read_body
     assert "    mov r10, qword ptr [rdi]" in read_body
-    assert "    mov r10, qword ptr [r10 + 80]" in read_body
-    assert "    mov r11, qword ptr [r10]" in read_body
+    assert "    mov r11, qword ptr [r10 + 96]" in read_body
     assert "    call r11" in read_body
     assert "    call __nif_method_main__Base_head" not in read_body
     assert "    call __nif_method_main__Derived_head" not in read_body
@@ -109,14 +109,19 @@ def test_emit_source_asm_emits_interface_dispatch_and_metadata_sections(tmp_path
 
     assert "    call rt_panic_null_deref" in use_body
     assert "    mov r10, qword ptr [rdi]" in use_body
-    assert "    mov r10, qword ptr [r10 + 64]" in use_body
-    assert "    mov r10, qword ptr [r10]" in use_body
+    assert "    mov r10, qword ptr [r10 - 8]" in use_body
     assert "    mov r11, qword ptr [r10]" in use_body
     assert "    call r11" in use_body
     assert "__nif_interface_main__Metric:" in asm
     assert "__nif_interface_name_main__Metric:" in asm
     assert "__nif_interface_methods_main__Box__main__Metric:" in asm
-    assert "__nif_interface_tables_main__Box:" in asm
+    assert (
+        "__nif_interface_tables_main__Box:\n"
+        ".quad __nif_interface_methods_main__Box__main__Metric\n"
+        "__nif_type_Box:\n"
+        "__nif_type_main__Box:\n"
+    ) in asm
+    assert "\n.long 0\n__nif_vtable_main__Box:\n.quad __nif_method_main__Box_score\n" in asm
 
 
 def test_emit_source_asm_is_byte_stable_for_multimodule_dispatch_metadata(tmp_path) -> None:
@@ -330,17 +335,88 @@ def test_emit_source_asm_preserves_virtual_and_interface_reference_args_during_l
     assert "    sub rsp, 32" in measure_mixed_body
     assert "    mov qword ptr [rsp + 24], rax" in measure_mixed_body
     assert "    mov r10, qword ptr [rdi]" in measure_mixed_body
-    assert "    mov r10, qword ptr [r10 + 64]" in measure_mixed_body
-    assert "    mov r10, qword ptr [r10]" in measure_mixed_body
+    assert "    mov r10, qword ptr [r10 - 16]" in measure_mixed_body
     assert "    call r11" in measure_mixed_body
 
     assert "    mov r10, qword ptr [rdi]" in write_slice_value_body
-    assert "    mov r10, qword ptr [r10 + 80]" in write_slice_value_body
-    assert "    mov r11, qword ptr [r10 + 8]" in write_slice_value_body
-    assert "    mov r11, qword ptr [r10]" in write_slice_value_body
+    assert "    mov r11, qword ptr [r10 + 104]" in write_slice_value_body
+    assert "    mov r11, qword ptr [r10 + 96]" in write_slice_value_body
 
     assert "    mov r10, qword ptr [rdi]" in write_slice_interface_body
-    assert "    mov r10, qword ptr [r10 + 64]" in write_slice_interface_body
-    assert "    mov r10, qword ptr [r10 + 8]" in write_slice_interface_body
+    assert "    mov r10, qword ptr [r10 - 8]" in write_slice_interface_body
     assert "    mov r11, qword ptr [r10 + 8]" in write_slice_interface_body
-    assert "    mov r11, qword ptr [r10]" in write_slice_interface_body
\ No newline at end of file
+    assert "    mov r11, qword ptr [r10]" in write_slice_interface_body
+
+def test_emit_source_asm_fronts_dispatch_with_inline_caches_when_requested(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        interface Metric {
+            fn score() -> i64;
+        }
+
+        class Box implements Metric {
+            fn score() -> i64 {
+                return 7;
+            }
+
+            fn head() -> i64 {
+                return 1;
+            }
+        }
+
+        fn use(value: Metric, box: Box) -> i64 {
+            return value.score() + box.head();
+        }
+
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+        skip_optimize=True,
+        options=BackendTargetOptions(inline_caches_enabled=True),
+    )
+
+    use_body = _body_for_label(asm, "__nif_fn_main__use")
+    cache_labels = [line[:-1] for line in asm.splitlines() if line.startswith(".L__nif_fn_main__use_i") and line.endswith("_ic:")]
+
+    assert len(cache_labels) == 2
+    for cache_label in cache_labels:
+        assert f"    mov r11, qword ptr [rip + {cache_label} + 8]" in use_body
+        assert f"    cmp r10, qword ptr [rip + {cache_label}]" in use_body
+        assert f"    cmp r10, qword ptr [rip + {cache_label} + 48]" in use_body
+        assert f"    cmp qword ptr [rip + {cache_label}], 1" in use_body
+        assert f"    mov qword ptr [rip + {cache_label} + 56], r11" in use_body
+        assert f"    mov qword ptr [rip + {cache_label}], 1" in use_body
+        assert f"{cache_label}_megamorphic:" in use_body
+        assert f"{cache_label}_hit:\n    call r11" in use_body
+        assert f".p2align 4\n{cache_label}:\n.zero 64" in asm
+    assert "    mov rax, qword ptr [r10 - 8]" in use_body
+    assert "    mov r10, qword ptr [r10 - 8]" in use_body
+    assert use_body.count("    mov r11, qword ptr [r10 + 96]") == 2
+    assert "\n.bss\n" in asm
+
+
+def test_emit_source_asm_omits_inline_caches_by_default(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        class Base {
+            fn head() -> i64 {
+                return 1;
+            }
+        }
+
+        fn read(value: Base) -> i64 {
+            return value.head();
+        }
+
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+    assert "_ic:" not in asm
+    assert "\n.bss\n" not in asm
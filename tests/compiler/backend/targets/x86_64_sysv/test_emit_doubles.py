@@ -8,6 +8,69 @@ def _body_for_label(asm: str, label: str) -> str:
     return asm[asm.index(f"{label}:") : asm.index(f"{epilogue_label(label)}:")]
 
 
+_STD_MATH_STUB = """
+extern fn rt_math_sqrt(value: double) -> double;
+extern fn rt_math_floor(value: double) -> double;
+extern fn rt_math_round(value: double) -> double;
+extern fn rt_math_abs(value: double) -> double;
+extern fn rt_math_min(left: double, right: double) -> double;
+extern fn rt_math_max(left: double, right: double) -> double;
+extern fn rt_math_pow(base: double, exponent: double) -> double;
+
+export fn sqrt(value: double) -> double {
+    return rt_math_sqrt(value);
+}
+
+export fn floor(value: double) -> double {
+    return rt_math_floor(value);
+}
+
+export fn round(value: double) -> double {
+    return rt_math_round(value);
+}
+
+export fn abs(value: double) -> double {
+    return rt_math_abs(value);
+}
+
+export fn min(left: double, right: double) -> double {
+    return rt_math_min(left, right);
+}
+
+export fn max(left: double, right: double) -> double {
+    return rt_math_max(left, right);
+}
+
+export fn pow(base: double, exponent: double) -> double {
+    return rt_math_pow(base, exponent);
+}
+"""
+
+
+def _emit_std_math_asm(tmp_path) -> str:
+    (tmp_path / "std").mkdir(parents=True)
+    (tmp_path / "std" / "math.nif").write_text(_STD_MATH_STUB, encoding="utf-8")
+    return emit_source_asm(
+        tmp_path,
+        """
+        import std.math as math;
+
+        fn shade(x: double, y: double) -> double {
+            var lit: double = math.sqrt(x) + math.floor(y) + math.round(x) + math.abs(y);
+            return lit + math.min(x, y) + math.max(x, y) + math.pow(x, y);
+        }
+
+        fn main() -> i64 {
+            if shade(2.0, -1.5) > 0.0 {
+                return 0;
+            }
+            return 1;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+
 def test_emit_source_asm_emits_double_constants_and_arithmetic_sequences(tmp_path) -> None:
     asm = emit_source_asm(
         tmp_path,
@@ -120,3 +183,32 @@ def test_emit_source_asm_is_byte_stable_for_double_programs(tmp_path) -> None:
     assert first == second
 
 
+def test_emit_source_asm_lowers_std_math_intrinsics_inline(tmp_path) -> None:
+    asm = _emit_std_math_asm(tmp_path)
+    shade_label = mangle_function_symbol(("main",), "shade")
+    shade_body = _body_for_label(asm, shade_label)
+    sqrt_label = mangle_function_symbol(("std", "math"), "sqrt")
+    min_label = mangle_function_symbol(("std", "math"), "min")
+    pow_label = mangle_function_symbol(("std", "math"), "pow")
+    sqrt_wrapper_body = _body_for_label(asm, sqrt_label)
+
+    assert "    sqrtsd xmm0, xmm0" in shade_body
+    assert "    cmp dword ptr [rip + rt_cpu_has_sse41], 0" in shade_body
+    assert "    roundsd xmm0, xmm0, 9" in shade_body
+    assert "    movabs rax, 0x3fdfffffffffffff" in shade_body
+    assert "    roundsd xmm0, xmm0, 11" in shade_body
+    assert "    movabs rax, 0x7fffffffffffffff" in shade_body
+    assert "    andpd xmm0, xmm1" in shade_body
+    assert "    ucomisd xmm0, xmm1" in shade_body
+    assert "    orpd xmm0, xmm1" in shade_body
+    assert "    minsd xmm0, xmm1" in shade_body
+    assert "    maxsd xmm0, xmm1" in shade_body
+    assert "    movabs rax, 0x7ff8000000000000" in shade_body
+    assert f"{shade_label}_i1_math_fallback:\n    call rt_math_floor\n" in shade_body
+    assert "    call rt_math_round" in shade_body
+    assert "call rt_math_sqrt" not in shade_body
+    assert f"call {sqrt_label}" not in shade_body
+    assert f"call {min_label}" not in shade_body
+    assert f"    call {pow_label}" in shade_body
+    assert "    sqrtsd xmm0, xmm0" in sqrt_wrapper_body
+    assert "call" not in sqrt_wrapper_body
@@ -2,7 +2,12 @@ from __future__ import annotations
 
 import re
 
-from compiler.backend.program.symbols import mangle_function_symbol
+from compiler.backend.targets import BackendTargetOptions
+from compiler.backend.program.symbols import (
+    mangle_function_symbol,
+    mangle_profile_name_symbol,
+    mangle_profile_site_symbol,
+)
 from tests.compiler.backend.targets.x86_64_sysv.helpers import emit_source_asm
 
 
@@ -60,6 +65,7 @@ def test_emit_source_asm_emits_root_frame_setup_before_trace_push(tmp_path) -> N
         }
         """,
         skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True),
     )
 
     keep_label = mangle_function_symbol(("main",), "keep")
@@ -229,7 +235,8 @@ def test_emit_source_asm_reuses_root_slots_across_forced_gc(tmp_path) -> None:
     _assert_root_frame_setup(main_body, root_count=2)
     _assert_root_frame_setup(choose_last_body, root_count=1)
     assert main_body.count("    call rt_gc_collect") == 3
-    assert main_body.count("    call rt_is_instance_of_type") == 2
+    assert main_body.count("    cmp dword ptr [rcx], ") == 2
+    assert "rt_is_instance_of_type" not in main_body
     assert "    call __nif_fn_main__choose_last" in main_body
     assert "    mov qword ptr [rbp - 168], r10" in main_body
     assert "    mov qword ptr [rbp - 160], r10" in main_body
@@ -279,4 +286,110 @@ def test_emit_source_asm_preserves_reference_array_iteration_roots_across_gc(tmp
     assert "    mov qword ptr [rax + rcx * 8 + 48], rdx" in main_body
     assert "    mov rax, qword ptr [rax + rcx * 8 + 48]" in main_body
     assert "    call rt_gc_collect" in main_body
-    assert main_body.count("    call rt_is_instance_of_type") == 2
\ No newline at end of file
+    assert main_body.count("    cmp dword ptr [rcx], ") == 2
+    assert "rt_is_instance_of_type" not in main_body
+
+
+def test_emit_source_asm_brackets_callables_with_function_profile_hooks(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn keep(value: Obj) -> Obj {
+            rt_gc_collect();
+            return value;
+        }
+
+        class Counter {
+            value: i64;
+        }
+
+        fn main() -> i64 {
+            keep(null);
+            var counter: Counter = Counter(1);
+            return counter.value;
+        }
+        """,
+        skip_optimize=True,
+        options=BackendTargetOptions(shadow_trace_enabled=True, function_profile_enabled=True),
+    )
+
+    keep_label = mangle_function_symbol(("main",), "keep")
+    keep_body = _body_for_label(asm, keep_label)
+    keep_function = _function_with_epilogue_for_label(asm, keep_label)
+    keep_epilogue = keep_function[keep_function.index(f".L{keep_label}_epilogue:") :]
+    site_symbol = mangle_profile_site_symbol(keep_label)
+
+    assert keep_body.index("    call rt_trace_push") < keep_body.index(f"    lea rdi, [rip + {site_symbol}]")
+    assert keep_body.index(f"    lea rdi, [rip + {site_symbol}]") < keep_body.index("    call rt_func_profile_enter")
+    assert keep_epilogue.index("    mov qword ptr [rsp], rax") < keep_epilogue.index("    call rt_func_profile_exit")
+    assert keep_epilogue.index("    call rt_func_profile_exit") < keep_epilogue.index("    call rt_trace_pop")
+    assert asm.count("    call rt_func_profile_enter") == asm.count("    call rt_func_profile_exit") == 3
+    assert f"{site_symbol}:\n.quad {mangle_profile_name_symbol(keep_label)}\n.zero 40\n" in asm
+    assert f'{mangle_profile_name_symbol(keep_label)}:\n.asciz "main::keep"\n' in asm
+    assert '.asciz "main::Counter#0"' in asm
+
+
+def test_emit_source_asm_omits_function_profile_hooks_by_default(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn keep(value: Obj) -> Obj {
+            rt_gc_collect();
+            return value;
+        }
+
+        class Counter {
+            value: i64;
+        }
+
+        fn main() -> i64 {
+            keep(null);
+            var counter: Counter = Counter(1);
+            return counter.value;
+        }
+        """,
+        skip_optimize=True,
+    )
+
+    assert "rt_func_profile" not in asm
+    assert "__nif_profile_site_" not in asm
+
+
+def test_emit_source_asm_shrink_wraps_root_frame_past_early_return(tmp_path) -> None:
+    asm = emit_source_asm(
+        tmp_path,
+        """
+        extern fn rt_gc_collect() -> unit;
+
+        fn keep(value: Obj, fast: bool) -> Obj {
+            if fast {
+                return null;
+            }
+            rt_gc_collect();
+            return value;
+        }
+
+        fn main() -> i64 {
+            keep(null, true);
+            return 0;
+        }
+        """,
+    )
+
+    keep_label = mangle_function_symbol(("main",), "keep")
+    keep_body = _body_for_label(asm, keep_label)
+    unframed_epilogue = f".L{keep_label}_epilogue_unframed"
+    unframed_exit = asm[asm.index(f"{unframed_epilogue}:") : asm.index("    ret", asm.index(f"{unframed_epilogue}:"))]
+
+    entry_branch = re.search(r"\n    j(e|ne) ", keep_body)
+
+    _assert_root_frame_setup(keep_body, root_count=1)
+    assert entry_branch is not None, keep_body
+    assert "rt_thread_state" not in keep_body[: entry_branch.start()]
+    assert f"    jmp {unframed_epilogue}" in asm
+    assert "rt_thread_state" not in unframed_exit
+    assert "mov qword ptr [rdi], rcx" not in unframed_exit
@@ -130,6 +130,11 @@ def test_backend_program_context_prepares_class_interface_and_string_metadata(tm
 
     assert derived_metadata.aliases == ("Derived", "main::Derived")
     assert derived_metadata.superclass_symbol == "__nif_type_main__Base"
+    base_metadata = next(record for record in metadata.classes if record.class_id.name == "Base")
+    str_metadata = next(record for record in metadata.classes if record.class_id.name == "Str")
+    assert base_metadata.type_id < derived_metadata.type_id < derived_metadata.subtype_id_end == base_metadata.subtype_id_end
+    assert not base_metadata.type_id <= str_metadata.type_id < base_metadata.subtype_id_end
+    assert str_metadata.subtype_id_end == str_metadata.type_id + 1
     assert derived_metadata.pointer_offsets == (24, 40)
     assert derived_metadata.pointer_offsets_symbol == "__nif_type_name_main__Derived__ptr_offsets"
     assert derived_metadata.interface_tables_symbol == "__nif_interface_tables_main__Derived"
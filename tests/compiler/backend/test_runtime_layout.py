@@ -31,7 +31,10 @@ from compiler.backend.program.runtime_layout import (
     RT_TYPE_FLAG_HAS_REFS,
     RT_TYPE_INTERFACE_TABLES_OFFSET,
     RT_TYPE_POINTER_OFFSETS_OFFSET,
+    RT_TYPE_SIZE_BYTES,
+    RT_TYPE_SUBTYPE_ID_END_OFFSET,
     RT_TYPE_SUPER_TYPE_OFFSET,
+    RT_TYPE_TYPE_ID_OFFSET,
     RT_VTABLE_ENTRY_SIZE_BYTES,
     array_runtime_kind_display_name_for_tag,
     array_runtime_kind_tag,
@@ -70,7 +73,7 @@ class _RtType(ctypes.Structure):
         ("trace_fn", ctypes.c_void_p),
         ("pointer_offsets", ctypes.POINTER(ctypes.c_uint32)),
         ("pointer_offsets_count", ctypes.c_uint32),
-        ("reserved0", ctypes.c_uint32),
+        ("subtype_id_end", ctypes.c_uint32),
         ("super_type", ctypes.c_void_p),
         ("interface_tables", ctypes.c_void_p),
         ("interface_slot_count", ctypes.c_uint32),
@@ -121,11 +124,14 @@ def test_object_and_type_layout_matches_runtime_contract() -> None:
     assert RT_OBJ_HEADER_TYPE_OFFSET == _RtObjHeader.type.offset
     assert RT_OBJ_HEADER_SIZE_BYTES == ctypes.sizeof(_RtObjHeader)
     assert RT_INTERFACE_DEBUG_NAME_OFFSET == _RtInterfaceType.debug_name.offset
+    assert RT_TYPE_TYPE_ID_OFFSET == _RtType.type_id.offset
     assert RT_TYPE_DEBUG_NAME_OFFSET == _RtType.debug_name.offset
+    assert RT_TYPE_SUBTYPE_ID_END_OFFSET == _RtType.subtype_id_end.offset
     assert RT_TYPE_POINTER_OFFSETS_OFFSET == _RtType.pointer_offsets.offset
     assert RT_TYPE_SUPER_TYPE_OFFSET == _RtType.super_type.offset
     assert RT_TYPE_INTERFACE_TABLES_OFFSET == _RtType.interface_tables.offset
     assert RT_TYPE_CLASS_VTABLE_OFFSET == _RtType.class_vtable.offset
+    assert RT_TYPE_SIZE_BYTES == ctypes.sizeof(_RtType)
     assert RT_INTERFACE_TABLE_ENTRY_SIZE_BYTES == ctypes.sizeof(ctypes.c_void_p)
     assert RT_INTERFACE_METHOD_ENTRY_SIZE_BYTES == ctypes.sizeof(ctypes.c_void_p)
     assert RT_VTABLE_ENTRY_SIZE_BYTES == ctypes.sizeof(ctypes.c_void_p)
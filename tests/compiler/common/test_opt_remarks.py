@@ -0,0 +1,79 @@
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+from compiler.common.opt_remarks import (
+    OptRemarkCollector,
+    PassRemarks,
+    collecting_opt_remarks,
+    opt_remarks_enabled,
+    render_opt_remarks_jsonl,
+    render_opt_remarks_summary,
+)
+from compiler.common.span import SourcePos, SourceSpan
+from compiler.semantic.symbols import ConstructorId, FunctionId, MethodId
+
+
+def _span(path: str, line: int) -> SourceSpan:
+    return SourceSpan(
+        start=SourcePos(path=path, offset=0, line=line, column=5),
+        end=SourcePos(path=path, offset=4, line=line, column=9),
+    )
+
+
+def test_pass_remarks_are_dropped_without_an_active_collector() -> None:
+    remarks = PassRemarks("constant_fold")
+    remarks.applied(None, "folded")
+    remarks.publish()
+
+    assert not remarks.enabled
+    assert not opt_remarks_enabled()
+
+
+def test_pass_remarks_publish_into_active_collector_with_callable_names() -> None:
+    collector = OptRemarkCollector()
+    with collecting_opt_remarks(collector):
+        remarks = PassRemarks("dead_store_elimination")
+        remarks.enter_callable(FunctionId(module_path=("main",), name="main"))
+        remarks.applied(None, "removed")
+        remarks.enter_callable(MethodId(module_path=("pkg", "shapes"), class_name="Box", name="area"))
+        remarks.missed(None, "kept")
+        remarks.enter_callable(ConstructorId(module_path=("main",), class_name="Box", ordinal=1))
+        remarks.applied(None, "removed")
+        remarks.leave_callable()
+        PassRemarks.discarded().applied(None, "speculative")
+        assert collector.remarks == []
+        remarks.publish()
+
+    assert [(remark.callable_name, remark.status) for remark in collector.remarks] == [
+        ("main::main", "applied"),
+        ("pkg.shapes::Box.area", "missed"),
+        ("main::Box#1", "applied"),
+    ]
+    assert not opt_remarks_enabled()
+
+
+def test_render_opt_remarks_jsonl_and_summary(tmp_path: Path) -> None:
+    collector = OptRemarkCollector()
+    with collecting_opt_remarks(collector):
+        remarks = PassRemarks("redundant_cast_elimination")
+        remarks.enter_callable(FunctionId(module_path=("main",), name="main"))
+        remarks.applied(_span(str(tmp_path / "main.nif"), 3), "identity cast")
+        remarks.missed(_span("<builtin>", 1), "not a cast")
+        remarks.publish()
+
+    lines = render_opt_remarks_jsonl(collector.remarks, project_root=tmp_path).splitlines()
+    first = json.loads(lines[0])
+    summary = render_opt_remarks_summary(collector.remarks).splitlines()
+
+    assert first == {
+        "pass": "redundant_cast_elimination",
+        "status": "applied",
+        "callable": "main::main",
+        "span": {"path": "main.nif", "line": 3, "column": 5, "end_line": 3, "end_column": 9},
+        "reason": "identity cast",
+    }
+    assert json.loads(lines[1])["span"]["path"] == "<builtin>"
+    assert summary[0].split() == ["callable", "pass", "applied", "missed"]
+    assert summary[1].split() == ["main::main", "redundant_cast_elimination", "1", "1"]
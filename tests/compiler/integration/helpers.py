@@ -19,6 +19,18 @@ STD_INTERNAL_MODULE_DEPENDENCIES: dict[str, tuple[str, ...]] = {
         "std/vec_impl/vec_i64.nif",
         "std/vec_impl/vec_u64.nif",
         "std/vec_impl/vec_double.nif",
+        "std/sort.nif",
+    ),
+    "heap": (
+        "std/heap_impl/heap_obj.nif",
+        "std/heap_impl/heap_i64.nif",
+        "std/heap_impl/heap_u64.nif",
+        "std/sort.nif",
+    ),
+    "deque": (
+        "std/deque_impl/deque_obj.nif",
+        "std/deque_impl/deque_i64.nif",
+        "std/deque_impl/deque_u64.nif",
     ),
 }
 
@@ -106,9 +118,21 @@ def assemble_host_executable(asm_path: Path, *, exe_path: Path | None = None) ->
         repository_root / "runtime" / "src" / "gc.c",
         repository_root / "runtime" / "src" / "gc_trace.c",
         repository_root / "runtime" / "src" / "gc_tracked_set.c",
+        repository_root / "runtime" / "src" / "alloc_profile.c",
+        repository_root / "runtime" / "src" / "gc_heap_dump.c",
+        repository_root / "runtime" / "src" / "perf_counters.c",
+        repository_root / "runtime" / "src" / "func_profile.c",
+        repository_root / "runtime" / "src" / "line_table.c",
         repository_root / "runtime" / "src" / "io.c",
         repository_root / "runtime" / "src" / "array.c",
+        repository_root / "runtime" / "src" / "cpu_features.c",
         repository_root / "runtime" / "src" / "math.c",
+        repository_root / "runtime" / "src" / "bits.c",
+        repository_root / "runtime" / "src" / "bigint.c",
+        repository_root / "runtime" / "src" / "bitset.c",
+        repository_root / "runtime" / "src" / "box.c",
+        repository_root / "runtime" / "src" / "sort.c",
+        repository_root / "runtime" / "src" / "str.c",
         repository_root / "runtime" / "src" / "panic.c",
     ]
     output_path = asm_path.with_suffix("") if exe_path is None else exe_path
@@ -117,6 +141,7 @@ def assemble_host_executable(asm_path: Path, *, exe_path: Path | None = None) ->
         [
             cc,
             "-std=c11",
+            "-fno-omit-frame-pointer",
             "-I",
             str(runtime_include),
             *(str(source_path) for source_path in runtime_sources),
@@ -0,0 +1,109 @@
+from __future__ import annotations
+
+import importlib.util
+import json
+import subprocess
+import sys
+from pathlib import Path
+
+from tests.compiler.integration.helpers import repo_root
+
+
+def load_bench():
+    path = repo_root() / "scripts" / "bench.py"
+    spec = importlib.util.spec_from_file_location("bench_harness", path)
+    assert spec is not None and spec.loader is not None
+    module = importlib.util.module_from_spec(spec)
+    sys.modules[spec.name] = module
+    spec.loader.exec_module(module)
+    return module
+
+
+def result_payload(samples: dict[str, list[float]]) -> dict[str, object]:
+    return {
+        "schema_version": 1,
+        "label": "synthetic",
+        "benchmarks": {
+            name: {
+                "samples_seconds": values,
+                "median_seconds": sorted(values)[len(values) // 2],
+                "max_rss_kb": 2048,
+                "assembly": {"instruction_count": 100},
+            }
+            for name, values in samples.items()
+        },
+    }
+
+
+def test_welch_t_test_matches_reference_values() -> None:
+    bench = load_bench()
+
+    # t = -1 with 8 degrees of freedom.
+    assert abs(bench.welch_t_test([1.0, 2.0, 3.0, 4.0, 5.0], [2.0, 3.0, 4.0, 5.0, 6.0]) - 0.346594) < 1e-5
+    assert bench.welch_t_test([1.0, 1.0, 1.0], [1.0, 1.0, 1.0]) == 1.0
+    assert bench.welch_t_test([1.0, 1.0, 1.0], [2.0, 2.0, 2.0]) == 0.0
+
+
+def test_compare_flags_only_significant_changes_above_threshold() -> None:
+    bench = load_bench()
+    base = result_payload(
+        {
+            "steady": [1.00, 1.02, 0.98, 1.01, 0.99],
+            "regressed": [1.00, 1.01, 0.99, 1.00, 1.01],
+            "improved": [2.00, 2.02, 1.98, 2.01, 1.99],
+            "noisy": [1.0, 1.5, 0.7, 1.3, 0.8],
+        }
+    )
+    new = result_payload(
+        {
+            "steady": [1.01, 0.99, 1.00, 1.02, 0.98],
+            "regressed": [1.20, 1.21, 1.19, 1.20, 1.22],
+            "improved": [1.50, 1.51, 1.49, 1.50, 1.52],
+            "noisy": [1.4, 0.8, 1.6, 0.9, 1.2],
+        }
+    )
+
+    comparisons = {
+        comparison.name: comparison.verdict
+        for comparison in bench.compare_results(base, new, alpha=0.01, threshold_percent=2.0)
+    }
+
+    assert comparisons == {"improved": "faster", "noisy": "same", "regressed": "slower", "steady": "same"}
+
+
+def test_compare_cli_fails_on_regression_when_requested(tmp_path: Path) -> None:
+    base_path = tmp_path / "base.json"
+    new_path = tmp_path / "new.json"
+    base_path.write_text(json.dumps(result_payload({"kernel": [1.00, 1.01, 0.99, 1.00]})), encoding="utf-8")
+    new_path.write_text(json.dumps(result_payload({"kernel": [1.50, 1.51, 1.49, 1.50]})), encoding="utf-8")
+    script = str(repo_root() / "scripts" / "bench.py")
+
+    report_only = subprocess.run(
+        [sys.executable, script, "compare", str(base_path), str(new_path)], capture_output=True, text=True, check=False
+    )
+    gated = subprocess.run(
+        [sys.executable, script, "compare", str(base_path), str(new_path), "--fail-on-regression"],
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+
+    assert report_only.returncode == 0
+    assert "slower" in report_only.stdout
+    assert gated.returncode == 1
+    assert "Significant regressions: kernel" in gated.stderr
+
+
+def test_compare_cli_rejects_non_result_files(tmp_path: Path) -> None:
+    bogus = tmp_path / "bogus.json"
+    bogus.write_text("[]", encoding="utf-8")
+
+    proc = subprocess.run(
+        [sys.executable, str(repo_root() / "scripts" / "bench.py"), "compare", str(bogus), str(bogus)],
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+
+    assert proc.returncode == 2
+    assert "not a schema v1 bench result file" in proc.stderr
@@ -51,6 +51,8 @@ def test_cli_defaults_to_backend_ir_host_native_path(tmp_path: Path, monkeypatch
     def _fake_emit_backend(target_input: BackendTargetInput, *, options) -> BackendEmitResult:
         seen["target_input"] = target_input
         seen["runtime_trace_enabled"] = options.runtime_trace_enabled
+        seen["shadow_trace_enabled"] = options.shadow_trace_enabled
+        seen["inline_caches_enabled"] = options.inline_caches_enabled
         return BackendEmitResult(assembly_text="; backend-ir target selected\n")
 
     _patch_resolve_backend_target(monkeypatch, _fake_emit_backend, seen=seen)
@@ -65,6 +67,8 @@ def test_cli_defaults_to_backend_ir_host_native_path(tmp_path: Path, monkeypatch
     assert target_input.program.entry_callable_id.name == "main"
     assert target_input.analysis_by_callable_id
     assert seen["runtime_trace_enabled"] is True
+    assert seen["shadow_trace_enabled"] is False
+    assert seen["inline_caches_enabled"] is False
     assert seen["requested_target_name"] is None
 
 
@@ -124,6 +128,60 @@ def test_cli_can_omit_runtime_trace_calls(tmp_path: Path, monkeypatch) -> None:
     assert seen["runtime_trace_enabled"] is False
 
 
+def test_cli_can_request_shadow_runtime_trace(tmp_path: Path, monkeypatch) -> None:
+    entry = tmp_path / "main.nif"
+    out_file = tmp_path / "out.s"
+    write(
+        entry,
+        """
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+    )
+
+    seen: dict[str, object] = {}
+
+    def _fake_emit_backend(target_input: BackendTargetInput, *, options) -> BackendEmitResult:
+        seen["runtime_trace_enabled"] = options.runtime_trace_enabled
+        seen["shadow_trace_enabled"] = options.shadow_trace_enabled
+        return BackendEmitResult(assembly_text="; backend-ir target selected\n")
+
+    _patch_resolve_backend_target(monkeypatch, _fake_emit_backend, seen=seen)
+
+    rc = run_cli(monkeypatch, ["nifc", str(entry), "--shadow-runtime-trace", "-o", str(out_file)])
+
+    assert rc == 0
+    assert seen["runtime_trace_enabled"] is True
+    assert seen["shadow_trace_enabled"] is True
+
+
+def test_cli_can_request_inline_caches(tmp_path: Path, monkeypatch) -> None:
+    entry = tmp_path / "main.nif"
+    out_file = tmp_path / "out.s"
+    write(
+        entry,
+        """
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+    )
+
+    seen: dict[str, object] = {}
+
+    def _fake_emit_backend(target_input: BackendTargetInput, *, options) -> BackendEmitResult:
+        seen["inline_caches_enabled"] = options.inline_caches_enabled
+        return BackendEmitResult(assembly_text="; backend-ir target selected\n")
+
+    _patch_resolve_backend_target(monkeypatch, _fake_emit_backend, seen=seen)
+
+    rc = run_cli(monkeypatch, ["nifc", str(entry), "--inline-caches", "-o", str(out_file)])
+
+    assert rc == 0
+    assert seen["inline_caches_enabled"] is True
+
+
 def test_cli_can_disable_all_optimization_phases(tmp_path: Path, monkeypatch) -> None:
     entry = tmp_path / "main.nif"
     out_file = tmp_path / "out.s"
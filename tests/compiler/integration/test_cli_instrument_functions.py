@@ -0,0 +1,85 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from tests.compiler.integration.helpers import compile_native_and_run, write
+
+
+def _profile_rows(stderr: str) -> dict[str, list[str]]:
+    rows: dict[str, list[str]] = {}
+    for line in stderr.splitlines():
+        if not line.startswith("[func-profile]") or "summary" in line or "self%" in line:
+            continue
+        cells = line.split()
+        rows[cells[-1]] = cells[1:-1]
+    return rows
+
+
+def test_cli_instrument_functions_prints_flat_profile_at_exit(tmp_path: Path, monkeypatch) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        class Accumulator {
+            total: i64;
+
+            fn add(value: i64) -> unit {
+                __self.total = __self.total + value;
+            }
+        }
+
+        fn fib(n: i64) -> i64 {
+            if n < 2 {
+                return n;
+            }
+            return fib(n - 1) + fib(n - 2);
+        }
+
+        fn main() -> i64 {
+            var acc: Accumulator = Accumulator(0);
+            var i: i64 = 0;
+            while i < 5 {
+                acc.add(fib(10));
+                i = i + 1;
+            }
+            if acc.total == 275 {
+                return 0;
+            }
+            return 1;
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch,
+        entry,
+        out_path=tmp_path / "out.s",
+        exe_path=tmp_path / "program",
+        extra_args=["--instrument-functions"],
+    )
+
+    assert run.returncode == 0, run.stderr
+    assert "[func-profile] summary functions=3 calls=891 " in run.stderr
+    rows = _profile_rows(run.stderr)
+    assert rows["main::fib"][3] == str(5 * 177)
+    assert rows["main::Accumulator.add"][3] == "5"
+    assert rows["main::main"][3] == "1"
+
+
+def test_cli_without_instrument_functions_prints_no_profile(tmp_path: Path, monkeypatch) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        fn main() -> i64 {
+            return 0;
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch, entry, out_path=tmp_path / "out.s", exe_path=tmp_path / "program"
+    )
+
+    assert run.returncode == 0
+    assert "[func-profile]" not in run.stderr
@@ -0,0 +1,151 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+from tests.compiler.integration.helpers import compile_native_and_run, write
+
+
+@pytest.mark.parametrize("extra_args", [[], ["--inline-caches"]], ids=["tables", "inline-caches"])
+def test_cli_dispatch_sites_stay_correct_from_monomorphic_to_megamorphic(
+    tmp_path: Path, monkeypatch, extra_args: list[str]
+) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        interface Metric {
+            fn score() -> i64;
+        }
+
+        class Base implements Metric {
+            fn score() -> i64 {
+                return 1;
+            }
+
+            fn weight() -> i64 {
+                return 10;
+            }
+        }
+
+        class Two extends Base {
+            override fn score() -> i64 {
+                return 2;
+            }
+        }
+
+        class Three extends Base {
+            override fn score() -> i64 {
+                return 3;
+            }
+
+            override fn weight() -> i64 {
+                return 30;
+            }
+        }
+
+        class Four extends Three {
+            override fn score() -> i64 {
+                return 4;
+            }
+        }
+
+        class Five extends Base {
+            override fn score() -> i64 {
+                return 5;
+            }
+
+            override fn weight() -> i64 {
+                return 50;
+            }
+        }
+
+        class Six extends Five {
+            override fn score() -> i64 {
+                return 6;
+            }
+
+            override fn weight() -> i64 {
+                return 60;
+            }
+        }
+
+        fn make(kind: i64) -> Base {
+            if kind == 0 {
+                return Base();
+            }
+            if kind == 1 {
+                return Two();
+            }
+            if kind == 2 {
+                return Three();
+            }
+            if kind == 3 {
+                return Four();
+            }
+            if kind == 4 {
+                return Five();
+            }
+            return Six();
+        }
+
+        fn total(values: Base[]) -> i64 {
+            var sum: i64 = 0;
+            var i: i64 = 0;
+            while (u64)i < values.len() {
+                var metric: Metric = values[i];
+                sum = sum + metric.score() * 1000 + values[i].weight();
+                i = i + 1;
+            }
+            return sum;
+        }
+
+        fn main() -> i64 {
+            var values: Base[] = Base[](12u);
+            var i: i64 = 0;
+            while i < 12 {
+                values[i] = make(0);
+                i = i + 1;
+            }
+            if total(values) != 12 * 1010 {
+                return 1;
+            }
+
+            i = 0;
+            while i < 12 {
+                values[i] = make(i % 3);
+                i = i + 1;
+            }
+            if total(values) != 4 * (1010 + 2010 + 3030) {
+                return 2;
+            }
+
+            i = 0;
+            while i < 12 {
+                values[i] = make(i % 6);
+                i = i + 1;
+            }
+            if total(values) != 2 * (1010 + 2010 + 3030 + 4030 + 5050 + 6060) {
+                return 3;
+            }
+            if total(values) != 2 * (1010 + 2010 + 3030 + 4030 + 5050 + 6060) {
+                return 4;
+            }
+            return 0;
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch,
+        entry,
+        project_root=tmp_path,
+        out_path=tmp_path / "out.s",
+        exe_path=tmp_path / "program",
+        extra_args=extra_args,
+    )
+
+    assert run.returncode == 0, run.stderr
+    asm = (tmp_path / "out.s").read_text(encoding="utf-8")
+    assert ("_megamorphic:" in asm) == bool(extra_args)
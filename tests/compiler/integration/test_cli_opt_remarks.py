@@ -0,0 +1,222 @@
+from __future__ import annotations
+
+import json
+from pathlib import Path
+
+from tests.compiler.integration.helpers import run_cli, write
+
+
+def _remarks(path: Path) -> list[dict[str, object]]:
+    return [json.loads(line) for line in path.read_text(encoding="utf-8").splitlines()]
+
+
+def test_cli_opt_remarks_reports_applied_and_missed_semantic_remarks(tmp_path: Path, monkeypatch, capsys) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        interface Shape {
+            fn area() -> i64;
+        }
+
+        class Square implements Shape {
+            side: i64;
+
+            fn area() -> i64 {
+                return __self.side * __self.side;
+            }
+        }
+
+        class Unit implements Shape {
+            fn area() -> i64 {
+                return 1;
+            }
+        }
+
+        fn measure(shape: Shape) -> i64 {
+            return shape.area();
+        }
+
+        fn widen(value: i64) -> i64 {
+            return (i64)value;
+        }
+
+        fn main() -> i64 {
+            var square: Shape = Square(3);
+            var unused: i64 = 5;
+            return measure(Unit()) + square.area() + widen(7);
+        }
+        """,
+    )
+    remarks_path = tmp_path / "out" / "remarks.jsonl"
+
+    rc = run_cli(
+        monkeypatch,
+        ["nifc", str(entry), "--stop-after", "check", "--opt-remarks", str(remarks_path)],
+    )
+    captured = capsys.readouterr()
+    remarks = _remarks(remarks_path)
+    by_pass = {(remark["pass"], remark["status"], remark["callable"]) for remark in remarks}
+
+    assert rc == 0
+    assert ("interface_call_devirtualization", "applied", "main::main") in by_pass
+    assert ("interface_call_devirtualization", "missed", "main::measure") in by_pass
+    assert ("dead_store_elimination", "applied", "main::main") in by_pass
+    assert ("redundant_cast_elimination", "applied", "main::widen") in by_pass
+    devirtualized = next(
+        remark
+        for remark in remarks
+        if remark["pass"] == "interface_call_devirtualization" and remark["callable"] == "main::main"
+    )
+    assert devirtualized["span"]["path"] == "main.nif"
+    assert "Square.area" in devirtualized["reason"]
+    assert any("'unused'" in str(remark["reason"]) for remark in remarks)
+    assert captured.err.splitlines()[0].split() == ["callable", "pass", "applied", "missed"]
+    assert any(line.startswith("main::measure ") for line in captured.err.splitlines())
+
+
+def test_cli_opt_remarks_include_backend_pass_changes(tmp_path: Path, monkeypatch, capsys) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        fn helper(a: i64, b: i64) -> i64 {
+            var t: i64 = a;
+            if b > 0 {
+                return t + b;
+            }
+            return t;
+        }
+
+        fn main() -> i64 {
+            return helper(3, 4);
+        }
+        """,
+    )
+    remarks_path = tmp_path / "remarks.jsonl"
+
+    rc = run_cli(
+        monkeypatch,
+        ["nifc", str(entry), "--stop-after", "backend-ir-passes", "--opt-remarks", str(remarks_path)],
+    )
+    capsys.readouterr()
+    backend_remarks = [
+        remark
+        for remark in _remarks(remarks_path)
+        if remark["pass"] == "dead_pure_definition_elimination" and remark["callable"] == "main::helper"
+    ]
+
+    assert rc == 0
+    assert backend_remarks
+    assert backend_remarks[0]["status"] == "applied"
+    assert backend_remarks[0]["span"]["path"] == "main.nif"
+    assert "instructions" in str(backend_remarks[0]["reason"])
+
+
+def test_cli_opt_remarks_report_backend_rewrite_sites(tmp_path: Path, monkeypatch, capsys) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        class Node {
+            value: i64;
+        }
+
+        fn scale(value: i64) -> i64 {
+            return value / 10;
+        }
+
+        fn cached(skip: bool, node: Node) -> i64 {
+            if skip {
+                return 0;
+            }
+            var other: Node = Node(2);
+            return node.value + other.value;
+        }
+
+        fn build(node: Node) -> i64 {
+            var other: Node = Node(1);
+            return node.value + other.value;
+        }
+
+        fn ratio(value: i64, divisor: i64) -> i64 {
+            return value / divisor;
+        }
+
+        fn fill(values: i64[]) -> unit {
+            var i: i64 = 0;
+            while i < (i64)values.len() {
+                values[i] = 7;
+                i = i + 1;
+            }
+        }
+
+        fn total(values: i64[]) -> i64 {
+            var sum: i64 = 0;
+            var i: i64 = 0;
+            while i < (i64)values.len() {
+                sum = sum + values[i];
+                i = i + 1;
+            }
+            return sum + values[0];
+        }
+
+        fn main() -> i64 {
+            var values: i64[] = i64[](16u);
+            fill(values);
+            var node: Node = Node(3);
+            return total(values) + scale(100) + ratio(9, 3) + cached(false, node) + build(node);
+        }
+        """,
+    )
+    remarks_path = tmp_path / "remarks.jsonl"
+
+    rc = run_cli(
+        monkeypatch,
+        ["nifc", str(entry), "--stop-after", "backend-ir-passes", "--opt-remarks", str(remarks_path)],
+    )
+    capsys.readouterr()
+    remarks = _remarks(remarks_path)
+
+    def reasons(pass_name: str, status: str, callable_name: str) -> list[str]:
+        return [
+            str(remark["reason"])
+            for remark in remarks
+            if remark["pass"] == pass_name and remark["status"] == status and remark["callable"] == callable_name
+        ]
+
+    assert rc == 0
+    assert any("multiply-high" in reason for reason in reasons("algebraic_simplify", "applied", "main::scale"))
+    assert any("not a constant" in reason for reason in reasons("algebraic_simplify", "missed", "main::ratio"))
+    assert any(reason.startswith("fill loop") for reason in reasons("idiom_recognition", "applied", "main::fill"))
+    assert any("counted loop kept" in reason for reason in reasons("idiom_recognition", "missed", "main::total"))
+    assert reasons("loop_rotation", "applied", "main::total")
+    assert reasons("bounds_check_elision", "applied", "main::total")
+    assert reasons("bounds_check_elision", "missed", "main::total")
+    assert reasons("gc_effect_inference", "applied", "main::main")
+    assert any("main::build stays a safepoint" in reason for reason in reasons("gc_effect_inference", "missed", "main::main"))
+    assert reasons("shrink_wrap", "applied", "main::cached")
+    assert any("entry block" in reason for reason in reasons("shrink_wrap", "missed", "main::build"))
+    # Passes that remark on their own sites no longer add the callable-level summary.
+    assert not any("rewrote callable" in reason for reason in reasons("algebraic_simplify", "applied", "main::scale"))
+    site_remarks = [remark for remark in remarks if remark["pass"] == "bounds_check_elision"]
+    assert all(remark["span"]["path"] == "main.nif" for remark in site_remarks)
+
+
+def test_cli_without_opt_remarks_stays_quiet(tmp_path: Path, monkeypatch, capsys) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        fn main() -> i64 {
+            var unused: i64 = 1;
+            return 0;
+        }
+        """,
+    )
+
+    rc = run_cli(monkeypatch, ["nifc", str(entry), "--stop-after", "check"])
+    captured = capsys.readouterr()
+
+    assert rc == 0
+    assert captured.err == ""
@@ -0,0 +1,89 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+import pytest
+
+from tests.compiler.integration.helpers import compile_native_and_run, write
+
+
+def _stacktrace_frames(stderr: str) -> list[str]:
+    lines = stderr.splitlines()
+    start = lines.index("stacktrace:") + 1
+    return [line.strip() for line in lines[start:] if line.startswith("  at ")]
+
+
+@pytest.mark.parametrize("extra_args", [[], ["--shadow-runtime-trace"]], ids=["line-tables", "shadow"])
+def test_cli_runtime_panic_stacktrace_reports_each_caller(tmp_path: Path, monkeypatch, extra_args: list[str]) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        fn read_first(values: i64[]) -> i64 {
+            return values[0];
+        }
+
+        fn relay(values: i64[]) -> i64 {
+            var result: i64 = read_first(values);
+            return result + 1;
+        }
+
+        fn main() -> i64 {
+            return relay(null);
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch,
+        entry,
+        project_root=tmp_path,
+        out_path=tmp_path / "out.s",
+        exe_path=tmp_path / "program",
+        extra_args=extra_args,
+    )
+
+    assert run.returncode != 0
+    assert "panic: Array API called with null object" in run.stderr
+    frames = _stacktrace_frames(run.stderr)
+    assert [frame.split(" (")[0] for frame in frames] == ["at main::read_first", "at main::relay", "at main::main"]
+    assert frames[1].endswith(":6:31)")
+    assert frames[2].endswith(":11:20)")
+
+
+def test_cli_runtime_panic_stacktrace_resolves_faulting_line_without_trace_calls(tmp_path: Path, monkeypatch) -> None:
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        class Holder {
+            first: i64;
+
+            constructor(values: i64[]) {
+                __self.first = values[0];
+            }
+        }
+
+        fn make(values: i64[]) -> Holder {
+            return Holder(values);
+        }
+
+        fn main() -> i64 {
+            var holder: Holder = make(null);
+            return holder.first;
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch, entry, project_root=tmp_path, out_path=tmp_path / "out.s", exe_path=tmp_path / "program"
+    )
+
+    assert run.returncode != 0
+    assert "rt_trace_" not in (tmp_path / "out.s").read_text(encoding="utf-8")
+    assert "panic: Array API called with null object" in run.stderr
+    frames = _stacktrace_frames(run.stderr)
+    assert [frame.split(" (")[0] for frame in frames] == ["at main::Holder#0", "at main::make", "at main::main"]
+    assert frames[0].endswith(":5:32)")
+    assert frames[1].endswith(":10:20)")
+    assert frames[2].endswith(":14:34)")
@@ -0,0 +1,74 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from tests.compiler.integration.helpers import compile_native_and_run, install_std_modules, write
+
+
+def test_cli_runtime_std_bits_intrinsics_match_runtime_wrappers(tmp_path: Path, monkeypatch) -> None:
+    install_std_modules(tmp_path, ["bits"])
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        import std.bits as bits;
+
+        fn check_counts(zero: u64, ones: u64, mixed: u64) -> i64 {
+            if bits.popcount(zero) != 0u || bits.popcount(ones) != 64u || bits.popcount(mixed) != 32u {
+                return 1;
+            }
+            if bits.clz(zero) != 64u || bits.clz(1u) != 63u || bits.clz(ones) != 0u || bits.clz(mixed) != 7u {
+                return 2;
+            }
+            if bits.ctz(zero) != 64u || bits.ctz(0x8000000000000000u) != 63u || bits.ctz(mixed) != 0u {
+                return 3;
+            }
+            if bits.popcount(0x8000000000000001u) != 2u || bits.ctz(0x100u) != 8u {
+                return 4;
+            }
+            return 0;
+        }
+
+        fn check_rotates_and_products(mixed: u64, ones: u64) -> i64 {
+            if bits.rotl(mixed, 4u) != 0x123456789abcdef0u || bits.rotr(mixed, 4u) != 0xf0123456789abcdeu {
+                return 11;
+            }
+            if bits.rotl(mixed, 68u) != bits.rotl(mixed, 4u) || bits.rotr(mixed, 64u) != mixed {
+                return 12;
+            }
+            if bits.bswap(mixed) != 0xefcdab8967452301u || bits.bswap(bits.bswap(ones)) != ones {
+                return 13;
+            }
+            if bits.mulhi(ones, ones) != 0xfffffffffffffffeu || bits.mulhi(0x100000000u, 0x100000000u) != 1u {
+                return 14;
+            }
+            if bits.mulhi(mixed, 3u) != 0u || bits.mulhi(0xfedcba9876543210u, mixed) != 0x0121fa00ad77d742u {
+                return 15;
+            }
+            return 0;
+        }
+
+        fn main() -> i64 {
+            var zero: u64 = 0u;
+            // The first popcount detects POPCNT in the runtime; the second pass runs the inline path.
+            var pass: i64 = 0;
+            while pass < 2 {
+                var status: i64 = check_counts(zero, ~zero, 0x0123456789abcdefu);
+                if status != 0 {
+                    return status + pass * 100;
+                }
+                pass = pass + 1;
+            }
+            return check_rotates_and_products(0x0123456789abcdefu, ~zero);
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch, entry, project_root=tmp_path, out_path=tmp_path / "out.s", exe_path=tmp_path / "program"
+    )
+
+    assert run.returncode == 0, run.stderr
+    asm = (tmp_path / "out.s").read_text(encoding="utf-8")
+    assert "popcnt rax, rax" in asm
+    assert "mul rcx" in asm
@@ -35,4 +35,96 @@ def test_cli_runtime_smoke_supports_std_math(tmp_path: Path, monkeypatch) -> Non
         monkeypatch, entry, project_root=tmp_path, out_path=tmp_path / "out.s", exe_path=tmp_path / "program"
     )
 
-    assert run.returncode == 0
\ No newline at end of file
+    assert run.returncode == 0
+
+def test_cli_runtime_std_math_intrinsics_keep_runtime_rounding_nan_and_signed_zero_rules(
+    tmp_path: Path, monkeypatch
+) -> None:
+    install_std_modules(tmp_path, ["math"])
+    entry = tmp_path / "main.nif"
+    write(
+        entry,
+        """
+        import std.math as math;
+
+        fn is_negative_zero(value: double) -> bool {
+            return value == 0.0 && 1.0 / value < 0.0;
+        }
+
+        fn is_positive_zero(value: double) -> bool {
+            return value == 0.0 && 1.0 / value > 0.0;
+        }
+
+        fn check_rounding(negative_half: double, big: double) -> i64 {
+            if math.floor(-2.5) != -3.0 || math.ceil(-2.5) != -2.0 || math.trunc(-2.7) != -2.0 {
+                return 1;
+            }
+            if math.round(2.5) != 3.0 || math.round(-2.5) != -3.0 || math.round(0.49999999999999994) != 0.0 {
+                return 2;
+            }
+            if !is_negative_zero(math.round(-0.3)) || !is_negative_zero(math.ceil(negative_half)) {
+                return 3;
+            }
+            if !is_negative_zero(math.trunc(negative_half)) || math.floor(negative_half) != -1.0 {
+                return 4;
+            }
+            if math.floor(big) != big || math.round(4503599627370497.0) != 4503599627370497.0 {
+                return 5;
+            }
+            return 0;
+        }
+
+        fn check_min_max(zero: double, negative_zero: double, nan: double) -> i64 {
+            if !is_negative_zero(math.min(zero, negative_zero)) || !is_negative_zero(math.min(negative_zero, zero)) {
+                return 11;
+            }
+            if !is_positive_zero(math.max(zero, negative_zero)) || !is_positive_zero(math.max(negative_zero, zero)) {
+                return 12;
+            }
+            if !math.is_nan(math.min(nan, 1.0)) || !math.is_nan(math.min(1.0, nan)) {
+                return 13;
+            }
+            if !math.is_nan(math.max(nan, 1.0)) || !math.is_nan(math.max(1.0, nan)) {
+                return 14;
+            }
+            if math.min(1.0, 2.0) != 1.0 || math.max(1.0, 2.0) != 2.0 || math.min(-3.0, -2.0) != -3.0 {
+                return 15;
+            }
+            return 0;
+        }
+
+        fn main() -> i64 {
+            var zero: double = 0.0;
+            var negative_zero: double = -zero;
+            // The first rounding call detects SSE4.1 in the runtime; the second pass runs the inline path.
+            var pass: i64 = 0;
+            while pass < 2 {
+                var status: i64 = check_rounding(-0.5, 10000000000000000000000.0);
+                if status != 0 {
+                    return status + pass * 100;
+                }
+                pass = pass + 1;
+            }
+            var status: i64 = check_min_max(zero, negative_zero, zero / zero);
+            if status != 0 {
+                return status;
+            }
+            if math.sqrt(6.25) != 2.5 || !math.is_nan(math.sqrt(-1.0)) {
+                return 21;
+            }
+            if !is_positive_zero(math.abs(negative_zero)) || math.abs(-7.5) != 7.5 {
+                return 22;
+            }
+            return 0;
+        }
+        """,
+    )
+
+    run = compile_native_and_run(
+        monkeypatch, entry, project_root=tmp_path, out_path=tmp_path / "out.s", exe_path=tmp_path / "program"
+    )
+
+    assert run.returncode == 0, run.stderr
+    asm = (tmp_path / "out.s").read_text(encoding="utf-8")
+    assert "roundsd" in asm
+    assert "minsd" in asm
@@ -0,0 +1,93 @@
+from __future__ import annotations
+
+import importlib.util
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+from tests.compiler.integration.helpers import repo_root
+
+
+def load_analyzer():
+    path = repo_root() / "scripts" / "analyze_heap_snapshot.py"
+    spec = importlib.util.spec_from_file_location("analyze_heap_snapshot", path)
+    assert spec is not None and spec.loader is not None
+    module = importlib.util.module_from_spec(spec)
+    sys.modules[spec.name] = module
+    spec.loader.exec_module(module)
+    return module
+
+
+def type_record(key: int, name: str) -> bytes:
+    encoded = name.encode("utf-8")
+    return struct.pack("<BQIII", 1, key, 0, 0, len(encoded)) + encoded
+
+
+def object_record(address: int, type_key: int, size: int, edges: tuple[int, ...] = ()) -> bytes:
+    return struct.pack("<BQQQI", 2, address, type_key, size, len(edges)) + struct.pack(f"<{len(edges)}Q", *edges)
+
+
+def root_record(address: int, kind: int, frame_index: int, slot_index: int) -> bytes:
+    return struct.pack("<BQIII", 3, address, kind, frame_index, slot_index)
+
+
+def write_snapshot(path: Path, records: list[bytes], *, object_count: int, root_count: int) -> None:
+    header = b"NIFHEAP1" + struct.pack("<II", 1, 8)
+    end = struct.pack("<BQQ", 255, object_count, root_count)
+    path.write_bytes(header + b"".join(records) + end)
+
+
+def test_analyzer_computes_dominator_retained_sizes(tmp_path: Path) -> None:
+    analyzer = load_analyzer()
+    snapshot_path = tmp_path / "heap.bin"
+    # global -> A -> B -> D, A -> C -> D (diamond), stack -> E -> C, F unreachable.
+    write_snapshot(
+        snapshot_path,
+        [
+            type_record(0x10, "Node"),
+            type_record(0x20, "Leaf"),
+            object_record(0xA0, 0x10, 100, (0xB0, 0xC0)),
+            object_record(0xB0, 0x10, 10, (0xD0,)),
+            object_record(0xC0, 0x10, 20, (0xD0,)),
+            object_record(0xD0, 0x20, 1000),
+            object_record(0xE0, 0x10, 5, (0xC0,)),
+            object_record(0xF0, 0x20, 7),
+            root_record(0xA0, 2, 0, 0),
+            root_record(0xE0, 1, 0, 3),
+        ],
+        object_count=6,
+        root_count=2,
+    )
+
+    report = analyzer.analyze(analyzer.read_snapshot(snapshot_path))
+
+    assert report.total_bytes == 1142
+    assert report.reachable_bytes == 1135
+    assert report.unreachable_bytes == 7
+
+    roots = {summary.root: summary.retained_bytes for summary in report.roots}
+    # C and D are reachable from both roots, so neither root retains them.
+    assert roots == {"global[0]": 110, "stack[frame=0 slot=3]": 5}
+
+    types = {summary.type_name: summary for summary in report.types}
+    assert types["Node"].count == 4
+    assert types["Node"].shallow_bytes == 135
+    # Nested Node B is dominated by Node A and must not be counted twice.
+    assert types["Node"].retained_bytes == 110 + 5 + 20
+    assert types["Leaf"].retained_bytes == 1000
+
+
+def test_analyzer_cli_rejects_non_snapshot_input(tmp_path: Path) -> None:
+    bogus = tmp_path / "bogus.bin"
+    bogus.write_bytes(b"not a heap snapshot")
+
+    proc = subprocess.run(
+        [sys.executable, str(repo_root() / "scripts" / "analyze_heap_snapshot.py"), str(bogus)],
+        capture_output=True,
+        text=True,
+        check=False,
+    )
+
+    assert proc.returncode == 1
+    assert "not a Niflheim heap snapshot" in proc.stderr
@@ -0,0 +1,242 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from compiler.common.logging import configure_logging, resolve_log_settings
+from compiler.resolver import resolve_program
+from compiler.semantic.ir import (
+    BinaryExprS,
+    CallExprS,
+    FieldReadExpr,
+    LiteralExprS,
+    LocalRefExpr,
+    SemanticReturn,
+    SemanticVarDecl,
+)
+from compiler.semantic.lowering.orchestration import lower_program
+from compiler.semantic.optimizations.box_unbox_elimination import box_unbox_elimination
+
+
+def _write(path: Path, text: str) -> None:
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(text.strip() + "\n", encoding="utf-8")
+
+
+def _optimize(tmp_path: Path):
+    return box_unbox_elimination(lower_program(resolve_program(tmp_path / "main.nif", project_root=tmp_path)))
+
+
+def _function_body(program, name: str):
+    function = next(fn for fn in program.modules[("main",)].functions if fn.function_id.name == name)
+    return function.body.statements
+
+
+def test_box_unbox_elimination_forwards_field_of_fresh_constructor(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Box {
+            final val: i64;
+        }
+
+        fn main() -> i64 {
+            return Box(7).val;
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "main")
+
+    assert isinstance(statements[0], SemanticReturn)
+    assert isinstance(statements[0].value, LiteralExprS)
+
+
+def test_box_unbox_elimination_removes_box_local_read_through_checked_cast(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Box {
+            final val: i64;
+        }
+
+        fn unwrap(value: i64) -> i64 {
+            var boxed: Box = Box(value);
+            var erased: Obj = Box(value + 1);
+            return boxed.val + ((Box)erased).val;
+        }
+
+        fn main() -> i64 {
+            return unwrap(1);
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "unwrap")
+
+    assert len(statements) == 1
+    assert isinstance(statements[0], SemanticReturn)
+    assert isinstance(statements[0].value, BinaryExprS)
+    assert isinstance(statements[0].value.left, LocalRefExpr)
+    assert isinstance(statements[0].value.right, BinaryExprS)
+
+
+def test_box_unbox_elimination_forwards_std_box_factories(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "std" / "box.nif",
+        """
+        export class BoxI64 {
+            final val: i64;
+
+            static fn of(value: i64) -> BoxI64 {
+                return BoxI64(value);
+            }
+        }
+        """,
+    )
+    _write(
+        tmp_path / "main.nif",
+        """
+        import std.box;
+
+        fn main() -> i64 {
+            var count: Obj = BoxI64.of(3);
+            return ((BoxI64)count).val;
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "main")
+
+    assert len(statements) == 1
+    assert isinstance(statements[0], SemanticReturn)
+    assert isinstance(statements[0].value, LiteralExprS)
+
+
+def test_box_unbox_elimination_keeps_reads_when_the_argument_changes(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Box {
+            final val: i64;
+        }
+
+        fn main() -> i64 {
+            var value: i64 = 1;
+            var boxed: Box = Box(value);
+            value = value + 1;
+            return boxed.val;
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "main")
+
+    assert isinstance(statements[1], SemanticVarDecl)
+    assert isinstance(statements[3], SemanticReturn)
+    assert isinstance(statements[3].value, FieldReadExpr)
+
+
+def test_box_unbox_elimination_keeps_reads_of_mutable_fields(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Cell {
+            val: i64;
+        }
+
+        fn bump(cell: Cell) -> unit {
+            cell.val = cell.val + 1;
+        }
+
+        fn main() -> i64 {
+            var cell: Cell = Cell(1);
+            bump(cell);
+            return cell.val;
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "main")
+
+    assert isinstance(statements[2], SemanticReturn)
+    assert isinstance(statements[2].value, FieldReadExpr)
+
+
+def test_box_unbox_elimination_keeps_constructions_with_side_effects(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Pair {
+            final left: i64;
+            final right: i64;
+        }
+
+        fn next() -> i64 {
+            return 4;
+        }
+
+        fn main() -> i64 {
+            return Pair(next(), 2).right + Pair(3, next()).right;
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "main")
+
+    assert isinstance(statements[0], SemanticReturn)
+    assert isinstance(statements[0].value, BinaryExprS)
+    assert isinstance(statements[0].value.left, FieldReadExpr)
+    assert isinstance(statements[0].value.right, CallExprS)
+
+
+def test_box_unbox_elimination_keeps_casts_that_can_fail(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Box {
+            final val: i64;
+        }
+
+        class Other {
+            final val: i64;
+        }
+
+        fn main() -> i64 {
+            var erased: Obj = Box(1);
+            return ((Other)erased).val;
+        }
+        """,
+    )
+
+    statements = _function_body(_optimize(tmp_path), "main")
+
+    assert isinstance(statements[0], SemanticVarDecl)
+    assert isinstance(statements[1].value, FieldReadExpr)
+
+
+def test_box_unbox_elimination_logs_exact_summary_counts(tmp_path: Path, capsys) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Box {
+            final val: i64;
+        }
+
+        fn main() -> i64 {
+            var boxed: Box = Box(2);
+            return boxed.val + Box(3).val;
+        }
+        """,
+    )
+
+    semantic = lower_program(resolve_program(tmp_path / "main.nif", project_root=tmp_path))
+    capsys.readouterr()
+    configure_logging(resolve_log_settings("debug", verbose=1, quiet=0))
+
+    box_unbox_elimination(semantic)
+    captured = capsys.readouterr()
+
+    assert (
+        captured.err.strip()
+        == "nifc: debug: Optimization pass box_unbox_elimination forwarded 2 field reads and removed 1 box declarations"
+    )
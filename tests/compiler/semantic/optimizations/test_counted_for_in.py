@@ -0,0 +1,202 @@
+from __future__ import annotations
+
+from pathlib import Path
+
+from compiler.resolver import resolve_program
+from compiler.semantic.ir import (
+    CallExprS,
+    FieldReadExpr,
+    IndexReadExpr,
+    LocalRefExpr,
+    SemanticAssign,
+    SemanticBlock,
+    SemanticContinue,
+    SemanticForIn,
+    SemanticIf,
+    SemanticVarDecl,
+    SemanticWhile,
+)
+from compiler.semantic.lowering.orchestration import lower_program
+from compiler.semantic.optimizations.counted_for_in import counted_for_in
+from compiler.semantic.optimizations.interface_call_devirtualization import interface_call_devirtualization
+
+
+def _write(path: Path, text: str) -> None:
+    path.write_text(text.strip() + "\n", encoding="utf-8")
+
+
+def _run_counted_for_in(tmp_path: Path):
+    program = lower_program(resolve_program(tmp_path / "main.nif", project_root=tmp_path))
+    return counted_for_in(interface_call_devirtualization(program))
+
+
+def _function(program, name: str):
+    return next(fn for fn in program.modules[("main",)].functions if fn.function_id.name == name)
+
+
+def _contains_call(node) -> bool:
+    if isinstance(node, CallExprS):
+        return True
+    if isinstance(node, (list, tuple)):
+        return any(_contains_call(item) for item in node)
+    if hasattr(node, "__dataclass_fields__"):
+        return any(_contains_call(getattr(node, name)) for name in node.__dataclass_fields__)
+    return False
+
+
+def test_counted_for_in_scalarizes_field_constructor_collection_and_steps_before_continue(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Span {
+            final start: i64;
+            final end: i64;
+
+            fn iter_len() -> u64 {
+                if __self.end <= __self.start {
+                    return 0u;
+                }
+                return (u64)(__self.end - __self.start);
+            }
+
+            fn iter_get(index: i64) -> i64 {
+                return __self.start + index;
+            }
+        }
+
+        fn main(limit: i64) -> i64 {
+            var total: i64 = 0;
+            for value in Span(2, limit) {
+                if value == 3 {
+                    continue;
+                }
+                total = total + value;
+            }
+            return total;
+        }
+        """,
+    )
+
+    fn = _function(_run_counted_for_in(tmp_path), "main")
+    loop_block = fn.body.statements[1]
+
+    assert isinstance(loop_block, SemanticBlock)
+    assert not _contains_call(loop_block)
+    start_decl, end_decl, length_decl, length_guard, index_decl, loop = loop_block.statements
+    assert [fn.local_info_by_id[decl.local_id].binding_kind for decl in (start_decl, end_decl, length_decl, index_decl)] == [
+        "for_in_collection",
+        "for_in_collection",
+        "for_in_length",
+        "for_in_index",
+    ]
+    assert isinstance(length_guard, SemanticIf)
+    assert isinstance(length_guard.else_block.statements[0], SemanticAssign)
+    assert isinstance(loop, SemanticWhile)
+
+    element_decl, body, step = loop.body.statements
+    assert isinstance(element_decl, SemanticVarDecl)
+    assert fn.local_info_by_id[element_decl.local_id].binding_kind == "for_in_element"
+    assert isinstance(element_decl.initializer.left, LocalRefExpr)
+    assert element_decl.initializer.left.local_id == start_decl.local_id
+    assert element_decl.initializer.right.local_id == index_decl.local_id
+    continue_branch = body.statements[0].then_block.statements[0]
+    assert continue_branch.statements == [step, SemanticContinue(span=continue_branch.statements[1].span)]
+
+
+def test_counted_for_in_binds_collection_once_and_inlines_field_backed_element_reads(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Items {
+            count: u64;
+            storage: i64[];
+
+            fn iter_len() -> u64 {
+                return __self.count;
+            }
+
+            fn iter_get(index: i64) -> i64 {
+                return __self.storage[index];
+            }
+        }
+
+        fn main(items: Items) -> i64 {
+            var total: i64 = 0;
+            for value in items {
+                total = total + value;
+            }
+            return total;
+        }
+        """,
+    )
+
+    fn = _function(_run_counted_for_in(tmp_path), "main")
+    collection_decl, length_decl, _index_decl, loop = fn.body.statements[1].statements
+
+    assert fn.local_info_by_id[collection_decl.local_id].binding_kind == "for_in_collection"
+    assert isinstance(length_decl.initializer.operand, FieldReadExpr)
+    assert length_decl.initializer.operand.receiver.local_id == collection_decl.local_id
+    element_read = loop.body.statements[0].initializer
+    assert isinstance(element_read, IndexReadExpr)
+    assert element_read.target.receiver.local_id == collection_decl.local_id
+    assert element_read.span == fn.body.statements[1].span
+
+
+def test_counted_for_in_keeps_protocol_calls_for_dynamic_or_statement_bodies(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        interface Seq {
+            fn iter_len() -> u64;
+            fn iter_get(index: i64) -> i64;
+        }
+
+        class Counted implements Seq {
+            calls: u64;
+
+            fn iter_len() -> u64 {
+                __self.calls = __self.calls + 1u;
+                return 3u;
+            }
+
+            fn iter_get(index: i64) -> i64 {
+                return index;
+            }
+        }
+
+        class Other implements Seq {
+            fn iter_len() -> u64 {
+                return 1u;
+            }
+
+            fn iter_get(index: i64) -> i64 {
+                return 0;
+            }
+        }
+
+        fn sum_seq(seq: Seq) -> i64 {
+            var total: i64 = 0;
+            for value in seq {
+                total = total + value;
+            }
+            return total;
+        }
+
+        fn sum_counted(seq: Counted) -> i64 {
+            var total: i64 = 0;
+            for value in seq {
+                total = total + value;
+            }
+            return total;
+        }
+
+        fn main() -> i64 {
+            return sum_seq(Other()) + sum_counted(Counted(0u));
+        }
+        """,
+    )
+
+    program = _run_counted_for_in(tmp_path)
+
+    assert isinstance(_function(program, "sum_seq").body.statements[1], SemanticForIn)
+    assert isinstance(_function(program, "sum_counted").body.statements[1], SemanticForIn)
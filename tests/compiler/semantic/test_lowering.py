@@ -1418,6 +1418,61 @@ def test_lower_program_lowers_string_literals_and_concat_to_explicit_helpers(tmp
     assert not hasattr(return_stmt.value.args[1].args[0], "type_name")
 
 
+def test_lower_program_fuses_string_concat_chains_into_one_buffer_fill(tmp_path: Path) -> None:
+    _write(
+        tmp_path / "main.nif",
+        """
+        class Str {
+            _bytes: u8[];
+
+            static fn from_u8_array(value: u8[]) -> Str {
+                return Str(value);
+            }
+
+            static fn from_i64(value: i64) -> Str {
+                return Str(u8[](1u));
+            }
+
+            static fn concat(left: Str, right: Str) -> Str {
+                return left;
+            }
+        }
+
+        fn main(name: Str, count: i64) -> Str {
+            var both: Str = "a" + "b" + "c";
+            return "hello " + "dear " + name + (": " + Str.from_i64(count));
+        }
+        """,
+    )
+
+    program = resolve_program(tmp_path / "main.nif", project_root=tmp_path)
+    semantic = lower_program(program)
+    statements = semantic.modules[("main",)].functions[0].body.statements
+
+    both_decl = statements[0]
+    assert isinstance(both_decl, SemanticVarDecl)
+    both_target = _assert_call_target(both_decl.initializer, StaticMethodCallTarget)
+    assert both_target.method_id.name == "from_u8_array"
+    assert both_decl.initializer.args[0].literal_text == '"abc"'
+
+    return_stmt = statements[1]
+    assert isinstance(return_stmt, SemanticReturn)
+    concat = return_stmt.value
+    assert isinstance(concat, StrConcatExprS)
+    assert concat.constructor_id == ConstructorId(module_path=("main",), class_name="Str")
+    assert concat.bytes_field_name == "_bytes"
+    assert concat.type_ref.canonical_name == "main::Str"
+    assert [type(part) for part in concat.parts] == [
+        StringLiteralBytesExpr,
+        LocalRefExpr,
+        StringLiteralBytesExpr,
+        LocalRefExpr,
+    ]
+    assert concat.parts[0].literal_text == '"hello dear "'
+    assert concat.parts[2].literal_text == '": "'
+    assert concat.parts[3].type_ref.canonical_name == "i64"
+
+
 def test_lower_program_lowers_array_len_calls_to_explicit_array_len_expr(tmp_path: Path) -> None:
     _write(
         tmp_path / "main.nif",
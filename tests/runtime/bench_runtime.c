@@ -0,0 +1,537 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "runtime.h"
+#include "array.h"
+#include "gc.h"
+#include "gc_tracked_set.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/* Runtime microbenchmarks. Each case times `run` over several repetitions
+ * (NIF_RUNTIME_BENCH_REPEATS, default 7) with `setup` excluded from the timed
+ * region, and prints median and minimum ns/op. NIF_RUNTIME_BENCH_FILTER keeps
+ * only cases whose name contains the given substring.
+ *
+ * The mark/ cases collect a heap whose objects all survive, so their cost is
+ * dominated by marking; the sweep/ cases fix the heap size and vary how much
+ * of it survives.
+ */
+
+enum {
+    BENCH_DEFAULT_REPEATS = 7,
+    BENCH_MAX_REPEATS = 64,
+    BENCH_HEAP_OBJECTS = 100000,
+    BENCH_ARRAY_LEN = 4096,
+    BENCH_TRACKED_SET_OBJECTS = 65536,
+};
+
+
+typedef struct BenchCase {
+    const char* name;
+    void (*setup)(void);
+    uint64_t (*run)(void);
+    void (*teardown)(void);
+} BenchCase;
+
+
+typedef struct NodeObj {
+    RtObjHeader header;
+    void* next;
+    uint64_t value;
+} NodeObj;
+
+
+static const uint32_t NODE_POINTER_OFFSETS[] = {
+    (uint32_t)offsetof(NodeObj, next),
+};
+
+
+static const RtType NODE_TYPE = {
+    .type_id = 0x424E4F44u,
+    .flags = RT_TYPE_FLAG_HAS_REFS,
+    .abi_version = 1u,
+    .align_bytes = 8u,
+    .fixed_size_bytes = sizeof(NodeObj),
+    .debug_name = "BenchNode",
+    .trace_fn = NULL,
+    .pointer_offsets = NODE_POINTER_OFFSETS,
+    .pointer_offsets_count = 1u,
+    .subtype_id_end = 0u,
+    .super_type = NULL,
+    .interface_tables = NULL,
+    .interface_slot_count = 0u,
+    .reserved1 = 0u,
+    .class_vtable = NULL,
+    .class_vtable_count = 0u,
+    .reserved2 = 0u,
+};
+
+
+static const RtType LEAF_TYPE = {
+    .type_id = 0x424C4541u,
+    .flags = RT_TYPE_FLAG_LEAF,
+    .abi_version = 1u,
+    .align_bytes = 8u,
+    .fixed_size_bytes = sizeof(RtObjHeader),
+    .debug_name = "BenchLeaf",
+    .trace_fn = NULL,
+    .pointer_offsets = NULL,
+    .pointer_offsets_count = 0u,
+    .subtype_id_end = 0u,
+    .super_type = NULL,
+    .interface_tables = NULL,
+    .interface_slot_count = 0u,
+    .reserved1 = 0u,
+    .class_vtable = NULL,
+    .class_vtable_count = 0u,
+    .reserved2 = 0u,
+};
+
+
+#define BENCH_CLASS_TYPE(ident, id, subtype_end, parent) \
+    static const RtType ident = { \
+        .type_id = (id), \
+        .flags = RT_TYPE_FLAG_LEAF, \
+        .abi_version = 1u, \
+        .align_bytes = 8u, \
+        .fixed_size_bytes = sizeof(RtObjHeader), \
+        .debug_name = #ident, \
+        .trace_fn = NULL, \
+        .pointer_offsets = NULL, \
+        .pointer_offsets_count = 0u, \
+        .subtype_id_end = (subtype_end), \
+        .super_type = (parent), \
+        .interface_tables = BENCH_INTERFACE_TABLES, \
+        .interface_slot_count = 4u, \
+        .reserved1 = 0u, \
+        .class_vtable = NULL, \
+        .class_vtable_count = 0u, \
+        .reserved2 = 0u, \
+    }
+
+
+static const RtInterfaceType BENCH_INTERFACE = {
+    .debug_name = "BenchInterface",
+    .slot_index = 3u,
+    .method_count = 1u,
+    .reserved0 = 0u,
+};
+
+static const void* BENCH_INTERFACE_METHODS[1] = {
+    (const void*)0x1234,
+};
+
+static const void* BENCH_INTERFACE_TABLES[4] = {
+    NULL,
+    NULL,
+    NULL,
+    BENCH_INTERFACE_METHODS,
+};
+
+BENCH_CLASS_TYPE(CLASS_DEPTH0, 1u, 10u, NULL);
+BENCH_CLASS_TYPE(CLASS_DEPTH1, 2u, 10u, &CLASS_DEPTH0);
+BENCH_CLASS_TYPE(CLASS_DEPTH2, 3u, 10u, &CLASS_DEPTH1);
+BENCH_CLASS_TYPE(CLASS_DEPTH3, 4u, 10u, &CLASS_DEPTH2);
+BENCH_CLASS_TYPE(CLASS_DEPTH4, 5u, 10u, &CLASS_DEPTH3);
+BENCH_CLASS_TYPE(CLASS_DEPTH5, 6u, 10u, &CLASS_DEPTH4);
+BENCH_CLASS_TYPE(CLASS_DEPTH6, 7u, 10u, &CLASS_DEPTH5);
+BENCH_CLASS_TYPE(CLASS_DEPTH7, 8u, 10u, &CLASS_DEPTH6);
+BENCH_CLASS_TYPE(CLASS_DEPTH8, 9u, 10u, &CLASS_DEPTH7);
+BENCH_CLASS_TYPE(CLASS_UNRELATED, 10u, 11u, NULL);
+
+
+static volatile uint64_t g_sink = 0;
+static void* g_root = NULL;
+static void* g_cast_obj = NULL;
+static void* g_array = NULL;
+static RtObjHeader* g_tracked_objs = NULL;
+
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+static void bench_reset_heap(void) {
+    rt_gc_reset_state();
+    g_root = NULL;
+    rt_gc_register_global_root(&g_root);
+}
+
+
+static void bench_release_heap(void) {
+    g_root = NULL;
+    rt_gc_unregister_global_root(&g_root);
+    rt_gc_reset_state();
+}
+
+
+static NodeObj* alloc_node(void* next, uint64_t value) {
+    NodeObj* node = (NodeObj*)rt_alloc_obj(rt_thread_state(), &NODE_TYPE, sizeof(NodeObj) - sizeof(RtObjHeader));
+    node->next = next;
+    node->value = value;
+    return node;
+}
+
+
+static void* alloc_leaf(uint64_t payload_bytes) {
+    return rt_alloc_obj(rt_thread_state(), &LEAF_TYPE, payload_bytes);
+}
+
+
+/* alloc/: unrooted allocations, so the cost includes amortized collection. */
+
+static uint64_t bench_alloc_payload(uint64_t payload_bytes, uint64_t count) {
+    for (uint64_t i = 0; i < count; i++) {
+        g_sink += (uint64_t)(uintptr_t)alloc_leaf(payload_bytes);
+    }
+    return count;
+}
+
+static uint64_t run_alloc_16(void) { return bench_alloc_payload(16u, 200000u); }
+static uint64_t run_alloc_64(void) { return bench_alloc_payload(64u, 200000u); }
+static uint64_t run_alloc_256(void) { return bench_alloc_payload(256u, 100000u); }
+static uint64_t run_alloc_4096(void) { return bench_alloc_payload(4096u, 20000u); }
+
+
+/* mark/: every object is reachable from g_root. */
+
+static void setup_mark_list(void) {
+    bench_reset_heap();
+    for (uint64_t i = 0; i < BENCH_HEAP_OBJECTS; i++) {
+        g_root = alloc_node(g_root, i);
+    }
+}
+
+
+/* Filled top-down so each new array is reachable through its parent before
+ * its own children allocate.
+ */
+static void fill_wide_tree(void* node, uint32_t depth, uint64_t fanout) {
+    for (uint64_t i = 0; i < fanout; i++) {
+        if (depth <= 1u) {
+            rt_array_set_ref(node, (int64_t)i, alloc_leaf(16u));
+            continue;
+        }
+        void* child = rt_array_new_ref(fanout);
+        rt_array_set_ref(node, (int64_t)i, child);
+        fill_wide_tree(child, depth - 1u, fanout);
+    }
+}
+
+
+static void setup_mark_wide_tree(void) {
+    bench_reset_heap();
+    /* fanout 48, depth 3: 1 + 48 + 48^2 arrays plus 48^3 leaves (~113k objects). */
+    g_root = rt_array_new_ref(48u);
+    fill_wide_tree(g_root, 3u, 48u);
+}
+
+
+static void setup_mark_ref_array(void) {
+    bench_reset_heap();
+    g_root = rt_array_new_ref(BENCH_HEAP_OBJECTS);
+    for (uint64_t i = 0; i < BENCH_HEAP_OBJECTS; i++) {
+        rt_array_set_ref(g_root, (int64_t)i, alloc_leaf(16u));
+    }
+}
+
+
+static uint64_t run_collect_all_live(void) {
+    const uint64_t live_objects = rt_gc_get_stats().tracked_object_count;
+    for (int i = 0; i < 5; i++) {
+        rt_gc_collect();
+    }
+    return live_objects * 5u;
+}
+
+
+/* sweep/: a fixed heap where a given fraction survives the timed collection. */
+
+static void setup_sweep(uint64_t survive_every) {
+    bench_reset_heap();
+    g_root = rt_array_new_ref(BENCH_HEAP_OBJECTS);
+    for (uint64_t i = 0; i < BENCH_HEAP_OBJECTS; i++) {
+        rt_array_set_ref(g_root, (int64_t)i, alloc_leaf(16u));
+    }
+    for (uint64_t i = 0; i < BENCH_HEAP_OBJECTS; i++) {
+        if (survive_every == 0u || i % survive_every != 0u) {
+            rt_array_set_ref(g_root, (int64_t)i, NULL);
+        }
+    }
+}
+
+static void setup_sweep_survive_0(void) { setup_sweep(0u); }
+static void setup_sweep_survive_10(void) { setup_sweep(10u); }
+static void setup_sweep_survive_50(void) { setup_sweep(2u); }
+static void setup_sweep_survive_100(void) { setup_sweep(1u); }
+
+
+static uint64_t run_sweep_once(void) {
+    const uint64_t tracked_before = rt_gc_get_stats().tracked_object_count;
+    rt_gc_collect();
+    return tracked_before;
+}
+
+
+/* array/: runtime accessors on a BENCH_ARRAY_LEN element array. */
+
+static void setup_array_i64(void) {
+    bench_reset_heap();
+    g_root = rt_array_new_i64(BENCH_ARRAY_LEN);
+    g_array = g_root;
+}
+
+
+static void setup_array_ref(void) {
+    bench_reset_heap();
+    g_root = rt_array_new_ref(BENCH_ARRAY_LEN);
+    g_array = g_root;
+    for (int64_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+        rt_array_set_ref(g_array, i, alloc_leaf(16u));
+    }
+}
+
+
+static uint64_t run_array_get_i64(void) {
+    int64_t total = 0;
+    for (int rep = 0; rep < 200; rep++) {
+        for (int64_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+            total += rt_array_get_i64(g_array, i);
+        }
+    }
+    g_sink += (uint64_t)total;
+    return 200u * BENCH_ARRAY_LEN;
+}
+
+
+static uint64_t run_array_set_i64(void) {
+    for (int rep = 0; rep < 200; rep++) {
+        for (int64_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+            rt_array_set_i64(g_array, i, i + rep);
+        }
+    }
+    return 200u * BENCH_ARRAY_LEN;
+}
+
+
+static uint64_t run_array_get_ref(void) {
+    uint64_t total = 0;
+    for (int rep = 0; rep < 200; rep++) {
+        for (int64_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+            total += (uint64_t)(uintptr_t)rt_array_get_ref(g_array, i);
+        }
+    }
+    g_sink += total;
+    return 200u * BENCH_ARRAY_LEN;
+}
+
+
+static uint64_t run_array_set_ref(void) {
+    for (int rep = 0; rep < 200; rep++) {
+        for (int64_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+            rt_array_set_ref(g_array, i, rt_array_get_ref(g_array, BENCH_ARRAY_LEN - 1 - i));
+        }
+    }
+    return 200u * BENCH_ARRAY_LEN;
+}
+
+
+static uint64_t run_array_slice_i64_64(void) {
+    for (int64_t i = 0; i < 20000; i++) {
+        const int64_t start = i % (BENCH_ARRAY_LEN - 64);
+        g_sink += (uint64_t)(uintptr_t)rt_array_slice_i64(g_array, start, start + 64);
+    }
+    return 20000u;
+}
+
+
+/* tracked_set/: direct insert/contains on synthetic headers. */
+
+static void setup_tracked_set(void) {
+    rt_gc_reset_state();
+    rt_gc_tracked_set_reset();
+    g_tracked_objs = (RtObjHeader*)calloc(BENCH_TRACKED_SET_OBJECTS, sizeof(RtObjHeader));
+    if (g_tracked_objs == NULL) {
+        fprintf(stderr, "bench_runtime: out of memory\n");
+        exit(1);
+    }
+}
+
+
+static void setup_tracked_set_filled(void) {
+    setup_tracked_set();
+    for (uint64_t i = 0; i < BENCH_TRACKED_SET_OBJECTS; i++) {
+        rt_gc_tracked_set_insert(&g_tracked_objs[i]);
+    }
+}
+
+
+static void teardown_tracked_set(void) {
+    rt_gc_tracked_set_reset();
+    free(g_tracked_objs);
+    g_tracked_objs = NULL;
+}
+
+
+static uint64_t run_tracked_set_insert(void) {
+    for (uint64_t i = 0; i < BENCH_TRACKED_SET_OBJECTS; i++) {
+        rt_gc_tracked_set_insert(&g_tracked_objs[i]);
+    }
+    return BENCH_TRACKED_SET_OBJECTS;
+}
+
+
+static uint64_t run_tracked_set_contains(void) {
+    uint64_t hits = 0;
+    for (int rep = 0; rep < 8; rep++) {
+        for (uint64_t i = 0; i < BENCH_TRACKED_SET_OBJECTS; i++) {
+            hits += (uint64_t)rt_gc_tracked_set_contains(&g_tracked_objs[i]);
+        }
+    }
+    g_sink += hits;
+    return 8u * BENCH_TRACKED_SET_OBJECTS;
+}
+
+
+/* cast/: class casts compare preorder type-id ranges; interface casts mirror the generated
+ * code's slot lookup in RtType.interface_tables.
+ */
+
+static void setup_cast(void) {
+    bench_reset_heap();
+    g_root = alloc_leaf(0u);
+    ((RtObjHeader*)g_root)->type = &CLASS_DEPTH8;
+    g_cast_obj = g_root;
+}
+
+
+static uint64_t bench_checked_cast(const RtType* expected) {
+    for (int i = 0; i < 1000000; i++) {
+        g_sink += (uint64_t)(uintptr_t)rt_checked_cast(g_cast_obj, expected);
+    }
+    return 1000000u;
+}
+
+static uint64_t run_cast_exact(void) { return bench_checked_cast(&CLASS_DEPTH8); }
+static uint64_t run_cast_depth4(void) { return bench_checked_cast(&CLASS_DEPTH4); }
+static uint64_t run_cast_depth8(void) { return bench_checked_cast(&CLASS_DEPTH0); }
+
+
+static uint64_t run_cast_instance_miss(void) {
+    uint64_t hits = 0;
+    for (int i = 0; i < 1000000; i++) {
+        hits += rt_is_instance_of_type(g_cast_obj, &CLASS_UNRELATED);
+    }
+    g_sink += hits;
+    return 1000000u;
+}
+
+
+static uint64_t run_cast_interface_lookup(void) {
+    uint64_t total = 0;
+    for (int i = 0; i < 1000000; i++) {
+        const RtType* type = ((RtObjHeader*)g_cast_obj)->type;
+        const void* table = BENCH_INTERFACE.slot_index < type->interface_slot_count
+            ? type->interface_tables[BENCH_INTERFACE.slot_index]
+            : NULL;
+        total += (uint64_t)(uintptr_t)table;
+    }
+    g_sink += total;
+    return 1000000u;
+}
+
+
+static const BenchCase BENCH_CASES[] = {
+    {"alloc/payload=16", bench_reset_heap, run_alloc_16, bench_release_heap},
+    {"alloc/payload=64", bench_reset_heap, run_alloc_64, bench_release_heap},
+    {"alloc/payload=256", bench_reset_heap, run_alloc_256, bench_release_heap},
+    {"alloc/payload=4096", bench_reset_heap, run_alloc_4096, bench_release_heap},
+    {"mark/list", setup_mark_list, run_collect_all_live, bench_release_heap},
+    {"mark/wide_tree", setup_mark_wide_tree, run_collect_all_live, bench_release_heap},
+    {"mark/ref_array", setup_mark_ref_array, run_collect_all_live, bench_release_heap},
+    {"sweep/survive=0%", setup_sweep_survive_0, run_sweep_once, bench_release_heap},
+    {"sweep/survive=10%", setup_sweep_survive_10, run_sweep_once, bench_release_heap},
+    {"sweep/survive=50%", setup_sweep_survive_50, run_sweep_once, bench_release_heap},
+    {"sweep/survive=100%", setup_sweep_survive_100, run_sweep_once, bench_release_heap},
+    {"array/get_i64", setup_array_i64, run_array_get_i64, bench_release_heap},
+    {"array/set_i64", setup_array_i64, run_array_set_i64, bench_release_heap},
+    {"array/get_ref", setup_array_ref, run_array_get_ref, bench_release_heap},
+    {"array/set_ref", setup_array_ref, run_array_set_ref, bench_release_heap},
+    {"array/slice_i64_len=64", setup_array_i64, run_array_slice_i64_64, bench_release_heap},
+    {"tracked_set/insert", setup_tracked_set, run_tracked_set_insert, teardown_tracked_set},
+    {"tracked_set/contains", setup_tracked_set_filled, run_tracked_set_contains, teardown_tracked_set},
+    {"cast/class_exact", setup_cast, run_cast_exact, bench_release_heap},
+    {"cast/class_depth=4", setup_cast, run_cast_depth4, bench_release_heap},
+    {"cast/class_depth=8", setup_cast, run_cast_depth8, bench_release_heap},
+    {"cast/instance_miss", setup_cast, run_cast_instance_miss, bench_release_heap},
+    {"cast/interface_lookup", setup_cast, run_cast_interface_lookup, bench_release_heap},
+};
+
+
+static int compare_double(const void* lhs, const void* rhs) {
+    const double a = *(const double*)lhs;
+    const double b = *(const double*)rhs;
+    return (a > b) - (a < b);
+}
+
+
+static int bench_repeats(void) {
+    const char* value = getenv("NIF_RUNTIME_BENCH_REPEATS");
+    if (value == NULL || value[0] == '\0') {
+        return BENCH_DEFAULT_REPEATS;
+    }
+    const int parsed = atoi(value);
+    if (parsed < 1) {
+        return 1;
+    }
+    return parsed > BENCH_MAX_REPEATS ? BENCH_MAX_REPEATS : parsed;
+}
+
+
+static void run_case(const BenchCase* bench_case, int repeats) {
+    double ns_per_op[BENCH_MAX_REPEATS];
+    uint64_t ops = 0;
+    for (int rep = 0; rep < repeats; rep++) {
+        bench_case->setup();
+        const uint64_t start_ns = bench_now_ns();
+        ops = bench_case->run();
+        const uint64_t elapsed_ns = bench_now_ns() - start_ns;
+        bench_case->teardown();
+        ns_per_op[rep] = ops == 0u ? 0.0 : (double)elapsed_ns / (double)ops;
+    }
+    qsort(ns_per_op, (size_t)repeats, sizeof(double), compare_double);
+    printf(
+        "%-26s %12.2f %12.2f %12llu\n",
+        bench_case->name,
+        ns_per_op[repeats / 2],
+        ns_per_op[0],
+        (unsigned long long)ops
+    );
+}
+
+
+int main(void) {
+    rt_init();
+
+    const char* filter = getenv("NIF_RUNTIME_BENCH_FILTER");
+    const int repeats = bench_repeats();
+    printf("%-26s %12s %12s %12s\n", "case", "median_ns_op", "min_ns_op", "ops");
+    for (size_t i = 0; i < sizeof(BENCH_CASES) / sizeof(BENCH_CASES[0]); i++) {
+        if (filter != NULL && filter[0] != '\0' && strstr(BENCH_CASES[i].name, filter) == NULL) {
+            continue;
+        }
+        run_case(&BENCH_CASES[i], repeats);
+    }
+
+    rt_shutdown();
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "runtime.h"
+#include "alloc_profile.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+typedef struct LeafObj {
+    RtObjHeader header;
+    uint64_t value;
+} LeafObj;
+
+
+static const RtType LEAF_TYPE = {
+    .type_id = 301,
+    .flags = RT_TYPE_FLAG_LEAF,
+    .abi_version = 1,
+    .align_bytes = 8,
+    .fixed_size_bytes = sizeof(LeafObj),
+    .debug_name = "ProfileLeaf",
+    .trace_fn = NULL,
+    .pointer_offsets = NULL,
+    .pointer_offsets_count = 0,
+    .subtype_id_end = 0,
+    .super_type = NULL,
+    .interface_tables = NULL,
+    .interface_slot_count = 0,
+    .reserved1 = 0,
+    .class_vtable = NULL,
+    .class_vtable_count = 0,
+    .reserved2 = 0,
+};
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_alloc_profile: %s\n", message);
+    exit(1);
+}
+
+
+static void assert_u64_eq(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_alloc_profile: %s (actual=%llu expected=%llu)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+
+static LeafObj* alloc_leaf(uint64_t value) {
+    uint64_t payload = sizeof(LeafObj) - sizeof(RtObjHeader);
+    LeafObj* leaf = (LeafObj*)rt_alloc_obj(rt_thread_state(), &LEAF_TYPE, payload);
+    leaf->value = value;
+    return leaf;
+}
+
+
+static LeafObj* alloc_leaf_at_line(uint32_t line) {
+    rt_trace_set_location(line, 1);
+    return alloc_leaf(line);
+}
+
+
+static void test_disabled_profiler_does_not_tag_objects(void) {
+    rt_gc_reset_state();
+    rt_alloc_profile_configure(0, 4);
+
+    LeafObj* leaf = alloc_leaf(1);
+    assert_u64_eq(leaf->header.reserved0, 0, "disabled profiler should leave reserved0 untouched");
+
+    RtAllocProfileStats stats = rt_alloc_profile_get_stats();
+    assert_u64_eq(stats.sampled_objects, 0, "disabled profiler should not sample allocations");
+    assert_u64_eq(stats.site_count, 0, "disabled profiler should not intern sites");
+
+    rt_gc_reset_state();
+}
+
+
+static void test_interval_one_samples_every_allocation_by_site(void) {
+    rt_gc_reset_state();
+    rt_alloc_profile_configure(1, 2);
+
+    rt_trace_push("outer", "profile.nif", 10, 1);
+    rt_trace_push("inner", "profile.nif", 20, 1);
+    for (uint32_t i = 0; i < 6; i++) {
+        alloc_leaf_at_line(21);
+    }
+    for (uint32_t i = 0; i < 3; i++) {
+        alloc_leaf_at_line(22);
+    }
+    rt_trace_pop();
+    rt_trace_pop();
+
+    RtAllocProfileStats stats = rt_alloc_profile_get_stats();
+    assert_u64_eq(stats.sampled_objects, 9, "interval=1 should sample every allocation");
+    assert_u64_eq(stats.sampled_bytes, 9 * sizeof(LeafObj), "sampled bytes should cover every allocation");
+    assert_u64_eq(stats.site_count, 2, "distinct call lines should intern distinct sites");
+    assert_u64_eq(stats.live_samples, 9, "all samples should be live before collection");
+
+    rt_gc_reset_state();
+    stats = rt_alloc_profile_get_stats();
+    assert_u64_eq(stats.site_count, 0, "gc reset should clear profiler sites");
+    assert_u64_eq(stats.live_samples, 0, "gc reset should clear live samples");
+}
+
+
+static void test_survivors_are_counted_once_and_freed_samples_are_dropped(void) {
+    rt_gc_reset_state();
+    rt_alloc_profile_configure(1, 1);
+
+    void* kept = alloc_leaf(1);
+    rt_gc_register_global_root(&kept);
+    for (uint32_t i = 0; i < 4; i++) {
+        alloc_leaf(100 + i);
+    }
+
+    rt_gc_collect();
+    RtAllocProfileStats stats = rt_alloc_profile_get_stats();
+    assert_u64_eq(stats.live_samples, 1, "collection should drop samples for freed objects");
+    assert_u64_eq(stats.survivor_samples, 1, "rooted sample should count as a survivor");
+    if (((RtObjHeader*)kept)->reserved0 != 1u) {
+        fail("surviving sample should be compacted into the first sample slot");
+    }
+
+    rt_gc_collect();
+    stats = rt_alloc_profile_get_stats();
+    assert_u64_eq(stats.survivor_samples, 1, "a sample should only count as a survivor once");
+
+    rt_gc_unregister_global_root(&kept);
+    rt_gc_collect();
+    stats = rt_alloc_profile_get_stats();
+    assert_u64_eq(stats.live_samples, 0, "unrooted survivor should be dropped after collection");
+    assert_u64_eq(stats.sampled_objects, 5, "sampled-object totals should persist across collections");
+
+    rt_gc_reset_state();
+}
+
+
+static void test_poisson_sampling_is_sparse_for_large_intervals(void) {
+    rt_gc_reset_state();
+    rt_alloc_profile_configure(64u * 1024u, 4);
+
+    const uint64_t allocation_count = 20000;
+    for (uint64_t i = 0; i < allocation_count; i++) {
+        alloc_leaf(i);
+    }
+
+    RtAllocProfileStats stats = rt_alloc_profile_get_stats();
+    const uint64_t total_bytes = allocation_count * sizeof(LeafObj);
+    const uint64_t expected_samples = total_bytes / (64u * 1024u);
+    if (stats.sampled_objects == 0 || stats.sampled_objects > expected_samples * 3u) {
+        fprintf(
+            stderr,
+            "test_alloc_profile: sample count out of range (actual=%llu expected~%llu)\n",
+            (unsigned long long)stats.sampled_objects,
+            (unsigned long long)expected_samples
+        );
+        exit(1);
+    }
+
+    rt_gc_reset_state();
+}
+
+
+int main(void) {
+    rt_init();
+
+    test_disabled_profiler_does_not_tag_objects();
+    test_interval_one_samples_every_allocation_by_site();
+    test_survivors_are_counted_once_and_freed_samples_are_dropped();
+    test_poisson_sampling_is_sparse_for_large_intervals();
+
+    rt_shutdown();
+    puts("test_alloc_profile: ok");
+    return 0;
+}
@@ -23,7 +23,7 @@ static const RtType LEAF_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0u,
@@ -196,6 +196,68 @@ static void test_ref_array_alias_and_overwrite_gc_semantics(void) {
     assert_u64_eq(cleared.tracked_object_count, 0u, "dropping array root should reclaim ref array after alias clears");
 }
 
+static void test_idiom_fill_kernels_stop_at_array_end(void) {
+    void* arr = rt_array_new_i64(4u);
+    assert_u64_eq((uint64_t)rt_array_fill_i64(arr, 1, 3, 5), 3u, "fill should stop at requested end");
+    assert_u64_eq((uint64_t)rt_array_get_i64(arr, 0), 0u, "fill should not touch slots before start");
+    assert_u64_eq((uint64_t)rt_array_get_i64(arr, 2), 5u, "fill should write slots inside range");
+    assert_u64_eq((uint64_t)rt_array_get_i64(arr, 3), 0u, "fill should not touch slots after end");
+    assert_u64_eq((uint64_t)rt_array_fill_i64(arr, 2, 9, 7), 4u, "fill should stop at array length");
+    assert_u64_eq((uint64_t)rt_array_get_i64(arr, 3), 7u, "fill should write up to array length");
+    assert_u64_eq((uint64_t)rt_array_fill_i64(arr, -1, 3, 1), (uint64_t)-1, "fill should not start at negative index");
+    assert_u64_eq((uint64_t)rt_array_fill_i64(NULL, 0, 3, 1), 0u, "fill should leave null arrays to the caller");
+
+    void* bytes = rt_array_new_u8(5u);
+    assert_u64_eq((uint64_t)rt_array_fill_u8(bytes, 0, 5, 0x1FFu), 5u, "u8 fill should cover whole array");
+    assert_u64_eq(rt_array_get_u8(bytes, 4), 0xFFu, "u8 fill should truncate value");
+
+    void* flags = rt_array_new_bool(2u);
+    rt_array_fill_bool(flags, 0, 2, 42);
+    assert_u64_eq((uint64_t)rt_array_get_bool(flags, 1), 1u, "bool fill should normalize value");
+}
+
+static void test_idiom_copy_and_mismatch_kernels(void) {
+    void* source = rt_array_new_u64(600u);
+    void* target = rt_array_new_u64(400u);
+    for (int64_t index = 0; index < 600; index++) {
+        rt_array_set_u64(source, index, (uint64_t)index * 3u);
+    }
+
+    assert_u64_eq((uint64_t)rt_array_copy_range(target, source, 10, 600), 400u, "copy should stop at shorter array");
+    assert_u64_eq(rt_array_get_u64(target, 9), 0u, "copy should not touch slots before start");
+    assert_u64_eq(rt_array_get_u64(target, 399), 1197u, "copy should move last in-bounds slot");
+
+    assert_u64_eq((uint64_t)rt_array_mismatch_range(target, source, 10, 400), 400u, "equal ranges should reach end");
+    assert_u64_eq((uint64_t)rt_array_mismatch_range(target, source, 0, 400), 1u, "mismatch should report first difference");
+    rt_array_set_u64(target, 300, 1u);
+    assert_u64_eq((uint64_t)rt_array_mismatch_range(target, source, 10, 600), 300u, "mismatch should scan past chunk boundaries");
+    assert_u64_eq((uint64_t)rt_array_mismatch_range(target, NULL, 10, 600), 10u, "mismatch should leave null arrays to the caller");
+}
+
+static void test_idiom_ref_fill_keeps_value_alive(void) {
+    RtThreadState* ts = rt_thread_state();
+    RtRootFrame frame;
+    void* slots[1] = {NULL};
+    rt_dbg_root_frame_init(&frame, slots, 1);
+    rt_dbg_push_roots(ts, &frame);
+
+    void* arr = rt_array_new_ref(3u);
+    rt_dbg_root_slot_store(&frame, 0, arr);
+    rt_array_fill_ref(arr, 0, 3, alloc_leaf(5u));
+    rt_gc_collect();
+    RtGcStats filled = rt_gc_get_stats();
+    assert_u64_eq(filled.tracked_object_count, 2u, "filled ref array should keep shared value alive");
+
+    rt_array_fill_ref(arr, 0, 3, NULL);
+    rt_gc_collect();
+    RtGcStats cleared = rt_gc_get_stats();
+    assert_u64_eq(cleared.tracked_object_count, 1u, "null fill should release previous values");
+
+    rt_dbg_root_slot_store(&frame, 0, NULL);
+    rt_dbg_pop_roots(ts);
+    rt_gc_collect();
+}
+
 int main(void) {
     rt_init();
 
@@ -204,6 +266,9 @@ int main(void) {
     test_ref_array_gc_tracing();
     test_ref_slice_copy_independence();
     test_ref_array_alias_and_overwrite_gc_semantics();
+    test_idiom_fill_kernels_stop_at_array_end();
+    test_idiom_copy_and_mismatch_kernels();
+    test_idiom_ref_fill_keeps_value_alive();
 
     rt_shutdown();
     puts("test_array_runtime: ok");
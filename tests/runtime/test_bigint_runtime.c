@@ -0,0 +1,288 @@
+#include "runtime_dbg.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+enum {
+    ROOT_SLOT_COUNT = 32,
+};
+
+static RtRootFrame g_frame;
+static void* g_slots[ROOT_SLOT_COUNT];
+static uint32_t g_next_slot = 0u;
+static uint64_t g_random_state = 0x9e3779b97f4a7c15u;
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_bigint_runtime: %s\n", message);
+    exit(1);
+}
+
+static void assert_u64(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_bigint_runtime: %s (actual=%llu expected=%llu)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+static void assert_true(int condition, const char* message) {
+    if (!condition) {
+        fail(message);
+    }
+}
+
+static uint64_t next_random(void) {
+    g_random_state ^= g_random_state << 13;
+    g_random_state ^= g_random_state >> 7;
+    g_random_state ^= g_random_state << 17;
+    return g_random_state;
+}
+
+static void release_roots(void) {
+    for (uint32_t i = 0u; i < g_next_slot; i++) {
+        rt_dbg_root_slot_store(&g_frame, i, NULL);
+    }
+    g_next_slot = 0u;
+}
+
+static void* keep_alive(void* obj) {
+    if (g_next_slot == ROOT_SLOT_COUNT) {
+        fail("test ran out of root slots");
+    }
+    rt_dbg_root_slot_store(&g_frame, g_next_slot, obj);
+    g_next_slot++;
+    return obj;
+}
+
+static void* new_limbs(uint64_t len) {
+    return keep_alive(rt_array_new_u64(len));
+}
+
+static uint64_t* limbs_of(void* limbs_obj) {
+    return (uint64_t*)rt_array_data_ptr(limbs_obj);
+}
+
+/* Random value with exactly len limbs (top limb nonzero). */
+static void* random_limbs(uint64_t len) {
+    void* limbs_obj = new_limbs(len);
+    uint64_t* limbs = limbs_of(limbs_obj);
+    for (uint64_t i = 0u; i < len; i++) {
+        limbs[i] = next_random();
+    }
+    if (len > 0u && limbs[len - 1u] == 0u) {
+        limbs[len - 1u] = 1u;
+    }
+    return limbs_obj;
+}
+
+static void* limbs_from_u64(uint64_t value) {
+    void* limbs_obj = new_limbs(1u);
+    limbs_of(limbs_obj)[0] = value;
+    return limbs_obj;
+}
+
+static void* u8_text(const char* text) {
+    return keep_alive(rt_array_from_bytes_u8((const uint8_t*)text, (uint64_t)strlen(text)));
+}
+
+static void assert_same_magnitude(void* actual_obj, void* expected_obj, const char* message) {
+    assert_true(rt_bigint_compare(actual_obj, expected_obj) == 0, message);
+}
+
+/* Reference product kept independent of the runtime kernels. */
+static void* reference_mul(void* left_obj, void* right_obj) {
+    const uint64_t left_len = rt_array_len(left_obj);
+    const uint64_t right_len = rt_array_len(right_obj);
+    void* out_obj = new_limbs(left_len + right_len);
+    const uint64_t* left = limbs_of(left_obj);
+    const uint64_t* right = limbs_of(right_obj);
+    uint64_t* out = limbs_of(out_obj);
+    for (uint64_t i = 0u; i < left_len; i++) {
+        uint64_t carry = 0u;
+        for (uint64_t j = 0u; j < right_len; j++) {
+            const unsigned __int128 product = (unsigned __int128)left[i] * right[j] + out[i + j] + carry;
+            out[i + j] = (uint64_t)product;
+            carry = (uint64_t)(product >> 64);
+        }
+        out[i + right_len] = carry;
+    }
+    return out_obj;
+}
+
+static void test_add_sub_and_compare_track_carries(void) {
+    void* max_word = limbs_from_u64(UINT64_MAX);
+    void* one = limbs_from_u64(1u);
+    void* sum = new_limbs(2u);
+    assert_u64(rt_bigint_add(sum, max_word, one), 2u, "2^64 should use two limbs");
+    assert_u64(limbs_of(sum)[0], 0u, "2^64 low limb");
+    assert_u64(limbs_of(sum)[1], 1u, "2^64 high limb");
+    assert_true(rt_bigint_compare(sum, max_word) > 0, "2^64 should exceed 2^64 - 1");
+    assert_true(rt_bigint_compare(one, sum) < 0, "one should be below 2^64");
+
+    void* back = new_limbs(2u);
+    assert_u64(rt_bigint_sub(back, sum, one), 1u, "2^64 - 1 should trim to one limb");
+    assert_same_magnitude(back, max_word, "subtraction should undo addition");
+
+    void* left = random_limbs(70u);
+    void* right = random_limbs(33u);
+    void* total = new_limbs(71u);
+    rt_bigint_add(total, left, right);
+    void* difference = new_limbs(71u);
+    rt_bigint_sub(difference, total, right);
+    assert_same_magnitude(difference, left, "(a + b) - b should equal a");
+    release_roots();
+}
+
+static void test_mul_matches_reference_across_thresholds(void) {
+    static const uint64_t shapes[][2] = {
+        {1u, 1u}, {5u, 3u}, {31u, 31u}, {32u, 32u}, {40u, 40u}, {101u, 100u}, {300u, 37u}, {257u, 129u}, {600u, 600u},
+    };
+    for (size_t i = 0u; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+        void* left = random_limbs(shapes[i][0]);
+        void* right = random_limbs(shapes[i][1]);
+        void* product = new_limbs(shapes[i][0] + shapes[i][1]);
+        const uint64_t used = rt_bigint_mul(product, left, right);
+        void* expected = reference_mul(left, right);
+        assert_true(used >= shapes[i][0] + shapes[i][1] - 1u, "product should keep its top limbs");
+        assert_same_magnitude(product, expected, "kernel product should match schoolbook reference");
+        release_roots();
+    }
+
+    void* all_ones = new_limbs(96u);
+    memset(limbs_of(all_ones), 0xff, 96u * sizeof(uint64_t));
+    void* square = new_limbs(192u);
+    rt_bigint_mul(square, all_ones, all_ones);
+    assert_same_magnitude(square, reference_mul(all_ones, all_ones), "all-ones square should carry through every limb");
+    release_roots();
+}
+
+static void check_divrem(void* quotient_expected, void* divisor, void* remainder_expected, const char* message) {
+    const uint64_t quotient_len = rt_array_len(quotient_expected);
+    const uint64_t divisor_len = rt_array_len(divisor);
+    void* product = new_limbs(quotient_len + divisor_len);
+    rt_bigint_mul(product, quotient_expected, divisor);
+    void* numerator = new_limbs(quotient_len + divisor_len + 1u);
+    rt_bigint_add(numerator, product, remainder_expected);
+
+    void* quotient = new_limbs(quotient_len + 2u);
+    void* remainder = new_limbs(divisor_len);
+    rt_bigint_divrem(quotient, remainder, numerator, divisor);
+    assert_same_magnitude(quotient, quotient_expected, message);
+    assert_same_magnitude(remainder, remainder_expected, message);
+}
+
+static void test_divrem_recovers_quotient_and_remainder(void) {
+    static const uint64_t shapes[][2] = {
+        {1u, 1u}, {9u, 1u}, {3u, 2u}, {50u, 10u}, {200u, 60u}, {60u, 200u}, {130u, 130u}, {400u, 97u}, {97u, 400u},
+    };
+    for (size_t i = 0u; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+        void* quotient = random_limbs(shapes[i][0]);
+        void* divisor = random_limbs(shapes[i][1]);
+        void* remainder = new_limbs(shapes[i][1]);
+        if (shapes[i][1] == 1u) {
+            limbs_of(remainder)[0] = next_random() % limbs_of(divisor)[0];
+        } else {
+            memcpy(limbs_of(remainder), limbs_of(random_limbs(shapes[i][1] - 1u)), (shapes[i][1] - 1u) * sizeof(uint64_t));
+        }
+        check_divrem(quotient, divisor, remainder, "divrem should invert q * d + r");
+        release_roots();
+    }
+
+    /* Divisors whose high limbs match the numerator's exercise the saturated quotient estimate. */
+    void* all_ones = new_limbs(150u);
+    memset(limbs_of(all_ones), 0xff, 150u * sizeof(uint64_t));
+    void* remainder = new_limbs(150u);
+    memset(limbs_of(remainder), 0xff, 149u * sizeof(uint64_t));
+    check_divrem(all_ones, all_ones, remainder, "all-ones operands should divide exactly");
+    release_roots();
+
+    void* small = limbs_from_u64(7u);
+    void* large = random_limbs(3u);
+    void* quotient = new_limbs(1u);
+    void* small_remainder = new_limbs(1u);
+    rt_bigint_divrem(quotient, small_remainder, small, large);
+    assert_u64(limbs_of(quotient)[0], 0u, "smaller numerator should have zero quotient");
+    assert_u64(limbs_of(small_remainder)[0], 7u, "smaller numerator should be its own remainder");
+
+    void* word_quotient = new_limbs(3u);
+    const uint64_t word_remainder = rt_bigint_divrem_word(word_quotient, large, 10u);
+    void* rebuilt = new_limbs(4u);
+    rt_bigint_mul_word_add(rebuilt, word_quotient, 10u, word_remainder);
+    assert_same_magnitude(rebuilt, large, "divrem_word and mul_word_add should round-trip");
+    release_roots();
+}
+
+static void test_decimal_conversion_round_trips(void) {
+    void* zero = new_limbs(0u);
+    void* text = keep_alive(rt_array_new_u8(1u));
+    assert_u64(rt_bigint_to_decimal(text, zero), 1u, "zero should render as one digit");
+    assert_u64(((const uint8_t*)rt_array_data_ptr(text))[0], '0', "zero should render as 0");
+
+    void* two_pow_64 = new_limbs(2u);
+    limbs_of(two_pow_64)[1] = 1u;
+    void* two_pow_64_text = keep_alive(rt_array_new_u8(40u));
+    const uint64_t digits = rt_bigint_to_decimal(two_pow_64_text, two_pow_64);
+    assert_u64(digits, 20u, "2^64 should have 20 digits");
+    assert_true(memcmp(rt_array_data_ptr(two_pow_64_text), "18446744073709551616", 20u) == 0, "2^64 digits");
+
+    void* padded = u8_text("x00018446744073709551616");
+    void* parsed = new_limbs(2u);
+    assert_u64(rt_bigint_from_decimal(parsed, padded, 1u, 24u), 2u, "leading zeros should not add limbs");
+    assert_same_magnitude(parsed, two_pow_64, "parsing 2^64 should skip leading zeros");
+    release_roots();
+
+    static const uint64_t sizes[] = {1u, 24u, 25u, 200u, 1500u};
+    for (size_t i = 0u; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        void* value = random_limbs(sizes[i]);
+        void* none = new_limbs(0u);
+        void* rendered = keep_alive(rt_array_new_u8(sizes[i] * 20u));
+        const uint64_t count = rt_bigint_to_decimal(rendered, value);
+        const uint8_t* rendered_digits = (const uint8_t*)rt_array_data_ptr(rendered);
+        assert_true(rendered_digits[0] != '0', "rendered digits should not have leading zeros");
+
+        /* Peel 19-digit chunks with the word kernel as an independent reference. */
+        void* remaining = new_limbs(sizes[i]);
+        memcpy(limbs_of(remaining), limbs_of(value), sizes[i] * sizeof(uint64_t));
+        uint64_t position = count;
+        while (rt_bigint_compare(remaining, none) != 0) {
+            uint64_t chunk = rt_bigint_divrem_word(remaining, remaining, 10000000000000000000u);
+            for (int digit = 0; digit < 19 && position > 0u; digit++) {
+                position--;
+                if (rendered_digits[position] != (uint8_t)('0' + chunk % 10u)) {
+                    fail("divide-and-conquer digits should match word-by-word conversion");
+                }
+                chunk /= 10u;
+            }
+        }
+
+        void* reparsed = new_limbs(count / 19u + 1u);
+        rt_bigint_from_decimal(reparsed, rendered, 0u, count);
+        assert_same_magnitude(reparsed, value, "decimal text should parse back to the same value");
+        release_roots();
+    }
+}
+
+int main(void) {
+    rt_init();
+    rt_dbg_root_frame_init(&g_frame, g_slots, ROOT_SLOT_COUNT);
+    rt_dbg_push_roots(rt_thread_state(), &g_frame);
+
+    test_add_sub_and_compare_track_carries();
+    test_mul_matches_reference_across_thresholds();
+    test_divrem_recovers_quotient_and_remainder();
+    test_decimal_conversion_round_trips();
+
+    rt_dbg_pop_roots(rt_thread_state());
+    rt_shutdown();
+    puts("test_bigint_runtime: ok");
+    return 0;
+}
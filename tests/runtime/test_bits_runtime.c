@@ -0,0 +1,86 @@
+#include "runtime.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_bits_runtime: %s\n", message);
+    exit(1);
+}
+
+static void assert_u64(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_bits_runtime: %s (actual=0x%016llx expected=0x%016llx)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+static void assert_true(int condition, const char* message) {
+    if (!condition) {
+        fail(message);
+    }
+}
+
+static void test_popcount_detects_popcnt_on_first_use(void) {
+    assert_true(rt_cpu_has_popcnt == 0u, "POPCNT detection should wait for the first popcount call");
+    assert_u64(rt_bits_popcount(0u), 0u, "popcount of zero");
+#if defined(__x86_64__) && defined(__POPCNT__)
+    assert_true(rt_cpu_has_popcnt == 1u, "POPCNT detection should report a CPU the runtime was built for");
+#endif
+    assert_true(rt_cpu_has_popcnt <= 1u, "POPCNT detection should store a boolean");
+    assert_u64(rt_bits_popcount(UINT64_MAX), 64u, "popcount of all ones");
+    assert_u64(rt_bits_popcount(0x8000000000000001u), 2u, "popcount of both edge bits");
+    assert_u64(rt_bits_popcount(0x0123456789abcdefu), 32u, "popcount of mixed nibbles");
+}
+
+static void test_leading_and_trailing_zero_counts_define_zero_as_width(void) {
+    assert_u64(rt_bits_clz(0u), 64u, "clz of zero should be the bit width");
+    assert_u64(rt_bits_ctz(0u), 64u, "ctz of zero should be the bit width");
+    assert_u64(rt_bits_clz(1u), 63u, "clz of one");
+    assert_u64(rt_bits_ctz(1u), 0u, "ctz of one");
+    assert_u64(rt_bits_clz(0x8000000000000000u), 0u, "clz of the top bit");
+    assert_u64(rt_bits_ctz(0x8000000000000000u), 63u, "ctz of the top bit");
+    assert_u64(rt_bits_clz(0x0000010000000000u), 23u, "clz of a middle bit");
+    assert_u64(rt_bits_ctz(0x0000010000000000u), 40u, "ctz of a middle bit");
+}
+
+static void test_rotates_take_amount_modulo_width(void) {
+    assert_u64(rt_bits_rotl(0x8000000000000001u, 1u), 0x0000000000000003u, "rotl should wrap the top bit");
+    assert_u64(rt_bits_rotr(0x8000000000000001u, 1u), 0xc000000000000000u, "rotr should wrap the low bit");
+    assert_u64(rt_bits_rotl(0x0123456789abcdefu, 0u), 0x0123456789abcdefu, "rotl by zero is identity");
+    assert_u64(rt_bits_rotr(0x0123456789abcdefu, 64u), 0x0123456789abcdefu, "rotr by the width is identity");
+    assert_u64(rt_bits_rotl(0x0123456789abcdefu, 68u), 0x123456789abcdef0u, "rotl should reduce amount mod 64");
+    assert_u64(rt_bits_rotr(0x0123456789abcdefu, 4u), 0xf0123456789abcdeu, "rotr by a nibble");
+}
+
+static void test_bswap_and_mulhi(void) {
+    assert_u64(rt_bits_bswap(0x0123456789abcdefu), 0xefcdab8967452301u, "bswap should reverse bytes");
+    assert_u64(rt_bits_mulhi(UINT64_MAX, UINT64_MAX), 0xfffffffffffffffeu, "mulhi of max operands");
+    assert_u64(rt_bits_mulhi(UINT64_C(1) << 32, UINT64_C(1) << 32), 1u, "mulhi should carry the 2^64 bit");
+    assert_u64(rt_bits_mulhi(0x0123456789abcdefu, 3u), 0u, "mulhi of a small product");
+    assert_u64(
+        rt_bits_mulhi(0xfedcba9876543210u, 0x0123456789abcdefu),
+        (uint64_t)(((unsigned __int128)0xfedcba9876543210u * 0x0123456789abcdefu) >> 64),
+        "mulhi should match a 128-bit product"
+    );
+}
+
+int main(void) {
+    rt_init();
+
+    test_popcount_detects_popcnt_on_first_use();
+    test_leading_and_trailing_zero_counts_define_zero_as_width();
+    test_rotates_take_amount_modulo_width();
+    test_bswap_and_mulhi();
+
+    rt_shutdown();
+    puts("test_bits_runtime: ok");
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "runtime_dbg.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+enum {
+    ROOT_SLOT_COUNT = 4,
+};
+
+static RtRootFrame g_frame;
+static void* g_slots[ROOT_SLOT_COUNT];
+static uint64_t g_random_state = 0x9e3779b97f4a7c15u;
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_bitset_runtime: %s\n", message);
+    exit(1);
+}
+
+static void assert_i64(int64_t actual, int64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_bitset_runtime: %s (actual=%lld expected=%lld)\n",
+            message,
+            (long long)actual,
+            (long long)expected
+        );
+        exit(1);
+    }
+}
+
+static uint64_t next_random(void) {
+    g_random_state ^= g_random_state << 13;
+    g_random_state ^= g_random_state >> 7;
+    g_random_state ^= g_random_state << 17;
+    return g_random_state;
+}
+
+static uint64_t reference_popcount(uint64_t value) {
+    uint64_t count = 0u;
+    while (value != 0u) {
+        value &= value - 1u;
+        count++;
+    }
+    return count;
+}
+
+/* Every length from 0 to 9 words covers the vector loop, the scalar tail, and both together. */
+static void test_binary_ops_match_scalar_reference(void) {
+    for (uint64_t len = 0u; len <= 9u; len++) {
+        for (unsigned op = 0u; op < 4u; op++) {
+            void* target = rt_array_new_u64(len);
+            rt_dbg_root_slot_store(&g_frame, 0u, target);
+            void* source = rt_array_new_u64(len);
+            rt_dbg_root_slot_store(&g_frame, 1u, source);
+            uint64_t* target_words = (uint64_t*)rt_array_data_ptr(target);
+            uint64_t* source_words = (uint64_t*)rt_array_data_ptr(source);
+            uint64_t expected[9];
+            for (uint64_t i = 0u; i < len; i++) {
+                target_words[i] = next_random();
+                source_words[i] = next_random();
+                switch (op) {
+                    case 0u: expected[i] = target_words[i] & source_words[i]; break;
+                    case 1u: expected[i] = target_words[i] | source_words[i]; break;
+                    case 2u: expected[i] = target_words[i] ^ source_words[i]; break;
+                    default: expected[i] = target_words[i] & ~source_words[i]; break;
+                }
+            }
+            switch (op) {
+                case 0u: rt_bitset_and(target, source); break;
+                case 1u: rt_bitset_or(target, source); break;
+                case 2u: rt_bitset_xor(target, source); break;
+                default: rt_bitset_and_not(target, source); break;
+            }
+            for (uint64_t i = 0u; i < len; i++) {
+                if (target_words[i] != expected[i]) {
+                    fail("binary bitset op should match the scalar reference");
+                }
+            }
+        }
+    }
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 1u, NULL);
+}
+
+static void test_count_matches_reference(void) {
+    const uint64_t len = 37u;
+    void* words = rt_array_new_u64(len);
+    rt_dbg_root_slot_store(&g_frame, 0u, words);
+    uint64_t* data = (uint64_t*)rt_array_data_ptr(words);
+    assert_i64((int64_t)rt_bitset_count(words), 0, "fresh words should have no bits set");
+
+    for (uint64_t i = 0u; i < len; i++) {
+        data[i] = next_random();
+    }
+    data[3] = UINT64_MAX;
+    data[4] = 0u;
+    uint64_t expected = 0u;
+    for (uint64_t i = 0u; i < len; i++) {
+        expected += reference_popcount(data[i]);
+    }
+    assert_i64((int64_t)rt_bitset_count(words), (int64_t)expected, "count should sum the word popcounts");
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+}
+
+static void test_next_set_scans_across_words(void) {
+    void* words = rt_array_new_u64(4u);
+    rt_dbg_root_slot_store(&g_frame, 0u, words);
+    uint64_t* data = (uint64_t*)rt_array_data_ptr(words);
+    assert_i64(rt_bitset_next_set(words, 0), -1, "empty words should have no next set bit");
+
+    data[0] = 1u | (1u << 5);
+    data[2] = 0x8000000000000000u;
+    data[3] = 1u;
+    assert_i64(rt_bitset_next_set(words, 0), 0, "bit 0 should be found from 0");
+    assert_i64(rt_bitset_next_set(words, 1), 5, "search should skip clear bits in the first word");
+    assert_i64(rt_bitset_next_set(words, 6), 191, "search should skip empty words");
+    assert_i64(rt_bitset_next_set(words, 191), 191, "the start bit itself should be reported");
+    assert_i64(rt_bitset_next_set(words, 192), 192, "a bit at a word boundary should be found");
+    assert_i64(rt_bitset_next_set(words, 193), -1, "search past the last set bit should report none");
+    assert_i64(rt_bitset_next_set(words, 1000), -1, "search past the end should report none");
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+}
+
+int main(void) {
+    rt_init();
+    rt_dbg_root_frame_init(&g_frame, g_slots, ROOT_SLOT_COUNT);
+    rt_dbg_push_roots(rt_thread_state(), &g_frame);
+
+    test_binary_ops_match_scalar_reference();
+    test_count_matches_reference();
+    test_next_set_scans_across_words();
+
+    rt_dbg_pop_roots(rt_thread_state());
+    rt_shutdown();
+    puts("test_bitset_runtime: ok");
+    return 0;
+}
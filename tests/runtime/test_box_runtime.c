@@ -0,0 +1,117 @@
+#include "runtime_dbg.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+enum {
+    ROOT_SLOT_COUNT = 2,
+};
+
+static RtRootFrame g_frame;
+static void* g_slots[ROOT_SLOT_COUNT];
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_box_runtime: %s\n", message);
+    exit(1);
+}
+
+static void assert_u64(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_box_runtime: %s (actual=%llu expected=%llu)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+static void push_frame(void) {
+    rt_dbg_root_frame_init(&g_frame, g_slots, ROOT_SLOT_COUNT);
+    rt_dbg_push_roots(rt_thread_state(), &g_frame);
+}
+
+static void pop_frame(void) {
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 1u, NULL);
+    rt_dbg_pop_roots(rt_thread_state());
+}
+
+/* Any managed object stands in for a box: the cache only stores and returns references. */
+static void* put_new_box(uint64_t kind, uint64_t slot) {
+    void* box = rt_array_new_u8(8u);
+    rt_dbg_root_slot_store(&g_frame, 0u, box);
+    rt_box_cache_put(kind, slot, box);
+    return box;
+}
+
+static void test_empty_slots_miss(void) {
+    for (uint64_t kind = 0u; kind < RT_BOX_CACHE_KIND_COUNT; kind++) {
+        if (rt_box_cache_get(kind, 0u) != NULL || rt_box_cache_get(kind, RT_BOX_CACHE_SLOT_COUNT - 1u) != NULL) {
+            fail("a slot that was never filled should miss");
+        }
+    }
+}
+
+static void test_put_then_get_returns_same_box(void) {
+    void* first = put_new_box(0u, 5u);
+    void* last = put_new_box(3u, RT_BOX_CACHE_SLOT_COUNT - 1u);
+    if (rt_box_cache_get(0u, 5u) != first || rt_box_cache_get(3u, RT_BOX_CACHE_SLOT_COUNT - 1u) != last) {
+        fail("get should return the box stored by put");
+    }
+    if (rt_box_cache_get(0u, 6u) != NULL || rt_box_cache_get(1u, 5u) != NULL) {
+        fail("put should only fill its own kind and slot");
+    }
+}
+
+static void test_cached_boxes_survive_collection(void) {
+    void* box = put_new_box(1u, 42u);
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    const uint64_t tracked_before = rt_gc_get_stats().tracked_object_count;
+
+    rt_gc_collect();
+    rt_gc_collect();
+
+    if (rt_box_cache_get(1u, 42u) != box) {
+        fail("a cached box should stay reachable through the cache roots");
+    }
+    assert_u64(rt_array_len(box), 8u, "a cached box should stay intact across collections");
+    assert_u64(
+        rt_gc_get_stats().tracked_object_count,
+        tracked_before,
+        "collections should not free cache tables or cached boxes"
+    );
+}
+
+static void test_shutdown_empties_cache(void) {
+    pop_frame();
+    rt_shutdown();
+    rt_init();
+    push_frame();
+
+    test_empty_slots_miss();
+    void* box = put_new_box(2u, 7u);
+    if (rt_box_cache_get(2u, 7u) != box) {
+        fail("the cache should refill after a runtime restart");
+    }
+}
+
+int main(void) {
+    rt_init();
+    push_frame();
+
+    test_empty_slots_miss();
+    test_put_then_get_returns_same_box();
+    test_cached_boxes_survive_collection();
+    test_shutdown_empties_cache();
+
+    pop_frame();
+    rt_shutdown();
+    puts("test_box_runtime: ok");
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "runtime.h"
+#include "func_profile.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_func_profile: %s\n", message);
+    exit(1);
+}
+
+
+static volatile uint64_t g_sink = 0;
+
+
+static void burn(uint32_t iterations) {
+    uint64_t x = 1;
+    for (uint32_t i = 0; i < iterations; i++) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+    }
+    g_sink = x;
+}
+
+
+static RtFuncProfileSite g_outer = {.name = "main::outer"};
+static RtFuncProfileSite g_inner = {.name = "main::inner"};
+static RtFuncProfileSite g_recursive = {.name = "main::recursive"};
+
+
+static void test_ticks_are_monotonic(void) {
+    uint64_t previous = rt_func_profile_ticks();
+    for (int i = 0; i < 1000; i++) {
+        uint64_t now = rt_func_profile_ticks();
+        if (now < previous) {
+            fail("tick source should never run backwards");
+        }
+        previous = now;
+    }
+}
+
+
+static void test_nested_calls_split_self_and_inclusive_time(void) {
+    rt_func_profile_reset();
+
+    rt_func_profile_enter(&g_outer);
+    burn(20000u);
+    for (int i = 0; i < 3; i++) {
+        rt_func_profile_enter(&g_inner);
+        burn(20000u);
+        rt_func_profile_exit();
+    }
+    rt_func_profile_exit();
+
+    if (rt_func_profile_site_count() != 2u) {
+        fail("each site should register exactly once");
+    }
+    if (g_outer.calls != 1u || g_inner.calls != 3u) {
+        fail("call counts should match enter/exit pairs");
+    }
+    if (g_outer.inclusive_ticks < g_inner.inclusive_ticks) {
+        fail("caller inclusive time should cover its callees");
+    }
+    if (g_outer.self_ticks + g_inner.inclusive_ticks != g_outer.inclusive_ticks) {
+        fail("caller self time should be its inclusive time minus callee time");
+    }
+    if (g_inner.self_ticks != g_inner.inclusive_ticks) {
+        fail("leaf self time should equal its inclusive time");
+    }
+    if (g_outer.active_depth != 0u || g_inner.active_depth != 0u) {
+        fail("active depth should return to zero after exits");
+    }
+}
+
+
+static void test_recursion_counts_inclusive_time_once(void) {
+    rt_func_profile_reset();
+
+    rt_func_profile_enter(&g_recursive);
+    burn(10000u);
+    rt_func_profile_enter(&g_recursive);
+    burn(10000u);
+    rt_func_profile_enter(&g_recursive);
+    burn(10000u);
+    rt_func_profile_exit();
+    rt_func_profile_exit();
+    rt_func_profile_exit();
+
+    if (g_recursive.calls != 3u) {
+        fail("recursive activations should each count as a call");
+    }
+    if (g_recursive.self_ticks != g_recursive.inclusive_ticks) {
+        fail("self-recursive inclusive time should only count the outermost activation");
+    }
+}
+
+
+static void test_report_closes_open_frames(void) {
+    rt_func_profile_reset();
+
+    rt_func_profile_enter(&g_outer);
+    rt_func_profile_enter(&g_inner);
+    burn(10000u);
+    rt_func_profile_print_report();
+
+    if (g_outer.calls != 1u || g_inner.calls != 1u) {
+        fail("report should close frames left open at exit");
+    }
+    if (g_outer.active_depth != 0u || g_inner.active_depth != 0u) {
+        fail("closing open frames should unwind active depth");
+    }
+    rt_func_profile_reset();
+    if (rt_func_profile_site_count() != 0u || g_outer.registered != 0u) {
+        fail("reset should unregister every site");
+    }
+}
+
+
+int main(void) {
+    rt_init();
+
+    test_ticks_are_monotonic();
+    test_nested_calls_split_self_and_inclusive_time();
+    test_recursion_counts_inclusive_time_once();
+    test_report_closes_open_frames();
+
+    rt_shutdown();
+    puts("test_func_profile: ok");
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include "runtime_dbg.h"
+#include "gc_trace.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct LeafObj {
+    RtObjHeader header;
+    uint64_t value;
+} LeafObj;
+
+
+static const RtType LEAF_TYPE = {
+    .type_id = 401,
+    .flags = RT_TYPE_FLAG_LEAF,
+    .abi_version = 1,
+    .align_bytes = 8,
+    .fixed_size_bytes = sizeof(LeafObj),
+    .debug_name = "EventLogLeaf",
+    .trace_fn = NULL,
+    .pointer_offsets = NULL,
+    .pointer_offsets_count = 0,
+    .subtype_id_end = 0,
+    .super_type = NULL,
+    .interface_tables = NULL,
+    .interface_slot_count = 0,
+    .reserved1 = 0,
+    .class_vtable = NULL,
+    .class_vtable_count = 0,
+    .reserved2 = 0,
+};
+
+
+static const char* EVENT_LOG_PATH = "test_gc_event_log.jsonl";
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_gc_event_log: %s\n", message);
+    exit(1);
+}
+
+
+static void assert_u64_eq(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_gc_event_log: %s (actual=%llu expected=%llu)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+
+static LeafObj* alloc_leaf(uint64_t value) {
+    uint64_t payload = sizeof(LeafObj) - sizeof(RtObjHeader);
+    LeafObj* leaf = (LeafObj*)rt_alloc_obj(rt_thread_state(), &LEAF_TYPE, payload);
+    leaf->value = value;
+    return leaf;
+}
+
+
+typedef struct EventLogCounts {
+    uint64_t cycle_records;
+    uint64_t summary_records;
+    uint64_t explicit_cycles;
+    uint64_t threshold_cycles;
+    uint64_t rooted_cycles;
+    uint64_t summaries_with_pauses;
+} EventLogCounts;
+
+
+static EventLogCounts read_event_log(void) {
+    EventLogCounts counts = {0};
+    FILE* file = fopen(EVENT_LOG_PATH, "r");
+    if (file == NULL) {
+        fail("event log file should exist");
+    }
+
+    char line[4096];
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] != '{' || strchr(line, '\n') == NULL) {
+            fail("each event log record should be one JSON object per line");
+        }
+        if (strstr(line, "\"event\":\"gc_cycle\"") != NULL) {
+            counts.cycle_records++;
+            if (strstr(line, "\"reason\":\"explicit\"") != NULL) {
+                counts.explicit_cycles++;
+            }
+            if (strstr(line, "\"reason\":\"threshold\"") != NULL) {
+                counts.threshold_cycles++;
+            }
+            if (strstr(line, "\"shadow_stack_frames\":1,\"shadow_stack_slots\":2,\"shadow_stack_refs\":1") != NULL
+                && strstr(line, "\"global_roots\":1,\"global_refs\":1") != NULL) {
+                counts.rooted_cycles++;
+            }
+            if (strstr(line, "\"before\":{") == NULL || strstr(line, "\"after\":{") == NULL) {
+                fail("cycle records should carry before/after stats");
+            }
+        } else if (strstr(line, "\"event\":\"gc_summary\"") != NULL) {
+            counts.summary_records++;
+            if (strstr(line, "\"pause_ns\":{\"p50\":") != NULL && strstr(line, "\"max\":") != NULL) {
+                counts.summaries_with_pauses++;
+            }
+        } else {
+            fail("unexpected event log record kind");
+        }
+    }
+    fclose(file);
+    return counts;
+}
+
+
+static void test_event_log_records_cycles_roots_and_summary(void) {
+    rt_gc_trace_set_event_log_path(EVENT_LOG_PATH);
+    rt_gc_reset_state();
+
+    void* global_ref = alloc_leaf(1);
+    rt_gc_register_global_root(&global_ref);
+
+    void* slots[2] = {NULL, NULL};
+    RtRootFrame frame;
+    rt_dbg_root_frame_init(&frame, slots, 2);
+    rt_dbg_push_roots(rt_thread_state(), &frame);
+    rt_dbg_root_slot_store(&frame, 0, alloc_leaf(2));
+
+    rt_gc_collect();
+    rt_gc_collect();
+
+    rt_dbg_pop_roots(rt_thread_state());
+    rt_gc_unregister_global_root(&global_ref);
+
+    for (uint64_t i = 0; i < 20000; i++) {
+        alloc_leaf(i);
+    }
+
+    rt_gc_trace_print_summary();
+
+    EventLogCounts counts = read_event_log();
+    assert_u64_eq(counts.explicit_cycles, 2, "explicit collections should be logged with reason=explicit");
+    if (counts.threshold_cycles == 0) {
+        fail("allocation pressure should log threshold-triggered cycles");
+    }
+    assert_u64_eq(
+        counts.cycle_records,
+        counts.explicit_cycles + counts.threshold_cycles,
+        "every cycle record should carry a known trigger reason"
+    );
+    assert_u64_eq(counts.rooted_cycles, 2, "rooted cycles should report shadow-stack and global root counts");
+    assert_u64_eq(counts.summary_records, 1, "shutdown should append exactly one summary record");
+    assert_u64_eq(counts.summaries_with_pauses, 1, "summary record should carry pause percentiles");
+
+    rt_gc_reset_state();
+    rt_gc_trace_set_event_log_path(NULL);
+    remove(EVENT_LOG_PATH);
+}
+
+
+int main(void) {
+    rt_init();
+
+    test_event_log_records_cycles_roots_and_summary();
+
+    rt_shutdown();
+    puts("test_gc_event_log: ok");
+    return 0;
+}
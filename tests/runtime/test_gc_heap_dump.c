@@ -0,0 +1,262 @@
+#include "runtime_dbg.h"
+#include "gc_heap_dump.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct NodeObj {
+    RtObjHeader header;
+    void* next;
+} NodeObj;
+
+
+typedef struct LeafObj {
+    RtObjHeader header;
+    uint64_t value;
+} LeafObj;
+
+
+static const uint32_t NODE_POINTER_OFFSETS[] = {
+    (uint32_t)offsetof(NodeObj, next),
+};
+
+
+static const RtType NODE_TYPE = {
+    .type_id = 501,
+    .flags = RT_TYPE_FLAG_HAS_REFS,
+    .abi_version = 1,
+    .align_bytes = 8,
+    .fixed_size_bytes = sizeof(NodeObj),
+    .debug_name = "DumpNode",
+    .trace_fn = NULL,
+    .pointer_offsets = NODE_POINTER_OFFSETS,
+    .pointer_offsets_count = 1,
+    .subtype_id_end = 0,
+    .super_type = NULL,
+    .interface_tables = NULL,
+    .interface_slot_count = 0,
+    .reserved1 = 0,
+    .class_vtable = NULL,
+    .class_vtable_count = 0,
+    .reserved2 = 0,
+};
+
+
+static const RtType LEAF_TYPE = {
+    .type_id = 502,
+    .flags = RT_TYPE_FLAG_LEAF,
+    .abi_version = 1,
+    .align_bytes = 8,
+    .fixed_size_bytes = sizeof(LeafObj),
+    .debug_name = "DumpLeaf",
+    .trace_fn = NULL,
+    .pointer_offsets = NULL,
+    .pointer_offsets_count = 0,
+    .subtype_id_end = 0,
+    .super_type = NULL,
+    .interface_tables = NULL,
+    .interface_slot_count = 0,
+    .reserved1 = 0,
+    .class_vtable = NULL,
+    .class_vtable_count = 0,
+    .reserved2 = 0,
+};
+
+
+static const char* HEAP_DUMP_PATH = "test_gc_heap_dump.bin";
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_gc_heap_dump: %s\n", message);
+    exit(1);
+}
+
+
+static void assert_u64_eq(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_gc_heap_dump: %s (actual=%llu expected=%llu)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+
+static NodeObj* alloc_node(void* next) {
+    uint64_t payload = sizeof(NodeObj) - sizeof(RtObjHeader);
+    NodeObj* node = (NodeObj*)rt_alloc_obj(rt_thread_state(), &NODE_TYPE, payload);
+    node->next = next;
+    return node;
+}
+
+
+static LeafObj* alloc_leaf(uint64_t value) {
+    uint64_t payload = sizeof(LeafObj) - sizeof(RtObjHeader);
+    LeafObj* leaf = (LeafObj*)rt_alloc_obj(rt_thread_state(), &LEAF_TYPE, payload);
+    leaf->value = value;
+    return leaf;
+}
+
+
+typedef struct SnapshotCounts {
+    uint64_t types;
+    uint64_t objects;
+    uint64_t roots;
+    uint64_t edges;
+    uint64_t global_roots;
+    uint64_t shadow_stack_roots;
+    uint64_t edge_to_expected_target;
+    uint64_t end_object_count;
+    uint64_t end_root_count;
+} SnapshotCounts;
+
+
+static void read_exact(FILE* file, void* data, size_t size) {
+    if (fread(data, 1, size, file) != size) {
+        fail("snapshot ended unexpectedly");
+    }
+}
+
+
+static uint32_t read_u32(FILE* file) {
+    uint32_t value = 0;
+    read_exact(file, &value, sizeof(value));
+    return value;
+}
+
+
+static uint64_t read_u64(FILE* file) {
+    uint64_t value = 0;
+    read_exact(file, &value, sizeof(value));
+    return value;
+}
+
+
+static SnapshotCounts read_snapshot(uint64_t expected_edge_target) {
+    SnapshotCounts counts = {0};
+    FILE* file = fopen(HEAP_DUMP_PATH, "rb");
+    if (file == NULL) {
+        fail("snapshot file should exist");
+    }
+
+    char magic[8];
+    read_exact(file, magic, sizeof(magic));
+    if (memcmp(magic, "NIFHEAP1", sizeof(magic)) != 0) {
+        fail("snapshot should start with the NIFHEAP1 magic");
+    }
+    assert_u64_eq(read_u32(file), RT_HEAP_DUMP_VERSION, "snapshot version should match the header constant");
+    assert_u64_eq(read_u32(file), sizeof(void*), "snapshot should record the pointer width");
+
+    for (;;) {
+        uint8_t tag = 0;
+        read_exact(file, &tag, sizeof(tag));
+        if (tag == RT_HEAP_DUMP_TAG_TYPE) {
+            (void)read_u64(file);
+            (void)read_u32(file);
+            (void)read_u32(file);
+            uint32_t name_len = read_u32(file);
+            char name[64];
+            if (name_len >= sizeof(name)) {
+                fail("type name should fit the test buffer");
+            }
+            read_exact(file, name, name_len);
+            counts.types++;
+        } else if (tag == RT_HEAP_DUMP_TAG_OBJECT) {
+            (void)read_u64(file);
+            (void)read_u64(file);
+            (void)read_u64(file);
+            uint32_t edge_count = read_u32(file);
+            for (uint32_t i = 0; i < edge_count; i++) {
+                if (read_u64(file) == expected_edge_target) {
+                    counts.edge_to_expected_target++;
+                }
+            }
+            counts.edges += edge_count;
+            counts.objects++;
+        } else if (tag == RT_HEAP_DUMP_TAG_ROOT) {
+            (void)read_u64(file);
+            uint32_t kind = read_u32(file);
+            (void)read_u32(file);
+            (void)read_u32(file);
+            if (kind == RT_GC_ROOT_GLOBAL) {
+                counts.global_roots++;
+            } else if (kind == RT_GC_ROOT_SHADOW_STACK) {
+                counts.shadow_stack_roots++;
+            }
+            counts.roots++;
+        } else if (tag == RT_HEAP_DUMP_TAG_END) {
+            counts.end_object_count = read_u64(file);
+            counts.end_root_count = read_u64(file);
+            break;
+        } else {
+            fail("snapshot contains an unknown record tag");
+        }
+    }
+    fclose(file);
+    return counts;
+}
+
+
+static void test_heap_dump_writes_types_objects_edges_and_roots(void) {
+    rt_gc_reset_state();
+
+    LeafObj* tail = alloc_leaf(7);
+    void* global_ref = alloc_node(tail);
+    rt_gc_register_global_root(&global_ref);
+
+    void* slots[1] = {NULL};
+    RtRootFrame frame;
+    rt_dbg_root_frame_init(&frame, slots, 1);
+    rt_dbg_push_roots(rt_thread_state(), &frame);
+    rt_dbg_root_slot_store(&frame, 0, alloc_node(NULL));
+
+    alloc_leaf(99);
+
+    if (rt_gc_dump_heap(HEAP_DUMP_PATH) != 0) {
+        fail("rt_gc_dump_heap should succeed for a writable path");
+    }
+
+    SnapshotCounts counts = read_snapshot((uint64_t)(uintptr_t)tail);
+    assert_u64_eq(counts.types, 2, "each type should be written exactly once");
+    assert_u64_eq(counts.objects, 4, "every tracked object should be written, including garbage");
+    assert_u64_eq(counts.edges, 1, "only non-null reference slots should be written as edges");
+    assert_u64_eq(counts.edge_to_expected_target, 1, "node edge should point at the leaf it references");
+    assert_u64_eq(counts.global_roots, 1, "global roots should be written");
+    assert_u64_eq(counts.shadow_stack_roots, 1, "non-null shadow-stack slots should be written");
+    assert_u64_eq(counts.end_object_count, counts.objects, "end record should repeat the object count");
+    assert_u64_eq(counts.end_root_count, counts.roots, "end record should repeat the root count");
+
+    rt_dbg_pop_roots(rt_thread_state());
+    rt_gc_unregister_global_root(&global_ref);
+    rt_gc_reset_state();
+    remove(HEAP_DUMP_PATH);
+}
+
+
+static void test_heap_dump_reports_unwritable_path(void) {
+    rt_gc_reset_state();
+    if (rt_gc_dump_heap("/nonexistent-directory/heap.bin") == 0) {
+        fail("rt_gc_dump_heap should fail for an unwritable path");
+    }
+    rt_gc_reset_state();
+}
+
+
+int main(void) {
+    rt_init();
+
+    test_heap_dump_writes_types_objects_edges_and_roots();
+    test_heap_dump_reports_unwritable_path();
+
+    rt_shutdown();
+    puts("test_gc_heap_dump: ok");
+    return 0;
+}
@@ -36,7 +36,7 @@ static const RtType NODE_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NODE_POINTER_OFFSETS,
     .pointer_offsets_count = 1,
-    .reserved0 = 0,
+    .subtype_id_end = 0,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0,
@@ -57,7 +57,7 @@ static const RtType LEAF_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0,
-    .reserved0 = 0,
+    .subtype_id_end = 0,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0,
@@ -50,7 +50,7 @@ static const RtType HASH_ONLY_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = HASH_ONLY_INTERFACE_TABLES,
     .interface_slot_count = 2u,
@@ -70,7 +70,7 @@ static const RtType KEY_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = KEY_INTERFACE_TABLES,
     .interface_slot_count = 2u,
@@ -90,7 +90,7 @@ static const RtType DERIVED_KEY_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = &KEY_TYPE,
     .interface_tables = KEY_INTERFACE_TABLES,
     .interface_slot_count = 2u,
@@ -100,6 +100,32 @@ static const RtType DERIVED_KEY_TYPE = {
     .reserved2 = 0u,
 };
 
+/* Compiler-shaped preorder numbering: Shape(1) { Circle(2), Square(3) }. */
+#define TEST_RANGED_TYPE(ident, name, id, subtype_end, parent) \
+    static const RtType ident = { \
+        .type_id = (id), \
+        .flags = RT_TYPE_FLAG_LEAF, \
+        .abi_version = 1u, \
+        .align_bytes = 8u, \
+        .fixed_size_bytes = 24u, \
+        .debug_name = name, \
+        .trace_fn = NULL, \
+        .pointer_offsets = NULL, \
+        .pointer_offsets_count = 0u, \
+        .subtype_id_end = (subtype_end), \
+        .super_type = (parent), \
+        .interface_tables = NULL, \
+        .interface_slot_count = 0u, \
+        .reserved1 = 0u, \
+        .class_vtable = NULL, \
+        .class_vtable_count = 0u, \
+        .reserved2 = 0u, \
+    }
+
+TEST_RANGED_TYPE(SHAPE_TYPE, "Shape", 1u, 4u, NULL);
+TEST_RANGED_TYPE(CIRCLE_TYPE, "Circle", 2u, 3u, &SHAPE_TYPE);
+TEST_RANGED_TYPE(SQUARE_TYPE, "Square", 3u, 4u, &SHAPE_TYPE);
+
 
 static void fail(const char* message) {
     fprintf(stderr, "test_interface_casts: %s\n", message);
@@ -235,6 +261,32 @@ static void test_is_instance_of_type_walks_superclass_chain(void) {
     }
 }
 
+static void test_is_instance_of_type_uses_subtype_id_ranges(void) {
+    void* shape = alloc_leaf(&SHAPE_TYPE);
+    void* circle = alloc_leaf(&CIRCLE_TYPE);
+    void* square = alloc_leaf(&SQUARE_TYPE);
+    void* key = alloc_leaf(&KEY_TYPE);
+
+    if (rt_is_instance_of_type(circle, &SHAPE_TYPE) != 1u || rt_is_instance_of_type(square, &SHAPE_TYPE) != 1u) {
+        fail("subclasses should fall inside their base type's id range");
+    }
+    if (rt_is_instance_of_type(circle, &CIRCLE_TYPE) != 1u) {
+        fail("a class should fall inside its own id range");
+    }
+    if (rt_is_instance_of_type(square, &CIRCLE_TYPE) != 0u || rt_is_instance_of_type(circle, &SQUARE_TYPE) != 0u) {
+        fail("sibling classes should not match each other's ranges");
+    }
+    if (rt_is_instance_of_type(shape, &CIRCLE_TYPE) != 0u) {
+        fail("base object should not be an instance of a subclass range");
+    }
+    if (rt_is_instance_of_type(key, &SHAPE_TYPE) != 0u || rt_is_instance_of_type(circle, &KEY_TYPE) != 0u) {
+        fail("types without ranges should fall back to the superclass walk");
+    }
+    if (rt_checked_cast(square, &SHAPE_TYPE) != square) {
+        fail("checked cast should accept a subclass through the id range");
+    }
+}
+
 int main(void) {
     rt_init();
 
@@ -245,6 +297,7 @@ int main(void) {
     test_checked_cast_accepts_derived_instance_for_base_type();
     test_is_instance_of_interface_uses_slot_tables();
     test_is_instance_of_type_walks_superclass_chain();
+    test_is_instance_of_type_uses_subtype_id_ranges();
 
     rt_shutdown();
     puts("test_interface_casts: ok");
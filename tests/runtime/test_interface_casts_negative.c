@@ -37,7 +37,7 @@ static const RtType HASH_ONLY_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = HASH_ONLY_INTERFACE_TABLES,
     .interface_slot_count = 2u,
@@ -57,7 +57,7 @@ static const RtType PLAIN_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0u,
@@ -43,7 +43,7 @@ static const RtType KEY_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = KEY_INTERFACE_TABLES,
     .interface_slot_count = 2u,
@@ -30,7 +30,7 @@ static const RtType KEY_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = KEY_INTERFACE_TABLES,
     .interface_slot_count = 1u,
@@ -50,7 +50,7 @@ static const RtType PLAIN_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = NULL,
     .pointer_offsets_count = 0u,
-    .reserved0 = 0u,
+    .subtype_id_end = 0u,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0u,
@@ -0,0 +1,186 @@
+#include "runtime.h"
+#include "line_table.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Three callables shaped like compiler output: an outer function calls a
+ * constructor wrapper, which calls its init body, which calls back into C.
+ * Each one links a frame record and marks its call site, and the tables are
+ * emitted the same way the backends emit them.
+ */
+#if defined(__x86_64__)
+#define TEST_LT_FRAME_ENTER "    pushq %rbp\n    movq %rsp, %rbp\n"
+#define TEST_LT_FRAME_LEAVE "    popq %rbp\n    ret\n"
+#define TEST_LT_CALL(target) "    call " target "\n"
+#define TEST_LT_CALL_ARG "    call *%rdi\n"
+#elif defined(__aarch64__)
+#define TEST_LT_FRAME_ENTER "    stp x29, x30, [sp, #-16]!\n    mov x29, sp\n"
+#define TEST_LT_FRAME_LEAVE "    ldp x29, x30, [sp], #16\n    ret\n"
+#define TEST_LT_CALL(target) "    bl " target "\n"
+#define TEST_LT_CALL_ARG "    blr x0\n"
+#else
+#error "test_line_table needs an x86_64 or aarch64 host"
+#endif
+
+#define TEST_LT_TABLE(name, entries, count, line, column, flags) \
+    "    .long " name " - .\n" \
+    "    .long " name "_end - " name "\n" \
+    "    .long test_lt_name_" name " - .\n" \
+    "    .long test_lt_file - .\n" \
+    "    .long " entries " - .\n" \
+    "    .long " count ", " line ", " column ", " flags ", 0\n"
+
+__asm__(
+    ".pushsection .text\n"
+    ".globl test_lt_outer\n"
+    "test_lt_outer:\n"
+    TEST_LT_FRAME_ENTER
+    ".globl test_lt_outer_loc0\n"
+    "test_lt_outer_loc0:\n"
+    TEST_LT_CALL("test_lt_wrapper")
+    TEST_LT_FRAME_LEAVE
+    "test_lt_outer_end:\n"
+    "test_lt_wrapper:\n"
+    TEST_LT_FRAME_ENTER
+    "test_lt_wrapper_loc0:\n"
+    TEST_LT_CALL("test_lt_init")
+    TEST_LT_FRAME_LEAVE
+    "test_lt_wrapper_end:\n"
+    "test_lt_init:\n"
+    TEST_LT_FRAME_ENTER
+    "test_lt_init_loc0:\n"
+    TEST_LT_CALL_ARG
+    TEST_LT_FRAME_LEAVE
+    "test_lt_init_end:\n"
+    ".popsection\n"
+    ".pushsection .rodata\n"
+    ".p2align 2\n"
+    "test_lt_outer_entries:\n"
+    "    .long test_lt_outer_loc0 - test_lt_outer, 12, 5\n"
+    "test_lt_wrapper_entries:\n"
+    "    .long test_lt_wrapper_loc0 - test_lt_wrapper, 20, 1\n"
+    "test_lt_init_entries:\n"
+    "    .long test_lt_init_loc0 - test_lt_init, 23, 9\n"
+    "test_lt_name_test_lt_outer:\n"
+    "    .asciz \"main::outer\"\n"
+    "test_lt_name_test_lt_wrapper:\n"
+    "test_lt_name_test_lt_init:\n"
+    "    .asciz \"main::Box#0\"\n"
+    "test_lt_file:\n"
+    "    .asciz \"main.nif\"\n"
+    ".popsection\n"
+    ".pushsection nif_line_tables,\"a\",@progbits\n"
+    ".p2align 2\n"
+    TEST_LT_TABLE("test_lt_outer", "test_lt_outer_entries", "1", "10", "1", "0")
+    TEST_LT_TABLE("test_lt_wrapper", "test_lt_wrapper_entries", "1", "20", "1", "0")
+    TEST_LT_TABLE("test_lt_init", "test_lt_init_entries", "1", "20", "1", "1")
+    ".popsection\n"
+);
+
+void test_lt_outer(void (*probe)(void));
+extern const char test_lt_outer_loc0[];
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_line_table: %s\n", message);
+    exit(1);
+}
+
+
+static void expect_frame(const RtTraceFrame* frame, const char* function_name, uint32_t line, uint32_t column) {
+    if (frame->function_name == NULL || strcmp(frame->function_name, function_name) != 0) {
+        fprintf(stderr, "test_line_table: expected %s, got %s\n", function_name, frame->function_name ? frame->function_name : "<null>");
+        exit(1);
+    }
+    if (frame->file_path == NULL || strcmp(frame->file_path, "main.nif") != 0) {
+        fail("symbolized frame should carry the table's file path");
+    }
+    if (frame->line != line || frame->column != column) {
+        fprintf(stderr, "test_line_table: %s expected %u:%u, got %u:%u\n", function_name, line, column, frame->line, frame->column);
+        exit(1);
+    }
+}
+
+
+static RtTraceFrame g_captured[8];
+static uint32_t g_captured_count = 0;
+
+
+static void capture_probe(void) {
+    g_captured_count = rt_trace_capture(g_captured, 8u);
+}
+
+
+static void test_tables_are_discovered(void) {
+    if (rt_line_table_count() != 3u) {
+        fail("all tables in the section should be visible");
+    }
+    if (rt_line_table_find((uintptr_t)&test_lt_outer) == NULL) {
+        fail("callable entry should be covered by its table");
+    }
+    if (rt_line_table_find((uintptr_t)&fail) != NULL) {
+        fail("runtime C code should not resolve to a table");
+    }
+}
+
+
+static void test_symbolize_uses_last_mark_before_return_address(void) {
+    RtTraceFrame frame;
+    if (!rt_line_table_symbolize((uintptr_t)&test_lt_outer + 1u, &frame)) {
+        fail("address in the prologue should symbolize");
+    }
+    expect_frame(&frame, "main::outer", 10u, 1u);
+
+    if (!rt_line_table_symbolize((uintptr_t)test_lt_outer_loc0 + 1u, &frame)) {
+        fail("address after the call-site mark should symbolize");
+    }
+    expect_frame(&frame, "main::outer", 12u, 5u);
+
+    if (rt_line_table_symbolize(0u, &frame)) {
+        fail("a null return address should not symbolize");
+    }
+}
+
+
+static void test_frame_walk_folds_constructor_wrapper(void) {
+    g_captured_count = 0u;
+    test_lt_outer(capture_probe);
+
+    if (g_captured_count != 2u) {
+        fprintf(stderr, "test_line_table: expected 2 frames, got %u\n", g_captured_count);
+        exit(1);
+    }
+    expect_frame(&g_captured[0], "main::Box#0", 23u, 9u);
+    expect_frame(&g_captured[1], "main::outer", 12u, 5u);
+}
+
+
+static void test_shadow_stack_takes_precedence(void) {
+    rt_trace_push("main::shadow", "main.nif", 3u, 4u);
+    g_captured_count = 0u;
+    test_lt_outer(capture_probe);
+    rt_trace_pop();
+
+    if (g_captured_count != 1u) {
+        fail("a non-empty shadow stack should be reported instead of walking frames");
+    }
+    expect_frame(&g_captured[0], "main::shadow", 3u, 4u);
+}
+
+
+int main(void) {
+    rt_init();
+
+    test_tables_are_discovered();
+    test_symbolize_uses_last_mark_before_return_address();
+    test_frame_walk_folds_constructor_wrapper();
+    test_shadow_stack_takes_precedence();
+
+    rt_shutdown();
+    puts("test_line_table: ok");
+    return 0;
+}
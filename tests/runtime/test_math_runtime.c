@@ -80,9 +80,19 @@ static void test_min_max_follow_java_like_nan_and_signed_zero_rules(void) {
     assert_close(rt_math_max(3.0, -4.0), 3.0, 0.0, "max should choose larger value");
 }
 
+static void test_rounding_wrappers_detect_sse41_on_first_use(void) {
+    assert_true(rt_cpu_has_sse41 == 0u, "SSE4.1 detection should wait for the first rounding call");
+    assert_close(rt_math_floor(-2.5), -3.0, 0.0, "floor should round toward negative infinity");
+#if defined(__x86_64__) && defined(__SSE4_1__)
+    assert_true(rt_cpu_has_sse41 == 1u, "SSE4.1 detection should report a CPU the runtime was built for");
+#endif
+    assert_true(rt_cpu_has_sse41 <= 1u, "SSE4.1 detection should store a boolean");
+}
+
 int main(void) {
     rt_init();
 
+    test_rounding_wrappers_detect_sse41_on_first_use();
     test_unary_wrappers_match_libm();
     test_binary_wrappers_match_libm();
     test_predicates_wrap_libm_classification();
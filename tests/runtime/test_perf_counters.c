@@ -0,0 +1,106 @@
+#include "runtime.h"
+#include "perf_counters.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_perf_counters: %s\n", message);
+    exit(1);
+}
+
+
+static volatile uint64_t g_sink = 0;
+
+
+static void burn_instructions(void) {
+    uint64_t x = 1;
+    for (uint32_t i = 0; i < 200000u; i++) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+    }
+    g_sink = x;
+}
+
+
+static void test_counter_names_are_stable(void) {
+    if (strcmp(rt_perf_counter_name(RT_PERF_COUNTER_CYCLES), "cycles") != 0
+        || strcmp(rt_perf_counter_name(RT_PERF_COUNTER_INSTRUCTIONS), "instructions") != 0
+        || strcmp(rt_perf_counter_name(RT_PERF_COUNTER_CACHE_MISSES), "cache_misses") != 0
+        || strcmp(rt_perf_counter_name(RT_PERF_COUNTER_BRANCH_MISSES), "branch_misses") != 0) {
+        fail("counter names are part of the event-log schema and must not change");
+    }
+}
+
+
+static void test_delta_and_accumulate(void) {
+    RtPerfCounterSample start = {0};
+    RtPerfCounterSample end = {0};
+    start.valid_mask = (1u << RT_PERF_COUNTER_CYCLES) | (1u << RT_PERF_COUNTER_INSTRUCTIONS);
+    end.valid_mask = 1u << RT_PERF_COUNTER_CYCLES;
+    start.values[RT_PERF_COUNTER_CYCLES] = 100u;
+    end.values[RT_PERF_COUNTER_CYCLES] = 175u;
+
+    RtPerfCounterSample delta = rt_perf_counters_delta(end, start);
+    if (delta.valid_mask != (1u << RT_PERF_COUNTER_CYCLES)) {
+        fail("delta should only be valid for counters valid in both samples");
+    }
+    if (delta.values[RT_PERF_COUNTER_CYCLES] != 75u || delta.values[RT_PERF_COUNTER_INSTRUCTIONS] != 0u) {
+        fail("delta should subtract valid counters and zero the rest");
+    }
+
+    RtPerfCounterSample total = {0};
+    rt_perf_counters_accumulate(&total, delta);
+    rt_perf_counters_accumulate(&total, delta);
+    if (total.valid_mask != delta.valid_mask || total.values[RT_PERF_COUNTER_CYCLES] != 150u) {
+        fail("accumulate should sum deltas and keep their valid mask");
+    }
+}
+
+
+static void test_live_counters_or_graceful_fallback(void) {
+    rt_perf_counters_reset();
+    rt_perf_counters_configure(1);
+
+    if (!rt_perf_counters_available()) {
+        RtPerfCounterSample sample = rt_perf_counters_read();
+        if (sample.valid_mask != 0u) {
+            fail("unavailable counters should read as an empty sample");
+        }
+        puts("test_perf_counters: hardware counters unavailable, checked fallback only");
+        rt_perf_counters_reset();
+        return;
+    }
+
+    RtPerfCounterSample before = rt_perf_counters_read();
+    burn_instructions();
+    RtPerfCounterSample after = rt_perf_counters_read();
+    if ((before.valid_mask & (1u << RT_PERF_COUNTER_CYCLES)) == 0u) {
+        fail("the cycles group leader should always be readable once open");
+    }
+    for (int id = 0; id < RT_PERF_COUNTER_COUNT; id++) {
+        if ((before.valid_mask & (1u << id)) != 0u && after.values[id] < before.values[id]) {
+            fail("counters should never run backwards");
+        }
+    }
+    RtPerfCounterSample delta = rt_perf_counters_delta(after, before);
+    if (delta.values[RT_PERF_COUNTER_CYCLES] == 0u) {
+        fail("busy loop should retire a nonzero number of cycles");
+    }
+    rt_perf_counters_reset();
+}
+
+
+int main(void) {
+    rt_init();
+
+    test_counter_names_are_stable();
+    test_delta_and_accumulate();
+    test_live_counters_or_graceful_fallback();
+
+    rt_shutdown();
+    puts("test_perf_counters: ok");
+    return 0;
+}
@@ -0,0 +1,217 @@
+#include "runtime_dbg.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+enum {
+    ROOT_SLOT_COUNT = 8,
+};
+
+static RtRootFrame g_frame;
+static void* g_slots[ROOT_SLOT_COUNT];
+static uint64_t g_random_state = 0x2545f4914f6cdd1du;
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_sort_runtime: %s\n", message);
+    exit(1);
+}
+
+static void assert_i64(int64_t actual, int64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_sort_runtime: %s (actual=%lld expected=%lld)\n",
+            message,
+            (long long)actual,
+            (long long)expected
+        );
+        exit(1);
+    }
+}
+
+static uint64_t next_random(void) {
+    g_random_state ^= g_random_state << 13;
+    g_random_state ^= g_random_state >> 7;
+    g_random_state ^= g_random_state << 17;
+    return g_random_state;
+}
+
+static int compare_i64(const void* left, const void* right) {
+    const int64_t a = *(const int64_t*)left;
+    const int64_t b = *(const int64_t*)right;
+    return (a > b) - (a < b);
+}
+
+static int compare_u64(const void* left, const void* right) {
+    const uint64_t a = *(const uint64_t*)left;
+    const uint64_t b = *(const uint64_t*)right;
+    return (a > b) - (a < b);
+}
+
+/* Fills values[0:len] with one of several input shapes that stress different partitioning paths. */
+static void fill_pattern(uint64_t* values, size_t len, unsigned pattern) {
+    for (size_t i = 0u; i < len; i++) {
+        switch (pattern) {
+            case 0u: values[i] = next_random(); break;
+            case 1u: values[i] = (uint64_t)i; break;
+            case 2u: values[i] = (uint64_t)(len - i); break;
+            case 3u: values[i] = next_random() % 4u; break;
+            case 4u: values[i] = (uint64_t)(i % 2u == 0u ? i : len - i); break;
+            case 5u: values[i] = i + 1u == len ? 0u : (uint64_t)i; break;
+            default: values[i] = next_random() % 1000u - 500u; break;
+        }
+    }
+}
+
+static void test_i64_and_u64_sorts_match_reference(void) {
+    static const size_t lengths[] = {0u, 1u, 2u, 23u, 24u, 25u, 129u, 255u, 256u, 1000u, 5000u, 70000u};
+    for (size_t length_index = 0u; length_index < sizeof(lengths) / sizeof(lengths[0]); length_index++) {
+        const size_t len = lengths[length_index];
+        for (unsigned pattern = 0u; pattern < 7u; pattern++) {
+            void* signed_array = rt_array_new_i64((uint64_t)len + 2u);
+            rt_dbg_root_slot_store(&g_frame, 0u, signed_array);
+            void* unsigned_array = rt_array_new_u64((uint64_t)len);
+            rt_dbg_root_slot_store(&g_frame, 1u, unsigned_array);
+
+            uint64_t* expected = (uint64_t*)malloc((len + 1u) * sizeof(uint64_t));
+            uint64_t* expected_unsigned = (uint64_t*)malloc((len + 1u) * sizeof(uint64_t));
+            fill_pattern(expected, len, pattern);
+            memcpy(expected_unsigned, expected, len * sizeof(uint64_t));
+            int64_t* signed_values = (int64_t*)rt_array_data_ptr(signed_array);
+            signed_values[0] = 77;
+            signed_values[len + 1u] = -77;
+            memcpy(signed_values + 1, expected, len * sizeof(uint64_t));
+            memcpy((void*)rt_array_data_ptr(unsigned_array), expected, len * sizeof(uint64_t));
+
+            rt_sort_i64(signed_array, 1, (int64_t)len + 1);
+            qsort(expected, len, sizeof(uint64_t), compare_i64);
+            if (memcmp(signed_values + 1, expected, len * sizeof(uint64_t)) != 0) {
+                fail("rt_sort_i64 should match qsort");
+            }
+            assert_i64(signed_values[0], 77, "rt_sort_i64 should leave elements before the range alone");
+            assert_i64(signed_values[len + 1u], -77, "rt_sort_i64 should leave elements after the range alone");
+
+            rt_sort_u64(unsigned_array, 0, (int64_t)len);
+            qsort(expected_unsigned, len, sizeof(uint64_t), compare_u64);
+            if (memcmp(rt_array_data_ptr(unsigned_array), expected_unsigned, len * sizeof(uint64_t)) != 0) {
+                fail("rt_sort_u64 should match qsort");
+            }
+            free(expected);
+            free(expected_unsigned);
+        }
+    }
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 1u, NULL);
+}
+
+static void test_u8_sort_counts_every_value(void) {
+    static const size_t lengths[] = {0u, 5u, 63u, 64u, 4096u};
+    for (size_t length_index = 0u; length_index < sizeof(lengths) / sizeof(lengths[0]); length_index++) {
+        const size_t len = lengths[length_index];
+        void* array = rt_array_new_u8((uint64_t)len);
+        rt_dbg_root_slot_store(&g_frame, 0u, array);
+        uint8_t* bytes = (uint8_t*)rt_array_data_ptr(array);
+        size_t counts[256] = {0};
+        for (size_t i = 0u; i < len; i++) {
+            bytes[i] = (uint8_t)next_random();
+            counts[bytes[i]]++;
+        }
+        rt_sort_u8(array, 0, (int64_t)len);
+        for (size_t i = 0u; i < len; i++) {
+            if (i > 0u && bytes[i - 1u] > bytes[i]) {
+                fail("rt_sort_u8 should sort ascending");
+            }
+            counts[bytes[i]]--;
+        }
+        for (unsigned value = 0u; value < 256u; value++) {
+            if (counts[value] != 0u) {
+                fail("rt_sort_u8 should keep every value");
+            }
+        }
+    }
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+}
+
+static void test_double_sort_uses_total_order(void) {
+    const double inputs[] = {3.5, -0.0, NAN, -INFINITY, 0.0, -2.0, INFINITY, 1e-300, -1e-300, 2.0};
+    const double expected[] = {-INFINITY, -2.0, -1e-300, -0.0, 0.0, 1e-300, 2.0, 3.5, INFINITY, NAN};
+    const size_t len = sizeof(inputs) / sizeof(inputs[0]);
+    void* array = rt_array_new_double((uint64_t)len);
+    rt_dbg_root_slot_store(&g_frame, 0u, array);
+    double* values = (double*)rt_array_data_ptr(array);
+    memcpy(values, inputs, sizeof(inputs));
+
+    rt_sort_double(array, 0, (int64_t)len);
+    if (memcmp(values, expected, sizeof(expected)) != 0) {
+        fail("rt_sort_double should order -0.0 before 0.0 and NaN last");
+    }
+    assert_i64(rt_sort_search_double(array, 0, (int64_t)len, 0.0), 4, "search should tell 0.0 from -0.0");
+    assert_i64(rt_sort_search_double(array, 0, (int64_t)len, NAN), 9, "search should find NaN");
+    assert_i64(rt_sort_search_double(array, 0, (int64_t)len, 1.0), -7, "search should report the insertion point");
+
+    const size_t big_len = 3000u;
+    void* big = rt_array_new_double((uint64_t)big_len);
+    rt_dbg_root_slot_store(&g_frame, 1u, big);
+    double* big_values = (double*)rt_array_data_ptr(big);
+    for (size_t i = 0u; i < big_len; i++) {
+        big_values[i] = ((double)(int64_t)(next_random() % 20001u) - 10000.0) / 7.0;
+    }
+    rt_sort_double(big, 0, (int64_t)big_len);
+    for (size_t i = 1u; i < big_len; i++) {
+        if (big_values[i - 1u] > big_values[i]) {
+            fail("radix-sorted doubles should be ascending");
+        }
+    }
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 1u, NULL);
+}
+
+static void test_search_finds_first_match_or_insertion_point(void) {
+    void* array = rt_array_new_i64(8u);
+    rt_dbg_root_slot_store(&g_frame, 0u, array);
+    const int64_t inputs[] = {-5, 1, 3, 3, 3, 8, 13, 21};
+    memcpy((void*)rt_array_data_ptr(array), inputs, sizeof(inputs));
+
+    assert_i64(rt_sort_search_i64(array, 0, 8, 3), 2, "search should return the first equal element");
+    assert_i64(rt_sort_search_i64(array, 0, 8, -9), -1, "search before the range should report insertion point 0");
+    assert_i64(rt_sort_search_i64(array, 0, 8, 99), -9, "search after the range should report insertion point 8");
+    assert_i64(rt_sort_search_i64(array, 3, 8, 8), 5, "ranged search should return absolute indices");
+    assert_i64(rt_sort_search_i64(array, 6, 8, 1), -7, "ranged search should report absolute insertion points");
+    assert_i64(rt_sort_search_i64(array, 4, 4, 3), -5, "an empty range should report its start");
+
+    void* bytes = rt_array_new_u8(4u);
+    rt_dbg_root_slot_store(&g_frame, 1u, bytes);
+    memcpy((void*)rt_array_data_ptr(bytes), "acex", 4u);
+    assert_i64(rt_sort_search_u8(bytes, 0, 4, 'e'), 2, "u8 search should find present bytes");
+    assert_i64(rt_sort_search_u8(bytes, 0, 4, 'd'), -3, "u8 search should report the insertion point");
+
+    void* words = rt_array_new_u64(3u);
+    rt_dbg_root_slot_store(&g_frame, 2u, words);
+    const uint64_t word_inputs[] = {1u, 0x8000000000000000u, UINT64_MAX};
+    memcpy((void*)rt_array_data_ptr(words), word_inputs, sizeof(word_inputs));
+    assert_i64(rt_sort_search_u64(words, 0, 3, UINT64_MAX), 2, "u64 search should compare unsigned");
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 1u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 2u, NULL);
+}
+
+int main(void) {
+    rt_init();
+    rt_dbg_root_frame_init(&g_frame, g_slots, ROOT_SLOT_COUNT);
+    rt_dbg_push_roots(rt_thread_state(), &g_frame);
+
+    test_i64_and_u64_sorts_match_reference();
+    test_u8_sort_counts_every_value();
+    test_double_sort_uses_total_order();
+    test_search_finds_first_match_or_insertion_point();
+
+    rt_dbg_pop_roots(rt_thread_state());
+    rt_shutdown();
+    puts("test_sort_runtime: ok");
+    return 0;
+}
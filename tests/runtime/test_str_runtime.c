@@ -0,0 +1,137 @@
+#include "runtime_dbg.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+enum {
+    ROOT_SLOT_COUNT = 4,
+};
+
+static RtRootFrame g_frame;
+static void* g_slots[ROOT_SLOT_COUNT];
+
+
+static void fail(const char* message) {
+    fprintf(stderr, "test_str_runtime: %s\n", message);
+    exit(1);
+}
+
+static void assert_u64(uint64_t actual, uint64_t expected, const char* message) {
+    if (actual != expected) {
+        fprintf(
+            stderr,
+            "test_str_runtime: %s (actual=%llu expected=%llu)\n",
+            message,
+            (unsigned long long)actual,
+            (unsigned long long)expected
+        );
+        exit(1);
+    }
+}
+
+static void assert_bytes(void* bytes, const char* expected, const char* message) {
+    const uint64_t len = rt_array_len(bytes);
+    if (len != strlen(expected) || memcmp(rt_array_data_ptr(bytes), expected, (size_t)len) != 0) {
+        fprintf(
+            stderr,
+            "test_str_runtime: %s (actual=%.*s expected=%s)\n",
+            message,
+            (int)len,
+            (const char*)rt_array_data_ptr(bytes),
+            expected
+        );
+        exit(1);
+    }
+}
+
+static void* new_bytes(uint64_t len) {
+    void* bytes = rt_array_new_u8(len);
+    rt_dbg_root_slot_store(&g_frame, 0u, bytes);
+    return bytes;
+}
+
+static void test_i64_formatting(void) {
+    const int64_t values[] = {0, 7, -7, 10, 1234567890, -1000, INT64_MAX, INT64_MIN};
+    const char* expected[] = {
+        "0", "7", "-7", "10", "1234567890", "-1000", "9223372036854775807", "-9223372036854775808",
+    };
+    for (size_t i = 0u; i < sizeof(values) / sizeof(values[0]); i++) {
+        const uint64_t len = rt_str_len_i64(values[i]);
+        assert_u64(len, strlen(expected[i]), "i64 length should match the decimal text");
+        void* bytes = new_bytes(len);
+        assert_u64(rt_str_write_i64(bytes, 0u, values[i]), len, "i64 write should return the end offset");
+        assert_bytes(bytes, expected[i], "i64 text should match Str.from_i64");
+    }
+}
+
+static void test_u64_formatting(void) {
+    const uint64_t values[] = {0u, 9u, 100u, UINT64_MAX};
+    const char* expected[] = {"0", "9", "100", "18446744073709551615"};
+    for (size_t i = 0u; i < sizeof(values) / sizeof(values[0]); i++) {
+        const uint64_t len = rt_str_len_u64(values[i]);
+        assert_u64(len, strlen(expected[i]), "u64 length should match the decimal text");
+        void* bytes = new_bytes(len);
+        assert_u64(rt_str_write_u64(bytes, 0u, values[i]), len, "u64 write should return the end offset");
+        assert_bytes(bytes, expected[i], "u64 text should match Str.from_u64");
+    }
+}
+
+static void test_double_formatting(void) {
+    const double values[] = {0.0, -0.0, 1.5, -2.25, 0.0000004, 0.9999996, 123456.000001, -1e15};
+    const char* expected[] = {
+        "0.000000", "0.000000", "1.500000", "-2.250000", "0.000000", "1.000000", "123456.000001",
+        "-1000000000000000.000000",
+    };
+    for (size_t i = 0u; i < sizeof(values) / sizeof(values[0]); i++) {
+        const uint64_t len = rt_str_len_double(values[i]);
+        assert_u64(len, strlen(expected[i]), "double length should match the fixed-point text");
+        void* bytes = new_bytes(len);
+        assert_u64(rt_str_write_double(bytes, 0u, values[i]), len, "double write should return the end offset");
+        assert_bytes(bytes, expected[i], "double text should match Str.from_double");
+    }
+}
+
+static void test_parts_chain_at_running_offsets(void) {
+    void* source = rt_array_new_u8(3u);
+    rt_dbg_root_slot_store(&g_frame, 1u, source);
+    memcpy((void*)rt_array_data_ptr(source), "abc", 3u);
+    void* empty = rt_array_new_u8(0u);
+    rt_dbg_root_slot_store(&g_frame, 2u, empty);
+
+    const uint8_t literal[] = {'x', '='};
+    const uint64_t len = 2u + 3u + 0u + rt_str_len_i64(-42) + rt_str_len_u64(5u);
+    void* bytes = new_bytes(len);
+    uint64_t offset = rt_str_write_literal(bytes, 0u, literal, 2u);
+    offset = rt_str_write_bytes(bytes, offset, source);
+    offset = rt_str_write_bytes(bytes, offset, empty);
+    offset = rt_str_write_i64(bytes, offset, -42);
+    offset = rt_str_write_u64(bytes, offset, 5u);
+    assert_u64(offset, len, "chained writes should end at the total length");
+    assert_bytes(bytes, "x=abc-425", "chained writes should concatenate in order");
+
+    if (rt_str_write_literal(bytes, len, literal, 0u) != len) {
+        fail("an empty literal should fit at the end of the buffer");
+    }
+    rt_dbg_root_slot_store(&g_frame, 1u, NULL);
+    rt_dbg_root_slot_store(&g_frame, 2u, NULL);
+}
+
+int main(void) {
+    rt_init();
+    rt_dbg_root_frame_init(&g_frame, g_slots, ROOT_SLOT_COUNT);
+    rt_dbg_push_roots(rt_thread_state(), &g_frame);
+
+    test_i64_formatting();
+    test_u64_formatting();
+    test_double_formatting();
+    test_parts_chain_at_running_offsets();
+
+    rt_dbg_root_slot_store(&g_frame, 0u, NULL);
+    rt_dbg_pop_roots(rt_thread_state());
+    rt_shutdown();
+    puts("test_str_runtime: ok");
+    return 0;
+}
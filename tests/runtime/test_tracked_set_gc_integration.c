@@ -32,7 +32,7 @@ static const RtType PAIR_TYPE = {
     .trace_fn = NULL,
     .pointer_offsets = PAIR_POINTER_OFFSETS,
     .pointer_offsets_count = 2,
-    .reserved0 = 0,
+    .subtype_id_end = 0,
     .super_type = NULL,
     .interface_tables = NULL,
     .interface_slot_count = 0,